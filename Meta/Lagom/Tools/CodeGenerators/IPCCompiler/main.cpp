@@ -279,6 +279,7 @@ int main(int argc, char** argv)
 #include <LibIPC/Encoder.h>
 #include <LibIPC/File.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/ReadonlyBuffer.h>
 #include <LibIPC/Stub.h>
 
 #ifdef __clang__
@@ -1684,7 +1684,15 @@ namespace Web::Bindings {
 void @wrapper_class@::initialize(JS::GlobalObject& global_object)
 {
     @wrapper_base_class@::initialize(global_object);
-}
+)~~~");
+
+    // Wrappers that answer property lookups themselves have to be asked every time.
+    if (interface.extended_attributes.contains("CustomGet") || interface.extended_attributes.contains("CustomSet") || interface.is_legacy_platform_object()) {
+        generator.append(R"~~~(    m_has_cacheable_property_lookups = false;
+)~~~");
+    }
+
+    generator.append(R"~~~(}
 
 @wrapper_class@::~@wrapper_class@()
 {
@@ -6,6 +6,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include <LibCore/ElapsedTimer.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/FontDatabase.h>
 #include <LibGfx/Painter.h>
@@ -20,6 +21,17 @@ static struct FontDatabaseSpoofer {
     }
 } g_spoof;
 
+template<typename Callback>
+static void report_pixel_throughput(StringView operation, int run_count, int pixels_per_run, Callback callback)
+{
+    auto timer = Core::ElapsedTimer(true);
+    timer.start();
+    for (int run = 0; run < run_count; run++)
+        callback();
+    auto elapsed_us = max(timer.elapsed_time().to_microseconds(), (i64)1);
+    outln("{}: {} Mpixels/s", operation, (i64)run_count * pixels_per_run / elapsed_us);
+}
+
 BENCHMARK_CASE(diagonal_lines)
 {
     const int run_count = 50;
@@ -57,7 +69,109 @@ BENCHMARK_CASE(fill_with_gradient)
     auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
     Gfx::Painter painter(*bitmap);
 
-    for (int run = 0; run < run_count; run++) {
+    report_pixel_throughput("fill_with_gradient"sv, run_count, bitmap_size * bitmap_size, [&] {
         painter.fill_rect_with_gradient(bitmap->rect(), Color::Blue, Color::Red);
-    }
+    });
+}
+
+BENCHMARK_CASE(fill_translucent)
+{
+    const int run_count = 100;
+    const int bitmap_size = 2000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    Gfx::Painter painter(*bitmap);
+    painter.clear_rect(bitmap->rect(), Color::White);
+
+    report_pixel_throughput("fill_translucent"sv, run_count, bitmap_size * bitmap_size, [&] {
+        painter.fill_rect(bitmap->rect(), Color(Color::Blue).with_alpha(128));
+    });
+}
+
+BENCHMARK_CASE(blit_opaque)
+{
+    const int run_count = 100;
+    const int bitmap_size = 2000;
+
+    auto source = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    Gfx::Painter painter(*bitmap);
+
+    report_pixel_throughput("blit_opaque"sv, run_count, bitmap_size * bitmap_size, [&] {
+        painter.blit({}, *source, source->rect());
+    });
+}
+
+BENCHMARK_CASE(blit_with_opacity)
+{
+    const int run_count = 100;
+    const int bitmap_size = 2000;
+
+    auto source = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    Gfx::Painter painter(*bitmap);
+
+    report_pixel_throughput("blit_with_opacity"sv, run_count, bitmap_size * bitmap_size, [&] {
+        painter.blit({}, *source, source->rect(), 0.5f);
+    });
+}
+
+BENCHMARK_CASE(blit_with_source_alpha)
+{
+    const int run_count = 100;
+    const int bitmap_size = 2000;
+
+    auto source = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size });
+    source->fill(Color(Color::Red).with_alpha(100));
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    Gfx::Painter painter(*bitmap);
+
+    report_pixel_throughput("blit_with_source_alpha"sv, run_count, bitmap_size * bitmap_size, [&] {
+        painter.blit({}, *source, source->rect());
+    });
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_integer_factor)
+{
+    const int run_count = 100;
+    const int bitmap_size = 2000;
+
+    auto source = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { bitmap_size / 2, bitmap_size / 2 });
+    source->fill(Color(Color::Red).with_alpha(100));
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    Gfx::Painter painter(*bitmap);
+
+    report_pixel_throughput("draw_scaled_bitmap_integer_factor"sv, run_count, bitmap_size * bitmap_size, [&] {
+        painter.draw_scaled_bitmap(bitmap->rect(), *source, source->rect());
+    });
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_nearest_neighbor)
+{
+    const int run_count = 100;
+    const int bitmap_size = 2000;
+
+    auto source = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { bitmap_size / 3, bitmap_size / 3 });
+    source->fill(Color(Color::Red).with_alpha(100));
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    Gfx::Painter painter(*bitmap);
+
+    report_pixel_throughput("draw_scaled_bitmap_nearest_neighbor"sv, run_count, bitmap_size * bitmap_size, [&] {
+        painter.draw_scaled_bitmap(bitmap->rect(), *source, source->rect());
+    });
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_bilinear)
+{
+    const int run_count = 10;
+    const int bitmap_size = 2000;
+
+    auto source = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { bitmap_size / 3, bitmap_size / 3 });
+    source->fill(Color(Color::Red).with_alpha(100));
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size });
+    Gfx::Painter painter(*bitmap);
+
+    report_pixel_throughput("draw_scaled_bitmap_bilinear"sv, run_count, bitmap_size * bitmap_size, [&] {
+        painter.draw_scaled_bitmap(bitmap->rect(), *source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::BilinearBlend);
+    });
 }
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Random.h>
+#include <LibGfx/BlendKernels.h>
+
+static constexpr size_t pixel_count = 37;
+
+static Gfx::RGBA32 random_pixel(bool make_opaque)
+{
+    auto pixel = get_random<Gfx::RGBA32>();
+    if (make_opaque)
+        pixel |= 0xff000000;
+    return pixel;
+}
+
+static void expect_blend_span_matches_color_blend(float opacity, bool use_source_alpha, Gfx::DestinationAlpha destination_alpha)
+{
+    Gfx::RGBA32 src[pixel_count];
+    Gfx::RGBA32 dst[pixel_count];
+    Gfx::RGBA32 expected[pixel_count];
+    for (size_t i = 0; i < pixel_count; ++i) {
+        src[i] = random_pixel(false);
+        dst[i] = random_pixel(i % 3 != 0);
+
+        auto dest_color = destination_alpha == Gfx::DestinationAlpha::Respect ? Color::from_rgba(dst[i]) : Color::from_rgb(dst[i]);
+        auto src_color = Color::from_rgb(src[i]);
+        if (use_source_alpha) {
+            float pixel_opacity = Color::from_rgba(src[i]).alpha() / 255.0;
+            src_color.set_alpha(255 * (opacity * pixel_opacity));
+        } else {
+            src_color.set_alpha(opacity * 255);
+        }
+        expected[i] = dest_color.blend(src_color).value();
+    }
+
+    Gfx::blend_span(dst, src, pixel_count, Gfx::alpha_table_for_opacity(opacity, use_source_alpha), destination_alpha);
+    for (size_t i = 0; i < pixel_count; ++i)
+        EXPECT_EQ(dst[i], expected[i]);
+}
+
+TEST_CASE(blend_span_matches_color_blend)
+{
+    for (float opacity : { 0.0f, 0.25f, 0.5f, 0.8f, 1.0f }) {
+        expect_blend_span_matches_color_blend(opacity, true, Gfx::DestinationAlpha::Respect);
+        expect_blend_span_matches_color_blend(opacity, true, Gfx::DestinationAlpha::Ignore);
+        expect_blend_span_matches_color_blend(opacity, false, Gfx::DestinationAlpha::Respect);
+        expect_blend_span_matches_color_blend(opacity, false, Gfx::DestinationAlpha::Ignore);
+    }
+}
+
+TEST_CASE(blend_color_span_matches_color_blend)
+{
+    for (u8 alpha : { 0, 1, 127, 128, 254, 255 }) {
+        auto color = Color::from_rgb(get_random<u32>()).with_alpha(alpha);
+        Gfx::RGBA32 dst[pixel_count];
+        Gfx::RGBA32 expected[pixel_count];
+        for (size_t i = 0; i < pixel_count; ++i) {
+            dst[i] = random_pixel(i % 4 != 0);
+            expected[i] = Color::from_rgba(dst[i]).blend(color).value();
+        }
+
+        Gfx::blend_color_span(dst, pixel_count, color);
+        for (size_t i = 0; i < pixel_count; ++i)
+            EXPECT_EQ(dst[i], expected[i]);
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/TrueTypeFont/GlyphAtlas.h>
+#include <LibTest/TestCase.h>
+#include <pthread.h>
+
+static RefPtr<Gfx::Bitmap> make_glyph(Gfx::IntSize const& size, Color color)
+{
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, size);
+    VERIFY(bitmap);
+    bitmap->fill(color);
+    return bitmap;
+}
+
+static bool entry_has_color(TTF::GlyphAtlas::Entry const& entry, Color color)
+{
+    for (int y = entry.rect.top(); y <= entry.rect.bottom(); ++y) {
+        for (int x = entry.rect.left(); x <= entry.rect.right(); ++x) {
+            if (entry.bitmap->get_pixel(x, y) != color)
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE(glyphs_are_rasterized_once)
+{
+    TTF::GlyphAtlas atlas(64);
+    int rasterize_count = 0;
+    auto rasterize = [&] {
+        ++rasterize_count;
+        return make_glyph({ 10, 12 }, Color::from_rgba(0x80ffffff));
+    };
+
+    auto first = atlas.ensure({ 1, 42 }, [&] { return rasterize(); });
+    auto second = atlas.ensure({ 1, 42 }, [&] { return rasterize(); });
+    EXPECT(first.has_value());
+    EXPECT(second.has_value());
+    EXPECT_EQ(rasterize_count, 1);
+    EXPECT_EQ(first->rect, second->rect);
+    EXPECT_EQ(first->rect.size(), Gfx::IntSize(10, 12));
+    EXPECT(entry_has_color(*first, Color::from_rgba(0x80ffffff)));
+
+    // The same glyph of another font is a different entry.
+    auto other_font = atlas.ensure({ 2, 42 }, [&] { return rasterize(); });
+    EXPECT_EQ(rasterize_count, 2);
+    EXPECT(!other_font->rect.intersects(first->rect));
+    EXPECT_EQ(atlas.glyph_count(), 2u);
+}
+
+TEST_CASE(glyphs_that_do_not_fit_are_rejected)
+{
+    TTF::GlyphAtlas atlas(32);
+    auto entry = atlas.ensure({ 1, 1 }, [] { return make_glyph({ 33, 8 }, Color::White); });
+    EXPECT(!entry.has_value());
+    EXPECT_EQ(atlas.glyph_count(), 0u);
+}
+
+TEST_CASE(least_recently_used_shelf_is_evicted)
+{
+    // Room for two shelves of two 16x16 glyphs each.
+    TTF::GlyphAtlas atlas(32);
+    int rasterize_count = 0;
+    auto ensure = [&](u32 glyph_id) {
+        return atlas.ensure({ 1, glyph_id }, [&] {
+            ++rasterize_count;
+            return make_glyph({ 16, 16 }, Color::from_rgb(glyph_id));
+        });
+    };
+
+    for (u32 glyph_id = 1; glyph_id <= 4; ++glyph_id)
+        EXPECT(ensure(glyph_id).has_value());
+    EXPECT_EQ(rasterize_count, 4);
+    EXPECT_EQ(atlas.eviction_count(), 0u);
+
+    // Glyph 1 shares the first shelf with glyph 2, so this makes the second shelf the least recently used one.
+    EXPECT(ensure(1).has_value());
+    EXPECT_EQ(rasterize_count, 4);
+
+    auto fifth = ensure(5);
+    EXPECT(fifth.has_value());
+    EXPECT_EQ(rasterize_count, 5);
+    EXPECT_EQ(atlas.eviction_count(), 1u);
+    EXPECT(entry_has_color(*fifth, Color::from_rgb(5)));
+
+    EXPECT(ensure(1).has_value());
+    EXPECT(ensure(2).has_value());
+    EXPECT_EQ(rasterize_count, 5);
+    EXPECT(ensure(3).has_value());
+    EXPECT_EQ(rasterize_count, 6);
+}
+
+TEST_CASE(eviction_does_not_overwrite_glyphs_still_in_use)
+{
+    TTF::GlyphAtlas atlas(16);
+    auto first = atlas.ensure({ 1, 1 }, [] { return make_glyph({ 16, 16 }, Color::Red); });
+    EXPECT(first.has_value());
+
+    auto second = atlas.ensure({ 1, 2 }, [] { return make_glyph({ 16, 16 }, Color::Blue); });
+    EXPECT(second.has_value());
+    EXPECT_EQ(second->rect, first->rect);
+    EXPECT_NE(second->bitmap.ptr(), first->bitmap.ptr());
+    EXPECT(entry_has_color(*first, Color::Red));
+    EXPECT(entry_has_color(*second, Color::Blue));
+}
+
+TEST_CASE(every_thread_has_its_own_atlas)
+{
+    auto* main_thread_atlas = &TTF::GlyphAtlas::the();
+    EXPECT_EQ(&TTF::GlyphAtlas::the(), main_thread_atlas);
+
+    TTF::GlyphAtlas* other_thread_atlas = nullptr;
+    pthread_t thread;
+    EXPECT_EQ(pthread_create(
+                  &thread, nullptr, [](void* atlas) -> void* {
+                      *static_cast<TTF::GlyphAtlas**>(atlas) = &TTF::GlyphAtlas::the();
+                      return nullptr;
+                  },
+                  &other_thread_atlas),
+        0);
+    EXPECT_EQ(pthread_join(thread, nullptr), 0);
+    EXPECT(other_thread_atlas);
+    EXPECT_NE(other_thread_atlas, main_thread_atlas);
+}
+
+TEST_CASE(atlas_is_destroyed_when_its_thread_exits)
+{
+    Optional<TTF::GlyphAtlas::Entry> entry;
+    pthread_t thread;
+    EXPECT_EQ(pthread_create(
+                  &thread, nullptr, [](void* entry) -> void* {
+                      *static_cast<Optional<TTF::GlyphAtlas::Entry>*>(entry) = TTF::GlyphAtlas::the().ensure({ 1, 1 }, [] { return make_glyph({ 8, 8 }, Color::Red); });
+                      return nullptr;
+                  },
+                  &entry),
+        0);
+    EXPECT_EQ(pthread_join(thread, nullptr), 0);
+    EXPECT(entry.has_value());
+    // The atlas held the only other reference to its bitmap.
+    if (entry.has_value())
+        EXPECT_EQ(entry->bitmap->ref_count(), 1u);
+}
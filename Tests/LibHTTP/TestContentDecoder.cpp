@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/Random.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibHTTP/ContentDecoder.h>
+
+static ByteBuffer make_test_data()
+{
+    // Mix some easily compressible runs with random bytes, so we get both compressed and stored blocks.
+    ByteBuffer data;
+    for (size_t i = 0; i < 256; ++i) {
+        if (i % 3 == 0) {
+            u8 random_bytes[1024];
+            fill_with_random(random_bytes, sizeof(random_bytes));
+            data.append(random_bytes, sizeof(random_bytes));
+        } else {
+            data.append("Lorem ipsum dolor sit amet, consectetur adipiscing elit. ", 57);
+        }
+    }
+    return data;
+}
+
+static Optional<ByteBuffer> decode_in_pieces(StringView const& content_encoding, ReadonlyBytes input, size_t piece_size)
+{
+    auto decoder = HTTP::ContentDecoder::create(content_encoding);
+    VERIFY(decoder);
+    ByteBuffer output;
+    for (size_t offset = 0; offset < input.size(); offset += piece_size) {
+        decoder->append(input.slice(offset, min(piece_size, input.size() - offset)));
+        auto decoded = decoder->decode(16 * KiB);
+        if (!decoded.has_value())
+            return {};
+        output.append(decoded->data(), decoded->size());
+    }
+    decoder->set_input_complete();
+    while (!decoder->is_finished()) {
+        auto decoded = decoder->decode(16 * KiB);
+        if (!decoded.has_value())
+            return {};
+        output.append(decoded->data(), decoded->size());
+    }
+    return output;
+}
+
+TEST_CASE(identity_is_passed_through)
+{
+    EXPECT(!HTTP::ContentDecoder::create("identity"sv));
+    EXPECT(!HTTP::ContentDecoder::create("br"sv));
+}
+
+TEST_CASE(gzip_in_pieces)
+{
+    auto data = make_test_data();
+    auto compressed = Compress::GzipCompressor::compress_all(data);
+    for (size_t piece_size : { 1, 1000, 100000 }) {
+        auto decoded = decode_in_pieces("gzip"sv, compressed.value(), piece_size);
+        EXPECT(decoded.has_value());
+        EXPECT(decoded.value() == data);
+    }
+}
+
+TEST_CASE(raw_deflate_in_pieces)
+{
+    auto data = make_test_data();
+    auto compressed = Compress::DeflateCompressor::compress_all(data);
+    auto decoded = decode_in_pieces("deflate"sv, compressed.value(), 1000);
+    EXPECT(decoded.has_value());
+    EXPECT(decoded.value() == data);
+}
+
+TEST_CASE(zlib_deflate)
+{
+    // "word1 abc word2", with the zlib wrapper.
+    const Array<u8, 21> compressed {
+        0x78, 0x9c, 0x2b, 0xcf, 0x2f, 0x4a, 0x31, 0x54, 0x48, 0x4c, 0x4a, 0x56,
+        0x28, 0x07, 0xb2, 0x8c, 0x00, 0x2b, 0x3c, 0x05, 0x42
+    };
+    auto decoded = decode_in_pieces("deflate"sv, compressed, 3);
+    EXPECT(decoded.has_value());
+    EXPECT(decoded.value().bytes() == "word1 abc word2"sv.bytes());
+}
+
+TEST_CASE(truncated_gzip_fails)
+{
+    auto data = make_test_data();
+    auto compressed = Compress::GzipCompressor::compress_all(data);
+    auto decoded = decode_in_pieces("gzip"sv, compressed->bytes().trim(compressed->size() / 2), 1000);
+    EXPECT(!decoded.has_value());
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// Each script is timed in the AST interpreter and in the bytecode interpreter (with each optimization level) separately.
+// The test case checks that they all come up with the same result, so the benchmarks only measure code that works.
+
+struct Script {
+    StringView source;
+    StringView expected_result;
+};
+
+static constexpr Script arithmetic_loop {
+    R"~~~(
+    function run(n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum = (sum + i * 3) % 1000003;
+        return sum;
+    }
+    run(1000000);
+)~~~"sv,
+    "18"sv,
+};
+
+static constexpr Script nested_loops {
+    R"~~~(
+    function run(n) {
+        var count = 0;
+        for (var i = 0; i < n; ++i) {
+            for (var j = 0; j < n; ++j) {
+                if ((i ^ j) & 1)
+                    count++;
+            }
+        }
+        return count;
+    }
+    run(1000);
+)~~~"sv,
+    "500000"sv,
+};
+
+static constexpr Script function_calls {
+    R"~~~(
+    function add(a, b) {
+        return a + b;
+    }
+    function run(n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum = add(sum, 1);
+        return sum;
+    }
+    run(300000);
+)~~~"sv,
+    "300000"sv,
+};
+
+static constexpr Script recursion {
+    R"~~~(
+    function fib(n) {
+        if (n < 2)
+            return n;
+        return fib(n - 1) + fib(n - 2);
+    }
+    fib(22);
+)~~~"sv,
+    "17711"sv,
+};
+
+static constexpr Script array_elements {
+    R"~~~(
+    function run(n) {
+        var a = [];
+        for (var i = 0; i < n; ++i)
+            a[i] = i;
+        var sum = 0;
+        for (var j = 0; j < n; ++j)
+            sum += a[j];
+        return sum;
+    }
+    run(300000);
+)~~~"sv,
+    "44999850000"sv,
+};
+
+static constexpr Script object_properties {
+    R"~~~(
+    function run(n) {
+        var point = { x: 0, y: 0 };
+        for (var i = 0; i < n; ++i) {
+            point.x += 1;
+            point.y += point.x;
+        }
+        return point.y;
+    }
+    run(300000);
+)~~~"sv,
+    "45000150000"sv,
+};
+
+static constexpr Script scripts[] = { arithmetic_loop, nested_loops, function_calls, recursion, array_elements, object_properties };
+
+TEST_CASE(every_interpreter_agrees)
+{
+    for (auto& script : scripts)
+        expect_result_in_every_interpreter(script.source, script.expected_result);
+}
+
+BENCHMARK_CASE(arithmetic_loop_ast)
+{
+    expect_result_in_interpreter(arithmetic_loop.source, InterpreterKind::AST, arithmetic_loop.expected_result);
+}
+
+BENCHMARK_CASE(arithmetic_loop_bytecode)
+{
+    expect_result_in_interpreter(arithmetic_loop.source, InterpreterKind::Bytecode, arithmetic_loop.expected_result);
+}
+
+BENCHMARK_CASE(arithmetic_loop_optimized_bytecode)
+{
+    expect_result_in_interpreter(arithmetic_loop.source, InterpreterKind::OptimizedBytecode, arithmetic_loop.expected_result);
+}
+
+BENCHMARK_CASE(nested_loops_ast)
+{
+    expect_result_in_interpreter(nested_loops.source, InterpreterKind::AST, nested_loops.expected_result);
+}
+
+BENCHMARK_CASE(nested_loops_bytecode)
+{
+    expect_result_in_interpreter(nested_loops.source, InterpreterKind::Bytecode, nested_loops.expected_result);
+}
+
+BENCHMARK_CASE(nested_loops_optimized_bytecode)
+{
+    expect_result_in_interpreter(nested_loops.source, InterpreterKind::OptimizedBytecode, nested_loops.expected_result);
+}
+
+BENCHMARK_CASE(function_calls_ast)
+{
+    expect_result_in_interpreter(function_calls.source, InterpreterKind::AST, function_calls.expected_result);
+}
+
+BENCHMARK_CASE(function_calls_bytecode)
+{
+    expect_result_in_interpreter(function_calls.source, InterpreterKind::Bytecode, function_calls.expected_result);
+}
+
+BENCHMARK_CASE(function_calls_optimized_bytecode)
+{
+    expect_result_in_interpreter(function_calls.source, InterpreterKind::OptimizedBytecode, function_calls.expected_result);
+}
+
+BENCHMARK_CASE(recursion_ast)
+{
+    expect_result_in_interpreter(recursion.source, InterpreterKind::AST, recursion.expected_result);
+}
+
+BENCHMARK_CASE(recursion_bytecode)
+{
+    expect_result_in_interpreter(recursion.source, InterpreterKind::Bytecode, recursion.expected_result);
+}
+
+BENCHMARK_CASE(recursion_optimized_bytecode)
+{
+    expect_result_in_interpreter(recursion.source, InterpreterKind::OptimizedBytecode, recursion.expected_result);
+}
+
+BENCHMARK_CASE(array_elements_ast)
+{
+    expect_result_in_interpreter(array_elements.source, InterpreterKind::AST, array_elements.expected_result);
+}
+
+BENCHMARK_CASE(array_elements_bytecode)
+{
+    expect_result_in_interpreter(array_elements.source, InterpreterKind::Bytecode, array_elements.expected_result);
+}
+
+BENCHMARK_CASE(array_elements_optimized_bytecode)
+{
+    expect_result_in_interpreter(array_elements.source, InterpreterKind::OptimizedBytecode, array_elements.expected_result);
+}
+
+BENCHMARK_CASE(object_properties_ast)
+{
+    expect_result_in_interpreter(object_properties.source, InterpreterKind::AST, object_properties.expected_result);
+}
+
+BENCHMARK_CASE(object_properties_bytecode)
+{
+    expect_result_in_interpreter(object_properties.source, InterpreterKind::Bytecode, object_properties.expected_result);
+}
+
+BENCHMARK_CASE(object_properties_optimized_bytecode)
+{
+    expect_result_in_interpreter(object_properties.source, InterpreterKind::OptimizedBytecode, object_properties.expected_result);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// These run tight loops of GetById and PutById instructions in the bytecode interpreter.
+// The loops live in functions, so that their variables aren't looked up on the global object every time around.
+
+static void run_benchmark(StringView source, double expected_result)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    ScriptRunner runner;
+    auto result = runner.run_in_bytecode_interpreter(*program, JS::Bytecode::Interpreter::OptimizationLevel::Default);
+    if (!result.has_value())
+        return;
+    EXPECT(result->is_number());
+    EXPECT_EQ(result->as_double(), expected_result);
+}
+
+BENCHMARK_CASE(own_property_get)
+{
+    run_benchmark(R"~~~(
+        function run(o, n) {
+            var sum = 0;
+            for (var i = 0; i < n; ++i)
+                sum += o.x + o.y;
+            return sum;
+        }
+        run({ x: 1, y: 2 }, 1000000);
+    )~~~"sv,
+        3000000);
+}
+
+BENCHMARK_CASE(own_property_put)
+{
+    run_benchmark(R"~~~(
+        function run(o, n) {
+            for (var i = 0; i < n; ++i)
+                o.x = i;
+            return o.x;
+        }
+        run({ x: 0 }, 1000000);
+    )~~~"sv,
+        999999);
+}
+
+BENCHMARK_CASE(prototype_property_get)
+{
+    run_benchmark(R"~~~(
+        function Base() {}
+        Base.prototype.value = 1;
+        function Derived() {}
+        Derived.prototype = Object.create(Base.prototype);
+        function run(o, n) {
+            var sum = 0;
+            for (var i = 0; i < n; ++i)
+                sum += o.value;
+            return sum;
+        }
+        run(new Derived(), 1000000);
+    )~~~"sv,
+        1000000);
+}
+
+BENCHMARK_CASE(method_call)
+{
+    run_benchmark(R"~~~(
+        function Point(x, y) {
+            this.x = x;
+            this.y = y;
+        }
+        Point.prototype.sum = function () {
+            return this.x + this.y;
+        };
+        function run(p, n) {
+            var sum = 0;
+            for (var i = 0; i < n; ++i)
+                sum += p.sum();
+            return sum;
+        }
+        run(new Point(1, 2), 1000000);
+    )~~~"sv,
+        3000000);
+}
+
+BENCHMARK_CASE(property_add)
+{
+    run_benchmark(R"~~~(
+        function run(n) {
+            var sum = 0;
+            for (var i = 0; i < n; ++i) {
+                var o = {};
+                o.x = 1;
+                o.y = 2;
+                sum += o.y;
+            }
+            return sum;
+        }
+        run(1000000);
+    )~~~"sv,
+        2000000);
+}
+
+BENCHMARK_CASE(polymorphic_property_get)
+{
+    run_benchmark(R"~~~(
+        function run(objects, n) {
+            var sum = 0;
+            for (var i = 0; i < n; ++i)
+                sum += objects[i % 4].x;
+            return sum;
+        }
+        run([{ x: 1 }, { a: 0, x: 1 }, { b: 0, x: 1 }, { c: 0, d: 0, x: 1 }], 1000000);
+    )~~~"sv,
+        1000000);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibTest/TestCase.h>
+
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/Exception.h>
+#include <LibJS/Runtime/GlobalObject.h>
+
+// Owns a VM and a global object, and runs scripts in either interpreter on top of them.
+// Anything that goes wrong along the way (syntax errors, uncaught exceptions) fails the current test.
+class ScriptRunner {
+public:
+    ScriptRunner()
+        : m_vm(JS::VM::create())
+        , m_interpreter(JS::Interpreter::create<JS::GlobalObject>(*m_vm))
+    {
+    }
+
+    JS::VM& vm() { return *m_vm; }
+    JS::Interpreter& interpreter() { return *m_interpreter; }
+
+    static RefPtr<JS::Program> parse(JS::Parser& parser)
+    {
+        auto program = parser.parse_program();
+        EXPECT(!parser.has_errors());
+        if (parser.has_errors())
+            return {};
+        return program;
+    }
+
+    Optional<JS::Value> run_in_ast_interpreter(JS::Program const& program)
+    {
+        m_interpreter->run(m_interpreter->global_object(), program);
+        return take_result();
+    }
+
+    Optional<JS::Value> run_in_bytecode_interpreter(JS::Bytecode::Executable const& executable)
+    {
+        JS::Bytecode::Interpreter bytecode_interpreter(m_interpreter->global_object(), m_interpreter->realm());
+        bytecode_interpreter.run(executable);
+        return take_result();
+    }
+
+    Optional<JS::Value> run_in_bytecode_interpreter(JS::Program const& program, JS::Bytecode::Interpreter::OptimizationLevel level)
+    {
+        // Functions are compiled with whatever level is set when they are first called, so it has to stay set until the script is done.
+        JS::Bytecode::Interpreter::set_optimization_level(level);
+        auto executable = JS::Bytecode::Generator::generate(program);
+        JS::Bytecode::Interpreter::optimization_pipeline().perform(executable);
+        auto result = run_in_bytecode_interpreter(executable);
+        JS::Bytecode::Interpreter::set_optimization_level(JS::Bytecode::Interpreter::OptimizationLevel::Default);
+        return result;
+    }
+
+private:
+    Optional<JS::Value> take_result()
+    {
+        if (auto* exception = m_vm->exception()) {
+            FAIL(String::formatted("Uncaught exception: {}", exception->value()));
+            m_vm->clear_exception();
+            return {};
+        }
+        return m_vm->last_value();
+    }
+
+    NonnullRefPtr<JS::VM> m_vm;
+    NonnullOwnPtr<JS::Interpreter> m_interpreter;
+};
+
+enum class InterpreterKind {
+    AST,
+    Bytecode,
+    OptimizedBytecode,
+};
+
+// Runs the program in a fresh VM with the given interpreter, and checks that it comes up with the expected result.
+inline void expect_result_in_interpreter(JS::Program const& program, InterpreterKind interpreter_kind, StringView expected_result)
+{
+    // NOTE: The result lives in the runner's heap, so the runner has to outlive it.
+    ScriptRunner runner;
+    StringView interpreter_name;
+    Optional<JS::Value> result;
+    switch (interpreter_kind) {
+    case InterpreterKind::AST:
+        interpreter_name = "AST interpreter"sv;
+        result = runner.run_in_ast_interpreter(program);
+        break;
+    case InterpreterKind::Bytecode:
+        interpreter_name = "Bytecode interpreter"sv;
+        result = runner.run_in_bytecode_interpreter(program, JS::Bytecode::Interpreter::OptimizationLevel::Default);
+        break;
+    case InterpreterKind::OptimizedBytecode:
+        interpreter_name = "Optimized bytecode interpreter"sv;
+        result = runner.run_in_bytecode_interpreter(program, JS::Bytecode::Interpreter::OptimizationLevel::Aggressive);
+        break;
+    }
+
+    if (!result.has_value())
+        return;
+    auto result_string = result->to_string_without_side_effects();
+    if (result_string != expected_result)
+        FAIL(String::formatted("{} returned '{}', expected '{}'", interpreter_name, result_string, expected_result));
+}
+
+inline void expect_result_in_interpreter(StringView source, InterpreterKind interpreter_kind, StringView expected_result)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+    expect_result_in_interpreter(*program, interpreter_kind, expected_result);
+}
+
+// Runs the script in the AST interpreter and in the bytecode interpreter at every optimization level, each in a fresh VM,
+// and checks that all of them come up with the expected result.
+inline void expect_result_in_every_interpreter(StringView source, StringView expected_result)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    for (auto interpreter_kind : { InterpreterKind::AST, InterpreterKind::Bytecode, InterpreterKind::OptimizedBytecode })
+        expect_result_in_interpreter(*program, interpreter_kind, expected_result);
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// test-js only runs in the AST interpreter, so these make sure the passes of the aggressive optimization pipeline
+// don't change what a script does. Each one is aimed at what a particular pass could get wrong, and is checked
+// against the AST interpreter and the default pipeline.
+
+TEST_CASE(constant_folding)
+{
+    expect_result_in_every_interpreter(R"~~~(
+        var results = [];
+        results.push(1 / -0, 1 / (0 * -1), -1 % 1 === 0 && 1 / (-1 % 1));
+        results.push(NaN == NaN, NaN != NaN, NaN < 1, NaN >= 1);
+        results.push(5.5 % 2, -5.5 % 2, 5 % -0);
+        results.push(1 << 33, -1 >>> 0, -16 >> 2, 2147483647 + 1 | 0, ~5);
+        results.push(~3.5, 3.5 | 0, 2 ** 3);
+        results.push(!0, !null, !undefined, !"", -(-0) === 0);
+
+        // None of these are numbers, so they are left to the interpreter.
+        var valueOfCalls = 0;
+        var object = { valueOf: function () { ++valueOfCalls; return 2; } };
+        results.push("1" + 2, 1 + "2", true + 1, null + 1, object * 3, object < 3, valueOfCalls);
+
+        var x = 1;
+        x = x + 1;
+        x = x * 10;
+        results.push(x);
+        results.join();
+    )~~~"sv,
+        "-Infinity,-Infinity,-Infinity,false,true,false,false,1.5,-1.5,NaN,2,4294967295,-4,-2147483648,-6,-4,3,8,true,true,true,true,true,12,12,2,1,6,true,2,20"sv);
+}
+
+TEST_CASE(constants_do_not_leak_between_blocks)
+{
+    expect_result_in_every_interpreter(R"~~~(
+        function run(flag) {
+            var value = 1;
+            if (flag)
+                value = 2;
+            var sum = 0;
+            for (var i = 0; i < 3; ++i) {
+                sum += value;
+                value = value * 2;
+            }
+            return sum;
+        }
+        [run(false), run(true)].join();
+    )~~~"sv,
+        "7,14"sv);
+}
+
+TEST_CASE(jump_threading)
+{
+    expect_result_in_every_interpreter(R"~~~(
+        function describe(value) {
+            var results = [];
+            results.push(value ?? "nullish");
+            results.push(value || "falsy");
+            results.push(value && "truthy");
+            results.push(value === undefined ? "undefined" : value === null ? "null" : "defined");
+            results.push((value ?? 0) || (value ?? 1) ? "either" : "neither");
+            if (value)
+                if (value)
+                    results.push("twice");
+            return results.join(":");
+        }
+        function assign(value) {
+            var a = value, b = value, c = value;
+            a ??= "a";
+            b ||= "b";
+            c &&= "c";
+            return [a, b, c].join(":");
+        }
+        [describe(undefined), describe(null), describe(0), describe(""), describe(1),
+            assign(undefined), assign(null), assign(0), assign(1)].join();
+    )~~~"sv,
+        "nullish:falsy::undefined:either,nullish:falsy::null:either,0:falsy:0:defined:neither,:falsy::defined:neither,1:1:truthy:defined:either:twice,a:b:,a:b:,0:b:0,1:1:c"sv);
+}
+
+TEST_CASE(dead_code_elimination)
+{
+    expect_result_in_every_interpreter(R"~~~(
+        function unreachable() {
+            return hoisted();
+            function hoisted() { return "hoisted"; }
+            throw new Error("not reached");
+        }
+        function folded(n) {
+            if (false)
+                n = 0;
+            while (false)
+                n = 1;
+            if (true)
+                return n + 1;
+            return -1;
+        }
+        function handlers() {
+            var log = [];
+            try {
+                log.push("try");
+                null.property;
+                log.push("not reached");
+            } catch (error) {
+                log.push("catch");
+            } finally {
+                log.push("finally");
+            }
+            return log.join(":");
+        }
+        [unreachable(), folded(2), handlers()].join();
+    )~~~"sv,
+        "hoisted,3,try:catch:finally"sv);
+}
+
+TEST_CASE(dead_store_elimination)
+{
+    expect_result_in_every_interpreter(R"~~~(
+        var calls = [];
+        function call(name) {
+            calls.push(name);
+            return name;
+        }
+        function run() {
+            var unused = { a: call("object") };
+            var unusedArray = [call("array"), 1, 2];
+            var overwritten = call("first");
+            overwritten = call("second");
+            "unused string";
+            10n;
+            (function () {});
+            return overwritten;
+        }
+        [run(), calls.join(":")].join();
+    )~~~"sv,
+        "second,object:array:first:second"sv);
+}
+
+TEST_CASE(register_allocation)
+{
+    expect_result_in_every_interpreter(R"~~~(
+        function add(a, b) { return a + b; }
+        function run(a, b, c, d, e) {
+            var nested = add(a, b) * (add(c, d) - add(e, add(a, add(b, c)))) + [a, b, c, d, e].length;
+            var swaps = [];
+            for (var i = 0; i < 3; ++i) {
+                var t = a;
+                a = b;
+                b = c;
+                c = t;
+                swaps.push(a, b, c);
+            }
+            var copy = a;
+            a = a + 1;
+            return [nested, swaps.join(""), copy, a].join(":");
+        }
+        run(1, 2, 3, 4, 5);
+    )~~~"sv,
+        "-7:231312123:1:2"sv);
+}
+
+TEST_CASE(block_merging)
+{
+    expect_result_in_every_interpreter(R"~~~(
+        function classify(n) {
+            var result = "";
+            switch (n) {
+            case 0:
+                result += "zero";
+            case 1:
+                result += "small";
+                break;
+            case 2:
+            case 3:
+                result += "medium";
+                break;
+            default:
+                result += "large";
+            }
+            if (n % 2)
+                result += ":odd";
+            else
+                result += ":even";
+            return result;
+        }
+        function loops() {
+            var count = 0;
+            for (var i = 0; i < 5; ++i) {
+                if (i == 1)
+                    continue;
+                for (var j = 0; j < 5; ++j) {
+                    if (j == 3)
+                        break;
+                    ++count;
+                }
+                if (i == 3)
+                    break;
+            }
+            var k = 0;
+            do {
+                ++k;
+            } while (k < 3);
+            return count + k;
+        }
+        [classify(0), classify(1), classify(3), classify(8), loops()].join();
+    )~~~"sv,
+        "zerosmall:even,small:odd,medium:odd,large:even,12"sv);
+}
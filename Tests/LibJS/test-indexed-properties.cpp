@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+#include <LibJS/Runtime/IndexedProperties.h>
+
+TEST_CASE(appending_int32_elements_keeps_them_packed)
+{
+    JS::SimpleIndexedPropertyStorage storage;
+    for (i32 i = 0; i < 100; ++i)
+        storage.put(i, JS::Value(i));
+    EXPECT_EQ(storage.elements_kind(), JS::ElementsKind::PackedInt32);
+    EXPECT_EQ(storage.array_like_size(), 100u);
+    EXPECT_EQ(storage.int32_elements().size(), 100u);
+    EXPECT_EQ(storage.get(99)->value.as_i32(), 99);
+
+    // Shrinking and appending again doesn't leave any holes either.
+    storage.take_last();
+    storage.set_array_like_size(50);
+    storage.put(50, JS::Value(50));
+    EXPECT_EQ(storage.elements_kind(), JS::ElementsKind::PackedInt32);
+    EXPECT_EQ(storage.array_like_size(), 51u);
+}
+
+TEST_CASE(holes_demote_int32_elements)
+{
+    JS::SimpleIndexedPropertyStorage written_past_the_end;
+    written_past_the_end.put(0, JS::Value(0));
+    written_past_the_end.put(2, JS::Value(2));
+    EXPECT_EQ(written_past_the_end.elements_kind(), JS::ElementsKind::Double);
+    EXPECT(!written_past_the_end.has_index(1));
+    EXPECT(written_past_the_end.has_holes());
+
+    JS::SimpleIndexedPropertyStorage grown;
+    grown.put(0, JS::Value(0));
+    grown.set_array_like_size(2);
+    EXPECT_EQ(grown.elements_kind(), JS::ElementsKind::Double);
+    EXPECT(grown.has_index(0));
+    EXPECT_EQ(grown.get(0)->value.as_double(), 0.0);
+    EXPECT(!grown.has_index(1));
+
+    JS::SimpleIndexedPropertyStorage appended_double;
+    appended_double.put(0, JS::Value(0));
+    appended_double.put(1, JS::Value(0.5));
+    EXPECT_EQ(appended_double.elements_kind(), JS::ElementsKind::Double);
+    EXPECT(!appended_double.has_holes());
+}
+
+TEST_CASE(array_push_keeps_int32_elements_packed)
+{
+    auto parser = JS::Parser(JS::Lexer("var array = []; for (var i = 0; i < 100; ++i) array.push(i); array;"sv));
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    ScriptRunner runner;
+    auto result = runner.run_in_ast_interpreter(*program);
+    if (!result.has_value())
+        return;
+    EXPECT(result->is_object());
+    if (!result->is_object())
+        return;
+
+    auto& indexed_properties = result->as_object().indexed_properties();
+    EXPECT(indexed_properties.is_simple_storage());
+    if (!indexed_properties.is_simple_storage())
+        return;
+    auto& storage = static_cast<JS::SimpleIndexedPropertyStorage const&>(indexed_properties.storage());
+    EXPECT_EQ(storage.elements_kind(), JS::ElementsKind::PackedInt32);
+    EXPECT_EQ(storage.array_like_size(), 100u);
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+#include <LibCore/DirIterator.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static constexpr auto source = R"~~~(
+    function add(a, b) { return a + b; }
+    function run(n) {
+        "use strict";
+        var text = `${ {a: "}"}.a }`;
+        var sum = 0n;
+        for (var i = 0; i < n; ++i) {
+            if (i % 3 == 0)
+                continue;
+            sum += BigInt(add(i, 1));
+        }
+        var squares = [1, 2, 3].map(x => x * x);
+        return text + sum + squares.join();
+    }
+    run(10);
+)~~~"sv;
+static constexpr auto expected_result = "}331,4,9"sv;
+
+static void expect_run_result(Optional<JS::Value> result)
+{
+    if (!result.has_value())
+        return;
+    EXPECT(result->is_string());
+    if (result->is_string())
+        EXPECT_EQ(result->as_string().string(), expected_result);
+}
+
+TEST_CASE(lazily_parsed_functions)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    parser.set_skip_function_bodies(true);
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    ScriptRunner runner;
+    expect_run_result(runner.run_in_ast_interpreter(*program));
+}
+
+TEST_CASE(nested_functions_are_skipped_when_parsing_lazily)
+{
+    // Parsing outer() jumps over the bodies of the functions in it, so the lexer has to pick up right where they end.
+    auto parser = JS::Parser(JS::Lexer(R"~~~(
+        function outer(x) {
+            function middle(y) {
+                var text = `${ function () { return { k: y }; }().k }`;
+                function inner() { return arguments.length; }
+                return inner(1, 2) + text;
+            }
+            var ratio = function () {} / 2 / 1;
+            return middle(x) + `${ (function () { return "}"; })() }` + /}/.source + isNaN(ratio);
+        }
+        outer(4);
+    )~~~"sv));
+    parser.set_skip_function_bodies(true);
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    ScriptRunner runner;
+    auto result = runner.run_in_ast_interpreter(*program);
+    if (!result.has_value())
+        return;
+    EXPECT(result->is_string());
+    if (result->is_string())
+        EXPECT_EQ(result->as_string().string(), "24}}true"sv);
+}
+
+TEST_CASE(syntax_errors_in_skipped_functions_are_reported_when_parsing)
+{
+    // Early errors must be reported before anything runs, even in functions that are never called.
+    static constexpr StringView sources[] = {
+        "function bad() { let a; let a; } 'parsed';"sv,
+        "function bad() { break; } 'parsed';"sv,
+        "function bad() { for (;;) { function inner() { continue; } } } 'parsed';"sv,
+        "function bad() { 'use strict'; var eval = 1; } 'parsed';"sv,
+        "function bad() { 'use strict'; with ({}) {} } 'parsed';"sv,
+        "function bad() { return function* () { yield = 1; }; } 'parsed';"sv,
+        "function bad() { a b; } 'parsed';"sv,
+    };
+    for (auto bad_source : sources) {
+        auto parser = JS::Parser(JS::Lexer(bad_source));
+        parser.set_skip_function_bodies(true);
+        parser.parse_program();
+        EXPECT(parser.has_errors());
+    }
+}
+
+TEST_CASE(executable_round_trip)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    parser.set_skip_function_bodies(true);
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    auto executable = JS::Bytecode::Generator::generate(*program);
+    JS::Bytecode::Interpreter::optimization_pipeline().perform(executable);
+
+    auto data = JS::Bytecode::ExecutableCache::serialize(executable, parser.function_nodes());
+    EXPECT(data.has_value());
+    if (!data.has_value())
+        return;
+
+    // Anything that has been tampered with should be turned away.
+    auto corrupted_data = data.value();
+    corrupted_data[corrupted_data.size() / 2] ^= 0x55;
+    EXPECT(!JS::Bytecode::ExecutableCache::deserialize(corrupted_data, parser.function_nodes()).has_value());
+    EXPECT(!JS::Bytecode::ExecutableCache::deserialize(data->bytes().slice(0, data->size() - 1), parser.function_nodes()).has_value());
+
+    auto loaded_executable = JS::Bytecode::ExecutableCache::deserialize(*data, parser.function_nodes());
+    EXPECT(loaded_executable.has_value());
+    if (!loaded_executable.has_value())
+        return;
+    EXPECT_EQ(loaded_executable->basic_blocks.size(), executable.basic_blocks.size());
+    EXPECT_EQ(loaded_executable->number_of_registers, executable.number_of_registers);
+
+    ScriptRunner runner;
+    expect_run_result(runner.run_in_bytecode_interpreter(*loaded_executable));
+}
+
+TEST_CASE(executables_with_out_of_range_operands_are_rejected)
+{
+    auto parser = JS::Parser(JS::Lexer("var object = { greeting: 'hello' }; object.greeting;"sv));
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    // These are internally consistent files, so only checking the operands against the tables we read can catch them.
+    auto without_strings = JS::Bytecode::Generator::generate(*program);
+    without_strings.string_table = make<JS::Bytecode::StringTable>();
+    auto data = JS::Bytecode::ExecutableCache::serialize(without_strings, parser.function_nodes());
+    EXPECT(data.has_value());
+    if (data.has_value())
+        EXPECT(!JS::Bytecode::ExecutableCache::deserialize(*data, parser.function_nodes()).has_value());
+
+    auto without_caches = JS::Bytecode::Generator::generate(*program);
+    without_caches.property_lookup_caches.clear();
+    data = JS::Bytecode::ExecutableCache::serialize(without_caches, parser.function_nodes());
+    EXPECT(data.has_value());
+    if (data.has_value())
+        EXPECT(!JS::Bytecode::ExecutableCache::deserialize(*data, parser.function_nodes()).has_value());
+}
+
+static void run_lazily(StringView text)
+{
+    auto parser = JS::Parser(JS::Lexer(text));
+    parser.set_skip_function_bodies(true);
+    auto program = ScriptRunner::parse(parser);
+    if (!program)
+        return;
+
+    auto executable = JS::Bytecode::Generator::generate(*program);
+    ScriptRunner runner;
+    expect_run_result(runner.run_in_bytecode_interpreter(executable));
+}
+
+TEST_CASE(cached_function_bytecode)
+{
+    char directory[] = "/tmp/test-lazy-compilation.XXXXXX";
+    EXPECT(mkdtemp(directory));
+    JS::Bytecode::ExecutableCache::enable(directory);
+
+    // The first run fills the cache with the bytecode of every function that gets called, the second one takes it from there.
+    for (size_t i = 0; i < 2; ++i)
+        run_lazily(source);
+
+    Core::DirIterator iterator(directory, Core::DirIterator::Flags::SkipDots);
+    size_t cached_executables = 0;
+    while (iterator.has_next()) {
+        auto path = iterator.next_full_path();
+        EXPECT(path.ends_with(".jsbc"));
+        unlink(path.characters());
+        ++cached_executables;
+    }
+    rmdir(directory);
+    // add() and run(), the arrow function is parsed along with run() and doesn't get a cache entry of its own.
+    EXPECT_EQ(cached_executables, 2u);
+}
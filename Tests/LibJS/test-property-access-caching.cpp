@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScriptRunner.h"
+
+// test-js only runs in the AST interpreter, so these check that the inline caches of GetById and PutById notice when
+// the objects they have seen change. Each script warms up an access with one kind of object, changes it, and then
+// collects what the same access sees afterwards.
+
+static constexpr auto prelude = R"~~~(
+    function getX(object) { return object.x; }
+    function setX(object, value) { object.x = value; }
+    function setXStrict(object, value) { "use strict"; object.x = value; }
+    function warmUp(callback) {
+        for (var i = 0; i < 10; ++i)
+            callback();
+    }
+    function throwsTypeError(callback) {
+        try {
+            callback();
+        } catch (error) {
+            return error instanceof TypeError;
+        }
+        return false;
+    }
+)~~~"sv;
+
+static void expect_result(StringView test_source, StringView expected_result)
+{
+    expect_result_in_every_interpreter(String::formatted("{}{}", prelude, test_source), expected_result);
+}
+
+TEST_CASE(get_after_accessor_redefinition)
+{
+    expect_result(R"~~~(
+        var own = { x: 1 };
+        warmUp(function () { getX(own); });
+        Object.defineProperty(own, "x", { get: function () { return 2; } });
+
+        var prototype = { x: 1 };
+        var inherited = Object.create(prototype);
+        warmUp(function () { getX(inherited); });
+        Object.defineProperty(prototype, "x", { get: function () { return 3; } });
+
+        var accessor = {};
+        Object.defineProperty(accessor, "x", { get: function () { return 1; }, configurable: true });
+        warmUp(function () { getX(accessor); });
+        Object.defineProperty(accessor, "x", { value: 4 });
+
+        [getX(own), getX(inherited), getX(accessor)].join();
+    )~~~"sv,
+        "2,3,4"sv);
+}
+
+TEST_CASE(get_after_prototype_changes)
+{
+    expect_result(R"~~~(
+        var results = [];
+        var prototype = { x: 1 };
+        var object = Object.create(prototype);
+        warmUp(function () { getX(object); });
+
+        prototype.x = 2;
+        results.push(getX(object));
+        Object.setPrototypeOf(object, { x: 3 });
+        results.push(getX(object));
+        Object.setPrototypeOf(object, null);
+        results.push(getX(object));
+
+        var grandparent = {};
+        var parent = Object.create(grandparent);
+        var child = Object.create(parent);
+        warmUp(function () { getX(child); });
+        grandparent.x = 4;
+        results.push(getX(child));
+        parent.x = 5;
+        results.push(getX(child));
+        child.x = 6;
+        results.push(getX(child));
+
+        results.join();
+    )~~~"sv,
+        "2,3,,4,5,6"sv);
+}
+
+TEST_CASE(get_after_delete_and_re_add)
+{
+    expect_result(R"~~~(
+        var results = [];
+        var object = { x: 1, y: 2 };
+        warmUp(function () { getX(object); });
+
+        Reflect.deleteProperty(object, "x");
+        results.push(typeof getX(object));
+        object.x = 3;
+        results.push(getX(object));
+
+        var shadowing = Object.create({ x: 4 });
+        shadowing.x = 5;
+        warmUp(function () { getX(shadowing); });
+        Reflect.deleteProperty(shadowing, "x");
+        results.push(getX(shadowing));
+
+        results.join();
+    )~~~"sv,
+        "undefined,3,4"sv);
+}
+
+TEST_CASE(put_after_accessor_redefinition)
+{
+    expect_result(R"~~~(
+        var results = [];
+        var object = { x: 1 };
+        warmUp(function () { setX(object, 2); });
+        Object.defineProperty(object, "x", {
+            get: function () { return 3; },
+            set: function (value) { results.push(`set ${value}`); },
+        });
+        setX(object, 4);
+        results.push(object.x);
+
+        var prototype = {};
+        warmUp(function () { setX(Object.create(prototype), 5); });
+        Object.defineProperty(prototype, "x", { set: function (value) { results.push(`inherited set ${value}`); } });
+        var inherited = Object.create(prototype);
+        setX(inherited, 6);
+        results.push(Object.getOwnPropertyNames(inherited).length);
+
+        results.join();
+    )~~~"sv,
+        "set 4,3,inherited set 6,0"sv);
+}
+
+TEST_CASE(put_after_prototype_changes)
+{
+    expect_result(R"~~~(
+        var results = [];
+        var prototype = {};
+        warmUp(function () { setX(Object.create(prototype), 1); });
+        Object.defineProperty(prototype, "x", { value: 2, writable: false });
+        var object = Object.create(prototype);
+        setX(object, 3);
+        results.push(object.x, Object.getOwnPropertyNames(object).length);
+        results.push(throwsTypeError(function () { setXStrict(object, 3); }));
+
+        var reassigned = {};
+        warmUp(function () { setX(reassigned, 4); });
+        Reflect.deleteProperty(reassigned, "x");
+        Object.setPrototypeOf(reassigned, {});
+        Object.defineProperty(Object.getPrototypeOf(reassigned), "x", { set: function (value) { results.push(`set ${value}`); } });
+        setX(reassigned, 5);
+        results.push(reassigned.hasOwnProperty("x"));
+
+        results.join();
+    )~~~"sv,
+        "2,0,true,set 5,false"sv);
+}
+
+TEST_CASE(put_after_freeze)
+{
+    expect_result(R"~~~(
+        var results = [];
+        var object = { x: 1 };
+        warmUp(function () { setX(object, 2); setXStrict(object, 2); });
+        Object.freeze(object);
+        setX(object, 3);
+        results.push(object.x, throwsTypeError(function () { setXStrict(object, 3); }), object.x);
+
+        warmUp(function () { setX({}, 4); setXStrict({}, 4); });
+        var frozen = Object.freeze({});
+        setX(frozen, 5);
+        results.push(typeof frozen.x, throwsTypeError(function () { setXStrict(frozen, 5); }), typeof frozen.x);
+
+        results.join();
+    )~~~"sv,
+        "2,true,2,undefined,true,undefined"sv);
+}
+
+TEST_CASE(put_after_prevent_extensions)
+{
+    expect_result(R"~~~(
+        var results = [];
+        warmUp(function () { setX({}, 1); setXStrict({}, 1); });
+        var object = Object.preventExtensions({});
+        setX(object, 2);
+        results.push(typeof object.x, throwsTypeError(function () { setXStrict(object, 2); }));
+        results.push(Object.getOwnPropertyNames(object).length);
+
+        var existing = { x: 3 };
+        warmUp(function () { setX(existing, 4); });
+        Object.preventExtensions(existing);
+        setX(existing, 5);
+        results.push(existing.x);
+
+        results.join();
+    )~~~"sv,
+        "undefined,true,0,5"sv);
+}
+
+TEST_CASE(put_after_delete_and_re_add)
+{
+    expect_result(R"~~~(
+        var object = { x: 1, y: 2 };
+        warmUp(function () { setX(object, 3); });
+        Reflect.deleteProperty(object, "x");
+        setX(object, 4);
+        var keys = Object.keys(object).join("");
+
+        Reflect.deleteProperty(object, "y");
+        object.y = 5;
+        setX(object, 6);
+        [keys, object.x, object.y, Object.keys(object).join("")].join();
+    )~~~"sv,
+        "yx,6,5,xy"sv);
+}
@@ -880,6 +880,72 @@ TEST_CASE(theoretically_infinite_loop)
     }
 }
 
+TEST_CASE(exponential_backtracking)
+{
+    // Without backreferences and lookarounds, these should fall back to an NFA simulation
+    // instead of trying every way of splitting up the input.
+    Array patterns {
+        "(a*)*b"sv,
+        "(a|a)*b"sv,
+        "(a|aa)+c"sv,
+        "^(\\w+\\s?)*$"sv,
+    };
+    auto subject = String::formatted("{}!", String::repeated('a', 100));
+    for (auto& pattern : patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT(re.parser_result.can_be_simulated_as_nfa);
+        EXPECT_EQ(re.search(subject).success, false);
+    }
+}
+
+TEST_CASE(exponential_backtracking_captures)
+{
+    Regex<ECMA262> re("(?:a|a)*c|(a)(b)");
+    auto result = re.search(String::formatted("{}b", String::repeated('a', 100)));
+    EXPECT_EQ(result.success, true);
+    if (result.success) {
+        EXPECT_EQ(result.matches.first().view, "ab"sv);
+        EXPECT_EQ(result.matches.first().column, 99ul);
+        EXPECT_EQ(result.capture_group_matches.first().size(), 2ul);
+        EXPECT_EQ(result.capture_group_matches.first()[0].view, "a"sv);
+        EXPECT_EQ(result.capture_group_matches.first()[1].view, "b"sv);
+    }
+}
+
+TEST_CASE(exponential_backtracking_search)
+{
+    // Once the NFA simulation takes over a search, it tries all the later start positions in the same pass.
+    Regex<ECMA262> re("(a|a)*b");
+    auto subject = String::formatted("{}!aab.{}b", String::repeated('a', 100), String::repeated('a', 50));
+    auto result = re.search(subject);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.count, 2u);
+    if (result.count == 2) {
+        EXPECT_EQ(result.matches[0].view, "aab"sv);
+        EXPECT_EQ(result.matches[0].column, 101ul);
+        EXPECT_EQ(result.matches[1].view.length(), 51u);
+        EXPECT_EQ(result.matches[1].column, 105ul);
+        EXPECT_EQ(result.capture_group_matches[0][0].view, "a"sv);
+        EXPECT_EQ(result.capture_group_matches[1][0].view, "a"sv);
+    }
+
+    // Trying every start position in turn would take quadratic time here, even though no single attempt backtracks much.
+    Regex<ECMA262> quadratic("(?:a|b)*c");
+    EXPECT_EQ(quadratic.search(String::repeated('a', 100'000)).success, false);
+}
+
+TEST_CASE(nfa_simulation_features)
+{
+    // Backreferences and lookarounds need backtracking.
+    EXPECT(!Regex<ECMA262>("(a)\\1").parser_result.can_be_simulated_as_nfa);
+    EXPECT(!Regex<ECMA262>("a(?=b)").parser_result.can_be_simulated_as_nfa);
+    EXPECT(!Regex<ECMA262>("a(?!b)").parser_result.can_be_simulated_as_nfa);
+    EXPECT(!Regex<ECMA262>("(?<=a)b").parser_result.can_be_simulated_as_nfa);
+
+    EXPECT(Regex<ECMA262>("^(a|b)*?c{2,3}\\b$").parser_result.can_be_simulated_as_nfa);
+    EXPECT(Regex<PosixExtended>("^[a-z]+(foo|bar)?$").parser_result.can_be_simulated_as_nfa);
+}
+
 static auto g_lots_of_a_s = String::repeated('a', 10'000'000);
 
 BENCHMARK_CASE(fork_performance)
@@ -197,6 +197,42 @@ TEST_CASE(doctype)
     EXPECT_END_TAG_TOKEN(html);
 }
 
+TEST_CASE(long_character_runs)
+{
+    // Long enough to be scanned in several chunks, with the special characters and multi-byte code points at awkward offsets.
+    auto tokens = run_tokenizer("<p>0123456789abcdefghijk&amp;lmnopqr\u00e9stuvwxyz0123456789\u2603ABCDEFGHIJKLMNOPQRSTUVWXYZ<b>x</b>0123456789abcdef</p>");
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p);
+    EXPECT_CHARACTER_TOKENS(0123456789abcdefghijk);
+    EXPECT_CHARACTER_TOKEN('&');
+    EXPECT_CHARACTER_TOKENS(lmnopqr);
+    EXPECT_CHARACTER_TOKEN(0xe9);
+    EXPECT_CHARACTER_TOKENS(stuvwxyz0123456789);
+    EXPECT_CHARACTER_TOKEN(0x2603);
+    EXPECT_CHARACTER_TOKENS(ABCDEFGHIJKLMNOPQRSTUVWXYZ);
+    EXPECT_START_TAG_TOKEN(b);
+    EXPECT_CHARACTER_TOKEN('x');
+    EXPECT_END_TAG_TOKEN(b);
+    EXPECT_CHARACTER_TOKENS(0123456789abcdef);
+    EXPECT_END_TAG_TOKEN(p);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(character_run_longer_than_the_run_limit)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 3000; ++i)
+        builder.append("\u00e9a");
+    auto tokens = run_tokenizer(builder.string_view());
+    EXPECT_EQ(tokens.size(), 6001u);
+    for (size_t i = 0; i < 6000; ++i) {
+        EXPECT_EQ(tokens[i].type(), Token::Type::Character);
+        EXPECT_EQ(tokens[i].code_point(), i % 2 ? (u32)'a' : 0xe9u);
+    }
+    EXPECT_EQ(tokens.last().type(), Token::Type::EndOfFile);
+}
+
 // NOTE: This relies on the format of HTMLToken::to_string() staying the same.
 //       If that changes, or something is added to the test HTML, the hash needs to be adjusted.
 TEST_CASE(regression)
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Hex.h>
+#include <AK/MappedFile.h>
+#include <AK/String.h>
+#include <AK/URL.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/DiskCache.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using RequestServer::DiskCache;
+
+// A directory for the cache to live in, which is deleted along with everything in it once the test is done.
+class TemporaryCacheDirectory {
+public:
+    TemporaryCacheDirectory()
+    {
+        char directory[] = "/tmp/TestDiskCache.XXXXXX";
+        VERIFY(mkdtemp(directory));
+        m_path = directory;
+    }
+
+    ~TemporaryCacheDirectory()
+    {
+        if (Core::File::remove(m_path, Core::File::RecursionMode::Allowed, false).is_error())
+            warnln("Failed to delete {}", m_path);
+    }
+
+    String const& path() const { return m_path; }
+    String file(StringView const& name) const { return String::formatted("{}/{}", m_path, name); }
+
+private:
+    String m_path;
+};
+
+static void write_file(String const& path, StringView const& contents)
+{
+    auto file = Core::File::open(path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate).release_value();
+    EXPECT(file->write(contents));
+}
+
+static String body_hash(StringView const& body)
+{
+    auto digest = Crypto::Hash::SHA256::hash((u8 const*)body.characters_without_null_termination(), body.length());
+    return encode_hex({ digest.immutable_data(), digest.data_length() });
+}
+
+// Maps the body the same way a client of RequestServer does.
+static String read_body(DiskCache::CachedResponse const& response)
+{
+    auto mapped_file = MappedFile::map_from_fd_and_close(dup(response.body_file.fd()), "body").release_value();
+    EXPECT_EQ(mapped_file->size(), response.body_size);
+    return String(mapped_file->bytes());
+}
+
+struct Header {
+    StringView name;
+    StringView value;
+};
+
+static HashMap<String, String, CaseInsensitiveStringTraits> make_headers(std::initializer_list<Header> list)
+{
+    HashMap<String, String, CaseInsensitiveStringTraits> headers;
+    for (auto& header : list)
+        headers.set(header.name, header.value);
+    return headers;
+}
+
+static HashMap<String, String, CaseInsensitiveStringTraits> cacheable_headers()
+{
+    return make_headers({ { "Cache-Control"sv, "max-age=3600"sv } });
+}
+
+TEST_CASE(store_same_body_twice)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    auto& cache = DiskCache::the();
+    cache.initialize(directory.path());
+    EXPECT(cache.is_enabled());
+
+    URL url("http://example.com/script.js");
+    auto body = "console.log('Well hello friends!');"sv;
+    cache.store(url, 200, cacheable_headers(), body.bytes());
+    cache.store(url, 200, cacheable_headers(), body.bytes());
+    EXPECT_EQ(cache.lookup(url), DiskCache::Lookup::Fresh);
+
+    auto response = cache.open(url);
+    EXPECT(response.has_value());
+    EXPECT_EQ(response->status_code, 200u);
+    EXPECT_EQ(read_body(*response), body);
+}
+
+TEST_CASE(bodies_are_handed_out_read_only)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    auto& cache = DiskCache::the();
+    cache.initialize(directory.path());
+
+    URL url("http://example.com/style.css");
+    auto body = "body { color: red; }"sv;
+    cache.store(url, 200, cacheable_headers(), body.bytes());
+
+    auto response = cache.open(url);
+    EXPECT(response.has_value());
+    EXPECT_EQ(fcntl(response->body_file.fd(), F_GETFL) & O_ACCMODE, O_RDONLY);
+    EXPECT_EQ(write(response->body_file.fd(), "x", 1), -1);
+
+    // Storing a new response must not change the body that was already handed out.
+    cache.store(url, 200, cacheable_headers(), "body { color: blue; }"sv.bytes());
+    EXPECT_EQ(read_body(*response), body);
+}
+
+TEST_CASE(freshness)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    auto& cache = DiskCache::the();
+    cache.initialize(directory.path());
+
+    auto body = "Hello friends!"sv;
+    auto store = [&](StringView const& path, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers) {
+        URL url(String::formatted("http://example.com/{}", path));
+        cache.store(url, 200, response_headers, body.bytes());
+        return cache.lookup(url);
+    };
+
+    EXPECT_EQ(store("max-age"sv, cacheable_headers()), DiskCache::Lookup::Fresh);
+    EXPECT_EQ(store("expires"sv, make_headers({ { "Date"sv, "Sun, 06 Nov 1994 08:49:37 GMT"sv }, { "Expires"sv, "Mon, 07 Nov 1994 08:49:37 GMT"sv } })), DiskCache::Lookup::Fresh);
+    EXPECT_EQ(store("age"sv, make_headers({ { "Cache-Control"sv, "max-age=60"sv }, { "Age"sv, "120"sv }, { "ETag"sv, "\"1\""sv } })), DiskCache::Lookup::Stale);
+    EXPECT_EQ(store("no-cache"sv, make_headers({ { "Cache-Control"sv, "no-cache, max-age=3600"sv }, { "ETag"sv, "\"1\""sv } })), DiskCache::Lookup::Stale);
+    EXPECT_EQ(store("last-modified"sv, make_headers({ { "Last-Modified"sv, "Sun, 06 Nov 1994 08:49:37 GMT"sv } })), DiskCache::Lookup::Fresh);
+
+    // These can never be reused, so they aren't kept at all.
+    EXPECT_EQ(store("no-store"sv, make_headers({ { "Cache-Control"sv, "no-store, max-age=3600"sv } })), DiskCache::Lookup::Miss);
+    EXPECT_EQ(store("expired"sv, make_headers({ { "Expires"sv, "Sun, 06 Nov 1994 08:49:37 GMT"sv } })), DiskCache::Lookup::Miss);
+    EXPECT_EQ(store("invalid-date"sv, make_headers({ { "Expires"sv, "tomorrow"sv } })), DiskCache::Lookup::Miss);
+
+    URL url("http://example.com/not-found");
+    cache.store(url, 404, cacheable_headers(), body.bytes());
+    EXPECT_EQ(cache.lookup(url), DiskCache::Lookup::Fresh);
+    cache.store(url, 500, cacheable_headers(), body.bytes());
+    EXPECT_EQ(cache.lookup(url), DiskCache::Lookup::Miss);
+}
+
+TEST_CASE(revalidation)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    auto& cache = DiskCache::the();
+    cache.initialize(directory.path());
+
+    URL url("http://example.com/image.png");
+    auto body = "Not really a PNG"sv;
+    auto response_headers = make_headers({ { "Cache-Control"sv, "max-age=0"sv }, { "ETag"sv, "\"abc\""sv }, { "Content-Length"sv, "16"sv } });
+    cache.store(url, 200, response_headers, body.bytes());
+    EXPECT_EQ(cache.lookup(url), DiskCache::Lookup::Stale);
+
+    HashMap<String, String> request_headers;
+    cache.add_revalidation_headers(url, request_headers);
+    EXPECT_EQ(request_headers.get("If-None-Match"), "\"abc\"");
+    EXPECT(!request_headers.contains("If-Modified-Since"));
+
+    auto stale_response = cache.open(url);
+    EXPECT(stale_response.has_value());
+
+    // The 304 describes an empty body, which must not end up in the headers of the stored one.
+    cache.did_revalidate(url, make_headers({ { "Cache-Control"sv, "max-age=3600"sv }, { "Content-Length"sv, "0"sv } }), *stale_response);
+    EXPECT_EQ(cache.lookup(url), DiskCache::Lookup::Fresh);
+    EXPECT_EQ(stale_response->response_headers.get("Cache-Control"), "max-age=3600");
+    EXPECT_EQ(stale_response->response_headers.get("Content-Length"), "16");
+    EXPECT_EQ(read_body(*stale_response), body);
+
+    auto response = cache.open(url);
+    EXPECT(response.has_value());
+    EXPECT_EQ(response->response_headers.get("Content-Length"), "16");
+    EXPECT_EQ(read_body(*response), body);
+}
+
+TEST_CASE(least_recently_used_entries_are_evicted)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    auto& cache = DiskCache::the();
+    // Room for four bodies of the largest size we cache.
+    cache.initialize(directory.path(), 4 * 32);
+    EXPECT_EQ(cache.max_entry_size(), 16u);
+
+    auto url = [](char name) { return URL(String::formatted("http://example.com/{}", name)); };
+    auto store = [&](char name, size_t size) {
+        auto body = String::repeated(name, size);
+        cache.store(url(name), 200, cacheable_headers(), body.bytes());
+    };
+
+    for (char name = 'a'; name < 'i'; ++name)
+        store(name, 16);
+    for (char name = 'a'; name < 'i'; ++name)
+        EXPECT_EQ(cache.lookup(url(name)), DiskCache::Lookup::Fresh);
+
+    // Touching an entry makes it the most recently used one.
+    EXPECT(cache.open(url('a')).has_value());
+    store('i', 16);
+    EXPECT_EQ(cache.lookup(url('a')), DiskCache::Lookup::Fresh);
+    EXPECT_EQ(cache.lookup(url('b')), DiskCache::Lookup::Miss);
+    EXPECT_EQ(cache.lookup(url('i')), DiskCache::Lookup::Fresh);
+
+    // It takes as many entries as needed to make room.
+    store('j', 16);
+    store('k', 16);
+    EXPECT_EQ(cache.lookup(url('c')), DiskCache::Lookup::Miss);
+    EXPECT_EQ(cache.lookup(url('d')), DiskCache::Lookup::Miss);
+    EXPECT_EQ(cache.lookup(url('e')), DiskCache::Lookup::Fresh);
+
+    // Anything larger than an eighth of the cache isn't kept.
+    store('l', 17);
+    EXPECT_EQ(cache.lookup(url('l')), DiskCache::Lookup::Miss);
+    EXPECT_EQ(cache.lookup(url('e')), DiskCache::Lookup::Fresh);
+}
+
+TEST_CASE(orphaned_bodies_are_collected)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    auto& cache = DiskCache::the();
+    cache.initialize(directory.path());
+
+    // Nothing has flushed the index yet, so re-opening the cache looks like it did after a crash.
+    auto body = "Hello friends!"sv;
+    cache.store(URL("http://example.com/"), 200, cacheable_headers(), body.bytes());
+    EXPECT(Core::File::exists(directory.file(body_hash(body))));
+    cache.initialize(directory.path());
+    EXPECT(!Core::File::exists(directory.file(body_hash(body))));
+
+    auto referenced_body = "I'm still wanted"sv;
+    auto orphaned_body = "Nobody wants me"sv;
+    write_file(directory.file(body_hash(referenced_body)), referenced_body);
+    write_file(directory.file(body_hash(orphaned_body)), orphaned_body);
+    write_file(directory.file(String::formatted("{}.tmp", body_hash(orphaned_body))), orphaned_body);
+    write_file(directory.file("README"sv), "Not a body"sv);
+    write_file(directory.file("index.json"sv),
+        String::formatted("{{\"version\":1,\"entries\":[{{\"url\":\"http://example.com/\",\"body_hash\":\"{}\",\"body_size\":{},\"status_code\":200,"
+                          "\"response_time\":0,\"age_at_response_time\":0,\"freshness_lifetime\":0,\"last_access_time\":0,\"response_headers\":{{\"ETag\":\"\\\"1\\\"\"}}}}]}}",
+            body_hash(referenced_body), referenced_body.length()));
+
+    cache.initialize(directory.path());
+    EXPECT_EQ(cache.lookup(URL("http://example.com/")), DiskCache::Lookup::Stale);
+    EXPECT(Core::File::exists(directory.file(body_hash(referenced_body))));
+    EXPECT(!Core::File::exists(directory.file(body_hash(orphaned_body))));
+    EXPECT(!Core::File::exists(directory.file(String::formatted("{}.tmp", body_hash(orphaned_body)))));
+    EXPECT(Core::File::exists(directory.file("README"sv)));
+    EXPECT(Core::File::exists(directory.file("index.json"sv)));
+}
+
+TEST_CASE(malformed_index_is_ignored)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    write_file(directory.file("index.json"sv), "{\"version\":1,\"entries\":[{\"url\":\"http://example.com/\",\"body_hash\":42}]}"sv);
+
+    auto& cache = DiskCache::the();
+    cache.initialize(directory.path());
+    EXPECT(cache.is_enabled());
+    EXPECT_EQ(cache.lookup(URL("http://example.com/")), DiskCache::Lookup::Miss);
+}
+
+TEST_CASE(body_hash_cannot_escape_cache_directory)
+{
+    Core::EventLoop loop;
+    TemporaryCacheDirectory directory;
+    // The file exists and has the right size, so only the body hash can give this entry away.
+    write_file(directory.file("secret"sv), "hunter2"sv);
+    mkdir(directory.file("cache"sv).characters(), 0700);
+    write_file(directory.file("cache/index.json"sv),
+        "{\"version\":1,\"entries\":[{\"url\":\"http://example.com/\",\"body_hash\":\"../secret\",\"body_size\":7,\"status_code\":200,"
+        "\"response_time\":0,\"age_at_response_time\":0,\"freshness_lifetime\":0,\"last_access_time\":0,\"response_headers\":{}}]}"sv);
+
+    auto& cache = DiskCache::the();
+    cache.initialize(directory.file("cache"sv));
+    EXPECT_EQ(cache.lookup(URL("http://example.com/")), DiskCache::Lookup::Miss);
+    EXPECT(!cache.open(URL("http://example.com/")).has_value());
+    EXPECT(Core::File::exists(directory.file("secret"sv)));
+}
@@ -95,6 +95,7 @@ Optional<FunctionAndArgumentIndex> get_function_and_argument_index(StringView so
 SheetGlobalObject::SheetGlobalObject(Sheet& sheet)
     : m_sheet(sheet)
 {
+    m_has_cacheable_property_lookups = false;
 }
 
 SheetGlobalObject::~SheetGlobalObject()
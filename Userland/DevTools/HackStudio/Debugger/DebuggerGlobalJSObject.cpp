@@ -15,6 +15,8 @@ namespace HackStudio {
 
 DebuggerGlobalJSObject::DebuggerGlobalJSObject()
 {
+    m_has_cacheable_property_lookups = false;
+
     auto regs = Debugger::the().session()->get_registers();
     auto lib = Debugger::the().session()->library_at(regs.ip());
     if (!lib)
@@ -23,6 +23,7 @@ DebuggerVariableJSObject::DebuggerVariableJSObject(const Debug::DebugInfo::Varia
     : JS::Object(prototype)
     , m_variable_info(variable_info)
 {
+    m_has_cacheable_property_lookups = false;
 }
 
 DebuggerVariableJSObject::~DebuggerVariableJSObject()
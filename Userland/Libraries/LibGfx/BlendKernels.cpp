@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Platform.h>
+#include <AK/SIMD.h>
+#include <LibGfx/BlendKernels.h>
+#include <string.h>
+
+#if ARCH(I386) || ARCH(X86_64)
+#    include <cpuid.h>
+#endif
+
+namespace Gfx {
+
+using AK::SIMD::u32x4;
+using AK::SIMD::u32x8;
+
+AlphaTable alpha_table_for_opacity(float opacity, bool use_source_alpha)
+{
+    // NOTE: This matches the float math the scalar blitters used to do for every pixel.
+    AlphaTable table;
+    for (size_t alpha = 0; alpha < table.size(); ++alpha) {
+        if (use_source_alpha) {
+            float pixel_opacity = alpha / 255.0;
+            table[alpha] = 255 * (opacity * pixel_opacity);
+        } else {
+            table[alpha] = opacity * 255;
+        }
+    }
+    return table;
+}
+
+bool cpu_supports_avx2()
+{
+#if ARCH(I386) || ARCH(X86_64)
+    static bool const s_supports_avx2 = [] {
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return false;
+        // The kernel has to save the YMM registers across context switches for us to use them.
+        if (!(ecx & bit_OSXSAVE))
+            return false;
+        u32 xcr0_low, xcr0_high;
+        asm volatile("xgetbv"
+                     : "=a"(xcr0_low), "=d"(xcr0_high)
+                     : "c"(0));
+        if ((xcr0_low & 0b110) != 0b110)
+            return false;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (ebx & bit_AVX2) != 0;
+    }();
+    return s_supports_avx2;
+#else
+    return false;
+#endif
+}
+
+ALWAYS_INLINE static void blend_pixel(RGBA32& dst, RGBA32 src, u8 alpha, DestinationAlpha destination_alpha)
+{
+    Color dest_color = destination_alpha == DestinationAlpha::Respect ? Color::from_rgba(dst) : Color::from_rgb(dst);
+    Color src_color = Color::from_rgb(src);
+    src_color.set_alpha(alpha);
+    dst = dest_color.blend(src_color).value();
+}
+
+// Blending onto an opaque pixel is (dst * (255 - alpha) + src * alpha) / 255 for each channel, and keeps the pixel opaque.
+// This handles red and blue together in one lane, and green separately, dividing by 255 exactly with shifts.
+// NOTE: Vectors are passed by reference, as passing 256-bit vectors by value outside of AVX code changes the ABI.
+template<typename V>
+ALWAYS_INLINE static void blend_onto_opaque(V& dst, V const& src, V const& alpha)
+{
+    V inverse_alpha = 255 - alpha;
+    V red_blue = (dst & 0x00ff00ff) * inverse_alpha + (src & 0x00ff00ff) * alpha;
+    V green = ((dst >> 8) & 0xff) * inverse_alpha + ((src >> 8) & 0xff) * alpha;
+    red_blue = ((red_blue + 0x00010001 + ((red_blue >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    green = ((green + 1 + (green >> 8)) >> 8) & 0xff;
+    dst = red_blue | (green << 8) | 0xff000000;
+}
+
+template<typename V>
+ALWAYS_INLINE static bool all_lanes_opaque(V const& pixels)
+{
+    constexpr size_t lane_count = sizeof(V) / sizeof(u32);
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+        if ((pixels[lane] >> 24) != 0xff)
+            return false;
+    }
+    return true;
+}
+
+// Returns how many pixels were blended; the caller takes care of the rest.
+template<typename V>
+ALWAYS_INLINE static size_t blend_span_impl(RGBA32* dst, RGBA32 const* src, size_t count, AlphaTable const& alpha_table, DestinationAlpha destination_alpha)
+{
+    constexpr size_t lane_count = sizeof(V) / sizeof(u32);
+    size_t i = 0;
+    for (; i + lane_count <= count; i += lane_count) {
+        V dst_pixels;
+        V src_pixels;
+        memcpy(&dst_pixels, dst + i, sizeof(V));
+        memcpy(&src_pixels, src + i, sizeof(V));
+
+        if (destination_alpha == DestinationAlpha::Respect && !all_lanes_opaque(dst_pixels)) {
+            for (size_t lane = 0; lane < lane_count; ++lane)
+                blend_pixel(dst[i + lane], src[i + lane], alpha_table[src[i + lane] >> 24], destination_alpha);
+            continue;
+        }
+
+        V alpha;
+        for (size_t lane = 0; lane < lane_count; ++lane)
+            alpha[lane] = alpha_table[src_pixels[lane] >> 24];
+
+        blend_onto_opaque(dst_pixels, src_pixels, alpha);
+        memcpy(dst + i, &dst_pixels, sizeof(V));
+    }
+    return i;
+}
+
+template<typename V>
+ALWAYS_INLINE static size_t blend_color_span_impl(RGBA32* dst, size_t count, Color color)
+{
+    constexpr size_t lane_count = sizeof(V) / sizeof(u32);
+    V src_pixels = V {} + color.value();
+    V alpha = V {} + color.alpha();
+    size_t i = 0;
+    for (; i + lane_count <= count; i += lane_count) {
+        V dst_pixels;
+        memcpy(&dst_pixels, dst + i, sizeof(V));
+
+        if (!all_lanes_opaque(dst_pixels)) {
+            for (size_t lane = 0; lane < lane_count; ++lane)
+                dst[i + lane] = Color::from_rgba(dst[i + lane]).blend(color).value();
+            continue;
+        }
+
+        blend_onto_opaque(dst_pixels, src_pixels, alpha);
+        memcpy(dst + i, &dst_pixels, sizeof(V));
+    }
+    return i;
+}
+
+#if ARCH(I386) || ARCH(X86_64)
+[[gnu::target("avx2")]] static size_t blend_span_avx2(RGBA32* dst, RGBA32 const* src, size_t count, AlphaTable const& alpha_table, DestinationAlpha destination_alpha)
+{
+    return blend_span_impl<u32x8>(dst, src, count, alpha_table, destination_alpha);
+}
+
+[[gnu::target("avx2")]] static size_t blend_color_span_avx2(RGBA32* dst, size_t count, Color color)
+{
+    return blend_color_span_impl<u32x8>(dst, count, color);
+}
+#endif
+
+void blend_span(RGBA32* dst, RGBA32 const* src, size_t count, AlphaTable const& alpha_table, DestinationAlpha destination_alpha)
+{
+    size_t i;
+#if ARCH(I386) || ARCH(X86_64)
+    if (cpu_supports_avx2())
+        i = blend_span_avx2(dst, src, count, alpha_table, destination_alpha);
+    else
+#endif
+        i = blend_span_impl<u32x4>(dst, src, count, alpha_table, destination_alpha);
+
+    for (; i < count; ++i)
+        blend_pixel(dst[i], src[i], alpha_table[src[i] >> 24], destination_alpha);
+}
+
+void blend_color_span(RGBA32* dst, size_t count, Color color)
+{
+    size_t i;
+#if ARCH(I386) || ARCH(X86_64)
+    if (cpu_supports_avx2())
+        i = blend_color_span_avx2(dst, count, color);
+    else
+#endif
+        i = blend_color_span_impl<u32x4>(dst, count, color);
+
+    for (; i < count; ++i)
+        dst[i] = Color::from_rgba(dst[i]).blend(color).value();
+}
+
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Types.h>
+#include <LibGfx/Color.h>
+
+namespace Gfx {
+
+// Vectorized versions of the per-pixel loops around Color::blend().
+// They produce exactly the same pixels as the scalar loops they replace.
+
+enum class DestinationAlpha {
+    Ignore,
+    Respect,
+};
+
+// Maps the alpha channel of a source pixel to the alpha it is blended with.
+using AlphaTable = Array<u8, 256>;
+AlphaTable alpha_table_for_opacity(float opacity, bool use_source_alpha);
+
+// For every pixel: dst = dst.blend(src with its alpha replaced by alpha_table[src alpha]).
+// With DestinationAlpha::Ignore, every destination pixel is treated as opaque.
+void blend_span(RGBA32* dst, RGBA32 const* src, size_t count, AlphaTable const&, DestinationAlpha);
+
+// For every pixel: dst = dst.blend(color), respecting the destination alpha.
+void blend_color_span(RGBA32* dst, size_t count, Color);
+
+bool cpu_supports_avx2();
+
+}
@@ -9,6 +9,7 @@
 
 #include "Painter.h"
 #include "Bitmap.h"
+#include "BlendKernels.h"
 #include "Emoji.h"
 #include "Font.h"
 #include "FontDatabase.h"
@@ -117,8 +118,7 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     size_t const dst_skip = m_target->pitch() / sizeof(RGBA32);
 
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
-            dst[j] = Color::from_rgba(dst[j]).blend(color).value();
+        blend_color_span(dst, physical_rect.width(), color);
         dst += dst_skip;
     }
 }
@@ -245,17 +245,20 @@ void Painter::fill_rect_with_gradient(Orientation orientation, IntRect const& a_
     float alpha_increment = increment * ((float)gradient_end.alpha() - (float)gradient_start.alpha());
 
     if (orientation == Orientation::Horizontal) {
-        for (int i = clipped_rect.height() - 1; i >= 0; --i) {
-            float c = offset * increment;
-            float c_alpha = gradient_start.alpha() + offset * alpha_increment;
-            for (int j = 0; j < clipped_rect.width(); ++j) {
-                auto color = gamma_accurate_blend(gradient_start, gradient_end, c);
-                color.set_alpha(c_alpha);
-                dst[j] = color.value();
-                c_alpha += alpha_increment;
-                c += increment;
-            }
+        // Every row of a horizontal gradient is the same, so compute the first one and copy it.
+        RGBA32* first_row = dst;
+        float c = offset * increment;
+        float c_alpha = gradient_start.alpha() + offset * alpha_increment;
+        for (int j = 0; j < clipped_rect.width(); ++j) {
+            auto color = gamma_accurate_blend(gradient_start, gradient_end, c);
+            color.set_alpha(c_alpha);
+            dst[j] = color.value();
+            c_alpha += alpha_increment;
+            c += increment;
+        }
+        for (int i = clipped_rect.height() - 2; i >= 0; --i) {
             dst += dst_skip;
+            fast_u32_copy(dst, first_row, clipped_rect.width());
         }
     } else {
         float c = offset * increment;
@@ -772,20 +775,10 @@ struct BlitState {
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    auto alpha_table = alpha_table_for_opacity(state.opacity, has_alpha & BlitState::SrcAlpha);
+    auto destination_alpha = (has_alpha & BlitState::DstAlpha) ? DestinationAlpha::Respect : DestinationAlpha::Ignore;
     for (int row = 0; row < state.row_count; ++row) {
-        for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_rgba(state.dst[x]) : Color::from_rgb(state.dst[x]);
-            if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_rgba(state.src[x]);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            }
-        }
+        blend_span(state.dst, state.src, state.column_count, alpha_table, destination_alpha);
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
     }
@@ -1053,27 +1046,42 @@ void Painter::blit(IntPoint const& position, Gfx::Bitmap const& source, IntRect
     VERIFY_NOT_REACHED();
 }
 
+static AlphaTable alpha_table_for_scaled_bitmap(float opacity)
+{
+    // NOTE: This matches what the scalar loops used to do: scale the source alpha by the opacity and truncate it.
+    AlphaTable table;
+    for (size_t alpha = 0; alpha < table.size(); ++alpha)
+        table[alpha] = opacity != 1.0f ? alpha * opacity : alpha;
+    return table;
+}
+
+// Sampling the source is a gather that we do pixel by pixel, so the scaled bitmaps are drawn one row at a time:
+// the row is sampled into a buffer, which is then blended into (or copied to) the destination as a whole span.
+template<bool has_alpha_channel>
+ALWAYS_INLINE static void draw_scaled_row(RGBA32* dst, Vector<RGBA32> const& row, AlphaTable const& alpha_table)
+{
+    if constexpr (has_alpha_channel)
+        blend_span(dst, row.data(), row.size(), alpha_table, DestinationAlpha::Respect);
+    else
+        fast_u32_copy(dst, row.data(), row.size());
+}
+
 template<bool has_alpha_channel, typename GetPixel>
 ALWAYS_INLINE static void do_draw_integer_scaled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& src_rect, Gfx::Bitmap const& source, int hfactor, int vfactor, GetPixel get_pixel, float opacity)
 {
-    bool has_opacity = opacity != 1.0f;
+    auto alpha_table = alpha_table_for_scaled_bitmap(opacity);
+    Vector<RGBA32> row;
+    row.resize(dst_rect.width());
     for (int y = 0; y < src_rect.height(); ++y) {
-        int dst_y = dst_rect.y() + y * vfactor;
+        auto* row_pixel = row.data();
         for (int x = 0; x < src_rect.width(); ++x) {
-            auto src_pixel = get_pixel(source, x + src_rect.left(), y + src_rect.top());
-            if (has_opacity)
-                src_pixel.set_alpha(src_pixel.alpha() * opacity);
-            for (int yo = 0; yo < vfactor; ++yo) {
-                auto* scanline = (Color*)target.scanline(dst_y + yo);
-                int dst_x = dst_rect.x() + x * hfactor;
-                for (int xo = 0; xo < hfactor; ++xo) {
-                    if constexpr (has_alpha_channel)
-                        scanline[dst_x + xo] = scanline[dst_x + xo].blend(src_pixel);
-                    else
-                        scanline[dst_x + xo] = src_pixel;
-                }
-            }
+            auto src_pixel = get_pixel(source, x + src_rect.left(), y + src_rect.top()).value();
+            for (int xo = 0; xo < hfactor; ++xo)
+                *row_pixel++ = src_pixel;
         }
+        int dst_y = dst_rect.y() + y * vfactor;
+        for (int yo = 0; yo < vfactor; ++yo)
+            draw_scaled_row<has_alpha_channel>(target.scanline(dst_y + yo) + dst_rect.x(), row, alpha_table);
     }
 }
 
@@ -1095,7 +1103,11 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
         }
     }
 
-    bool has_opacity = opacity != 1.0f;
+    auto alpha_table = alpha_table_for_scaled_bitmap(opacity);
+    Vector<RGBA32> row;
+    row.resize(clipped_rect.width());
+    Optional<i64> sampled_y;
+
     i64 shift = (i64)1 << 32;
     i64 fractional_mask = (shift - (u64)1);
     i64 half_pixel = (i64)1 << 31;
@@ -1105,36 +1117,35 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
     i64 src_top = src_rect.top() * shift;
 
     for (int y = clipped_rect.top(); y <= clipped_rect.bottom(); ++y) {
-        auto* scanline = (Color*)target.scanline(y);
-        for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
-            auto desired_x = ((x - dst_rect.x()) * hscale + src_left);
-            auto desired_y = ((y - dst_rect.y()) * vscale + src_top);
+        auto desired_y = ((y - dst_rect.y()) * vscale + src_top);
 
-            Color src_pixel;
-            if constexpr (do_bilinear_blend) {
+        if constexpr (do_bilinear_blend) {
+            auto scaled_y0 = clamp((desired_y - half_pixel) >> 32, 0, src_rect.height() - 1);
+            auto scaled_y1 = clamp((desired_y + half_pixel) >> 32, 0, src_rect.height() - 1);
+            float y_ratio = (((desired_y + half_pixel) & fractional_mask) / (float)shift);
+
+            for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
+                auto desired_x = ((x - dst_rect.x()) * hscale + src_left);
                 auto scaled_x0 = clamp((desired_x - half_pixel) >> 32, 0, src_rect.width() - 1);
                 auto scaled_x1 = clamp((desired_x + half_pixel) >> 32, 0, src_rect.width() - 1);
-                auto scaled_y0 = clamp((desired_y - half_pixel) >> 32, 0, src_rect.height() - 1);
-                auto scaled_y1 = clamp((desired_y + half_pixel) >> 32, 0, src_rect.height() - 1);
-
                 float x_ratio = (((desired_x + half_pixel) & fractional_mask) / (float)shift);
-                float y_ratio = (((desired_y + half_pixel) & fractional_mask) / (float)shift);
 
-                src_pixel = get_pixel(source, scaled_x0, scaled_y0).interpolate(get_pixel(source, scaled_x1, scaled_y0), x_ratio).interpolate(get_pixel(source, scaled_x0, scaled_y1).interpolate(get_pixel(source, scaled_x1, scaled_y1), x_ratio), y_ratio);
-            } else {
-                auto scaled_x = desired_x >> 32;
-                auto scaled_y = desired_y >> 32;
-                src_pixel = get_pixel(source, scaled_x, scaled_y);
+                auto src_pixel = get_pixel(source, scaled_x0, scaled_y0).interpolate(get_pixel(source, scaled_x1, scaled_y0), x_ratio).interpolate(get_pixel(source, scaled_x0, scaled_y1).interpolate(get_pixel(source, scaled_x1, scaled_y1), x_ratio), y_ratio);
+                row[x - clipped_rect.left()] = src_pixel.value();
             }
-
-            if (has_opacity)
-                src_pixel.set_alpha(src_pixel.alpha() * opacity);
-            if constexpr (has_alpha_channel) {
-                scanline[x] = scanline[x].blend(src_pixel);
-            } else {
-                scanline[x] = src_pixel;
+        } else {
+            // Upscaled rows often sample the same source row as the one before them, which is still in the buffer.
+            auto scaled_y = desired_y >> 32;
+            if (sampled_y != scaled_y) {
+                for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
+                    auto desired_x = ((x - dst_rect.x()) * hscale + src_left);
+                    row[x - clipped_rect.left()] = get_pixel(source, desired_x >> 32, scaled_y).value();
+                }
+                sampled_y = scaled_y;
             }
         }
+
+        draw_scaled_row<has_alpha_channel>(target.scanline(y) + clipped_rect.left(), row, alpha_table);
     }
 }
 
@@ -1220,12 +1231,54 @@ FLATTEN void Painter::draw_glyph(IntPoint const& point, u32 code_point, Font con
     if (glyph.is_glyph_bitmap()) {
         draw_bitmap(top_left, glyph.glyph_bitmap(), color);
     } else {
-        blit_filtered(top_left, *glyph.bitmap(), glyph.bitmap()->rect(), [color](Color pixel) -> Color {
+        blit_filtered(top_left, *glyph.bitmap(), glyph.bitmap_rect(), [color](Color pixel) -> Color {
             return pixel.multiply(color);
         });
     }
 }
 
+void Painter::draw_glyph_run(Gfx::Bitmap const& source, Span<GlyphRunEntry const> glyphs, Color color)
+{
+    if (scale() != 1 || source.scale() != 1) {
+        for (auto& glyph : glyphs) {
+            blit_filtered(glyph.position, source, glyph.source_rect, [color](Color pixel) -> Color {
+                return pixel.multiply(color);
+            });
+        }
+        return;
+    }
+
+    auto clip_rect = this->clip_rect();
+    auto translation = this->translation();
+    size_t const dst_skip = m_target->pitch() / sizeof(RGBA32);
+    size_t const src_skip = source.pitch() / sizeof(RGBA32);
+    bool const color_is_opaque = color.alpha() == 0xff;
+
+    for (auto& glyph : glyphs) {
+        auto safe_src_rect = glyph.source_rect.intersected(source.rect());
+        auto dst_rect = IntRect(glyph.position.translated(translation), safe_src_rect.size());
+        auto clipped_rect = dst_rect.intersected(clip_rect);
+        if (clipped_rect.is_empty())
+            continue;
+
+        RGBA32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
+        RGBA32 const* src = source.scanline(safe_src_rect.y() + clipped_rect.y() - dst_rect.y()) + safe_src_rect.x() + clipped_rect.x() - dst_rect.x();
+        for (int row = 0; row < clipped_rect.height(); ++row) {
+            for (int x = 0; x < clipped_rect.width(); ++x) {
+                auto coverage = Color::from_rgba(src[x]);
+                if (!coverage.alpha())
+                    continue;
+                if (coverage.alpha() == 0xff && color_is_opaque)
+                    dst[x] = color.value();
+                else
+                    dst[x] = Color::from_rgba(dst[x]).blend(coverage.multiply(color)).value();
+            }
+            dst += dst_skip;
+            src += src_skip;
+        }
+    }
+}
+
 void Painter::draw_emoji(IntPoint const& point, Gfx::Bitmap const& emoji, Font const& font)
 {
     if (!font.is_fixed_width())
@@ -1558,12 +1611,43 @@ void Painter::draw_text(IntRect const& rect, Utf32View const& text, TextAlignmen
     draw_text(rect, text, font(), alignment, color, elision, wrapping);
 }
 
-void Painter::draw_text(IntRect const& rect, StringView const& raw_text, Font const& font, TextAlignment alignment, Color color, TextElision elision, TextWrapping wrapping)
+void Painter::draw_text_in_glyph_runs(IntRect const& rect, Utf8View const& text, Font const& font, TextAlignment alignment, Color color, TextElision elision, TextWrapping wrapping)
 {
-    Utf8View text { raw_text };
+    // Consecutive glyphs that live in the same bitmap (i.e. the TrueType glyph atlas) are collected
+    // and drawn in one go, instead of setting up a separate blit for every single glyph.
+    RefPtr<Bitmap> run_source;
+    Vector<GlyphRunEntry, 64> run;
+    auto flush_run = [&] {
+        if (!run.is_empty())
+            draw_glyph_run(*run_source, run, color);
+        run.clear_with_capacity();
+    };
+
     do_draw_text(rect, text, font, alignment, elision, wrapping, [&](IntRect const& r, u32 code_point) {
-        draw_glyph_or_emoji(r.location(), code_point, font, color);
+        if (!font.contains_glyph(code_point)) {
+            flush_run();
+            draw_glyph_or_emoji(r.location(), code_point, font, color);
+            return;
+        }
+        auto glyph = font.glyph(code_point);
+        auto top_left = r.location() + IntPoint(glyph.left_bearing(), 0);
+        if (glyph.is_glyph_bitmap()) {
+            draw_bitmap(top_left, glyph.glyph_bitmap(), color);
+            return;
+        }
+        if (glyph.bitmap() != run_source) {
+            flush_run();
+            run_source = glyph.bitmap();
+        }
+        run.append({ top_left, glyph.bitmap_rect() });
     });
+    flush_run();
+}
+
+void Painter::draw_text(IntRect const& rect, StringView const& raw_text, Font const& font, TextAlignment alignment, Color color, TextElision elision, TextWrapping wrapping)
+{
+    Utf8View text { raw_text };
+    draw_text_in_glyph_runs(rect, text, font, alignment, color, elision, wrapping);
 }
 
 void Painter::draw_text(IntRect const& rect, Utf32View const& raw_text, Font const& font, TextAlignment alignment, Color color, TextElision elision, TextWrapping wrapping)
@@ -1573,9 +1657,7 @@ void Painter::draw_text(IntRect const& rect, Utf32View const& raw_text, Font con
     StringBuilder builder;
     builder.append(raw_text);
     auto text = Utf8View { builder.string_view() };
-    do_draw_text(rect, text, font, alignment, elision, wrapping, [&](IntRect const& r, u32 code_point) {
-        draw_glyph_or_emoji(r.location(), code_point, font, color);
-    });
+    draw_text_in_glyph_runs(rect, text, font, alignment, color, elision, wrapping);
 }
 
 void Painter::draw_text(Function<void(IntRect const&, u32)> draw_one_glyph, IntRect const& rect, Utf8View const& text, Font const& font, TextAlignment alignment, TextElision elision, TextWrapping wrapping)
@@ -135,9 +135,9 @@ public:
     }
 
     IntRect clip_rect() const { return state().clip_rect; }
+    IntPoint translation() const { return state().translation; }
 
 protected:
-    IntPoint translation() const { return state().translation; }
     IntRect to_physical(IntRect const& r) const { return r.translated(translation()) * scale(); }
     IntPoint to_physical(IntPoint const& p) const { return p.translated(translation()) * scale(); }
     int scale() const { return state().scale; }
@@ -165,6 +165,13 @@ protected:
     Vector<State, 4> m_state_stack;
 
 private:
+    struct GlyphRunEntry {
+        IntPoint position;
+        IntRect source_rect;
+    };
+    void draw_glyph_run(Gfx::Bitmap const& source, Span<GlyphRunEntry const>, Color);
+    void draw_text_in_glyph_runs(IntRect const&, Utf8View const& text, Font const&, TextAlignment, Color, TextElision, TextWrapping);
+
     Vector<DirectionalRun> split_text_into_directional_runs(Utf8View const&, TextDirection initial_direction);
     bool text_contains_bidirectional_text(Utf8View const&, TextDirection);
     template<typename DrawGlyphFunction>
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Checked.h>
 #include <AK/MappedFile.h>
 #include <AK/Utf32View.h>
@@ -13,6 +14,7 @@
 #include <LibGfx/TrueTypeFont/Cmap.h>
 #include <LibGfx/TrueTypeFont/Font.h>
 #include <LibGfx/TrueTypeFont/Glyf.h>
+#include <LibGfx/TrueTypeFont/GlyphAtlas.h>
 #include <LibGfx/TrueTypeFont/Tables.h>
 #include <LibTextCodec/Decoder.h>
 #include <math.h>
@@ -483,8 +485,23 @@ bool Font::is_fixed_width() const
     return glyph_metrics(glyph_id_for_code_point('.'), 1, 1).advance_width == glyph_metrics(glyph_id_for_code_point('X'), 1, 1).advance_width;
 }
 
-int ScaledFont::width(StringView const& view) const { return unicode_view_width(Utf8View(view)); }
-int ScaledFont::width(Utf8View const& view) const { return unicode_view_width(view); }
+u64 ScaledFont::next_atlas_id()
+{
+    static Atomic<u64> s_next_atlas_id { 1 };
+    return s_next_atlas_id++;
+}
+
+ScaledGlyphMetrics ScaledFont::glyph_metrics(u32 glyph_id) const
+{
+    if (auto it = m_cached_glyph_metrics.find(glyph_id); it != m_cached_glyph_metrics.end())
+        return it->value;
+    auto metrics = m_font->glyph_metrics(glyph_id, m_x_scale, m_y_scale);
+    m_cached_glyph_metrics.set(glyph_id, metrics);
+    return metrics;
+}
+
+int ScaledFont::width(StringView const& view) const { return cached_text_width(view); }
+int ScaledFont::width(Utf8View const& view) const { return cached_text_width(view.as_string()); }
 int ScaledFont::width(Utf32View const& view) const { return unicode_view_width(view); }
 
 template<typename T>
@@ -508,6 +525,20 @@ ALWAYS_INLINE int ScaledFont::unicode_view_width(T const& view) const
     return longest_width;
 }
 
+int ScaledFont::cached_text_width(StringView const& view) const
+{
+    if (view.is_empty())
+        return 0;
+    auto it = m_cached_text_widths.find(view.hash(), [&](auto& entry) { return entry.key == view; });
+    if (it != m_cached_text_widths.end())
+        return it->value;
+    auto width = unicode_view_width(Utf8View(view));
+    if (m_cached_text_widths.size() >= text_width_cache_size)
+        m_cached_text_widths.clear();
+    m_cached_text_widths.set(view, width);
+    return width;
+}
+
 RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id) const
 {
     auto glyph_iterator = m_cached_glyph_bitmaps.find(glyph_id);
@@ -522,8 +553,21 @@ RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id) const
 Gfx::Glyph ScaledFont::glyph(u32 code_point) const
 {
     auto id = glyph_id_for_code_point(code_point);
-    auto bitmap = rasterize_glyph(id);
     auto metrics = glyph_metrics(id);
+
+    // Glyphs that didn't make it into the atlas (because they are empty or too large) are kept here, so we don't rasterize them on every draw.
+    if (auto it = m_cached_glyph_bitmaps.find(id); it != m_cached_glyph_bitmaps.end())
+        return Gfx::Glyph(it->value, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+
+    RefPtr<Gfx::Bitmap> bitmap;
+    auto atlas_entry = GlyphAtlas::the().ensure({ m_atlas_id, id }, [&] {
+        bitmap = m_font->rasterize_glyph(id, m_x_scale, m_y_scale);
+        return bitmap;
+    });
+    if (atlas_entry.has_value())
+        return Gfx::Glyph(atlas_entry->bitmap, atlas_entry->rect, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+
+    m_cached_glyph_bitmaps.set(id, bitmap);
     return Gfx::Glyph(bitmap, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
 }
 
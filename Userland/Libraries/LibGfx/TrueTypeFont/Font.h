@@ -113,12 +113,16 @@ public:
         float units_per_em = m_font->units_per_em();
         m_x_scale = (point_width * dpi_x) / (POINTS_PER_INCH * units_per_em);
         m_y_scale = (point_height * dpi_y) / (POINTS_PER_INCH * units_per_em);
+        m_atlas_id = next_atlas_id();
     }
     u32 glyph_id_for_code_point(u32 code_point) const { return m_font->glyph_id_for_code_point(code_point); }
     ScaledFontMetrics metrics() const { return m_font->metrics(m_x_scale, m_y_scale); }
-    ScaledGlyphMetrics glyph_metrics(u32 glyph_id) const { return m_font->glyph_metrics(glyph_id, m_x_scale, m_y_scale); }
+    ScaledGlyphMetrics glyph_metrics(u32 glyph_id) const;
     RefPtr<Gfx::Bitmap> rasterize_glyph(u32 glyph_id) const;
 
+    // Identifies this font in the GlyphAtlas. Unlike the address of the font, this is never reused.
+    u64 atlas_id() const { return m_atlas_id; }
+
     // Gfx::Font implementation
     virtual NonnullRefPtr<Font> clone() const override { return *this; } // FIXME: clone() should not need to be implemented
     virtual u8 presentation_size() const override { return m_point_height; }
@@ -151,8 +155,18 @@ private:
     float m_y_scale { 0.0f };
     float m_point_width { 0.0f };
     float m_point_height { 0.0f };
+    u64 m_atlas_id { 0 };
     mutable HashMap<u32, RefPtr<Gfx::Bitmap>> m_cached_glyph_bitmaps;
+    mutable HashMap<u32, ScaledGlyphMetrics> m_cached_glyph_metrics;
+
+    // The same strings tend to be measured over and over again while laying out and painting,
+    // so we remember their widths. Once full, the cache simply starts over.
+    static constexpr size_t text_width_cache_size = 1024;
+    mutable HashMap<String, int> m_cached_text_widths;
+
+    static u64 next_atlas_id();
 
+    int cached_text_width(StringView const&) const;
     template<typename T>
     int unicode_view_width(T const& view) const;
 };
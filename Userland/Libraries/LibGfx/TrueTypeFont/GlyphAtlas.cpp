@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Memory.h>
+#include <AK/OwnPtr.h>
+#include <LibGfx/TrueTypeFont/GlyphAtlas.h>
+
+namespace TTF {
+
+// NOTE: Entries hold on to the atlas bitmap, and reference counts aren't atomic, so an atlas must never be shared between threads.
+//       The atlas of a thread is destroyed when the thread exits.
+static thread_local OwnPtr<GlyphAtlas> s_the;
+
+GlyphAtlas& GlyphAtlas::the()
+{
+    if (!s_the)
+        s_the = make<GlyphAtlas>();
+    return *s_the;
+}
+
+GlyphAtlas::GlyphAtlas(int size)
+    : m_size(size)
+{
+}
+
+Optional<GlyphAtlas::Entry> GlyphAtlas::ensure(GlyphAtlasKey const& key, Function<RefPtr<Gfx::Bitmap>()> rasterize_glyph)
+{
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        m_shelves[it->value.shelf_index].last_used = ++m_clock;
+        return Entry { *m_bitmap, it->value.rect };
+    }
+
+    auto glyph_bitmap = rasterize_glyph();
+    if (!glyph_bitmap || glyph_bitmap->format() != Gfx::BitmapFormat::BGRA8888 || glyph_bitmap->scale() != 1)
+        return {};
+
+    if (!m_bitmap) {
+        m_bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { m_size, m_size });
+        if (!m_bitmap)
+            return {};
+    }
+
+    auto slot = allocate(glyph_bitmap->size());
+    if (!slot.has_value())
+        return {};
+
+    for (int y = 0; y < slot->rect.height(); ++y)
+        fast_u32_copy(m_bitmap->scanline(slot->rect.y() + y) + slot->rect.x(), glyph_bitmap->scanline(y), slot->rect.width());
+
+    auto& shelf = m_shelves[slot->shelf_index];
+    shelf.keys.append(key);
+    shelf.last_used = ++m_clock;
+    m_entries.set(key, *slot);
+    return Entry { *m_bitmap, slot->rect };
+}
+
+Optional<GlyphAtlas::Slot> GlyphAtlas::allocate(Gfx::IntSize const& size)
+{
+    if (size.is_empty() || size.width() > m_size || size.height() > m_size)
+        return {};
+
+    auto take_from_shelf = [&](size_t shelf_index) {
+        auto& shelf = m_shelves[shelf_index];
+        Slot slot { { shelf.next_x, shelf.y, size.width(), size.height() }, shelf_index };
+        shelf.next_x += size.width();
+        return slot;
+    };
+
+    // Prefer the tightest shelf that still has room, but don't waste more than half a glyph's height.
+    Optional<size_t> best_shelf;
+    for (size_t i = 0; i < m_shelves.size(); ++i) {
+        auto& shelf = m_shelves[i];
+        if (shelf.height < size.height() || shelf.height > size.height() + size.height() / 2 || shelf.next_x + size.width() > m_size)
+            continue;
+        if (!best_shelf.has_value() || shelf.height < m_shelves[*best_shelf].height)
+            best_shelf = i;
+    }
+    if (best_shelf.has_value())
+        return take_from_shelf(*best_shelf);
+
+    if (m_next_shelf_y + size.height() <= m_size) {
+        m_shelves.append({ m_next_shelf_y, size.height(), 0, 0, {} });
+        m_next_shelf_y += size.height();
+        return take_from_shelf(m_shelves.size() - 1);
+    }
+
+    Optional<size_t> least_recently_used_shelf;
+    for (size_t i = 0; i < m_shelves.size(); ++i) {
+        auto& shelf = m_shelves[i];
+        if (shelf.height < size.height())
+            continue;
+        if (!least_recently_used_shelf.has_value() || shelf.last_used < m_shelves[*least_recently_used_shelf].last_used)
+            least_recently_used_shelf = i;
+    }
+
+    if (!ensure_bitmap_is_writable())
+        return {};
+
+    if (least_recently_used_shelf.has_value()) {
+        evict_shelf(*least_recently_used_shelf);
+        return take_from_shelf(*least_recently_used_shelf);
+    }
+
+    // None of the shelves is tall enough, so start over with an empty atlas.
+    for (size_t i = 0; i < m_shelves.size(); ++i)
+        evict_shelf(i);
+    m_shelves.clear();
+    m_shelves.append({ 0, size.height(), 0, 0, {} });
+    m_next_shelf_y = size.height();
+    return take_from_shelf(0);
+}
+
+void GlyphAtlas::evict_shelf(size_t shelf_index)
+{
+    auto& shelf = m_shelves[shelf_index];
+    for (auto& key : shelf.keys)
+        m_entries.remove(key);
+    shelf.keys.clear_with_capacity();
+    shelf.next_x = 0;
+    ++m_eviction_count;
+}
+
+bool GlyphAtlas::ensure_bitmap_is_writable()
+{
+    if (m_bitmap->ref_count() == 1)
+        return true;
+    auto copy = m_bitmap->clone();
+    if (!copy)
+        return false;
+    m_bitmap = move(copy);
+    return true;
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/Traits.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Rect.h>
+
+namespace TTF {
+
+struct GlyphAtlasKey {
+    // Identifies a font at one particular size, see ScaledFont::atlas_id().
+    u64 font_id { 0 };
+    u32 glyph_id { 0 };
+
+    bool operator==(GlyphAtlasKey const&) const = default;
+};
+
+// Packs rasterized glyphs of all scaled fonts into one shared bitmap, so that a run of text
+// can be blitted from a single source. Glyphs are packed into horizontal shelves; since all
+// glyphs of a font at a given size have the same height, they end up sharing shelves. When
+// the atlas is full, the least recently used shelf of a suitable height is evicted.
+// Every thread has an atlas of its own.
+class GlyphAtlas {
+    AK_MAKE_NONCOPYABLE(GlyphAtlas);
+    AK_MAKE_NONMOVABLE(GlyphAtlas);
+
+public:
+    static constexpr int default_size = 512;
+
+    // The atlas of the calling thread.
+    static GlyphAtlas& the();
+
+    explicit GlyphAtlas(int size = default_size);
+
+    struct Entry {
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+        Gfx::IntRect rect;
+    };
+
+    // Returns where the glyph lives in the atlas, calling rasterize_glyph() first if it is not in
+    // there yet. Glyphs which fail to rasterize or don't fit into the atlas return an empty value.
+    Optional<Entry> ensure(GlyphAtlasKey const&, Function<RefPtr<Gfx::Bitmap>()> rasterize_glyph);
+
+    // The bitmap is only ever modified in place while nobody else holds a reference to it. If a
+    // shelf has to be evicted while an earlier Entry is still alive (e.g. in a batched text run),
+    // the atlas moves to a copy instead, so that the earlier entry keeps pointing at valid pixels.
+    Gfx::Bitmap const* bitmap() const { return m_bitmap.ptr(); }
+
+    size_t glyph_count() const { return m_entries.size(); }
+    size_t eviction_count() const { return m_eviction_count; }
+
+private:
+    struct Shelf {
+        int y { 0 };
+        int height { 0 };
+        int next_x { 0 };
+        u64 last_used { 0 };
+        Vector<GlyphAtlasKey> keys;
+    };
+
+    struct Slot {
+        Gfx::IntRect rect;
+        size_t shelf_index { 0 };
+    };
+
+    Optional<Slot> allocate(Gfx::IntSize const&);
+    void evict_shelf(size_t shelf_index);
+    bool ensure_bitmap_is_writable();
+
+    int m_size { 0 };
+    RefPtr<Gfx::Bitmap> m_bitmap;
+    Vector<Shelf> m_shelves;
+    int m_next_shelf_y { 0 };
+    HashMap<GlyphAtlasKey, Slot> m_entries;
+    u64 m_clock { 0 };
+    size_t m_eviction_count { 0 };
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<TTF::GlyphAtlasKey> : public GenericTraits<TTF::GlyphAtlasKey> {
+    static unsigned hash(TTF::GlyphAtlasKey const& key) { return pair_int_hash(u64_hash(key.font_id), key.glyph_id); }
+};
+
+}
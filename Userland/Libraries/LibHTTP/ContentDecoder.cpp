@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibHTTP/ContentDecoder.h>
+
+namespace HTTP {
+
+// How much decoded data we ask the decompressor for at a time.
+static constexpr size_t decode_chunk_size = 4 * KiB;
+
+// How much compressed data has to be buffered before it is safe to decode another chunk without reaching the end of it.
+// A stored deflate block is copied into the 32 KiB window in one go, a Huffman code is at most 15 bits (so at most two
+// bytes of input per byte of output), and a block header (including the code tables) takes less than 300 bytes.
+static constexpr size_t safe_input_size = 32 * KiB + 2 * decode_chunk_size + 16 * KiB;
+
+OwnPtr<ContentDecoder> ContentDecoder::create(StringView const& content_encoding)
+{
+    auto encoding = content_encoding.trim_whitespace();
+    if (encoding.equals_ignoring_case("gzip"sv) || encoding.equals_ignoring_case("x-gzip"sv))
+        return adopt_own(*new ContentDecoder(Encoding::Gzip));
+    if (encoding.equals_ignoring_case("deflate"sv))
+        return adopt_own(*new ContentDecoder(Encoding::Deflate));
+    dbgln_if(JOB_DEBUG, "ContentDecoder: Passing through content encoding '{}'", encoding);
+    return nullptr;
+}
+
+ContentDecoder::ContentDecoder(Encoding encoding)
+    : m_encoding(encoding)
+{
+}
+
+ContentDecoder::~ContentDecoder()
+{
+    // Streams insist on having their errors handled before they go away.
+    if (m_decompressor)
+        m_decompressor->handle_any_error();
+    m_input.handle_any_error();
+}
+
+void ContentDecoder::append(ReadonlyBytes bytes)
+{
+    VERIFY(!m_input_complete);
+    m_input.write_or_error(bytes);
+}
+
+bool ContentDecoder::can_read_safely() const
+{
+    return m_input_complete || m_input.size() >= safe_input_size;
+}
+
+bool ContentDecoder::create_decompressor()
+{
+    if (m_encoding == Encoding::Gzip) {
+        m_decompressor = make<Compress::GzipDecompressor>(m_input);
+        return true;
+    }
+
+    // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
+    // https://tools.ietf.org/html/rfc7230#section-4.2.2
+    // From the RFC:
+    // "Note: Some non-conformant implementations send the "deflate"
+    //        compressed data without the zlib wrapper."
+    // A zlib header is two bytes, with the compression method 8 (deflate) in the low nibble of the first one,
+    // and both of them together being a multiple of 31.
+    u8 header[2];
+    if (m_input.read_without_consuming({ header, sizeof(header) }) == sizeof(header)) {
+        if ((header[0] & 0xf) == 8 && ((header[0] << 8) | header[1]) % 31 == 0) {
+            if (header[1] & 0x20) {
+                dbgln("ContentDecoder: Zlib streams with a preset dictionary are not supported");
+                return false;
+            }
+            m_input.discard_or_error(sizeof(header));
+        } else {
+            dbgln_if(JOB_DEBUG, "ContentDecoder: No zlib header, assuming raw deflate data");
+        }
+    }
+    m_decompressor = make<Compress::DeflateDecompressor>(m_input);
+    return true;
+}
+
+Optional<ByteBuffer> ContentDecoder::decode(size_t max_size)
+{
+    ByteBuffer output;
+    if (m_is_finished || !can_read_safely())
+        return output;
+
+    if (!m_decompressor && !create_decompressor())
+        return {};
+
+    u8 buffer[decode_chunk_size];
+    while (output.size() < max_size && can_read_safely()) {
+        auto nread = m_decompressor->read({ buffer, min(sizeof(buffer), max_size - output.size()) });
+        if (m_decompressor->handle_any_error()) {
+            dbgln("ContentDecoder: Failed to decode the response body");
+            return {};
+        }
+        if (nread == 0) {
+            if (m_input_complete)
+                m_is_finished = true;
+            break;
+        }
+        if (!output.try_append(buffer, nread))
+            return {};
+    }
+    return output;
+}
+
+}
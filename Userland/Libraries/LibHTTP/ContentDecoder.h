@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/MemoryStream.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/StringView.h>
+
+namespace HTTP {
+
+// Decodes a response body with a "gzip" or "deflate" content coding as it arrives, so we never have to hold on to all of it.
+//
+// The decompressors in LibCompress pull their input from a stream, and can't be resumed once that stream runs dry.
+// So we only ask them for output while enough compressed data is buffered that they can't possibly run out of it,
+// and leave the rest for once more data (or the end of the body) arrives.
+class ContentDecoder {
+public:
+    // Returns nullptr for content codings that we pass through as they are.
+    static OwnPtr<ContentDecoder> create(StringView const& content_encoding);
+    ~ContentDecoder();
+
+    void append(ReadonlyBytes);
+    void set_input_complete() { m_input_complete = true; }
+
+    // Decodes at most max_size bytes of what has been received so far. An empty buffer means that we need more input,
+    // or that everything has been decoded already; an empty Optional means that the data is corrupt.
+    Optional<ByteBuffer> decode(size_t max_size);
+
+    bool is_finished() const { return m_is_finished; }
+
+private:
+    enum class Encoding {
+        Gzip,
+        Deflate,
+    };
+
+    explicit ContentDecoder(Encoding);
+
+    bool create_decompressor();
+    bool can_read_safely() const;
+
+    Encoding m_encoding;
+    DuplexMemoryStream m_input;
+    OwnPtr<InputStream> m_decompressor;
+    bool m_input_complete { false };
+    bool m_is_finished { false };
+};
+
+}
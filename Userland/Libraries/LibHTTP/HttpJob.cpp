@@ -46,6 +46,8 @@ void HttpJob::start(NonnullRefPtr<Core::Socket> socket)
 
 void HttpJob::shutdown(ShutdownMode mode)
 {
+    // The output stream may go away along with whoever cancelled us.
+    stop_waiting_for_output_stream();
     if (!m_socket)
         return;
     if (mode == ShutdownMode::CloseSocket) {
@@ -111,4 +113,10 @@ bool HttpJob::write(ReadonlyBytes bytes)
     return m_socket->write(bytes);
 }
 
+void HttpJob::set_socket_idle(bool idle)
+{
+    if (m_socket)
+        m_socket->set_idle(idle);
+}
+
 }
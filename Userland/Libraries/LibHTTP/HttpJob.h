@@ -43,6 +43,7 @@ protected:
     virtual ByteBuffer receive(size_t) override;
     virtual bool eof() const override;
     virtual bool write(ReadonlyBytes) override;
+    virtual void set_socket_idle(bool) override;
     virtual bool is_established() const override { return true; }
 
 private:
@@ -65,6 +65,8 @@ void HttpsJob::start(NonnullRefPtr<Core::Socket> socket)
 
 void HttpsJob::shutdown(ShutdownMode mode)
 {
+    // The output stream may go away along with whoever cancelled us.
+    stop_waiting_for_output_stream();
     if (!m_socket)
         return;
     if (mode == ShutdownMode::CloseSocket) {
@@ -140,4 +142,10 @@ bool HttpsJob::write(ReadonlyBytes data)
     return m_socket->write(data);
 }
 
+void HttpsJob::set_socket_idle(bool idle)
+{
+    if (m_socket)
+        m_socket->set_idle(idle);
+}
+
 }
@@ -46,6 +46,7 @@ protected:
     virtual ByteBuffer receive(size_t) override;
     virtual bool eof() const override;
     virtual bool write(ReadonlyBytes) override;
+    virtual void set_socket_idle(bool) override;
     virtual bool is_established() const override { return m_socket->is_established(); }
     virtual bool should_fail_on_empty_payload() const override { return false; }
     virtual void read_while_data_available(Function<IterationDecision()>) override;
@@ -5,8 +5,6 @@
  */
 
 #include <AK/Debug.h>
-#include <LibCompress/Gzip.h>
-#include <LibCompress/Zlib.h>
 #include <LibCore/Event.h>
 #include <LibCore/TCPSocket.h>
 #include <LibHTTP/HttpResponse.h>
@@ -16,61 +14,6 @@
 
 namespace HTTP {
 
-static Optional<ByteBuffer> handle_content_encoding(const ByteBuffer& buf, const String& content_encoding)
-{
-    dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf has content_encoding={}", content_encoding);
-
-    if (content_encoding == "gzip") {
-        if (!Compress::GzipDecompressor::is_likely_compressed(buf)) {
-            dbgln("Job::handle_content_encoding: buf is not gzip compressed!");
-        }
-
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is gzip compressed!");
-
-        auto uncompressed = Compress::GzipDecompressor::decompress_all(buf);
-        if (!uncompressed.has_value()) {
-            dbgln("Job::handle_content_encoding: Gzip::decompress() failed.");
-            return {};
-        }
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Gzip::decompress() successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.value().size());
-        }
-
-        return uncompressed.value();
-    } else if (content_encoding == "deflate") {
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is deflate compressed!");
-
-        // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
-        // https://tools.ietf.org/html/rfc7230#section-4.2.2
-        auto uncompressed = Compress::Zlib::decompress_all(buf);
-        if (!uncompressed.has_value()) {
-            // From the RFC:
-            // "Note: Some non-conformant implementations send the "deflate"
-            //        compressed data without the zlib wrapper."
-            dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: Zlib::decompress_all() failed. Trying DeflateDecompressor::decompress_all()");
-            uncompressed = Compress::DeflateDecompressor::decompress_all(buf);
-
-            if (!uncompressed.has_value()) {
-                dbgln("Job::handle_content_encoding: DeflateDecompressor::decompress_all() failed.");
-                return {};
-            }
-        }
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Deflate decompression successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.value().size());
-        }
-
-        return uncompressed.value();
-    }
-
-    return buf;
-}
-
 Job::Job(const HttpRequest& request, OutputStream& output_stream)
     : Core::NetworkJob(output_stream)
     , m_request(request)
@@ -83,7 +26,7 @@ Job::~Job()
 
 void Job::flush_received_buffers()
 {
-    if (!m_can_stream_response || m_buffered_size == 0)
+    if (m_buffered_size == 0)
         return;
     dbgln_if(JOB_DEBUG, "Job: Flushing received buffers: have {} bytes in {} buffers for {}", m_buffered_size, m_received_buffers.size(), m_request.url());
     for (size_t i = 0; i < m_received_buffers.size(); ++i) {
@@ -103,6 +46,84 @@ void Job::flush_received_buffers()
     dbgln_if(JOB_DEBUG, "Job: Flushing received buffers done: have {} bytes in {} buffers for {}", m_buffered_size, m_received_buffers.size(), m_request.url());
 }
 
+bool Job::decode_received_content()
+{
+    VERIFY(m_content_decoder);
+    while (m_buffered_size < max_buffered_size) {
+        auto decoded = m_content_decoder->decode(64 * KiB);
+        if (!decoded.has_value())
+            return false;
+        if (decoded->is_empty())
+            break;
+        m_buffered_size += decoded->size();
+        m_received_buffers.append(decoded.release_value());
+    }
+    return true;
+}
+
+void Job::pause_reading()
+{
+    if (!m_is_reading_paused) {
+        dbgln_if(JOB_DEBUG, "Job: {} bytes are waiting to be written for {}, pausing reads", m_buffered_size, m_request.url());
+        m_is_reading_paused = true;
+        set_socket_idle(true);
+    }
+    wait_for_output_stream_to_drain();
+}
+
+void Job::resume_reading()
+{
+    if (!m_is_reading_paused)
+        return;
+    dbgln_if(JOB_DEBUG, "Job: Resuming reads for {}", m_request.url());
+    m_is_reading_paused = false;
+    set_socket_idle(false);
+}
+
+void Job::wait_for_output_stream_to_drain()
+{
+    if (m_output_stream_fd < 0) {
+        if (!has_timer())
+            start_timer(50);
+        return;
+    }
+    if (!m_output_stream_notifier) {
+        m_output_stream_notifier = Core::Notifier::construct(m_output_stream_fd, Core::Notifier::Event::Write, this);
+        m_output_stream_notifier->on_ready_to_write = [this] {
+            m_output_stream_notifier->set_enabled(false);
+            output_stream_did_drain();
+        };
+    }
+    m_output_stream_notifier->set_enabled(true);
+}
+
+void Job::stop_waiting_for_output_stream()
+{
+    stop_timer();
+    if (m_output_stream_notifier)
+        m_output_stream_notifier->set_enabled(false);
+}
+
+void Job::output_stream_did_drain()
+{
+    stop_timer();
+    if (is_cancelled() || has_error())
+        return;
+
+    if (m_state == State::Finished) {
+        finish_up();
+        return;
+    }
+
+    if (m_content_decoder && !decode_received_content())
+        return did_fail(Core::NetworkJob::Error::TransmissionFailed);
+    flush_received_buffers();
+    if (m_buffered_size < max_buffered_size)
+        resume_reading();
+    else
+        wait_for_output_stream_to_drain();
+}
+
 void Job::on_socket_connected()
 {
     register_on_ready_to_write([&] {
@@ -182,6 +203,9 @@ void Job::on_socket_connected()
                     if (on_headers_received)
                         on_headers_received(m_headers, m_code > 0 ? m_code : Optional<u32> {});
                     m_state = State::InBody;
+
+                    if (auto content_encoding = m_headers.get("Content-Encoding"sv); content_encoding.has_value())
+                        m_content_decoder = ContentDecoder::create(content_encoding.value());
                 }
 
                 // We've reached the end of the headers, there's a possibility that the server
@@ -217,11 +241,7 @@ void Job::on_socket_connected()
             }
             auto value = line.substring(name.length() + 2, line.length() - name.length() - 2);
             m_headers.set(name, value);
-            if (name.equals_ignoring_case("Content-Encoding")) {
-                // Assume that any content-encoding means that we can't decode it as a stream :(
-                dbgln_if(JOB_DEBUG, "Content-Encoding {} detected, cannot stream output :(", value);
-                m_can_stream_response = false;
-            } else if (name.equals_ignoring_case("Content-Length")) {
+            if (name.equals_ignoring_case("Content-Length")) {
                 auto length = value.to_uint();
                 if (length.has_value())
                     m_content_length = length.value();
@@ -233,7 +253,7 @@ void Job::on_socket_connected()
         VERIFY(can_read());
 
         read_while_data_available([&] {
-            auto read_size = 64 * KiB;
+            size_t read_size = 64 * KiB;
             if (m_current_chunk_remaining_size.has_value()) {
             read_chunk_size:;
                 auto remaining = m_current_chunk_remaining_size.value();
@@ -275,13 +295,14 @@ void Job::on_socket_connected()
                         } else {
                             m_current_chunk_total_size = size;
                             m_current_chunk_remaining_size = size;
-                            read_size = size;
+                            // Big chunks are read in pieces, like everything else.
+                            read_size = min<size_t>(size, read_size);
 
                             dbgln_if(JOB_DEBUG, "Job: Chunk of size '{}' started", size);
                         }
                     }
                 } else {
-                    read_size = remaining;
+                    read_size = min<size_t>(remaining, read_size);
 
                     dbgln_if(JOB_DEBUG, "Job: Resuming chunk with '{}' bytes left over", remaining);
                 }
@@ -330,9 +351,17 @@ void Job::on_socket_connected()
                 }
             }
 
-            m_received_buffers.append(payload);
-            m_buffered_size += payload.size();
             m_received_size += payload.size();
+            if (m_content_decoder) {
+                m_content_decoder->append(payload);
+                if (!decode_received_content()) {
+                    deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+                    return IterationDecision::Break;
+                }
+            } else {
+                m_buffered_size += payload.size();
+                m_received_buffers.append(payload);
+            }
             flush_received_buffers();
 
             deferred_invoke([this] { did_progress(m_content_length, m_received_size); });
@@ -373,55 +402,39 @@ void Job::on_socket_connected()
         if (!is_established()) {
             dbgln_if(JOB_DEBUG, "Connection appears to have closed, finishing up");
             finish_up();
+            return;
         }
+
+        // Don't let the response pile up in memory while whoever reads the output stream is slower than the network.
+        if (m_state != State::Finished && m_buffered_size >= max_buffered_size)
+            pause_reading();
     });
 }
 
 void Job::timer_event(Core::TimerEvent& event)
 {
     event.accept();
-    finish_up();
-    if (m_buffered_size == 0)
-        stop_timer();
+    output_stream_did_drain();
 }
 
 void Job::finish_up()
 {
     VERIFY(!m_has_scheduled_finish);
     m_state = State::Finished;
-    if (!m_can_stream_response) {
-        auto flattened_buffer = ByteBuffer::create_uninitialized(m_buffered_size).release_value(); // FIXME: Handle possible OOM situation.
-        u8* flat_ptr = flattened_buffer.data();
-        for (auto& received_buffer : m_received_buffers) {
-            memcpy(flat_ptr, received_buffer.data(), received_buffer.size());
-            flat_ptr += received_buffer.size();
-        }
-        m_received_buffers.clear();
-
-        // For the time being, we cannot stream stuff with content-encoding set to _anything_.
-        // FIXME: LibCompress exposes a streaming interface, so this can be resolved
-        auto content_encoding = m_headers.get("Content-Encoding");
-        if (content_encoding.has_value()) {
-            if (auto result = handle_content_encoding(flattened_buffer, content_encoding.value()); result.has_value())
-                flattened_buffer = result.release_value();
-            else
-                return did_fail(Core::NetworkJob::Error::TransmissionFailed);
-        }
-
-        m_buffered_size = flattened_buffer.size();
-        m_received_buffers.append(move(flattened_buffer));
-        m_can_stream_response = true;
+    if (m_content_decoder) {
+        m_content_decoder->set_input_complete();
+        if (!decode_received_content())
+            return did_fail(Core::NetworkJob::Error::TransmissionFailed);
     }
 
     flush_received_buffers();
-    if (m_buffered_size != 0) {
+    if (m_buffered_size != 0 || (m_content_decoder && !m_content_decoder->is_finished())) {
         // We have to wait for the client to consume all the downloaded data
         // before we can actually call `did_finish`. in a normal flow, this should
         // never be hit since the client is reading as we are writing, unless there
         // are too many concurrent downloads going on.
         dbgln_if(JOB_DEBUG, "Flush finished with {} bytes remaining, will try again later", m_buffered_size);
-        if (!has_timer())
-            start_timer(50);
+        wait_for_output_stream_to_drain();
         return;
     }
 
@@ -9,8 +9,11 @@
 #include <AK/FileStream.h>
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <LibCore/NetworkJob.h>
+#include <LibCore/Notifier.h>
 #include <LibCore/TCPSocket.h>
+#include <LibHTTP/ContentDecoder.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 
@@ -27,10 +30,24 @@ public:
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     const HttpResponse* response() const { return static_cast<const HttpResponse*>(Core::NetworkJob::response()); }
 
+    // If the output stream writes to a file descriptor (like the pipe to a RequestServer client), we can wait
+    // for it to become writable when the reader falls behind, instead of polling it.
+    void set_output_stream_fd(int fd) { m_output_stream_fd = fd; }
+
 protected:
+    // We stop reading from the server once this much of the response is waiting for the output stream to take it.
+    static constexpr size_t max_buffered_size = 1 * MiB;
+
     void finish_up();
     void on_socket_connected();
     void flush_received_buffers();
+    bool decode_received_content();
+    void pause_reading();
+    void resume_reading();
+    void wait_for_output_stream_to_drain();
+    void stop_waiting_for_output_stream();
+    void output_stream_did_drain();
+    virtual void set_socket_idle(bool) = 0;
     virtual void register_on_ready_to_read(Function<void()>) = 0;
     virtual void register_on_ready_to_write(Function<void()>) = 0;
     virtual bool can_read_line() const = 0;
@@ -58,14 +75,17 @@ protected:
     HashMap<String, String, CaseInsensitiveStringTraits> m_headers;
     Vector<ByteBuffer, 2> m_received_buffers;
     size_t m_buffered_size { 0 };
+    OwnPtr<ContentDecoder> m_content_decoder;
+    int m_output_stream_fd { -1 };
+    RefPtr<Core::Notifier> m_output_stream_notifier;
     size_t m_received_size { 0 };
     bool m_sent_data { 0 };
     Optional<u32> m_content_length;
     Optional<ssize_t> m_current_chunk_remaining_size;
     Optional<size_t> m_current_chunk_total_size;
-    bool m_can_stream_response { true };
     bool m_should_read_chunk_ending_line { false };
     bool m_has_scheduled_finish { false };
+    bool m_is_reading_paused { false };
 };
 
 }
@@ -11,6 +11,7 @@
 #include <LibIPC/Decoder.h>
 #include <LibIPC/Dictionary.h>
 #include <LibIPC/File.h>
+#include <LibIPC/ReadonlyBuffer.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <string.h>
@@ -100,9 +101,10 @@ bool Decoder::decode(String& value)
     }
     char* text_buffer = nullptr;
     auto text_impl = StringImpl::create_uninitialized(static_cast<size_t>(length), text_buffer);
-    m_stream >> Bytes { text_buffer, static_cast<size_t>(length) };
+    if (!decode_payload(Bytes { text_buffer, static_cast<size_t>(length) }))
+        return false;
     value = *text_impl;
-    return !m_stream.handle_any_error();
+    return true;
 }
 
 bool Decoder::decode(ByteBuffer& value)
@@ -124,8 +126,73 @@ bool Decoder::decode(ByteBuffer& value)
     else
         return false;
 
-    m_stream >> value.bytes();
-    return !m_stream.handle_any_error();
+    return decode_payload(value.bytes());
+}
+
+bool Decoder::decode_payload(Bytes destination)
+{
+    if (destination.size() < out_of_band_payload_threshold) {
+        m_stream >> destination;
+        return !m_stream.handle_any_error();
+    }
+
+    bool is_out_of_band = false;
+    if (!decode(is_out_of_band))
+        return false;
+    if (!is_out_of_band) {
+        m_stream >> destination;
+        return !m_stream.handle_any_error();
+    }
+
+    // ByteBuffer and String own their storage, so this is the one copy they can't avoid. Use ReadonlyBuffer to read large payloads in place.
+    auto payload = decode_out_of_band_payload(destination.size());
+    if (!payload.has_value())
+        return false;
+    payload->bytes().copy_to(destination);
+    return true;
+}
+
+Optional<ReadonlyBuffer> Decoder::decode_out_of_band_payload(size_t size)
+{
+    IPC::File payload_file;
+    if (!decode(payload_file))
+        return {};
+    // NOTE: We only ever map the payload read-only. The sender dropped its own mapping before sending it to us.
+    return ReadonlyBuffer::map_anonymous_file(payload_file.take_fd(), size);
+}
+
+bool Decoder::decode(ReadonlyBuffer& value)
+{
+    i32 length = 0;
+    m_stream >> length;
+    if (m_stream.handle_any_error())
+        return false;
+    if (length <= 0) {
+        value = {};
+        return true;
+    }
+
+    if (static_cast<size_t>(length) >= out_of_band_payload_threshold) {
+        bool is_out_of_band = false;
+        if (!decode(is_out_of_band))
+            return false;
+        if (is_out_of_band) {
+            auto payload = decode_out_of_band_payload(length);
+            if (!payload.has_value())
+                return false;
+            value = payload.release_value();
+            return true;
+        }
+    }
+
+    auto bytes = ByteBuffer::create_uninitialized(length);
+    if (!bytes.has_value())
+        return false;
+    m_stream >> bytes->bytes();
+    if (m_stream.handle_any_error())
+        return false;
+    value = ReadonlyBuffer(bytes.release_value());
+    return true;
 }
 
 bool Decoder::decode(URL& value)
@@ -47,6 +47,7 @@ public:
     bool decode(URL&);
     bool decode(Dictionary&);
     bool decode(File&);
+    bool decode(ReadonlyBuffer&);
     template<typename K, typename V>
     bool decode(HashMap<K, V>& hashmap)
     {
@@ -118,6 +119,9 @@ public:
     }
 
 private:
+    bool decode_payload(Bytes);
+    Optional<ReadonlyBuffer> decode_out_of_band_payload(size_t);
+
     InputMemoryStream& m_stream;
     int m_sockfd { -1 };
 };
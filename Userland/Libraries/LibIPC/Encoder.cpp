@@ -14,6 +14,7 @@
 #include <LibIPC/Dictionary.h>
 #include <LibIPC/Encoder.h>
 #include <LibIPC/File.h>
+#include <LibIPC/ReadonlyBuffer.h>
 
 namespace IPC {
 
@@ -126,13 +127,51 @@ Encoder& Encoder::operator<<(String const& value)
     if (value.is_null())
         return *this << (i32)-1;
     *this << static_cast<i32>(value.length());
-    return *this << value.view();
+    encode_payload(value.bytes());
+    return *this;
 }
 
 Encoder& Encoder::operator<<(ByteBuffer const& value)
 {
     *this << static_cast<i32>(value.size());
-    m_buffer.data.append(value.data(), value.size());
+    encode_payload(value.bytes());
+    return *this;
+}
+
+void Encoder::encode_payload(ReadonlyBytes bytes)
+{
+    if (bytes.size() < out_of_band_payload_threshold) {
+        m_buffer.data.append(bytes.data(), bytes.size());
+        return;
+    }
+
+    // Large payloads go out-of-band, so the peer can map them instead of pulling them through the socket.
+    // The sender's mapping goes away with `buffer` below, leaving the peer as the only one able to touch the contents.
+#ifdef __serenity__
+    auto buffer = Core::AnonymousBuffer::create_with_size(bytes.size());
+    if (buffer.is_valid()) {
+        *this << true;
+        memcpy(buffer.data<void>(), bytes.data(), bytes.size());
+        *this << IPC::File(buffer.fd());
+        return;
+    }
+#endif
+    *this << false;
+    m_buffer.data.append(bytes.data(), bytes.size());
+}
+
+Encoder& Encoder::operator<<(ReadonlyBuffer const& value)
+{
+    *this << static_cast<i32>(value.size());
+#ifdef __serenity__
+    // Buffers that already live in an anonymous file are sent as they are, without copying them.
+    if (value.size() >= out_of_band_payload_threshold && value.fd() != -1) {
+        *this << true;
+        *this << IPC::File(value.fd());
+        return *this;
+    }
+#endif
+    encode_payload(value.bytes());
     return *this;
 }
 
@@ -45,6 +45,7 @@ public:
     Encoder& operator<<(URL const&);
     Encoder& operator<<(Dictionary const&);
     Encoder& operator<<(File const&);
+    Encoder& operator<<(ReadonlyBuffer const&);
     template<typename K, typename V>
     Encoder& operator<<(HashMap<K, V> const& hashmap)
     {
@@ -95,6 +96,8 @@ public:
     }
 
 private:
+    void encode_payload(ReadonlyBytes);
+
     MessageBuffer& m_buffer;
 };
 
@@ -37,6 +37,10 @@ struct MessageBuffer {
     Vector<RefPtr<AutoCloseFileDescriptor>> fds;
 };
 
+// ByteBuffer and String payloads at least this large are not copied into the message
+// stream, but handed to the peer as a file descriptor to a shared memory buffer.
+static constexpr size_t out_of_band_payload_threshold = 64 * KiB;
+
 enum class ErrorCode : u32 {
     PeerDisconnected
 };
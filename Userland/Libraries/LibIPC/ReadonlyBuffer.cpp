@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/AnonymousBuffer.h>
+#include <LibIPC/Message.h>
+#include <LibIPC/ReadonlyBuffer.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace IPC {
+
+Optional<ReadonlyBuffer> ReadonlyBuffer::copy(ReadonlyBytes bytes)
+{
+    if (bytes.size() < out_of_band_payload_threshold) {
+        auto inline_bytes = ByteBuffer::copy(bytes);
+        if (!inline_bytes.has_value())
+            return {};
+        return ReadonlyBuffer(inline_bytes.release_value());
+    }
+
+    // The only writable mapping of the file is gone once `anonymous_buffer` goes out of scope,
+    // after that the contents can't change anymore.
+    int fd = -1;
+    {
+        auto anonymous_buffer = Core::AnonymousBuffer::create_with_size(bytes.size());
+        if (!anonymous_buffer.is_valid())
+            return {};
+        memcpy(anonymous_buffer.data<void>(), bytes.data(), bytes.size());
+        fd = dup(anonymous_buffer.fd());
+        if (fd < 0) {
+            perror("dup");
+            return {};
+        }
+    }
+    return map_anonymous_file(fd, bytes.size());
+}
+
+Optional<ReadonlyBuffer> ReadonlyBuffer::map_anonymous_file(int fd, size_t size)
+{
+    auto mapping = Mapping::create(fd, size);
+    if (!mapping)
+        return {};
+    ReadonlyBuffer buffer;
+    buffer.m_mapping = move(mapping);
+    return buffer;
+}
+
+RefPtr<ReadonlyBuffer::Mapping> ReadonlyBuffer::Mapping::create(int fd, size_t size)
+{
+    auto* data = mmap(nullptr, round_up_to_power_of_two(size, PAGE_SIZE), PROT_READ, MAP_FILE | MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return {};
+    }
+    return adopt_ref(*new Mapping(fd, static_cast<u8 const*>(data), size));
+}
+
+ReadonlyBuffer::Mapping::Mapping(int fd, u8 const* data, size_t size)
+    : m_fd(fd)
+    , m_data(data)
+    , m_size(size)
+{
+}
+
+ReadonlyBuffer::Mapping::~Mapping()
+{
+    auto rc = munmap(const_cast<u8*>(m_data), round_up_to_power_of_two(m_size, PAGE_SIZE));
+    VERIFY(rc == 0);
+    rc = close(m_fd);
+    VERIFY(rc == 0);
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Span.h>
+
+namespace IPC {
+
+// Bytes that can't be changed once they're created, and that are received without copying them.
+// Small buffers travel inline like a ByteBuffer. Large ones live in an anonymous file, which both
+// sides only ever map read-only, and which the receiver reads straight from its mapping.
+class ReadonlyBuffer {
+public:
+    ReadonlyBuffer() = default;
+
+    explicit ReadonlyBuffer(ByteBuffer bytes)
+        : m_inline_bytes(move(bytes))
+    {
+    }
+
+    // Copies the bytes into an anonymous file if they're large enough to be sent out-of-band.
+    static Optional<ReadonlyBuffer> copy(ReadonlyBytes);
+
+    // Takes ownership of the fd, an anonymous file of at least `size` bytes.
+    static Optional<ReadonlyBuffer> map_anonymous_file(int fd, size_t size);
+
+    ReadonlyBytes bytes() const { return m_mapping ? m_mapping->bytes() : m_inline_bytes.bytes(); }
+    size_t size() const { return bytes().size(); }
+    bool is_empty() const { return size() == 0; }
+
+    // -1 if the bytes are kept inline.
+    int fd() const { return m_mapping ? m_mapping->fd() : -1; }
+
+private:
+    class Mapping : public RefCounted<Mapping> {
+    public:
+        static RefPtr<Mapping> create(int fd, size_t size);
+        ~Mapping();
+
+        int fd() const { return m_fd; }
+        ReadonlyBytes bytes() const { return { m_data, m_size }; }
+
+    private:
+        Mapping(int fd, u8 const* data, size_t size);
+
+        int m_fd { -1 };
+        u8 const* m_data { nullptr };
+        size_t m_size { 0 };
+    };
+
+    ByteBuffer m_inline_bytes;
+    RefPtr<Mapping> m_mapping;
+};
+
+}
@@ -1568,6 +1568,17 @@ void ASTNode::dump(int indent) const
     outln("{}", class_name());
 }
 
+void FunctionBody::dump(int indent) const
+{
+    if (needs_parsing()) {
+        ASTNode::dump(indent);
+        print_indent(indent + 1);
+        outln("(Not parsed yet)");
+        return;
+    }
+    ScopeNode::dump(indent);
+}
+
 void ScopeNode::dump(int indent) const
 {
     ASTNode::dump(indent);
@@ -69,6 +69,7 @@ public:
     virtual bool is_identifier() const { return false; }
     virtual bool is_scope_node() const { return false; }
     virtual bool is_program() const { return false; }
+    virtual bool is_function_body() const { return false; }
     virtual bool is_function_declaration() const { return false; }
 
 protected:
@@ -344,8 +345,37 @@ public:
     Value execute(Interpreter& interpreter, GlobalObject& object) const override;
 };
 
+// The functions found while parsing some code, by the offset they start at in it. Cached bytecode refers to functions this way.
+using FunctionNodesByOffset = HashMap<size_t, NonnullRefPtr<ASTNode>>;
+
 class FunctionBody final : public ScopeNode {
 public:
+    // When the parser skips over a function body, this is what it needs to come back and parse it later.
+    struct SkippedSource {
+        StringView text() const { return source.substring_view(start_offset, end_offset - start_offset); }
+
+        // NOTE: This is the source text of the whole script, which all the function bodies that were skipped in it share.
+        String source;
+        String filename;
+        size_t start_offset { 0 };
+        size_t end_offset { 0 };
+        size_t line_number { 0 };
+        size_t line_column { 0 };
+        // Where the closing '}' is, so a parser can jump over the body.
+        size_t end_line_number { 0 };
+        size_t end_line_column { 0 };
+        FunctionKind kind { FunctionKind::Regular };
+        Program::Type program_type { Program::Type::Script };
+
+        // What checking the body for early errors found out, which the function that contains it needs to know.
+        bool contains_direct_call_to_eval { false };
+        bool might_need_arguments_object { false };
+
+        // The bodies of functions nested in this one, by the offset they start at. These have been checked already,
+        // so parsing this body just picks them up instead of checking them again.
+        HashMap<size_t, NonnullRefPtr<FunctionBody>> checked_function_bodies;
+    };
+
     explicit FunctionBody(SourceRange source_range)
         : ScopeNode(source_range)
     {
@@ -355,10 +385,33 @@ public:
 
     bool in_strict_mode() const { return m_in_strict_mode; }
 
+    SkippedSource const* skipped_source() const { return m_skipped_source.ptr(); }
+    void set_skipped_source(SkippedSource skipped_source) { m_skipped_source = make<SkippedSource>(move(skipped_source)); }
+    HashMap<size_t, NonnullRefPtr<FunctionBody>> take_checked_function_bodies() { return move(m_skipped_source->checked_function_bodies); }
+
+    bool needs_parsing() const { return m_skipped_source && !m_has_been_parsed; }
+    // If parsing a skipped body failed, this is the syntax error to throw whenever the function is called.
+    // NOTE: Skipped bodies are checked for syntax errors when they are skipped, so this is just a safety net.
+    String const& deferred_syntax_error() const { return m_deferred_syntax_error; }
+    FunctionNodesByOffset const& function_nodes() const { return m_function_nodes; }
+    void did_parse_skipped_source(String deferred_syntax_error, FunctionNodesByOffset function_nodes)
+    {
+        m_has_been_parsed = true;
+        m_deferred_syntax_error = move(deferred_syntax_error);
+        m_function_nodes = move(function_nodes);
+    }
+
     virtual Value execute(Interpreter&, GlobalObject&) const override;
+    virtual void dump(int indent) const override;
 
 private:
+    virtual bool is_function_body() const override { return true; }
+
     bool m_in_strict_mode { false };
+    bool m_has_been_parsed { false };
+    OwnPtr<SkippedSource> m_skipped_source;
+    String m_deferred_syntax_error;
+    FunctionNodesByOffset m_function_nodes;
 };
 
 class Expression : public ASTNode {
@@ -1872,6 +1925,9 @@ inline bool ASTNode::fast_is<ScopeNode>() const { return is_scope_node(); }
 template<>
 inline bool ASTNode::fast_is<Program>() const { return is_program(); }
 
+template<>
+inline bool ASTNode::fast_is<FunctionBody>() const { return is_function_body(); }
+
 template<>
 inline bool ASTNode::fast_is<FunctionDeclaration>() const { return is_function_declaration(); }
 
@@ -64,4 +64,19 @@ void BasicBlock::grow(size_t additional_size)
     VERIFY(m_buffer_size <= m_buffer_capacity);
 }
 
+void BasicBlock::take_instruction_stream_from(BasicBlock& other)
+{
+    swap(m_buffer, other.m_buffer);
+    swap(m_buffer_capacity, other.m_buffer_capacity);
+    m_buffer_size = exchange(other.m_buffer_size, 0);
+}
+
+void BasicBlock::append_moved_instruction(Instruction const& instruction)
+{
+    auto length = instruction.length();
+    VERIFY(can_grow(length));
+    __builtin_memcpy(next_slot(), &instruction, length);
+    grow(length);
+}
+
 }
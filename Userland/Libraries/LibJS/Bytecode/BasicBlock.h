@@ -36,6 +36,11 @@ public:
     bool can_grow(size_t additional_size) const { return m_buffer_size + additional_size <= m_buffer_capacity; }
     void grow(size_t additional_size);
 
+    // Optimization passes that change a block's instructions build the new instruction stream in a scratch block, then move it over here.
+    // NOTE: The instructions we had before are *not* destroyed, the pass has either moved them into the new stream or destroyed them already.
+    void take_instruction_stream_from(BasicBlock&);
+    void append_moved_instruction(Instruction const&);
+
     void terminate(Badge<Generator>) { m_is_terminated = true; }
     bool is_terminated() const { return m_is_terminated; }
 
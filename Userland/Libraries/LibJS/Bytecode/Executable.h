@@ -10,6 +10,7 @@
 #include <AK/NonnullOwnPtrVector.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
+#include <LibJS/Bytecode/PropertyLookupCache.h>
 #include <LibJS/Bytecode/StringTable.h>
 
 namespace JS::Bytecode {
@@ -20,6 +21,8 @@ struct Executable {
     NonnullOwnPtr<StringTable> string_table;
     NonnullOwnPtr<IdentifierTable> identifier_table;
     size_t number_of_registers { 0 };
+    // One for every GetById and PutById instruction, which refer to theirs by index.
+    mutable Vector<PropertyLookupCache> property_lookup_caches;
 
     String const& get_string(StringTableIndex index) const { return string_table->get(index); }
     FlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/File.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <stdio.h>
+#include <unistd.h>
+
+namespace JS::Bytecode {
+
+static constexpr u32 cache_file_magic = 0x4342534a; // "JSBC"
+static constexpr u32 cache_file_version = 1;
+static constexpr u32 no_label = NumericLimits<u32>::max();
+
+// Most instructions are written out byte for byte, so anything that changes their layout makes old cache files useless.
+static constexpr u32 instruction_sizes[] = {
+#define __BYTECODE_OP(op) \
+    sizeof(Op::op),
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+};
+static constexpr size_t instruction_type_count = sizeof(instruction_sizes) / sizeof(instruction_sizes[0]);
+
+static void write_layout_fingerprint(OutputStream& stream)
+{
+    stream << cache_file_magic << cache_file_version;
+    stream << static_cast<u32>(sizeof(void*)) << static_cast<u32>(sizeof(Value));
+    for (auto size : instruction_sizes)
+        stream << size;
+}
+
+static ByteBuffer layout_fingerprint()
+{
+    DuplexMemoryStream stream;
+    write_layout_fingerprint(stream);
+    return stream.copy_into_contiguous_buffer();
+}
+
+static OwnPtr<ExecutableCache> s_the;
+
+ExecutableCache* ExecutableCache::the()
+{
+    return s_the.ptr();
+}
+
+void ExecutableCache::enable(String directory)
+{
+    s_the = adopt_own(*new ExecutableCache(Core::File::absolute_path(directory)));
+}
+
+String ExecutableCache::path_for(Key const& key) const
+{
+    Crypto::Hash::SHA256 sha;
+    sha.update(layout_fingerprint());
+    u8 flags[] = {
+        key.is_strict,
+        key.is_generator,
+        key.is_module,
+        key.is_optimized,
+        static_cast<u8>(key.is_optimized ? Interpreter::optimization_level() : Interpreter::OptimizationLevel::__Count),
+    };
+    sha.update(flags, sizeof(flags));
+    sha.update(key.source_text);
+    auto digest = sha.digest();
+    return String::formatted("{}/{}.jsbc", m_directory, encode_hex({ digest.immutable_data(), digest.data_length() }));
+}
+
+Optional<Executable> ExecutableCache::load(Key const& key, FunctionNodesByOffset const& function_nodes) const
+{
+    auto path = path_for(key);
+    auto file_or_error = Core::File::open(path, Core::OpenMode::ReadOnly);
+    if (file_or_error.is_error())
+        return {};
+    auto executable = deserialize(file_or_error.value()->read_all(), function_nodes);
+    dbgln_if(JS_BYTECODE_DEBUG, "ExecutableCache: {} {}", executable.has_value() ? "Loaded" : "Failed to load", path);
+    return executable;
+}
+
+void ExecutableCache::store(Key const& key, Executable const& executable, FunctionNodesByOffset const& function_nodes) const
+{
+    auto data = serialize(executable, function_nodes);
+    if (!data.has_value())
+        return;
+
+    auto path = path_for(key);
+    if (!Core::File::ensure_parent_directories(path))
+        return;
+
+    // Write to a file of our own first, so that nobody ever gets to see a partially written one.
+    auto temporary_path = String::formatted("{}.{}", path, getpid());
+    auto file_or_error = Core::File::open(temporary_path, Core::OpenMode::WriteOnly);
+    if (file_or_error.is_error())
+        return;
+    auto& file = *file_or_error.value();
+    bool written = file.write(data->data(), data->size());
+    file.close();
+    if (!written || rename(temporary_path.characters(), path.characters()) < 0) {
+        unlink(temporary_path.characters());
+        return;
+    }
+    dbgln_if(JS_BYTECODE_DEBUG, "ExecutableCache: Stored {}", path);
+}
+
+static FunctionNode const* as_function_node(ASTNode const& node)
+{
+    if (is<FunctionDeclaration>(node))
+        return &static_cast<FunctionDeclaration const&>(node);
+    if (is<FunctionExpression>(node))
+        return &static_cast<FunctionExpression const&>(node);
+    return nullptr;
+}
+
+static void write_string(OutputStream& stream, StringView string)
+{
+    stream << static_cast<u32>(string.length());
+    stream << string.bytes();
+}
+
+static Optional<String> read_string(InputMemoryStream& stream)
+{
+    u32 length = 0;
+    stream >> length;
+    if (stream.has_any_error() || length > stream.remaining())
+        return {};
+    String string { stream.bytes().slice(stream.offset(), length) };
+    stream.discard_or_error(length);
+    return string;
+}
+
+// Instructions that are copied byte for byte may still refer to the tables we read, so they have to stay within them.
+static bool has_valid_table_indices(Instruction const& instruction, u32 string_count, u32 identifier_count, u32 property_lookup_cache_count)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::NewString:
+        return static_cast<Op::NewString const&>(instruction).index().value() < string_count;
+    case Instruction::Type::NewRegExp: {
+        auto& new_regexp = static_cast<Op::NewRegExp const&>(instruction);
+        return new_regexp.source_index().value() < string_count && new_regexp.flags_index().value() < string_count;
+    }
+    case Instruction::Type::GetById: {
+        auto& get_by_id = static_cast<Op::GetById const&>(instruction);
+        return get_by_id.property().value() < identifier_count && get_by_id.cache_index() < property_lookup_cache_count;
+    }
+    case Instruction::Type::PutById: {
+        auto& put_by_id = static_cast<Op::PutById const&>(instruction);
+        return put_by_id.property().value() < identifier_count && put_by_id.cache_index() < property_lookup_cache_count;
+    }
+    default:
+        return true;
+    }
+}
+
+Optional<ByteBuffer> ExecutableCache::serialize(Executable const& executable, FunctionNodesByOffset const& function_nodes)
+{
+    HashMap<FunctionNode const*, size_t> function_node_offsets;
+    for (auto& it : function_nodes) {
+        if (auto* function_node = as_function_node(*it.value))
+            function_node_offsets.set(function_node, it.key);
+    }
+
+    HashMap<BasicBlock const*, u32> block_indices;
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i)
+        block_indices.set(&executable.basic_blocks[i], i);
+    auto label_index = [&](Optional<Label> const& label) -> Optional<u32> {
+        if (!label.has_value())
+            return no_label;
+        return block_indices.get(&label->block());
+    };
+
+    DuplexMemoryStream stream;
+    write_layout_fingerprint(stream);
+    stream << static_cast<u32>(executable.number_of_registers);
+    stream << static_cast<u32>(executable.property_lookup_caches.size());
+    stream << static_cast<u32>(executable.string_table->size());
+    for (size_t i = 0; i < executable.string_table->size(); ++i)
+        write_string(stream, executable.get_string(i));
+    stream << static_cast<u32>(executable.identifier_table->size());
+    for (size_t i = 0; i < executable.identifier_table->size(); ++i)
+        write_string(stream, executable.get_identifier(i));
+
+    stream << static_cast<u32>(executable.basic_blocks.size());
+    for (auto& block : executable.basic_blocks) {
+        write_string(stream, block.name());
+        stream << static_cast<u32>(block.size());
+    }
+
+    for (auto& block : executable.basic_blocks) {
+        u32 instruction_count = 0;
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+            ++instruction_count;
+        stream << instruction_count;
+
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = *it;
+            stream << static_cast<u8>(instruction.type());
+
+            // Instructions that point into the executable or the AST (or own memory elsewhere) are written out as what they refer to.
+            Vector<Optional<Label>, 3> labels;
+            switch (instruction.type()) {
+            case Instruction::Type::Jump:
+            case Instruction::Type::JumpConditional:
+            case Instruction::Type::JumpNullish:
+            case Instruction::Type::JumpUndefined: {
+                auto& jump = static_cast<Op::Jump const&>(instruction);
+                labels.append(jump.true_target());
+                labels.append(jump.false_target());
+                break;
+            }
+            case Instruction::Type::EnterUnwindContext: {
+                auto& enter = static_cast<Op::EnterUnwindContext const&>(instruction);
+                labels.append(enter.entry_point());
+                labels.append(enter.handler_target());
+                labels.append(enter.finalizer_target());
+                break;
+            }
+            case Instruction::Type::ContinuePendingUnwind:
+                labels.append(static_cast<Op::ContinuePendingUnwind const&>(instruction).resume_target());
+                break;
+            case Instruction::Type::Yield:
+                labels.append(static_cast<Op::Yield const&>(instruction).continuation());
+                break;
+            case Instruction::Type::NewBigInt:
+                write_string(stream, static_cast<Op::NewBigInt const&>(instruction).bigint().to_base(10));
+                continue;
+            case Instruction::Type::NewFunction: {
+                auto offset = function_node_offsets.get(&static_cast<Op::NewFunction const&>(instruction).function_node());
+                if (!offset.has_value())
+                    return {};
+                stream << static_cast<u64>(*offset);
+                continue;
+            }
+            case Instruction::Type::GetVariable:
+                stream << static_cast<u64>(static_cast<Op::GetVariable const&>(instruction).identifier().value());
+                continue;
+            case Instruction::Type::SetVariable:
+                stream << static_cast<u64>(static_cast<Op::SetVariable const&>(instruction).identifier().value());
+                continue;
+            case Instruction::Type::LoadImmediate:
+                if (static_cast<Op::LoadImmediate const&>(instruction).value().is_cell())
+                    return {};
+                break;
+            case Instruction::Type::NewClass:
+            case Instruction::Type::PushDeclarativeEnvironment:
+                return {};
+            default:
+                break;
+            }
+
+            if (!labels.is_empty()) {
+                for (auto& label : labels) {
+                    auto index = label_index(label);
+                    if (!index.has_value())
+                        return {};
+                    stream << *index;
+                }
+                continue;
+            }
+
+            auto length = instruction.length();
+            stream << static_cast<u32>(length);
+            stream << ReadonlyBytes { &instruction, length };
+        }
+    }
+
+    auto data = stream.copy_into_contiguous_buffer();
+    auto digest = Crypto::Hash::SHA256::hash(data);
+    data.append(digest.immutable_data(), digest.data_length());
+    return data;
+}
+
+Optional<Executable> ExecutableCache::deserialize(ReadonlyBytes bytes, FunctionNodesByOffset const& function_nodes)
+{
+    constexpr auto digest_size = Crypto::Hash::SHA256::DigestSize;
+    if (bytes.size() < digest_size)
+        return {};
+    auto payload = bytes.slice(0, bytes.size() - digest_size);
+    auto digest = Crypto::Hash::SHA256::hash(payload.data(), payload.size());
+    if (__builtin_memcmp(bytes.offset_pointer(payload.size()), digest.immutable_data(), digest_size) != 0)
+        return {};
+
+    auto fingerprint = layout_fingerprint();
+    if (payload.size() < fingerprint.size() || __builtin_memcmp(payload.data(), fingerprint.data(), fingerprint.size()) != 0)
+        return {};
+
+    InputMemoryStream stream(payload.slice(fingerprint.size()));
+    ScopeGuard handle_errors = [&] { stream.handle_any_error(); };
+
+    u32 number_of_registers = 0;
+    u32 property_lookup_cache_count = 0;
+    stream >> number_of_registers >> property_lookup_cache_count;
+    // Every cache belongs to an instruction, so there can't be more of them than there are bytes left.
+    if (stream.has_any_error() || property_lookup_cache_count > stream.remaining())
+        return {};
+
+    auto string_table = make<StringTable>();
+    u32 string_count = 0;
+    stream >> string_count;
+    for (u32 i = 0; i < string_count; ++i) {
+        auto string = read_string(stream);
+        if (!string.has_value())
+            return {};
+        string_table->insert(string.release_value());
+    }
+
+    auto identifier_table = make<IdentifierTable>();
+    u32 identifier_count = 0;
+    stream >> identifier_count;
+    for (u32 i = 0; i < identifier_count; ++i) {
+        auto identifier = read_string(stream);
+        if (!identifier.has_value())
+            return {};
+        identifier_table->insert(identifier.release_value());
+    }
+    if (string_table->size() != string_count || identifier_table->size() != identifier_count)
+        return {};
+
+    NonnullOwnPtrVector<BasicBlock> basic_blocks;
+    u32 block_count = 0;
+    stream >> block_count;
+    if (stream.has_any_error() || block_count == 0 || block_count > stream.remaining())
+        return {};
+    for (u32 i = 0; i < block_count; ++i) {
+        auto name = read_string(stream);
+        u32 size = 0;
+        stream >> size;
+        if (!name.has_value() || stream.has_any_error() || size > payload.size() * 8)
+            return {};
+        basic_blocks.append(BasicBlock::create(name.release_value(), size));
+    }
+
+    auto read_label = [&]() -> Optional<Optional<Label>> {
+        u32 index = 0;
+        stream >> index;
+        if (stream.has_any_error())
+            return {};
+        if (index == no_label)
+            return Optional<Label> {};
+        if (index >= basic_blocks.size())
+            return {};
+        return Optional<Label> { Label { basic_blocks[index] } };
+    };
+
+    for (auto& block : basic_blocks) {
+        u32 instruction_count = 0;
+        stream >> instruction_count;
+        for (u32 i = 0; i < instruction_count; ++i) {
+            u8 raw_type = 0;
+            stream >> raw_type;
+            if (stream.has_any_error() || raw_type >= instruction_type_count)
+                return {};
+            auto type = static_cast<Instruction::Type>(raw_type);
+            if (!block.can_grow(instruction_sizes[raw_type]))
+                return {};
+
+            switch (type) {
+            case Instruction::Type::Jump:
+            case Instruction::Type::JumpConditional:
+            case Instruction::Type::JumpNullish:
+            case Instruction::Type::JumpUndefined: {
+                auto true_target = read_label();
+                auto false_target = read_label();
+                if (!true_target.has_value() || !false_target.has_value())
+                    return {};
+                if (type == Instruction::Type::Jump)
+                    new (block.next_slot()) Op::Jump(true_target.release_value(), false_target.release_value());
+                else if (type == Instruction::Type::JumpConditional)
+                    new (block.next_slot()) Op::JumpConditional(true_target.release_value(), false_target.release_value());
+                else if (type == Instruction::Type::JumpNullish)
+                    new (block.next_slot()) Op::JumpNullish(true_target.release_value(), false_target.release_value());
+                else
+                    new (block.next_slot()) Op::JumpUndefined(true_target.release_value(), false_target.release_value());
+                break;
+            }
+            case Instruction::Type::EnterUnwindContext: {
+                auto entry_point = read_label();
+                auto handler_target = read_label();
+                auto finalizer_target = read_label();
+                if (!entry_point.has_value() || !entry_point->has_value() || !handler_target.has_value() || !finalizer_target.has_value())
+                    return {};
+                new (block.next_slot()) Op::EnterUnwindContext(entry_point->value(), handler_target.release_value(), finalizer_target.release_value());
+                break;
+            }
+            case Instruction::Type::ContinuePendingUnwind: {
+                auto resume_target = read_label();
+                if (!resume_target.has_value() || !resume_target->has_value())
+                    return {};
+                new (block.next_slot()) Op::ContinuePendingUnwind(resume_target->value());
+                break;
+            }
+            case Instruction::Type::Yield: {
+                auto continuation = read_label();
+                if (!continuation.has_value())
+                    return {};
+                if (continuation->has_value())
+                    new (block.next_slot()) Op::Yield(continuation->value());
+                else
+                    new (block.next_slot()) Op::Yield(nullptr);
+                break;
+            }
+            case Instruction::Type::NewBigInt: {
+                auto bigint = read_string(stream);
+                if (!bigint.has_value())
+                    return {};
+                new (block.next_slot()) Op::NewBigInt(Crypto::SignedBigInteger::from_base(10, *bigint));
+                break;
+            }
+            case Instruction::Type::NewFunction: {
+                u64 offset = 0;
+                stream >> offset;
+                auto node = function_nodes.get(offset);
+                if (stream.has_any_error() || !node.has_value())
+                    return {};
+                auto* function_node = as_function_node(*node.value());
+                if (!function_node)
+                    return {};
+                new (block.next_slot()) Op::NewFunction(*function_node);
+                break;
+            }
+            case Instruction::Type::GetVariable:
+            case Instruction::Type::SetVariable: {
+                u64 identifier = 0;
+                stream >> identifier;
+                if (stream.has_any_error() || identifier >= identifier_count)
+                    return {};
+                if (type == Instruction::Type::GetVariable)
+                    new (block.next_slot()) Op::GetVariable(identifier);
+                else
+                    new (block.next_slot()) Op::SetVariable(identifier);
+                break;
+            }
+            case Instruction::Type::NewClass:
+            case Instruction::Type::PushDeclarativeEnvironment:
+                return {};
+            default: {
+                u32 length = 0;
+                stream >> length;
+                if (stream.has_any_error() || length < instruction_sizes[raw_type] || length > stream.remaining() || !block.can_grow(length))
+                    return {};
+                __builtin_memcpy(block.next_slot(), stream.bytes().offset_pointer(stream.offset()), length);
+                stream.discard_or_error(length);
+                // NOTE: These are all plain data, so there's nothing to destroy if they turn out to be bogus.
+                auto& instruction = *static_cast<Instruction const*>(block.next_slot());
+                if (instruction.type() != type || instruction.length() != length)
+                    return {};
+                if (!has_valid_table_indices(instruction, string_count, identifier_count, property_lookup_cache_count))
+                    return {};
+                break;
+            }
+            }
+
+            auto& instruction = *static_cast<Instruction*>(block.next_slot());
+            bool registers_are_valid = true;
+            instruction.visit_registers([&](Register& reg, auto) {
+                if (reg.index() >= number_of_registers)
+                    registers_are_valid = false;
+            });
+            // NOTE: The instruction is only part of the block (and destroyed with it) once we've grown the block over it.
+            if (!registers_are_valid) {
+                Instruction::destroy(instruction);
+                return {};
+            }
+            block.grow(instruction.length());
+        }
+    }
+    if (stream.has_any_error() || !stream.eof())
+        return {};
+
+    Vector<PropertyLookupCache> property_lookup_caches;
+    property_lookup_caches.resize(property_lookup_cache_count);
+    return Executable { {}, move(basic_blocks), move(string_table), move(identifier_table), number_of_registers, move(property_lookup_caches) };
+}
+
+}
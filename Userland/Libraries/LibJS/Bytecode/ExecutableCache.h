@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Executable.h>
+
+namespace JS::Bytecode {
+
+// Keeps the (optimized) bytecode of lazily parsed code on disk, so running the same script again doesn't have to generate it again.
+// Every executable goes into a file of its own, named after a hash of the source text it came from and everything else that went into it.
+// NOTE: Cached bytecode still refers to the functions in its source text, so that has to be parsed either way.
+class ExecutableCache {
+public:
+    struct Key {
+        StringView source_text;
+        bool is_strict { false };
+        bool is_generator { false };
+        bool is_module { false };
+        // Whether the executable went through the optimization pipeline of the current optimization level.
+        bool is_optimized { false };
+    };
+
+    static ExecutableCache* the();
+    static void enable(String directory);
+
+    Optional<Executable> load(Key const&, FunctionNodesByOffset const&) const;
+    void store(Key const&, Executable const&, FunctionNodesByOffset const&) const;
+
+    // NOTE: Not all bytecode can be serialized, in which case this returns nothing.
+    static Optional<ByteBuffer> serialize(Executable const&, FunctionNodesByOffset const&);
+    static Optional<Executable> deserialize(ReadonlyBytes, FunctionNodesByOffset const&);
+
+private:
+    explicit ExecutableCache(String directory)
+        : m_directory(move(directory))
+    {
+    }
+
+    String path_for(Key const&) const;
+
+    String m_directory;
+};
+
+}
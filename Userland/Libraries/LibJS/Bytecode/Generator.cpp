@@ -45,7 +45,9 @@ Executable Generator::generate(ASTNode const& node, bool is_in_generator_functio
             generator.emit<Bytecode::Op::Yield>(nullptr);
         }
     }
-    return { {}, move(generator.m_root_basic_blocks), move(generator.m_string_table), move(generator.m_identifier_table), generator.m_next_register };
+    Vector<PropertyLookupCache> property_lookup_caches;
+    property_lookup_caches.resize(generator.m_next_property_lookup_cache);
+    return { {}, move(generator.m_root_basic_blocks), move(generator.m_string_table), move(generator.m_identifier_table), generator.m_next_register, move(property_lookup_caches) };
 }
 
 void Generator::grow(size_t additional_size)
@@ -113,7 +115,7 @@ void Generator::emit_load_from_reference(JS::ASTNode const& node)
             emit<Bytecode::Op::GetByValue>(object_reg);
         } else {
             auto identifier_table_ref = intern_identifier(verify_cast<Identifier>(expression.property()).string());
-            emit<Bytecode::Op::GetById>(identifier_table_ref);
+            emit<Bytecode::Op::GetById>(identifier_table_ref, next_property_lookup_cache());
         }
         return;
     }
@@ -147,7 +149,7 @@ void Generator::emit_store_to_reference(JS::ASTNode const& node)
         } else {
             emit<Bytecode::Op::Load>(value_reg);
             auto identifier_table_ref = intern_identifier(verify_cast<Identifier>(expression.property()).string());
-            emit<Bytecode::Op::PutById>(object_reg, identifier_table_ref);
+            emit<Bytecode::Op::PutById>(object_reg, identifier_table_ref, next_property_lookup_cache());
         }
         return;
     }
@@ -111,6 +111,8 @@ public:
         return m_identifier_table->insert(move(string));
     }
 
+    u32 next_property_lookup_cache() { return m_next_property_lookup_cache++; }
+
     bool is_in_generator_function() const { return m_is_in_generator_function; }
     void enter_generator_context() { m_is_in_generator_function = true; }
     void leave_generator_context() { m_is_in_generator_function = false; }
@@ -129,6 +131,7 @@ private:
 
     u32 m_next_register { 2 };
     u32 m_next_block { 1 };
+    u32 m_next_property_lookup_cache { 0 };
     bool m_is_in_generator_function { false };
     Vector<Label> m_continuable_scopes;
     Vector<Label> m_breakable_scopes;
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/Function.h>
 #include <AK/Span.h>
 #include <LibJS/Forward.h>
 
@@ -82,6 +83,18 @@ namespace JS::Bytecode {
 class Instruction {
 public:
     constexpr static bool IsTerminator = false;
+    constexpr static bool ReadsAccumulator = true;
+    // NOTE: Instructions that throw leave the accumulator alone, but then we don't carry on with the next one anyway.
+    constexpr static bool WritesAccumulator = true;
+    // Whether executing the instruction may leave an exception behind. The interpreter only checks for one after those that can.
+    constexpr static bool CanThrow = true;
+
+    enum class RegisterAccess {
+        Read,
+        Write,
+        ReadWrite,
+    };
+    using RegisterVisitor = Function<void(Register&, RegisterAccess)>;
 
     enum class Type {
 #define __BYTECODE_OP(op) \
@@ -91,11 +104,15 @@ public:
     };
 
     bool is_terminator() const;
+    bool reads_accumulator() const;
+    bool writes_accumulator() const;
     Type type() const { return m_type; }
     size_t length() const;
     String to_string(Bytecode::Executable const&) const;
     void execute(Bytecode::Interpreter&) const;
     void replace_references(BasicBlock const&, BasicBlock const&);
+    // Calls the visitor for every register operand (apart from the accumulator, which is implied by the instruction type).
+    void visit_registers(RegisterVisitor const&);
     static void destroy(Instruction&);
 
 protected:
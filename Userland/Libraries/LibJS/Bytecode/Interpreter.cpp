@@ -18,6 +18,7 @@ namespace JS::Bytecode {
 
 static Interpreter* s_current;
 bool g_dump_bytecode = false;
+bool g_dump_passes = false;
 
 Interpreter* Interpreter::current()
 {
@@ -39,6 +40,66 @@ Interpreter::~Interpreter()
     s_current = nullptr;
 }
 
+template<typename OpType>
+static ALWAYS_INLINE size_t instruction_length(OpType const& instruction)
+{
+    if constexpr (requires { instruction.length_impl(); })
+        return instruction.length_impl();
+    else
+        return sizeof(OpType);
+}
+
+template<typename OpType>
+static ALWAYS_INLINE void execute_instruction(OpType const& instruction, Interpreter& interpreter, Value*)
+{
+    instruction.execute_impl(interpreter);
+}
+
+// These are simple enough to do right in the interpreter loop, without calling out to execute_impl().
+template<>
+ALWAYS_INLINE void execute_instruction(Op::Load const& instruction, Interpreter&, Value* registers)
+{
+    registers[Register::accumulator_index] = registers[instruction.src().index()];
+}
+
+template<>
+ALWAYS_INLINE void execute_instruction(Op::LoadImmediate const& instruction, Interpreter&, Value* registers)
+{
+    registers[Register::accumulator_index] = instruction.value();
+}
+
+template<>
+ALWAYS_INLINE void execute_instruction(Op::Store const& instruction, Interpreter&, Value* registers)
+{
+    registers[instruction.dst().index()] = registers[Register::accumulator_index];
+}
+
+template<typename OpType>
+static ALWAYS_INLINE BasicBlock const& jump_target(OpType const&, Value)
+{
+    VERIFY_NOT_REACHED();
+}
+
+static ALWAYS_INLINE BasicBlock const& jump_target(Op::Jump const& jump, Value)
+{
+    return jump.true_target()->block();
+}
+
+static ALWAYS_INLINE BasicBlock const& jump_target(Op::JumpConditional const& jump, Value condition)
+{
+    return (condition.to_boolean() ? *jump.true_target() : *jump.false_target()).block();
+}
+
+static ALWAYS_INLINE BasicBlock const& jump_target(Op::JumpNullish const& jump, Value condition)
+{
+    return (condition.is_nullish() ? *jump.true_target() : *jump.false_target()).block();
+}
+
+static ALWAYS_INLINE BasicBlock const& jump_target(Op::JumpUndefined const& jump, Value condition)
+{
+    return (condition.is_undefined() ? *jump.true_target() : *jump.false_target()).block();
+}
+
 Value Interpreter::run(Executable const& executable, BasicBlock const* entry_point)
 {
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter will run unit {:p}", &executable);
@@ -70,59 +131,83 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
         registers()[Register::global_object_index] = Value(&global_object());
     }
 
-    for (;;) {
-        Bytecode::InstructionStreamIterator pc(block->instruction_stream());
-        bool will_jump = false;
-        bool will_return = false;
-        while (!pc.at_end()) {
-            auto& instruction = *pc;
-            instruction.execute(*this);
-            if (vm().exception()) {
-                m_saved_exception = {};
-                if (m_unwind_contexts.is_empty())
-                    break;
-                auto& unwind_context = m_unwind_contexts.last();
-                if (unwind_context.executable != m_current_executable)
-                    break;
-                if (unwind_context.handler) {
-                    block = unwind_context.handler;
-                    unwind_context.handler = nullptr;
-                    accumulator() = vm().exception()->value();
-                    vm().clear_exception();
-                    will_jump = true;
-                    break;
-                }
-                if (unwind_context.finalizer) {
-                    block = unwind_context.finalizer;
-                    m_unwind_contexts.take_last();
-                    will_jump = true;
-                    m_saved_exception = Handle<Exception>::create(vm().exception());
-                    vm().clear_exception();
-                    break;
-                }
-            }
-            if (m_pending_jump.has_value()) {
-                block = m_pending_jump.release_value();
-                will_jump = true;
-                break;
-            }
-            if (!m_return_value.is_empty()) {
-                will_return = true;
-                break;
-            }
-            ++pc;
-        }
-
-        if (will_return)
-            break;
-
-        if (pc.at_end() && !will_jump)
-            break;
+    // NOTE: Other frames get register windows of their own, so ours stays where it is while we run.
+    auto* register_values = registers().data();
+
+    // Every instruction handler jumps straight to the handler of the next instruction through this table,
+    // rather than going back to a single switch. This gives each of them an indirect branch of its own to predict.
+    static void const* const dispatch_table[] = {
+#define __BYTECODE_OP(op) &&handle_##op,
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    };
+
+    u8 const* pc = nullptr;
+    u8 const* end = nullptr;
+    Instruction const* instruction = nullptr;
+
+enter_block:
+    pc = block->instruction_stream().data();
+    end = pc + block->size();
+
+dispatch:
+    if (pc == end)
+        goto done;
+    instruction = reinterpret_cast<Instruction const*>(pc);
+    goto* dispatch_table[to_underlying(instruction->type())];
+
+    // Jumps go straight to their target block. Other terminators may go elsewhere (or stop running altogether),
+    // so we have to look at what they did. Everything else just carries on with the next instruction.
+#define __BYTECODE_OP(op)                                                                  \
+    handle_##op:                                                                           \
+    {                                                                                      \
+        auto& op_instruction = static_cast<Op::op const&>(*instruction);                   \
+        if constexpr (IsBaseOf<Op::Jump, Op::op>) {                                        \
+            block = &jump_target(op_instruction, register_values[Register::accumulator_index]); \
+            goto enter_block;                                                              \
+        }                                                                                  \
+        execute_instruction(op_instruction, *this, register_values);                       \
+        if constexpr (Op::op::CanThrow) {                                                  \
+            if (vm().exception()) [[unlikely]]                                             \
+                goto handle_exception;                                                     \
+        }                                                                                  \
+        if constexpr (Op::op::IsTerminator)                                                \
+            goto handle_control_flow;                                                      \
+        pc += instruction_length(op_instruction);                                          \
+        goto dispatch;                                                                     \
+    }
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+
+handle_exception:
+    m_saved_exception = {};
+    if (m_unwind_contexts.is_empty() || m_unwind_contexts.last().executable != m_current_executable)
+        goto done;
+    if (auto& unwind_context = m_unwind_contexts.last(); unwind_context.handler) {
+        block = unwind_context.handler;
+        unwind_context.handler = nullptr;
+        accumulator() = vm().exception()->value();
+        vm().clear_exception();
+        goto enter_block;
+    } else if (unwind_context.finalizer) {
+        block = unwind_context.finalizer;
+        m_unwind_contexts.take_last();
+        m_saved_exception = Handle<Exception>::create(vm().exception());
+        vm().clear_exception();
+        goto enter_block;
+    }
 
-        if (vm().exception())
-            break;
+handle_control_flow:
+    if (m_pending_jump.has_value()) {
+        block = m_pending_jump.release_value();
+        goto enter_block;
     }
+    if (!m_return_value.is_empty())
+        goto done;
+    pc += instruction->length();
+    goto dispatch;
 
+done:
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
     if constexpr (JS_BYTECODE_DEBUG) {
@@ -177,6 +262,7 @@ void Interpreter::continue_pending_unwind(Label const& resume_label)
 }
 
 AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> Interpreter::s_optimization_pipelines {};
+Interpreter::OptimizationLevel Interpreter::s_optimization_level { Interpreter::OptimizationLevel::Default };
 
 Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::OptimizationLevel level)
 {
@@ -199,6 +285,29 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
         pm->add<Passes::MergeBlocks>();
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::PlaceBlocks>();
+    } else if (level == OptimizationLevel::Aggressive) {
+        // Fold what we can first, so the blocks that become unreachable are gone before we start merging.
+        pm->add<Passes::ConstantFolding>();
+        pm->add<Passes::ThreadJumps>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::DeadCodeElimination>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::UnifySameBlocks>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::MergeBlocks>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::UnifySameBlocks>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::MergeBlocks>();
+        // Merged blocks give constants a longer way to travel.
+        pm->add<Passes::ConstantFolding>();
+        pm->add<Passes::ThreadJumps>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::DeadCodeElimination>();
+        pm->add<Passes::DeadStoreElimination>();
+        pm->add<Passes::AllocateRegisters>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::PlaceBlocks>();
     } else {
         VERIFY_NOT_REACHED();
     }
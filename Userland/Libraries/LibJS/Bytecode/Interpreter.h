@@ -64,14 +64,20 @@ public:
 
     enum class OptimizationLevel {
         Default,
+        Aggressive,
         __Count,
     };
-    static Bytecode::PassManager& optimization_pipeline(OptimizationLevel = OptimizationLevel::Default);
+    static Bytecode::PassManager& optimization_pipeline(OptimizationLevel);
+    // The pipeline that functions are run through when they're compiled.
+    static Bytecode::PassManager& optimization_pipeline() { return optimization_pipeline(s_optimization_level); }
+    static OptimizationLevel optimization_level() { return s_optimization_level; }
+    static void set_optimization_level(OptimizationLevel level) { s_optimization_level = level; }
 
 private:
     RegisterWindow& registers() { return m_register_windows.last(); }
 
     static AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> s_optimization_pipelines;
+    static OptimizationLevel s_optimization_level;
 
     VM& m_vm;
     GlobalObject& m_global_object;
@@ -236,28 +236,31 @@ void ConcatString::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.reg(m_lhs) = result_or_error.release_value();
 }
 
-void GetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
-{
-    auto reference = [&] {
-        auto const& string = interpreter.current_executable().get_identifier(m_identifier);
-        if (m_cached_environment_coordinate.has_value()) {
-            auto* environment = interpreter.vm().running_execution_context().lexical_environment;
-            for (size_t i = 0; i < m_cached_environment_coordinate->hops; ++i)
-                environment = environment->outer_environment();
-            VERIFY(environment);
-            VERIFY(environment->is_declarative_environment());
-            if (!environment->is_permanently_screwed_by_eval()) {
-                return Reference { *environment, string, interpreter.vm().in_strict_mode(), m_cached_environment_coordinate };
-            }
-            m_cached_environment_coordinate = {};
+// Once a binding has been found in a declarative environment, we remember where it was, so we can skip the lookup by name next time.
+static Reference resolve_variable(Bytecode::Interpreter& interpreter, IdentifierTableIndex identifier, Optional<EnvironmentCoordinate>& cached_environment_coordinate)
+{
+    auto const& string = interpreter.current_executable().get_identifier(identifier);
+    if (cached_environment_coordinate.has_value()) {
+        auto* environment = interpreter.vm().running_execution_context().lexical_environment;
+        for (size_t i = 0; i < cached_environment_coordinate->hops; ++i)
+            environment = environment->outer_environment();
+        VERIFY(environment);
+        VERIFY(environment->is_declarative_environment());
+        if (!environment->is_permanently_screwed_by_eval()) {
+            return Reference { *environment, string, interpreter.vm().in_strict_mode(), cached_environment_coordinate };
         }
+        cached_environment_coordinate = {};
+    }
 
-        auto reference = interpreter.vm().resolve_binding(string);
-        if (reference.environment_coordinate().has_value())
-            m_cached_environment_coordinate = reference.environment_coordinate();
-        return reference;
-    }();
+    auto reference = interpreter.vm().resolve_binding(string);
+    if (reference.environment_coordinate().has_value())
+        cached_environment_coordinate = reference.environment_coordinate();
+    return reference;
+}
 
+void GetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto reference = resolve_variable(interpreter, m_identifier, m_cached_environment_coordinate);
     if (interpreter.vm().exception())
         return;
 
@@ -266,9 +269,8 @@ void GetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 
 void SetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    auto& vm = interpreter.vm();
-    auto reference = vm.resolve_binding(interpreter.current_executable().get_identifier(m_identifier));
-    if (vm.exception())
+    auto reference = resolve_variable(interpreter, m_identifier, m_cached_environment_coordinate);
+    if (interpreter.vm().exception())
         return;
 
     reference.put_value(interpreter.global_object(), interpreter.accumulator());
@@ -276,14 +278,34 @@ void SetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 
 void GetById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    auto object_or_error = interpreter.accumulator().to_object(interpreter.global_object());
+    auto& executable = interpreter.current_executable();
+    auto& identifier = executable.get_identifier(m_property);
+    auto base = interpreter.accumulator();
+
+    // Don't bother making a String object just to ask it how long it is.
+    if (base.is_string() && identifier == interpreter.vm().names.length.as_string()) {
+        interpreter.accumulator() = Value(base.as_string().utf16_string_view().length_in_code_units());
+        return;
+    }
+
+    auto object_or_error = base.to_object(interpreter.global_object());
     if (object_or_error.is_error())
         return;
     auto* object = object_or_error.release_value();
-    auto value_or_error = object->get(interpreter.current_executable().get_identifier(m_property));
+
+    auto& cache = executable.property_lookup_caches[m_cache_index];
+    if (auto value = cache.get(*object); value.has_value()) {
+        interpreter.accumulator() = value.release_value();
+        return;
+    }
+
+    PropertyKey property_key { identifier };
+    auto value_or_error = object->get(property_key);
     if (value_or_error.is_error())
         return;
     interpreter.accumulator() = value_or_error.release_value();
+    if (!property_key.is_number())
+        cache.fill_after_get(*object, property_key.to_string_or_symbol());
 }
 
 void PutById::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -292,7 +314,24 @@ void PutById::execute_impl(Bytecode::Interpreter& interpreter) const
     if (object_or_error.is_error())
         return;
     auto* object = object_or_error.release_value();
-    MUST(object->set(interpreter.current_executable().get_identifier(m_property), interpreter.accumulator(), Object::ShouldThrowExceptions::Yes));
+
+    auto& executable = interpreter.current_executable();
+    auto& cache = executable.property_lookup_caches[m_cache_index];
+    auto value = interpreter.accumulator();
+    // NOTE: A put on a primitive sets a property on a temporary object, so there's nothing worth remembering about it.
+    bool is_cacheable = interpreter.reg(m_base).is_object();
+    if (is_cacheable && cache.put(*object, value))
+        return;
+
+    PropertyKey property_key { executable.get_identifier(m_property) };
+    // NOTE: This may run a setter, which may do anything at all to the object, so we make sure the old shape doesn't go away under our feet.
+    auto shape_before_put = object->shape().make_weak_ptr();
+    auto should_throw = interpreter.vm().in_strict_mode() ? Object::ShouldThrowExceptions::Yes : Object::ShouldThrowExceptions::No;
+    auto succeeded_or_error = object->set(property_key, value, should_throw);
+    if (succeeded_or_error.is_error() || !succeeded_or_error.value())
+        return;
+    if (is_cacheable && shape_before_put && !property_key.is_number())
+        cache.fill_after_put(*object, *shape_before_put, property_key.to_string_or_symbol());
 }
 
 void Jump::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -507,7 +546,10 @@ void PutByValue::execute_impl(Bytecode::Interpreter& interpreter) const
     auto property_key_or_error = interpreter.reg(m_property).to_property_key(interpreter.global_object());
     if (property_key_or_error.is_error())
         return;
-    MUST(object->set(property_key_or_error.release_value(), interpreter.accumulator(), Object::ShouldThrowExceptions::Yes));
+    auto should_throw = interpreter.vm().in_strict_mode() ? Object::ShouldThrowExceptions::Yes : Object::ShouldThrowExceptions::No;
+    auto succeeded_or_error = object->set(property_key_or_error.release_value(), interpreter.accumulator(), should_throw);
+    if (succeeded_or_error.is_error())
+        return;
 }
 
 void GetIterator::execute_impl(Bytecode::Interpreter& interpreter) const
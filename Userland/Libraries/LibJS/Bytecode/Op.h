@@ -23,6 +23,9 @@ namespace JS::Bytecode::Op {
 
 class Load final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     explicit Load(Register src)
         : Instruction(Type::Load)
         , m_src(src)
@@ -32,6 +35,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_src, RegisterAccess::Read); }
+
+    Register src() const { return m_src; }
 
 private:
     Register m_src;
@@ -39,6 +45,9 @@ private:
 
 class LoadImmediate final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     explicit LoadImmediate(Value value)
         : Instruction(Type::LoadImmediate)
         , m_value(value)
@@ -48,6 +57,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    Value value() const { return m_value; }
 
 private:
     Value m_value;
@@ -55,6 +67,9 @@ private:
 
 class Store final : public Instruction {
 public:
+    constexpr static bool WritesAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     explicit Store(Register dst)
         : Instruction(Type::Store)
         , m_dst(dst)
@@ -64,6 +79,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_dst, RegisterAccess::Write); }
+
+    Register dst() const { return m_dst; }
 
 private:
     Register m_dst;
@@ -105,6 +123,10 @@ private:
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_registers_impl(RegisterVisitor const& visitor)              \
+        {                                                                      \
+            visitor(m_lhs_reg, RegisterAccess::Read);                          \
+        }                                                                      \
                                                                                \
     private:                                                                   \
         Register m_lhs_reg;                                                    \
@@ -131,6 +153,7 @@ JS_ENUMERATE_COMMON_BINARY_OPS(JS_DECLARE_COMMON_BINARY_OP)
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_registers_impl(RegisterVisitor const&) { }                  \
     };
 
 JS_ENUMERATE_COMMON_UNARY_OPS(JS_DECLARE_COMMON_UNARY_OP)
@@ -138,6 +161,9 @@ JS_ENUMERATE_COMMON_UNARY_OPS(JS_DECLARE_COMMON_UNARY_OP)
 
 class NewString final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     explicit NewString(StringTableIndex string)
         : Instruction(Type::NewString)
         , m_string(string)
@@ -147,6 +173,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex index() const { return m_string; }
 
 private:
     StringTableIndex m_string;
@@ -154,6 +183,9 @@ private:
 
 class NewObject final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     NewObject()
         : Instruction(Type::NewObject)
     {
@@ -162,10 +194,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class NewRegExp final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+
     NewRegExp(StringTableIndex source_index, StringTableIndex flags_index)
         : Instruction(Type::NewRegExp)
         , m_source_index(source_index)
@@ -176,6 +211,10 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex source_index() const { return m_source_index; }
+    StringTableIndex flags_index() const { return m_flags_index; }
 
 private:
     StringTableIndex m_source_index;
@@ -185,6 +224,8 @@ private:
 // NOTE: This instruction is variable-width depending on the number of excluded names
 class CopyObjectExcludingProperties final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+
     CopyObjectExcludingProperties(Register from_object, Vector<Register> const& excluded_names)
         : Instruction(Type::CopyObjectExcludingProperties)
         , m_from_object(from_object)
@@ -197,6 +238,12 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        visitor(m_from_object, RegisterAccess::Read);
+        for (size_t i = 0; i < m_excluded_names_count; i++)
+            visitor(m_excluded_names[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const { return sizeof(*this) + sizeof(Register) * m_excluded_names_count; }
 
@@ -208,6 +255,9 @@ private:
 
 class NewBigInt final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     explicit NewBigInt(Crypto::SignedBigInteger bigint)
         : Instruction(Type::NewBigInt)
         , m_bigint(move(bigint))
@@ -217,6 +267,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    Crypto::SignedBigInteger const& bigint() const { return m_bigint; }
 
 private:
     Crypto::SignedBigInteger m_bigint;
@@ -225,6 +278,9 @@ private:
 // NOTE: This instruction is variable-width depending on the number of elements!
 class NewArray final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     NewArray()
         : Instruction(Type::NewArray)
         , m_element_count(0)
@@ -242,6 +298,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        for (size_t i = 0; i < m_element_count; ++i)
+            visitor(m_elements[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const
     {
@@ -263,10 +324,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class ConcatString final : public Instruction {
 public:
+    constexpr static bool WritesAccumulator = false;
+
     explicit ConcatString(Register lhs)
         : Instruction(Type::ConcatString)
         , m_lhs(lhs)
@@ -276,6 +340,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_lhs, RegisterAccess::ReadWrite); }
 
 private:
     Register m_lhs;
@@ -283,6 +348,8 @@ private:
 
 class SetVariable final : public Instruction {
 public:
+    constexpr static bool WritesAccumulator = false;
+
     explicit SetVariable(IdentifierTableIndex identifier)
         : Instruction(Type::SetVariable)
         , m_identifier(identifier)
@@ -292,13 +359,20 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    IdentifierTableIndex identifier() const { return m_identifier; }
 
 private:
     IdentifierTableIndex m_identifier;
+
+    Optional<EnvironmentCoordinate> mutable m_cached_environment_coordinate;
 };
 
 class GetVariable final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+
     explicit GetVariable(IdentifierTableIndex identifier)
         : Instruction(Type::GetVariable)
         , m_identifier(identifier)
@@ -308,6 +382,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    IdentifierTableIndex identifier() const { return m_identifier; }
 
 private:
     IdentifierTableIndex m_identifier;
@@ -317,36 +394,50 @@ private:
 
 class GetById final : public Instruction {
 public:
-    explicit GetById(IdentifierTableIndex property)
+    GetById(IdentifierTableIndex property, u32 cache_index)
         : Instruction(Type::GetById)
         , m_property(property)
+        , m_cache_index(cache_index)
     {
     }
 
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    IdentifierTableIndex property() const { return m_property; }
+    u32 cache_index() const { return m_cache_index; }
 
 private:
     IdentifierTableIndex m_property;
+    u32 m_cache_index { 0 };
 };
 
 class PutById final : public Instruction {
 public:
-    explicit PutById(Register base, IdentifierTableIndex property)
+    constexpr static bool WritesAccumulator = false;
+
+    PutById(Register base, IdentifierTableIndex property, u32 cache_index)
         : Instruction(Type::PutById)
         , m_base(base)
         , m_property(property)
+        , m_cache_index(cache_index)
     {
     }
 
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_base, RegisterAccess::Read); }
+
+    IdentifierTableIndex property() const { return m_property; }
+    u32 cache_index() const { return m_cache_index; }
 
 private:
     Register m_base;
     IdentifierTableIndex m_property;
+    u32 m_cache_index { 0 };
 };
 
 class GetByValue final : public Instruction {
@@ -360,6 +451,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_base, RegisterAccess::Read); }
 
 private:
     Register m_base;
@@ -367,6 +459,8 @@ private:
 
 class PutByValue final : public Instruction {
 public:
+    constexpr static bool WritesAccumulator = false;
+
     PutByValue(Register base, Register property)
         : Instruction(Type::PutByValue)
         , m_base(base)
@@ -377,6 +471,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        visitor(m_base, RegisterAccess::Read);
+        visitor(m_property, RegisterAccess::Read);
+    }
 
 private:
     Register m_base;
@@ -386,6 +485,9 @@ private:
 class Jump : public Instruction {
 public:
     constexpr static bool IsTerminator = true;
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool WritesAccumulator = false;
+    constexpr static bool CanThrow = false;
 
     explicit Jump(Type type, Optional<Label> taken_target = {}, Optional<Label> nontaken_target = {})
         : Instruction(type)
@@ -410,6 +512,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& true_target() const { return m_true_target; }
     auto& false_target() const { return m_false_target; }
@@ -421,6 +524,8 @@ protected:
 
 class JumpConditional final : public Jump {
 public:
+    constexpr static bool ReadsAccumulator = true;
+
     explicit JumpConditional(Optional<Label> true_target = {}, Optional<Label> false_target = {})
         : Jump(Type::JumpConditional, move(true_target), move(false_target))
     {
@@ -432,6 +537,8 @@ public:
 
 class JumpNullish final : public Jump {
 public:
+    constexpr static bool ReadsAccumulator = true;
+
     explicit JumpNullish(Optional<Label> true_target = {}, Optional<Label> false_target = {})
         : Jump(Type::JumpNullish, move(true_target), move(false_target))
     {
@@ -443,6 +550,8 @@ public:
 
 class JumpUndefined final : public Jump {
 public:
+    constexpr static bool ReadsAccumulator = true;
+
     explicit JumpUndefined(Optional<Label> true_target = {}, Optional<Label> false_target = {})
         : Jump(Type::JumpUndefined, move(true_target), move(false_target))
     {
@@ -455,6 +564,8 @@ public:
 // NOTE: This instruction is variable-width depending on the number of arguments!
 class Call final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+
     enum class CallType {
         Call,
         Construct,
@@ -474,6 +585,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        visitor(m_callee, RegisterAccess::Read);
+        visitor(m_this_value, RegisterAccess::Read);
+        for (size_t i = 0; i < m_argument_count; ++i)
+            visitor(m_arguments[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const
     {
@@ -490,6 +608,8 @@ private:
 
 class NewClass final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+
     explicit NewClass(ClassExpression const& class_expression)
         : Instruction(Type::NewClass)
         , m_class_expression(class_expression)
@@ -499,6 +619,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 
 private:
     ClassExpression const& m_class_expression;
@@ -506,6 +627,9 @@ private:
 
 class NewFunction final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     explicit NewFunction(FunctionNode const& function_node)
         : Instruction(Type::NewFunction)
         , m_function_node(function_node)
@@ -515,6 +639,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    FunctionNode const& function_node() const { return m_function_node; }
 
 private:
     FunctionNode const& m_function_node;
@@ -523,6 +650,8 @@ private:
 class Return final : public Instruction {
 public:
     constexpr static bool IsTerminator = true;
+    constexpr static bool WritesAccumulator = false;
+    constexpr static bool CanThrow = false;
 
     Return()
         : Instruction(Type::Return)
@@ -532,6 +661,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Increment final : public Instruction {
@@ -544,6 +674,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Decrement final : public Instruction {
@@ -556,11 +687,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Throw final : public Instruction {
 public:
     constexpr static bool IsTerminator = true;
+    constexpr static bool WritesAccumulator = false;
 
     Throw()
         : Instruction(Type::Throw)
@@ -570,11 +703,15 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class EnterUnwindContext final : public Instruction {
 public:
     constexpr static bool IsTerminator = true;
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool WritesAccumulator = false;
+    constexpr static bool CanThrow = false;
 
     EnterUnwindContext(Label entry_point, Optional<Label> handler_target, Optional<Label> finalizer_target)
         : Instruction(Type::EnterUnwindContext)
@@ -587,6 +724,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& entry_point() const { return m_entry_point; }
     auto& handler_target() const { return m_handler_target; }
@@ -600,6 +738,10 @@ private:
 
 class LeaveUnwindContext final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool WritesAccumulator = false;
+    constexpr static bool CanThrow = false;
+
     LeaveUnwindContext()
         : Instruction(Type::LeaveUnwindContext)
     {
@@ -608,11 +750,14 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class ContinuePendingUnwind final : public Instruction {
 public:
     constexpr static bool IsTerminator = true;
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool WritesAccumulator = false;
 
     explicit ContinuePendingUnwind(Label resume_target)
         : Instruction(Type::ContinuePendingUnwind)
@@ -623,6 +768,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& resume_target() const { return m_resume_target; }
 
@@ -633,6 +779,8 @@ private:
 class Yield final : public Instruction {
 public:
     constexpr static bool IsTerminator = true;
+    constexpr static bool WritesAccumulator = false;
+    constexpr static bool CanThrow = false;
 
     explicit Yield(Label continuation_label)
         : Instruction(Type::Yield)
@@ -648,6 +796,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& continuation() const { return m_continuation_label; }
 
@@ -657,6 +806,9 @@ private:
 
 class PushDeclarativeEnvironment final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+    constexpr static bool WritesAccumulator = false;
+
     explicit PushDeclarativeEnvironment(HashMap<u32, Variable> variables)
         : Instruction(Type::PushDeclarativeEnvironment)
         , m_variables(move(variables))
@@ -666,6 +818,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 
 private:
     HashMap<u32, Variable> m_variables;
@@ -681,6 +834,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorNext final : public Instruction {
@@ -693,6 +847,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorResultDone final : public Instruction {
@@ -705,6 +860,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorResultValue final : public Instruction {
@@ -717,10 +873,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class ResolveThisBinding final : public Instruction {
 public:
+    constexpr static bool ReadsAccumulator = false;
+
     explicit ResolveThisBinding()
         : Instruction(Type::ResolveThisBinding)
     {
@@ -729,6 +888,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 }
@@ -765,6 +925,21 @@ ALWAYS_INLINE void Instruction::replace_references(BasicBlock const& from, Basic
 #undef __BYTECODE_OP
 }
 
+ALWAYS_INLINE void Instruction::visit_registers(RegisterVisitor const& visitor)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op&>(*this).visit_registers_impl(visitor);
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
 ALWAYS_INLINE size_t Instruction::length() const
 {
     if (type() == Type::Call)
@@ -800,4 +975,32 @@ ALWAYS_INLINE bool Instruction::is_terminator() const
 #undef __BYTECODE_OP
 }
 
+ALWAYS_INLINE bool Instruction::reads_accumulator() const
+{
+#define __BYTECODE_OP(op) \
+    case Type::op:        \
+        return Op::op::ReadsAccumulator;
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+#undef __BYTECODE_OP
+}
+
+ALWAYS_INLINE bool Instruction::writes_accumulator() const
+{
+#define __BYTECODE_OP(op) \
+    case Type::op:        \
+        return Op::op::WritesAccumulator;
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+#undef __BYTECODE_OP
+}
+
 }
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <LibJS/Bytecode/Pass/Liveness.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// The accumulator and the global object have fixed places in the register window.
+static constexpr u32 first_allocatable_register = Register::global_object_index + 1;
+
+struct InterferenceGraph {
+    explicit InterferenceGraph(size_t register_count)
+    {
+        neighbors.resize(register_count);
+        copies.resize(register_count);
+        is_used.resize(register_count);
+    }
+
+    void add_edge(u32 a, u32 b)
+    {
+        if (a == b || a < first_allocatable_register || b < first_allocatable_register)
+            return;
+        neighbors[a].set(b);
+        neighbors[b].set(a);
+    }
+
+    // Two registers that must not share a place in the register window, because both their values are needed at some point.
+    Vector<HashTable<u32>> neighbors;
+    // Registers that one is copied to or from, and which we'd like to give the same place so the copy goes away.
+    Vector<Vector<u32>> copies;
+    Vector<bool> is_used;
+};
+
+// If the accumulator was loaded from a register and is then stored into another one, both hold the same value.
+static Optional<u32> copied_register(Instruction const* previous_instruction, Instruction const& instruction)
+{
+    if (!previous_instruction || previous_instruction->type() != Instruction::Type::Load || instruction.type() != Instruction::Type::Store)
+        return {};
+    return static_cast<Op::Load const&>(*previous_instruction).src().index();
+}
+
+static void build_interference_graph(Executable const& executable, Liveness const& liveness, InterferenceGraph& graph)
+{
+    for (auto& block : executable.basic_blocks) {
+        auto live = liveness.live_at_end(block);
+        auto instructions = Liveness::instructions(block);
+        for (size_t i = instructions.size(); i-- > 0;) {
+            auto& instruction = *instructions[i];
+            auto copy_source = copied_register(i > 0 ? instructions[i - 1] : nullptr, instruction);
+
+            // Whatever the instruction writes can't share a register with anything that's still needed afterwards.
+            // The exception is the source of a copy, which holds the same value anyway (until one of them is written to again).
+            instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+                graph.is_used[reg.index()] = true;
+                if (access == Instruction::RegisterAccess::Read)
+                    return;
+                live.for_each([&](u32 live_register) {
+                    if (copy_source.has_value() && live_register == *copy_source)
+                        return;
+                    graph.add_edge(reg.index(), live_register);
+                });
+                if (copy_source.has_value() && *copy_source >= first_allocatable_register && reg.index() >= first_allocatable_register) {
+                    graph.copies[reg.index()].append(*copy_source);
+                    graph.copies[*copy_source].append(reg.index());
+                }
+            });
+
+            Liveness::step_backwards(instruction, live);
+        }
+    }
+}
+
+static Vector<u32> color_registers(InterferenceGraph const& graph, u32& register_count)
+{
+    Vector<u32> colors;
+    colors.resize(graph.neighbors.size());
+    Vector<bool> is_colored;
+    is_colored.resize(graph.neighbors.size());
+    register_count = first_allocatable_register;
+
+    for (u32 i = 0; i < first_allocatable_register && i < colors.size(); ++i) {
+        colors[i] = i;
+        is_colored[i] = true;
+    }
+
+    HashTable<u32> neighbor_colors;
+    for (u32 reg = first_allocatable_register; reg < colors.size(); ++reg) {
+        if (!graph.is_used[reg])
+            continue;
+
+        neighbor_colors.clear();
+        for (auto neighbor : graph.neighbors[reg]) {
+            if (is_colored[neighbor])
+                neighbor_colors.set(colors[neighbor]);
+        }
+
+        Optional<u32> color;
+        for (auto copy : graph.copies[reg]) {
+            if (is_colored[copy] && !neighbor_colors.contains(colors[copy])) {
+                color = colors[copy];
+                break;
+            }
+        }
+        if (!color.has_value()) {
+            color = first_allocatable_register;
+            while (neighbor_colors.contains(*color))
+                ++*color;
+        }
+
+        colors[reg] = *color;
+        is_colored[reg] = true;
+        register_count = max(register_count, *color + 1);
+    }
+    return colors;
+}
+
+// Once both sides of a copy share a register, storing the accumulator right back where it was just loaded from does nothing.
+static void remove_redundant_stores(BasicBlock& block)
+{
+    auto instructions = Liveness::instructions(block);
+    auto is_redundant = [&](size_t i) {
+        auto copy_source = copied_register(i > 0 ? instructions[i - 1] : nullptr, *instructions[i]);
+        return copy_source.has_value() && *copy_source == static_cast<Op::Store const&>(*instructions[i]).dst().index();
+    };
+
+    bool found_redundant_store = false;
+    for (size_t i = 0; i < instructions.size() && !found_redundant_store; ++i)
+        found_redundant_store = is_redundant(i);
+    if (!found_redundant_store)
+        return;
+
+    auto new_block = BasicBlock::create(block.name(), block.size());
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        if (is_redundant(i))
+            Instruction::destroy(*instructions[i]);
+        else
+            new_block->append_moved_instruction(*instructions[i]);
+    }
+    block.take_instruction_stream_from(*new_block);
+}
+
+void AllocateRegisters::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    auto liveness = Liveness::analyze(executable.executable);
+    if (!liveness.has_value()) {
+        finished();
+        return;
+    }
+
+    InterferenceGraph graph { executable.executable.number_of_registers };
+    build_interference_graph(executable.executable, *liveness, graph);
+
+    u32 register_count = 0;
+    auto colors = color_registers(graph, register_count);
+
+    for (auto& block : executable.executable.basic_blocks) {
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            ++it;
+            instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess) {
+                reg = Register(colors[reg.index()]);
+            });
+        }
+        remove_redundant_stores(block);
+    }
+    executable.executable.number_of_registers = register_count;
+
+    finished();
+}
+
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <math.h>
+
+namespace JS::Bytecode::Passes {
+
+// Only numbers, booleans, null and undefined: everything else lives on the heap, and the bytecode can't keep it alive.
+static bool is_foldable_constant(Value value)
+{
+    return !value.is_empty() && !value.is_cell();
+}
+
+static Optional<i32> to_int32_if_exact(Value value)
+{
+    if (!value.is_integral_number())
+        return {};
+    auto number = value.as_double();
+    if (number < NumericLimits<i32>::min() || number > NumericLimits<i32>::max())
+        return {};
+    return static_cast<i32>(number);
+}
+
+// NOTE: These follow the spec for numbers only. Anything else could call user code (valueOf, toString) or throw, so we leave it to the interpreter.
+static Optional<Value> fold_binary_operation(Instruction::Type type, Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+    auto lhs_number = lhs.as_double();
+    auto rhs_number = rhs.as_double();
+
+    switch (type) {
+    case Instruction::Type::Add:
+        return Value(lhs_number + rhs_number);
+    case Instruction::Type::Sub:
+        return Value(lhs_number - rhs_number);
+    case Instruction::Type::Mul:
+        return Value(lhs_number * rhs_number);
+    case Instruction::Type::Div:
+        return Value(lhs_number / rhs_number);
+    case Instruction::Type::Mod:
+        // fmod() handles NaN, infinities and zeroes the same way Number::remainder does.
+        return Value(fmod(lhs_number, rhs_number));
+    case Instruction::Type::GreaterThan:
+        return Value(lhs_number > rhs_number);
+    case Instruction::Type::GreaterThanEquals:
+        return Value(lhs_number >= rhs_number);
+    case Instruction::Type::LessThan:
+        return Value(lhs_number < rhs_number);
+    case Instruction::Type::LessThanEquals:
+        return Value(lhs_number <= rhs_number);
+    case Instruction::Type::LooselyEquals:
+    case Instruction::Type::StrictlyEquals:
+        return Value(lhs_number == rhs_number);
+    case Instruction::Type::LooselyInequals:
+    case Instruction::Type::StrictlyInequals:
+        return Value(lhs_number != rhs_number);
+    default:
+        break;
+    }
+
+    auto lhs_int = to_int32_if_exact(lhs);
+    auto rhs_int = to_int32_if_exact(rhs);
+    if (!lhs_int.has_value() || !rhs_int.has_value())
+        return {};
+    auto shift_count = static_cast<u32>(*rhs_int) % 32;
+
+    switch (type) {
+    case Instruction::Type::BitwiseAnd:
+        return Value(*lhs_int & *rhs_int);
+    case Instruction::Type::BitwiseOr:
+        return Value(*lhs_int | *rhs_int);
+    case Instruction::Type::BitwiseXor:
+        return Value(*lhs_int ^ *rhs_int);
+    case Instruction::Type::LeftShift:
+        return Value(static_cast<i32>(static_cast<u32>(*lhs_int) << shift_count));
+    case Instruction::Type::RightShift:
+        return Value(*lhs_int >> shift_count);
+    case Instruction::Type::UnsignedRightShift:
+        return Value(static_cast<double>(static_cast<u32>(*lhs_int) >> shift_count));
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_unary_operation(Instruction::Type type, Value value)
+{
+    if (type == Instruction::Type::Not)
+        return Value(!value.to_boolean());
+
+    if (!value.is_number())
+        return {};
+    switch (type) {
+    case Instruction::Type::UnaryPlus:
+        return value;
+    case Instruction::Type::UnaryMinus:
+        return Value(-value.as_double());
+    case Instruction::Type::Increment:
+        return Value(value.as_double() + 1);
+    case Instruction::Type::Decrement:
+        return Value(value.as_double() - 1);
+    case Instruction::Type::BitwiseNot:
+        if (auto int_value = to_int32_if_exact(value); int_value.has_value())
+            return Value(~*int_value);
+        return {};
+    default:
+        return {};
+    }
+}
+
+static Optional<bool> fold_conditional_jump(Instruction::Type type, Value condition)
+{
+    switch (type) {
+    case Instruction::Type::JumpConditional:
+        return condition.to_boolean();
+    case Instruction::Type::JumpNullish:
+        return condition.is_nullish();
+    case Instruction::Type::JumpUndefined:
+        return condition.is_undefined();
+    default:
+        return {};
+    }
+}
+
+static bool is_binary_operation(Instruction::Type type)
+{
+    switch (type) {
+#define __BYTECODE_OP(op, ...) \
+    case Instruction::Type::op:
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        return true;
+    default:
+        return false;
+    }
+}
+
+static Register binary_operation_lhs(Instruction& instruction)
+{
+    Optional<Register> lhs;
+    instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess) { lhs = reg; });
+    return lhs.value();
+}
+
+static void fold_block(BasicBlock& block)
+{
+    static_assert(sizeof(Op::JumpConditional) == sizeof(Op::Jump));
+    static_assert(sizeof(Op::JumpNullish) == sizeof(Op::Jump));
+    static_assert(sizeof(Op::JumpUndefined) == sizeof(Op::Jump));
+
+    // Folded instructions turn into LoadImmediate, which can be bigger than what it replaces.
+    auto new_block = BasicBlock::create(block.name(), block.size() * sizeof(Op::LoadImmediate));
+
+    Optional<Value> accumulator;
+    HashMap<u32, Value> registers;
+    auto known_register = [&](Register reg) -> Optional<Value> {
+        return registers.get(reg.index());
+    };
+
+    auto replace_with_constant = [&](Instruction& instruction, Value value) {
+        Instruction::destroy(instruction);
+        new (new_block->next_slot()) Op::LoadImmediate(value);
+        new_block->grow(sizeof(Op::LoadImmediate));
+        accumulator = value;
+    };
+
+    InstructionStreamIterator it { block.instruction_stream() };
+    while (!it.at_end()) {
+        auto& instruction = const_cast<Instruction&>(*it);
+        ++it;
+        auto type = instruction.type();
+
+        switch (type) {
+        case Instruction::Type::LoadImmediate:
+            accumulator = static_cast<Op::LoadImmediate&>(instruction).value();
+            if (!is_foldable_constant(*accumulator))
+                accumulator = {};
+            break;
+        case Instruction::Type::Load:
+            accumulator = known_register(static_cast<Op::Load&>(instruction).src());
+            if (accumulator.has_value()) {
+                replace_with_constant(instruction, *accumulator);
+                continue;
+            }
+            break;
+        case Instruction::Type::Store:
+            if (accumulator.has_value())
+                registers.set(static_cast<Op::Store&>(instruction).dst().index(), *accumulator);
+            else
+                registers.remove(static_cast<Op::Store&>(instruction).dst().index());
+            break;
+        case Instruction::Type::JumpConditional:
+        case Instruction::Type::JumpNullish:
+        case Instruction::Type::JumpUndefined:
+            if (accumulator.has_value()) {
+                auto& jump = static_cast<Op::Jump&>(instruction);
+                auto taken = fold_conditional_jump(type, *accumulator).value();
+                auto target = taken ? jump.true_target() : jump.false_target();
+                Instruction::destroy(instruction);
+                new (&instruction) Op::Jump(move(target));
+            }
+            break;
+        default:
+            if (is_binary_operation(type)) {
+                auto lhs = known_register(binary_operation_lhs(instruction));
+                Optional<Value> result;
+                if (lhs.has_value() && accumulator.has_value())
+                    result = fold_binary_operation(type, *lhs, *accumulator);
+                if (result.has_value()) {
+                    replace_with_constant(instruction, *result);
+                    continue;
+                }
+            } else if (accumulator.has_value()) {
+                if (auto result = fold_unary_operation(type, *accumulator); result.has_value()) {
+                    replace_with_constant(instruction, *result);
+                    continue;
+                }
+            }
+
+            if (instruction.writes_accumulator())
+                accumulator = {};
+            instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+                if (access != Instruction::RegisterAccess::Read)
+                    registers.remove(reg.index());
+            });
+            break;
+        }
+
+        new_block->append_moved_instruction(instruction);
+    }
+
+    block.take_instruction_stream_from(*new_block);
+}
+
+void ConstantFolding::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks)
+        fold_block(block);
+
+    finished();
+}
+
+}
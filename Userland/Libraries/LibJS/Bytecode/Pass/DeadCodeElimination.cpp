@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void DeadCodeElimination::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.cfg.has_value());
+    auto& cfg = *executable.cfg;
+
+    // NOTE: The CFG includes the ways into handlers, finalizers and generator continuations, so they count as reachable.
+    HashTable<BasicBlock const*> reachable_blocks;
+    Vector<BasicBlock const*> blocks_to_visit { &executable.executable.basic_blocks.first() };
+    while (!blocks_to_visit.is_empty()) {
+        auto* block = blocks_to_visit.take_last();
+        if (reachable_blocks.set(block) != AK::HashSetResult::InsertedNewEntry)
+            continue;
+        for (auto* successor : cfg.get(block).value_or({}))
+            blocks_to_visit.append(successor);
+    }
+
+    executable.executable.basic_blocks.remove_all_matching([&](auto& block) { return !reachable_blocks.contains(block.ptr()); });
+
+    // The blocks we removed may still be in the CFG, so it has to be generated again before anyone else looks at it.
+    executable.cfg.clear();
+    executable.inverted_cfg.clear();
+
+    finished();
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Pass/Liveness.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Instructions that do nothing but produce a value (and maybe allocate an object for it), so they can go if nobody looks at that value.
+static bool only_produces_a_value(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::Load:
+    case Instruction::Type::LoadImmediate:
+    case Instruction::Type::Store:
+    case Instruction::Type::NewString:
+    case Instruction::Type::NewObject:
+    case Instruction::Type::NewArray:
+    case Instruction::Type::NewBigInt:
+    case Instruction::Type::NewFunction:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool is_dead(Instruction const& instruction, RegisterSet const& live_after)
+{
+    if (!only_produces_a_value(instruction))
+        return false;
+    if (instruction.type() == Instruction::Type::Store)
+        return !live_after.contains(static_cast<Op::Store const&>(instruction).dst().index());
+    return !live_after.contains(Register::accumulator_index);
+}
+
+// Returns whether anything was removed.
+static bool remove_dead_instructions(BasicBlock& block, RegisterSet live)
+{
+    auto instructions = Liveness::instructions(block);
+    Vector<bool> is_instruction_dead;
+    is_instruction_dead.resize(instructions.size());
+    bool found_dead_instructions = false;
+    for (size_t i = instructions.size(); i-- > 0;) {
+        auto& instruction = *instructions[i];
+        if (is_dead(instruction, live)) {
+            is_instruction_dead[i] = true;
+            found_dead_instructions = true;
+            continue;
+        }
+        Liveness::step_backwards(instruction, live);
+    }
+
+    if (!found_dead_instructions)
+        return false;
+
+    auto new_block = BasicBlock::create(block.name(), block.size());
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        if (is_instruction_dead[i])
+            Instruction::destroy(*instructions[i]);
+        else
+            new_block->append_moved_instruction(*instructions[i]);
+    }
+    block.take_instruction_stream_from(*new_block);
+    return true;
+}
+
+void DeadStoreElimination::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    // Removing an instruction can make the ones that computed its input dead as well, in this block or in another one.
+    for (bool changed = true; changed;) {
+        auto liveness = Liveness::analyze(executable.executable);
+        if (!liveness.has_value())
+            break;
+        changed = false;
+        for (auto& block : executable.executable.basic_blocks)
+            changed |= remove_dead_instructions(block, liveness->live_at_end(block));
+    }
+
+    finished();
+}
+
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Pass/Liveness.h>
+#include <LibJS/Bytecode/Register.h>
+
+namespace JS::Bytecode {
+
+Vector<Instruction*> Liveness::instructions(BasicBlock const& block)
+{
+    Vector<Instruction*> instructions;
+    InstructionStreamIterator it { block.instruction_stream() };
+    while (!it.at_end()) {
+        instructions.append(const_cast<Instruction*>(&*it));
+        ++it;
+    }
+    return instructions;
+}
+
+void Liveness::step_backwards(Instruction const& instruction, RegisterSet& live)
+{
+    auto& mutable_instruction = const_cast<Instruction&>(instruction);
+
+    // First whatever the instruction writes, then whatever it reads, so that an instruction that overwrites a register
+    // it has just read keeps it alive.
+    if (instruction.writes_accumulator())
+        live.remove(Register::accumulator_index);
+    mutable_instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+        if (access == Instruction::RegisterAccess::Write)
+            live.remove(reg.index());
+    });
+
+    if (instruction.reads_accumulator())
+        live.set(Register::accumulator_index);
+    mutable_instruction.visit_registers([&](Register& reg, Instruction::RegisterAccess access) {
+        if (access != Instruction::RegisterAccess::Write)
+            live.set(reg.index());
+    });
+}
+
+Optional<Liveness> Liveness::analyze(Executable const& executable)
+{
+    Liveness liveness;
+    auto block_count = executable.basic_blocks.size();
+    for (size_t i = 0; i < block_count; ++i)
+        liveness.m_block_indices.set(&executable.basic_blocks[i], i);
+
+    Vector<Vector<size_t>> successors;
+    successors.resize(block_count);
+    // Blocks that end without a terminator fall off the end of the executable, which hands the accumulator to the caller.
+    Vector<bool> exits_with_accumulator;
+    exits_with_accumulator.resize(block_count);
+
+    for (size_t i = 0; i < block_count; ++i) {
+        auto& block = executable.basic_blocks[i];
+        InstructionStreamIterator it { block.instruction_stream() };
+        Instruction const* last_instruction = nullptr;
+        while (!it.at_end()) {
+            auto& instruction = *it;
+            switch (instruction.type()) {
+            case Instruction::Type::EnterUnwindContext:
+            case Instruction::Type::LeaveUnwindContext:
+            case Instruction::Type::ContinuePendingUnwind:
+            case Instruction::Type::Yield:
+                return {};
+            default:
+                break;
+            }
+            last_instruction = &instruction;
+            ++it;
+        }
+
+        if (!last_instruction || !last_instruction->is_terminator()) {
+            exits_with_accumulator[i] = true;
+            continue;
+        }
+
+        switch (last_instruction->type()) {
+        case Instruction::Type::Jump:
+        case Instruction::Type::JumpConditional:
+        case Instruction::Type::JumpNullish:
+        case Instruction::Type::JumpUndefined: {
+            auto& jump = static_cast<Op::Jump const&>(*last_instruction);
+            for (auto& target : { jump.true_target(), jump.false_target() }) {
+                if (!target.has_value())
+                    continue;
+                auto index = liveness.m_block_indices.get(&target->block());
+                VERIFY(index.has_value());
+                successors[i].append(*index);
+            }
+            break;
+        }
+        case Instruction::Type::Return:
+        case Instruction::Type::Throw:
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    auto register_count = max(executable.number_of_registers, static_cast<size_t>(Register::global_object_index + 1));
+    for (size_t i = 0; i < block_count; ++i) {
+        liveness.m_live_at_start.empend(register_count);
+        liveness.m_live_at_end.empend(register_count);
+        if (exits_with_accumulator[i])
+            liveness.m_live_at_end[i].set(Register::accumulator_index);
+    }
+
+    // Registers only become live, never dead again, so this settles eventually.
+    // Going through the blocks back to front makes that happen sooner, since code mostly flows forward.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = block_count; i-- > 0;) {
+            auto& live_at_end = liveness.m_live_at_end[i];
+            for (auto successor : successors[i])
+                live_at_end.merge(liveness.m_live_at_start[successor]);
+
+            auto live = live_at_end;
+            auto block_instructions = instructions(executable.basic_blocks[i]);
+            for (size_t j = block_instructions.size(); j-- > 0;)
+                step_backwards(*block_instructions[j], live);
+            changed |= liveness.m_live_at_start[i].merge(live);
+        }
+    }
+
+    return liveness;
+}
+
+RegisterSet const& Liveness::live_at_end(BasicBlock const& block) const
+{
+    return m_live_at_end[*m_block_indices.get(&block)];
+}
+
+RegisterSet const& Liveness::live_at_start(BasicBlock const& block) const
+{
+    return m_live_at_start[*m_block_indices.get(&block)];
+}
+
+}
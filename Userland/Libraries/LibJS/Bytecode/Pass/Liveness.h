@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Instruction.h>
+
+namespace JS::Bytecode {
+
+// A set of registers, indexed the same way as the register window (so the accumulator is register 0).
+class RegisterSet {
+public:
+    explicit RegisterSet(size_t register_count)
+    {
+        m_words.resize((register_count + 63) / 64);
+    }
+
+    bool contains(u32 index) const { return m_words[index / 64] & (1ull << (index % 64)); }
+    void set(u32 index) { m_words[index / 64] |= 1ull << (index % 64); }
+    void remove(u32 index) { m_words[index / 64] &= ~(1ull << (index % 64)); }
+
+    // Returns whether anything was added.
+    bool merge(RegisterSet const& other)
+    {
+        bool changed = false;
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            auto merged = m_words[i] | other.m_words[i];
+            changed |= merged != m_words[i];
+            m_words[i] = merged;
+        }
+        return changed;
+    }
+
+    template<typename Callback>
+    void for_each(Callback callback) const
+    {
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            for (auto word = m_words[i]; word; word &= word - 1)
+                callback(static_cast<u32>(i * 64 + __builtin_ctzll(word)));
+        }
+    }
+
+private:
+    Vector<u64> m_words;
+};
+
+// Which registers hold a value that may still be read later on, at the end of every block of an executable.
+class Liveness {
+public:
+    // Returns nothing for executables with control flow that we can't follow registers through, i.e. generators (whose
+    // registers live on across a yield) and anything with an unwind context (where an exception may leave any instruction).
+    static Optional<Liveness> analyze(Executable const&);
+
+    RegisterSet const& live_at_end(BasicBlock const&) const;
+    RegisterSet const& live_at_start(BasicBlock const&) const;
+
+    // Turns the registers that are live right after the instruction into the ones that are live right before it.
+    static void step_backwards(Instruction const&, RegisterSet&);
+
+    static Vector<Instruction*> instructions(BasicBlock const&);
+
+private:
+    Liveness() = default;
+
+    HashMap<BasicBlock const*, size_t> m_block_indices;
+    Vector<RegisterSet> m_live_at_start;
+    Vector<RegisterSet> m_live_at_end;
+};
+
+}
@@ -21,6 +21,7 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
     HashTable<BasicBlock const*> blocks_to_merge;
     HashMap<BasicBlock const*, BasicBlock const*> blocks_to_replace;
     Vector<BasicBlock const*> blocks_to_remove;
+    HashTable<BasicBlock const*> merged_blocks;
     Vector<size_t> boundaries;
 
     for (auto& entry : cfg) {
@@ -103,6 +104,9 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
             if (!entry.has_value())
                 break;
             auto& successor = *entry->begin();
+            // An earlier merge may have taken the successor already, in which case we keep jumping to where it went.
+            if (merged_blocks.contains(successor))
+                break;
             successors.append(successor);
             auto it = blocks_to_merge.find(successor);
             if (it == blocks_to_merge.end())
@@ -124,6 +128,9 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
 
         blocks_to_merge = move(blocks_to_merge_copy);
 
+        for (auto& entry : successors)
+            merged_blocks.set(entry);
+
         size_t size = 0;
         StringBuilder builder;
         builder.append("merge");
@@ -150,9 +157,19 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
             }
             __builtin_memcpy(block.next_slot(), entry->instruction_stream().data(), copy_end);
             block.grow(copy_end);
+            // The instructions live on in the merged block now, so the old one mustn't destroy them when it goes away.
+            const_cast<BasicBlock&>(*entry).take_instruction_stream_from(*BasicBlock::create({}, 0));
         }
 
         auto first_successor_position = replace_blocks(successors, *new_block);
+        // A loop may jump back into one of the blocks we merged, which are gone now.
+        InstructionStreamIterator merged_block_it { block.instruction_stream() };
+        while (!merged_block_it.at_end()) {
+            auto& instruction = *merged_block_it;
+            ++merged_block_it;
+            for (auto& entry : successors)
+                const_cast<Instruction&>(instruction).replace_references(*entry, block);
+        }
         VERIFY(first_successor_position.has_value());
         executable.executable.basic_blocks.insert(*first_successor_position, move(new_block));
     }
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// What taking one way out of a conditional jump tells us about the accumulator.
+struct KnownCondition {
+    Optional<bool> is_truthy;
+    Optional<bool> is_nullish;
+    Optional<bool> is_undefined;
+};
+
+static KnownCondition condition_after_jump(Instruction::Type type, bool taken)
+{
+    switch (type) {
+    case Instruction::Type::JumpConditional:
+        return { taken, {}, {} };
+    case Instruction::Type::JumpNullish:
+        if (taken)
+            return { false, true, {} };
+        return { {}, false, false };
+    case Instruction::Type::JumpUndefined:
+        if (taken)
+            return { false, true, true };
+        return { {}, {}, false };
+    default:
+        return {};
+    }
+}
+
+static Optional<bool> outcome_of_jump(Instruction::Type type, KnownCondition const& condition)
+{
+    switch (type) {
+    case Instruction::Type::JumpConditional:
+        return condition.is_truthy;
+    case Instruction::Type::JumpNullish:
+        return condition.is_nullish;
+    case Instruction::Type::JumpUndefined:
+        return condition.is_undefined;
+    default:
+        return {};
+    }
+}
+
+// Follows the target through blocks that do nothing but jump on, as long as we know which way they go.
+static Label thread_target(Label target, Optional<KnownCondition> const& condition)
+{
+    // Give up eventually, we might be going around in circles.
+    for (size_t hops = 0; hops < 16; ++hops) {
+        InstructionStreamIterator it { target.block().instruction_stream() };
+        if (it.at_end())
+            break;
+        auto& instruction = *it;
+        if (!instruction.is_terminator())
+            break;
+
+        auto type = instruction.type();
+        auto& jump = static_cast<Op::Jump const&>(instruction);
+        if (type == Instruction::Type::Jump) {
+            target = *jump.true_target();
+            continue;
+        }
+        if (!condition.has_value())
+            break;
+        auto outcome = outcome_of_jump(type, *condition);
+        if (!outcome.has_value())
+            break;
+        target = *outcome ? *jump.true_target() : *jump.false_target();
+    }
+    return target;
+}
+
+void ThreadJumps::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        InstructionStreamIterator it { block.instruction_stream() };
+        Instruction* last_instruction = nullptr;
+        while (!it.at_end()) {
+            last_instruction = const_cast<Instruction*>(&*it);
+            ++it;
+        }
+        if (!last_instruction)
+            continue;
+
+        auto type = last_instruction->type();
+        if (type != Instruction::Type::Jump && type != Instruction::Type::JumpConditional && type != Instruction::Type::JumpNullish && type != Instruction::Type::JumpUndefined)
+            continue;
+
+        auto& jump = static_cast<Op::Jump&>(*last_instruction);
+        if (type == Instruction::Type::Jump) {
+            jump.set_targets(thread_target(*jump.true_target(), {}), {});
+            continue;
+        }
+        jump.set_targets(
+            thread_target(*jump.true_target(), condition_after_jump(type, true)),
+            thread_target(*jump.false_target(), condition_after_jump(type, false)));
+    }
+
+    finished();
+}
+
+}
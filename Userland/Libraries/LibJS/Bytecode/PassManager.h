@@ -13,6 +13,9 @@
 
 namespace JS::Bytecode {
 
+// Dump the executable before the first and after every single pass of a pipeline.
+extern bool g_dump_passes;
+
 struct PassPipelineExecutable {
     Executable& executable;
     Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> cfg {};
@@ -26,6 +29,8 @@ public:
     virtual ~Pass() = default;
 
     virtual void perform(PassPipelineExecutable&) = 0;
+    virtual StringView name() const = 0;
+
     void started()
     {
         gettimeofday(&m_start_time, nullptr);
@@ -74,11 +79,22 @@ public:
     virtual void perform(PassPipelineExecutable& executable) override
     {
         started();
-        for (auto& pass : m_passes)
+        if (g_dump_passes) {
+            warnln("\033[33;1mBefore optimization:\033[0m");
+            executable.executable.dump();
+        }
+        for (auto& pass : m_passes) {
             pass.perform(executable);
+            if (g_dump_passes) {
+                warnln("\033[33;1mAfter {}:\033[0m", pass.name());
+                executable.executable.dump();
+            }
+        }
         finished();
     }
 
+    virtual StringView name() const override { return "PassManager"sv; }
+
 private:
     NonnullOwnPtrVector<Pass> m_passes;
 };
@@ -92,6 +108,7 @@ public:
 
 private:
     virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "GenerateCFG"sv; }
 };
 
 class MergeBlocks : public Pass {
@@ -101,6 +118,7 @@ public:
 
 private:
     virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "MergeBlocks"sv; }
 };
 
 class PlaceBlocks : public Pass {
@@ -110,6 +128,7 @@ public:
 
 private:
     virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "PlaceBlocks"sv; }
 };
 
 class UnifySameBlocks : public Pass {
@@ -119,6 +138,62 @@ public:
 
 private:
     virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "UnifySameBlocks"sv; }
+};
+
+// Evaluates arithmetic on numbers and conditional jumps whose operands are known constants, within each block.
+class ConstantFolding : public Pass {
+public:
+    ConstantFolding() = default;
+    ~ConstantFolding() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "ConstantFolding"sv; }
+};
+
+// Sends jumps straight to where a jump they land on would go, if we already know which way it will go.
+class ThreadJumps : public Pass {
+public:
+    ThreadJumps() = default;
+    ~ThreadJumps() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "ThreadJumps"sv; }
+};
+
+// Removes the blocks that can't be reached from the entry block. Needs the CFG.
+class DeadCodeElimination : public Pass {
+public:
+    DeadCodeElimination() = default;
+    ~DeadCodeElimination() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "DeadCodeElimination"sv; }
+};
+
+// Removes loads and stores of values that are never read.
+class DeadStoreElimination : public Pass {
+public:
+    DeadStoreElimination() = default;
+    ~DeadStoreElimination() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "DeadStoreElimination"sv; }
+};
+
+// Reuses registers whose values are no longer needed, to keep the register window small.
+class AllocateRegisters : public Pass {
+public:
+    AllocateRegisters() = default;
+    ~AllocateRegisters() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "AllocateRegisters"sv; }
 };
 
 class DumpCFG : public Pass {
@@ -132,6 +207,7 @@ public:
 
 private:
     virtual void perform(PassPipelineExecutable&) override;
+    virtual StringView name() const override { return "DumpCFG"sv; }
 
     FILE* m_file { nullptr };
 };
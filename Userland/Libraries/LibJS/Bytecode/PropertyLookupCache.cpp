@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PropertyLookupCache.h>
+#include <LibJS/Runtime/Object.h>
+
+namespace JS::Bytecode {
+
+// Array has a "length" property that isn't in its shape, and arrays can share shapes with ordinary objects.
+// So if we didn't find "length" in the shape, that doesn't mean that the object doesn't have one.
+static bool is_length(StringOrSymbol const& property_name)
+{
+    return property_name.is_string() && property_name.as_string() == "length"sv;
+}
+
+Object* PropertyLookupCache::walk_prototype_chain(Entry const& entry, Object& object)
+{
+    // A shape knows its prototype, so if all the shapes still match, it's still the same chain of objects.
+    auto* current = &object;
+    for (auto& prototype_shape : entry.prototype_shapes) {
+        current = current->shape().prototype();
+        if (!current || &current->shape() != prototype_shape.ptr())
+            return nullptr;
+    }
+    return current;
+}
+
+bool PropertyLookupCache::record_prototype_chain(Entry& entry, Object& object, StringOrSymbol const& property_name, Object*& holder, PropertyMetadata& holder_metadata)
+{
+    holder = nullptr;
+    for (auto* prototype = object.shape().prototype(); prototype; prototype = prototype->shape().prototype()) {
+        if (entry.prototype_shapes.size() == max_prototype_chain_length)
+            return false;
+        auto& shape = prototype->shape();
+        // Unique shapes are changed in place when properties are added or removed, so matching them doesn't tell us anything.
+        if (!prototype->has_cacheable_property_lookups() || shape.is_unique())
+            return false;
+        entry.prototype_shapes.append(shape.make_weak_ptr());
+        if (auto metadata = shape.lookup(property_name); metadata.has_value()) {
+            holder = prototype;
+            holder_metadata = metadata.value();
+            return true;
+        }
+    }
+    return true;
+}
+
+PropertyLookupCache::Entry& PropertyLookupCache::entry_to_fill()
+{
+    auto& entry = m_entries[m_next_entry_to_replace];
+    m_next_entry_to_replace = (m_next_entry_to_replace + 1) % max_entries;
+    return entry;
+}
+
+Optional<Value> PropertyLookupCache::get(Object& object) const
+{
+    if (!object.has_cacheable_property_lookups())
+        return {};
+    auto& shape = object.shape();
+    for (auto& entry : m_entries) {
+        if (entry.shape.ptr() != &shape)
+            continue;
+        Object* holder = &object;
+        if (entry.kind == Kind::Prototype)
+            holder = walk_prototype_chain(entry, object);
+        else if (entry.kind != Kind::Own)
+            holder = nullptr;
+        if (!holder)
+            continue;
+        auto value = holder->get_direct(entry.property_offset);
+        // Redefining a data property as an accessor with the same attributes doesn't change the shape.
+        if (value.is_accessor())
+            return {};
+        return value.value_or(js_undefined());
+    }
+    return {};
+}
+
+void PropertyLookupCache::fill_after_get(Object& object, StringOrSymbol const& property_name)
+{
+    auto& shape = object.shape();
+    if (!object.has_cacheable_property_lookups() || shape.is_unique())
+        return;
+
+    Entry entry;
+    entry.shape = shape.make_weak_ptr();
+    if (auto metadata = shape.lookup(property_name); metadata.has_value()) {
+        if (object.get_direct(metadata->offset).is_accessor())
+            return;
+        entry.kind = Kind::Own;
+        entry.property_offset = metadata->offset;
+    } else {
+        if (is_length(property_name))
+            return;
+        Object* holder = nullptr;
+        PropertyMetadata holder_metadata;
+        if (!record_prototype_chain(entry, object, property_name, holder, holder_metadata) || !holder)
+            return;
+        if (holder->get_direct(holder_metadata.offset).is_accessor())
+            return;
+        entry.kind = Kind::Prototype;
+        entry.property_offset = holder_metadata.offset;
+    }
+    entry_to_fill() = move(entry);
+}
+
+bool PropertyLookupCache::put(Object& object, Value value) const
+{
+    if (!object.has_cacheable_property_lookups())
+        return false;
+    auto& shape = object.shape();
+    for (auto& entry : m_entries) {
+        if (entry.shape.ptr() != &shape)
+            continue;
+        if (entry.kind == Kind::Own) {
+            if (object.get_direct(entry.property_offset).is_accessor())
+                return false;
+            object.put_direct(entry.property_offset, value);
+            return true;
+        }
+        if (entry.kind != Kind::AddProperty)
+            continue;
+        auto* new_shape = entry.new_shape.ptr();
+        if (!new_shape || !walk_prototype_chain(entry, object))
+            continue;
+        // Preventing extensions doesn't change the shape, so we have to ask every time.
+        if (!MUST(object.is_extensible()))
+            return false;
+        object.append_direct_with_transition(*new_shape, value);
+        return true;
+    }
+    return false;
+}
+
+void PropertyLookupCache::fill_after_put(Object& object, Shape& shape_before_put, StringOrSymbol const& property_name)
+{
+    auto& shape = object.shape();
+    if (!object.has_cacheable_property_lookups() || shape.is_unique() || shape_before_put.is_unique())
+        return;
+
+    Entry entry;
+    entry.shape = shape_before_put.make_weak_ptr();
+    if (&shape == &shape_before_put) {
+        auto metadata = shape.lookup(property_name);
+        if (!metadata.has_value() || !metadata->attributes.is_writable() || object.get_direct(metadata->offset).is_accessor())
+            return;
+        entry.kind = Kind::Own;
+        entry.property_offset = metadata->offset;
+        entry_to_fill() = move(entry);
+        return;
+    }
+
+    // Otherwise, we only cache the put if it added a new property, the same way it would for any other object with the old shape.
+    if (is_length(property_name))
+        return;
+    if (shape.prototype() != shape_before_put.prototype() || shape.property_count() != shape_before_put.property_count() + 1)
+        return;
+    auto metadata = shape.lookup(property_name);
+    if (!metadata.has_value() || metadata->offset != shape_before_put.property_count() || !(metadata->attributes == default_attributes))
+        return;
+    if (shape_before_put.create_put_transition(property_name, default_attributes) != &shape)
+        return;
+
+    Object* holder = nullptr;
+    PropertyMetadata holder_metadata;
+    if (!record_prototype_chain(entry, object, property_name, holder, holder_metadata) || holder)
+        return;
+    entry.kind = Kind::AddProperty;
+    entry.new_shape = shape.make_weak_ptr();
+    entry.property_offset = metadata->offset;
+    entry_to_fill() = move(entry);
+}
+
+}
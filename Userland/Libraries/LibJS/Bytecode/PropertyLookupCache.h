@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <AK/WeakPtr.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/StringOrSymbol.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode {
+
+// An inline cache for a single GetById or PutById instruction.
+// It remembers where the property was found for the last few shapes the instruction has seen, so that the next time
+// an object with one of those shapes comes along, we can go straight to the right storage slot instead of looking
+// the property up again.
+class PropertyLookupCache {
+public:
+    // How many different shapes a single instruction can remember, before it starts forgetting the oldest ones.
+    static constexpr size_t max_entries = 4;
+
+    // Properties that are further up the prototype chain than this aren't worth checking every hop for.
+    static constexpr size_t max_prototype_chain_length = 4;
+
+    Optional<Value> get(Object&) const;
+    void fill_after_get(Object&, StringOrSymbol const&);
+
+    // Returns false if the object isn't in the cache, in which case the caller has to do a regular [[Set]].
+    bool put(Object&, Value) const;
+    void fill_after_put(Object&, Shape& shape_before_put, StringOrSymbol const&);
+
+private:
+    enum class Kind : u8 {
+        Invalid,
+        // The property is an own data property of the object.
+        Own,
+        // The property is a data property of an object on the prototype chain (only used by GetById).
+        Prototype,
+        // The property doesn't exist anywhere on the prototype chain, and putting it adds it to the object (only used by PutById).
+        AddProperty,
+    };
+
+    struct Entry {
+        Kind kind { Kind::Invalid };
+        WeakPtr<Shape> shape;
+        // The shapes of the objects on the prototype chain that we had to look at, in order.
+        // For a Prototype entry, the last one of these holds the property.
+        Vector<WeakPtr<Shape>, 1> prototype_shapes;
+        // For AddProperty, the shape the object transitions to once the property has been added.
+        WeakPtr<Shape> new_shape;
+        u32 property_offset { 0 };
+    };
+
+    static Object* walk_prototype_chain(Entry const&, Object&);
+    static bool record_prototype_chain(Entry&, Object&, StringOrSymbol const&, Object*& holder, PropertyMetadata& holder_metadata);
+    Entry& entry_to_fill();
+
+    AK::Array<Entry, max_entries> m_entries;
+    u8 m_next_entry_to_replace { 0 };
+};
+
+}
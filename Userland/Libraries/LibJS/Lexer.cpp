@@ -828,6 +828,35 @@ Token Lexer::next()
     return m_current_token;
 }
 
+Token Lexer::skip_to_closing_curly(size_t position, size_t line_number, size_t line_column)
+{
+    VERIFY(m_current_token.type() == TokenType::CurlyOpen);
+    VERIFY(position + 1 >= m_position && position < m_source.length() && m_source[position] == '}');
+
+    // Anything between the curlies is balanced, so the only bracket we have to account for is the one we skip to.
+    if (!m_template_states.is_empty() && m_template_states.last().in_expr)
+        m_template_states.last().open_bracket_count--;
+
+    m_position = position + 1;
+    m_current_char = '}';
+    m_line_number = line_number;
+    m_line_column = line_column;
+    m_regex_is_in_character_class = false;
+    m_eof = false;
+    consume();
+
+    m_current_token = Token(
+        TokenType::CurlyClose,
+        "",
+        m_source.substring_view(position, 0),
+        m_source.substring_view(position, 1),
+        m_filename,
+        line_number,
+        line_column,
+        m_position);
+    return m_current_token;
+}
+
 Token Lexer::force_slash_as_regex()
 {
     VERIFY(m_current_token.type() == TokenType::Slash || m_current_token.type() == TokenType::SlashEquals);
@@ -27,6 +27,9 @@ public:
 
     Token force_slash_as_regex();
 
+    // Continues after the '}' at `position` that closes the '{' we just lexed, as if everything in between had been lexed too.
+    Token skip_to_closing_curly(size_t position, size_t line_number, size_t line_column);
+
 private:
     void consume();
     bool consume_exponent();
@@ -724,10 +724,12 @@ RefPtr<FunctionExpression> Parser::try_parse_arrow_function_expression(bool expe
         }
     }
 
-    return create_ast_node<FunctionExpression>(
+    auto function_node = create_ast_node<FunctionExpression>(
         { m_state.current_token.filename(), rule_start.position(), position() }, "", move(body),
         move(parameters), function_length, FunctionKind::Regular, body->in_strict_mode(),
         /* might_need_arguments_object */ false, contains_direct_call_to_eval, /* is_arrow_function */ true);
+    record_function_node(rule_start.position(), function_node);
+    return function_node;
 }
 
 RefPtr<Statement> Parser::try_parse_labelled_statement(AllowLabelledFunction allow_function)
@@ -2091,62 +2093,187 @@ NonnullRefPtr<FunctionBody> Parser::parse_function_body(Vector<FunctionDeclarati
 {
     auto rule_start = push_start();
     auto function_body = create_ast_node<FunctionBody>({ m_state.current_token.filename(), rule_start.position(), position() });
+    parse_function_body_statements(function_body, parameters, function_kind, contains_direct_call_to_eval);
+    consume(TokenType::CurlyClose);
+    return function_body;
+}
+
+// NOTE: This stops at the closing curly brace, and leaves consuming it to the caller.
+void Parser::parse_function_body_statements(FunctionBody& function_body, Vector<FunctionDeclaration::Parameter> const& parameters, FunctionKind function_kind, bool& contains_direct_call_to_eval)
+{
     ScopePusher function_scope = ScopePusher::function_scope(*this, function_body, parameters); // FIXME <-
     consume(TokenType::CurlyOpen);
     auto has_use_strict = parse_directive(function_body);
     bool previous_strict_mode = m_state.strict_mode;
     if (has_use_strict) {
         m_state.strict_mode = true;
-        function_body->set_strict_mode();
+        function_body.set_strict_mode();
         if (!is_simple_parameter_list(parameters))
             syntax_error("Illegal 'use strict' directive in function with non-simple parameter list");
     } else if (previous_strict_mode) {
-        function_body->set_strict_mode();
+        function_body.set_strict_mode();
     }
 
     parse_statement_list(function_body);
 
     // If the function contains 'use strict' we need to check the parameters (again).
-    if (function_body->in_strict_mode() || function_kind != FunctionKind::Regular) {
-        Vector<StringView> parameter_names;
-        for (auto& parameter : parameters) {
-            parameter.binding.visit(
-                [&](FlyString const& parameter_name) {
-                    check_identifier_name_for_assignment_validity(parameter_name, function_body->in_strict_mode());
-                    if (function_kind == FunctionKind::Generator && parameter_name == "yield"sv)
+    check_parameter_names(parameters, function_kind, function_body.in_strict_mode());
+
+    m_state.strict_mode = previous_strict_mode;
+    contains_direct_call_to_eval = function_scope.contains_direct_call_to_eval();
+}
+
+void Parser::check_parameter_names(Vector<FunctionDeclaration::Parameter> const& parameters, FunctionKind function_kind, bool in_strict_mode)
+{
+    if (!in_strict_mode && function_kind == FunctionKind::Regular)
+        return;
+
+    Vector<StringView> parameter_names;
+    for (auto& parameter : parameters) {
+        parameter.binding.visit(
+            [&](FlyString const& parameter_name) {
+                check_identifier_name_for_assignment_validity(parameter_name, in_strict_mode);
+                if (function_kind == FunctionKind::Generator && parameter_name == "yield"sv)
+                    syntax_error("Parameter name 'yield' not allowed in this context");
+
+                for (auto& previous_name : parameter_names) {
+                    if (previous_name == parameter_name) {
+                        syntax_error(String::formatted("Duplicate parameter '{}' not allowed in strict mode", parameter_name));
+                    }
+                }
+
+                parameter_names.append(parameter_name);
+            },
+            [&](NonnullRefPtr<BindingPattern> const& binding) {
+                binding->for_each_bound_name([&](auto& bound_name) {
+                    if (function_kind == FunctionKind::Generator && bound_name == "yield"sv)
                         syntax_error("Parameter name 'yield' not allowed in this context");
 
                     for (auto& previous_name : parameter_names) {
-                        if (previous_name == parameter_name) {
-                            syntax_error(String::formatted("Duplicate parameter '{}' not allowed in strict mode", parameter_name));
+                        if (previous_name == bound_name) {
+                            syntax_error(String::formatted("Duplicate parameter '{}' not allowed in strict mode", bound_name));
+                            break;
                         }
                     }
-
-                    parameter_names.append(parameter_name);
-                },
-                [&](NonnullRefPtr<BindingPattern> const& binding) {
-                    binding->for_each_bound_name([&](auto& bound_name) {
-                        if (function_kind == FunctionKind::Generator && bound_name == "yield"sv)
-                            syntax_error("Parameter name 'yield' not allowed in this context");
-
-                        for (auto& previous_name : parameter_names) {
-                            if (previous_name == bound_name) {
-                                syntax_error(String::formatted("Duplicate parameter '{}' not allowed in strict mode", bound_name));
-                                break;
-                            }
-                        }
-                        parameter_names.append(bound_name);
-                    });
+                    parameter_names.append(bound_name);
                 });
-        }
+            });
+    }
+}
+
+bool Parser::can_skip_function_body(u8 parse_options) const
+{
+    if (!m_skip_function_bodies)
+        return false;
+    // Methods and functions in class bodies and parameter lists depend on more of the surrounding context than we keep around for later.
+    if (!(parse_options & FunctionNodeParseOptions::CheckForFunctionAndName))
+        return false;
+    if (parse_options & (FunctionNodeParseOptions::AllowSuperPropertyLookup | FunctionNodeParseOptions::AllowSuperConstructorCall))
+        return false;
+    return !m_state.referenced_private_names && !m_state.in_formal_parameter_context;
+}
+
+size_t Parser::source_offset_of(Token const& token) const
+{
+    auto* source_start = m_state.lexer.source().characters_without_null_termination();
+    return m_source_text_offset + (token.value().characters_without_null_termination() - source_start);
+}
+
+void Parser::record_function_node(Position const& start, NonnullRefPtr<ASTNode> function_node)
+{
+    if (m_skip_function_bodies)
+        m_function_nodes.set(start.offset, move(function_node));
+}
+
+NonnullRefPtr<FunctionBody> Parser::skip_function_body(Vector<FunctionDeclaration::Parameter> const& parameters, FunctionKind function_kind, bool& contains_direct_call_to_eval)
+{
+    auto start_offset = source_offset_of(m_state.current_token);
+
+    // Bodies nested in one we checked were checked along with it, so when we come back to parse that one for real, we jump over them.
+    if (auto it = m_checked_function_bodies.find(start_offset); it != m_checked_function_bodies.end()) {
+        auto function_body = it->value;
+        auto& skipped_source = *function_body->skipped_source();
+        contains_direct_call_to_eval = skipped_source.contains_direct_call_to_eval;
+        if (skipped_source.might_need_arguments_object)
+            m_state.function_might_need_arguments_object = true;
+        m_state.current_token = m_state.lexer.skip_to_closing_curly(skipped_source.end_offset - 1 - m_source_text_offset, skipped_source.end_line_number, skipped_source.end_line_column);
+        consume(TokenType::CurlyClose);
+        return function_body;
     }
 
+    auto rule_start = push_start();
+    auto function_body = create_ast_node<FunctionBody>({ m_state.current_token.filename(), rule_start.position(), position() });
+
+    if (m_source_text.is_null())
+        m_source_text = m_state.lexer.source();
+
+    FunctionBody::SkippedSource skipped_source;
+    skipped_source.source = m_source_text;
+    skipped_source.filename = m_state.lexer.filename();
+    skipped_source.start_offset = start_offset;
+    skipped_source.line_number = m_state.current_token.line_number();
+    skipped_source.line_column = m_state.current_token.line_column();
+    skipped_source.kind = function_kind;
+    skipped_source.program_type = m_program_type;
+
+    // Early errors have to be reported before any of the script runs, no matter when the function is called, so the body
+    // is parsed all the same. We just don't keep what we parsed. Functions nested in it are skipped in turn, and we keep
+    // those around so parsing this body later doesn't check them again. That way every body is parsed at most twice:
+    // once up front, and once more if the function is ever called.
+    {
+        auto parsed_body = create_ast_node<FunctionBody>({ m_state.current_token.filename(), rule_start.position(), position() });
+        auto function_nodes = move(m_function_nodes);
+        auto checked_function_bodies = move(m_checked_function_bodies);
+        parse_function_body_statements(parsed_body, parameters, function_kind, contains_direct_call_to_eval);
+        skipped_source.checked_function_bodies = move(m_checked_function_bodies);
+        m_checked_function_bodies = move(checked_function_bodies);
+        m_function_nodes = move(function_nodes);
+        if (parsed_body->in_strict_mode())
+            function_body->set_strict_mode();
+    }
+
+    if (match(TokenType::CurlyClose)) {
+        skipped_source.end_offset = source_offset_of(m_state.current_token) + 1;
+        skipped_source.end_line_number = m_state.current_token.line_number();
+        skipped_source.end_line_column = m_state.current_token.line_column();
+    }
     consume(TokenType::CurlyClose);
-    m_state.strict_mode = previous_strict_mode;
-    contains_direct_call_to_eval = function_scope.contains_direct_call_to_eval();
+
+    skipped_source.contains_direct_call_to_eval = contains_direct_call_to_eval;
+    skipped_source.might_need_arguments_object = m_state.function_might_need_arguments_object;
+    function_body->set_skipped_source(move(skipped_source));
+    if (!has_errors())
+        m_checked_function_bodies.set(start_offset, function_body);
     return function_body;
 }
 
+void Parser::parse_skipped_function_body(FunctionBody const& function_body, Vector<FunctionNode::Parameter> const& parameters)
+{
+    VERIFY(function_body.needs_parsing());
+    auto& skipped_source = *function_body.skipped_source();
+
+    // NOTE: The lexer counts the column of the first character it sees as the one after what we pass in here.
+    Lexer lexer { skipped_source.source.substring_view(skipped_source.start_offset), skipped_source.filename, skipped_source.line_number, skipped_source.line_column - 1 };
+    Parser parser { move(lexer), skipped_source.program_type };
+    parser.m_skip_function_bodies = true;
+    parser.m_source_text = skipped_source.source;
+    parser.m_source_text_offset = skipped_source.start_offset;
+    parser.m_state.strict_mode = function_body.in_strict_mode();
+    parser.m_state.in_function_context = true;
+    parser.m_state.in_generator_function_context = skipped_source.kind == FunctionKind::Generator;
+
+    // NOTE: Every function object created from this body shares it, so we fill it in rather than making a new one.
+    auto& body = const_cast<FunctionBody&>(function_body);
+    parser.m_checked_function_bodies = body.take_checked_function_bodies();
+    bool contains_direct_call_to_eval = false;
+    parser.parse_function_body_statements(body, parameters, skipped_source.kind, contains_direct_call_to_eval);
+
+    String syntax_error;
+    if (parser.has_errors())
+        syntax_error = parser.errors().first().to_string();
+    body.did_parse_skipped_source(move(syntax_error), move(parser.m_function_nodes));
+}
+
 NonnullRefPtr<BlockStatement> Parser::parse_block_statement()
 {
     auto rule_start = push_start();
@@ -2210,18 +2337,22 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
     });
 
     bool contains_direct_call_to_eval = false;
-    auto body = parse_function_body(parameters, function_kind, contains_direct_call_to_eval);
+    auto body = can_skip_function_body(parse_options)
+        ? skip_function_body(parameters, function_kind, contains_direct_call_to_eval)
+        : parse_function_body(parameters, function_kind, contains_direct_call_to_eval);
 
     auto has_strict_directive = body->in_strict_mode();
 
     if (has_strict_directive)
         check_identifier_name_for_assignment_validity(name, true);
 
-    return create_ast_node<FunctionNodeType>(
+    auto function_node = create_ast_node<FunctionNodeType>(
         { m_state.current_token.filename(), rule_start.position(), position() },
         name, move(body), move(parameters), function_length,
         function_kind, has_strict_directive, m_state.function_might_need_arguments_object,
         contains_direct_call_to_eval);
+    record_function_node(rule_start.position(), function_node);
+    return function_node;
 }
 
 Vector<FunctionNode::Parameter> Parser::parse_formal_parameters(int& function_length, u8 parse_options)
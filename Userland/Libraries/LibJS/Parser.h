@@ -42,6 +42,14 @@ public:
 
     NonnullRefPtr<Program> parse_program(bool starts_in_strict_mode = false);
 
+    // Check function bodies for syntax errors up front, but throw away what we parsed, and only keep the AST and bytecode
+    // of a function around once it's first called.
+    void set_skip_function_bodies(bool skip_function_bodies) { m_skip_function_bodies = skip_function_bodies; }
+    static void parse_skipped_function_body(FunctionBody const&, Vector<FunctionNode::Parameter> const&);
+
+    // NOTE: These are only recorded while skipping function bodies.
+    FunctionNodesByOffset const& function_nodes() const { return m_function_nodes; }
+
     template<typename FunctionNodeType>
     NonnullRefPtr<FunctionNodeType> parse_function_node(u8 parse_options = FunctionNodeParseOptions::CheckForFunctionAndName);
     Vector<FunctionNode::Parameter> parse_formal_parameters(int& function_length, u8 parse_options = 0);
@@ -73,6 +81,8 @@ public:
     NonnullRefPtr<Statement> parse_statement(AllowLabelledFunction allow_labelled_function = AllowLabelledFunction::No);
     NonnullRefPtr<BlockStatement> parse_block_statement();
     NonnullRefPtr<FunctionBody> parse_function_body(Vector<FunctionDeclaration::Parameter> const& parameters, FunctionKind function_kind, bool& contains_direct_call_to_eval);
+    void parse_function_body_statements(FunctionBody&, Vector<FunctionDeclaration::Parameter> const& parameters, FunctionKind function_kind, bool& contains_direct_call_to_eval);
+    NonnullRefPtr<FunctionBody> skip_function_body(Vector<FunctionDeclaration::Parameter> const& parameters, FunctionKind function_kind, bool& contains_direct_call_to_eval);
     NonnullRefPtr<ReturnStatement> parse_return_statement();
     NonnullRefPtr<VariableDeclaration> parse_variable_declaration(bool for_loop_variable_declaration = false);
     NonnullRefPtr<Statement> parse_for_statement();
@@ -206,6 +216,10 @@ private:
     bool match_invalid_escaped_keyword() const;
 
     bool parse_directive(ScopeNode& body);
+    void check_parameter_names(Vector<FunctionDeclaration::Parameter> const& parameters, FunctionKind function_kind, bool in_strict_mode);
+    bool can_skip_function_body(u8 parse_options) const;
+    size_t source_offset_of(Token const&) const;
+    void record_function_node(Position const& start, NonnullRefPtr<ASTNode> function_node);
     void parse_statement_list(ScopeNode& output_node, AllowLabelledFunction allow_labelled_functions = AllowLabelledFunction::No);
 
     struct RulePosition {
@@ -280,5 +294,12 @@ private:
     Vector<ParserState> m_saved_state;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
     Program::Type m_program_type;
+
+    bool m_skip_function_bodies { false };
+    // The source text that skipped function bodies refer to, and where in it our lexer starts.
+    String m_source_text;
+    size_t m_source_text_offset { 0 };
+    FunctionNodesByOffset m_function_nodes;
+    HashMap<size_t, NonnullRefPtr<FunctionBody>> m_checked_function_bodies;
 };
 }
@@ -46,9 +46,14 @@ public:
     [[nodiscard]] bool length_is_writable() const { return m_length_writable; };
 
 private:
+    virtual bool is_array_exotic_object() const final { return true; }
+
     ThrowCompletionOr<bool> set_length(PropertyDescriptor const&);
 
     bool m_length_writable { true };
 };
 
+template<>
+inline bool Object::fast_is<Array>() const { return is_array_exotic_object(); }
+
 }
@@ -7,8 +7,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -27,6 +29,36 @@ namespace JS {
 
 static HashTable<Object*> s_array_join_seen_objects;
 
+// Elements that an Array keeps in simple storage are always plain data properties, so reading them straight out of there
+// is indistinguishable from the full property lookup. Holes and everything else still have to take the long way round.
+static Optional<Value> simple_storage_element(Object const& object, size_t index)
+{
+    if (!is<Array>(object) || !object.indexed_properties().is_simple_storage() || index >= object.indexed_properties().array_like_size())
+        return {};
+    auto element = object.indexed_properties().get(index);
+    if (!element.has_value())
+        return {};
+    return element->value;
+}
+
+// Performs HasProperty(O, index), followed by Get(O, index) if the property is there.
+static ThrowCompletionOr<Optional<Value>> element_if_present(Object& object, size_t index)
+{
+    if (auto element = simple_storage_element(object, index); element.has_value())
+        return element;
+    if (!TRY(object.has_property(index)))
+        return Optional<Value> {};
+    return TRY(object.get(index));
+}
+
+// Performs Get(O, index).
+static ThrowCompletionOr<Value> element_at(Object& object, size_t index)
+{
+    if (auto element = simple_storage_element(object, index); element.has_value())
+        return element.release_value();
+    return object.get(index);
+}
+
 ArrayPrototype::ArrayPrototype(GlobalObject& global_object)
     : Array(*global_object.object_prototype())
 {
@@ -169,15 +201,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::filter)
     // 7. Repeat, while k < len,
     for (; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // c. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(k));
+            auto k_value = element.release_value();
 
             // ii. Let selected be ! ToBoolean(? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »)).
             auto selected = TRY(vm.call(callback_function.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
@@ -219,15 +249,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // c. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_name));
+            auto k_value = element.release_value();
 
             // ii. Perform ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             TRY(vm.call(callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -266,12 +294,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         auto property_name = PropertyKey { k };
 
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // c. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_name));
+            auto k_value = element.release_value();
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(vm.call(callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -345,6 +373,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::pop)
         return js_undefined();
     }
     auto index = length - 1;
+
+    // Nobody can tell if we take the last element straight out of simple storage, as long as the length can be changed.
+    if (is<Array>(*this_object) && static_cast<Array&>(*this_object).length_is_writable() && simple_storage_element(*this_object, index).has_value())
+        return this_object->indexed_properties().take_last(this_object).value;
+
     auto element = TRY(this_object->get(index));
     TRY(this_object->delete_property_or_throw(index));
     TRY(this_object->set(vm.names.length, Value(index), Object::ShouldThrowExceptions::Yes));
@@ -360,6 +393,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::shift)
         TRY(this_object->set(vm.names.length, Value(0), Object::ShouldThrowExceptions::Yes));
         return js_undefined();
     }
+
+    // Same goes for the first element, but moving all the others down is only unobservable if there are no holes.
+    if (is<Array>(*this_object) && static_cast<Array&>(*this_object).length_is_writable() && this_object->indexed_properties().is_simple_storage()) {
+        auto& storage = static_cast<SimpleIndexedPropertyStorage const&>(this_object->indexed_properties().storage());
+        if (!storage.has_holes())
+            return this_object->indexed_properties().take_first(this_object).value;
+    }
+
     auto first = TRY(this_object->get(0));
     for (size_t k = 1; k < length; ++k) {
         size_t from = k;
@@ -611,15 +652,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
 
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
-        auto property_name = PropertyKey { k };
-
         // a. Let kPresent be ? HasProperty(O, ! ToString(𝔽(k))).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // b. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let elementK be ? Get(O, ! ToString(𝔽(k))).
-            auto element_k = TRY(object->get(property_name));
+            auto element_k = element.release_value();
 
             // ii. Let same be IsStrictlyEqual(searchElement, elementK).
             auto same = is_strictly_equal(search_element, element_k);
@@ -675,15 +714,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reduce)
         // b. Repeat, while kPresent is false and k < len,
         for (; !k_present && k < length; ++k) {
             // i. Let Pk be ! ToString(𝔽(k)).
-            auto property_name = PropertyKey { k };
-
             // ii. Set kPresent to ? HasProperty(O, Pk).
-            k_present = TRY(object->has_property(property_name));
+            auto element = TRY(element_if_present(*object, k));
+            k_present = element.has_value();
 
             // iii. If kPresent is true, then
             if (k_present) {
                 // 1. Set accumulator to ? Get(O, Pk).
-                accumulator = TRY(object->get(property_name));
+                accumulator = element.release_value();
             }
 
             // iv. Set k to k + 1.
@@ -697,15 +735,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reduce)
     // 9. Repeat, while k < len,
     for (; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // c. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_name));
+            auto k_value = element.release_value();
 
             // ii. Set accumulator to ? Call(callbackfn, undefined, « accumulator, kValue, 𝔽(k), O »).
             accumulator = TRY(vm.call(callback_function.as_function(), js_undefined(), accumulator, k_value, Value(k), object));
@@ -757,15 +793,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reduce_right)
         // b. Repeat, while kPresent is false and k ≥ 0,
         for (; !k_present && k >= 0; --k) {
             // i. Let Pk be ! ToString(𝔽(k)).
-            auto property_name = PropertyKey { k };
-
             // ii. Set kPresent to ? HasProperty(O, Pk).
-            k_present = TRY(object->has_property(property_name));
+            auto element = TRY(element_if_present(*object, k));
+            k_present = element.has_value();
 
             // iii. If kPresent is true, then
             if (k_present) {
                 // 1. Set accumulator to ? Get(O, Pk).
-                accumulator = TRY(object->get(property_name));
+                accumulator = element.release_value();
             }
 
             // iv. Set k to k - 1.
@@ -779,15 +814,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reduce_right)
     // 9. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // c. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_name));
+            auto k_value = element.release_value();
 
             // ii. Set accumulator to ? Call(callbackfn, undefined, « accumulator, kValue, 𝔽(k), O »).
             accumulator = TRY(vm.call(callback_function.as_function(), js_undefined(), accumulator, k_value, Value((size_t)k), object));
@@ -932,6 +965,32 @@ static ThrowCompletionOr<void> array_merge_sort(VM& vm, GlobalObject& global_obj
     return {};
 }
 
+// Without a comparison function, elements are compared by their string representations. For numbers that can't have any side effects,
+// so we can stringify each of them once up front instead of twice per comparison.
+static void sort_numbers_by_string_representation(MarkedValueList& numbers)
+{
+    struct Entry {
+        Value number;
+        String string;
+        size_t original_index;
+    };
+    Vector<Entry> entries;
+    entries.ensure_capacity(numbers.size());
+    for (size_t i = 0; i < numbers.size(); ++i)
+        entries.unchecked_append({ numbers[i], numbers[i].to_string_without_side_effects(), i });
+
+    // Different numbers can have the same string representation (0 and -0), so the original index breaks ties to keep the sort stable.
+    // Number strings are plain ASCII, so comparing them byte by byte is the same as comparing their code units.
+    quick_sort(entries, [](auto& a, auto& b) {
+        if (a.string != b.string)
+            return a.string < b.string;
+        return a.original_index < b.original_index;
+    });
+
+    for (size_t i = 0; i < entries.size(); ++i)
+        numbers[i] = entries[i].number;
+}
+
 // 23.1.3.28 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -945,20 +1004,21 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 
     MarkedValueList items(vm.heap());
     for (size_t k = 0; k < length; ++k) {
-        auto k_present = TRY(object->has_property(k));
-
-        if (k_present) {
-            auto k_value = TRY(object->get(k));
-            items.append(k_value);
-        }
+        auto element = TRY(element_if_present(*object, k));
+        if (element.has_value())
+            items.append(element.release_value());
     }
 
-    // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
-    // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
-    // to be stable. FIXME: when initially scanning through the array, maintain a flag
-    // for if an unstable sort would be indistinguishable from a stable sort (such as just
-    // just strings or numbers), and in that case use quick sort instead for better performance.
-    TRY(array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), items));
+    if (callback.is_undefined() && all_of(items, [](auto& item) { return item.is_number(); })) {
+        sort_numbers_by_string_representation(items);
+    } else {
+        // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
+        // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
+        // to be stable. FIXME: when initially scanning through the array, maintain a flag
+        // for if an unstable sort would be indistinguishable from a stable sort (such as just
+        // just strings), and in that case use quick sort instead for better performance.
+        TRY(array_merge_sort(vm, global_object, callback.is_undefined() ? nullptr : &callback.as_function(), items));
+    }
 
     for (size_t j = 0; j < items.size(); ++j)
         TRY(object->set(j, items[j], Object::ShouldThrowExceptions::Yes));
@@ -1015,15 +1075,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
 
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
-        auto property_name = PropertyKey { k };
-
         // a. Let kPresent be ? HasProperty(O, ! ToString(𝔽(k))).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // b. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let elementK be ? Get(O, ! ToString(𝔽(k))).
-            auto element_k = TRY(object->get(property_name));
+            auto element_k = element.release_value();
 
             // ii. Let same be IsStrictlyEqual(searchElement, elementK).
             auto same = is_strictly_equal(search_element, element_k);
@@ -1064,7 +1122,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
     }
     auto value_to_find = vm.argument(0);
     for (u64 i = from_index; i < length; ++i) {
-        auto element = TRY(this_object->get(i));
+        auto element = TRY(element_at(*this_object, i));
         if (same_value_zero(element, value_to_find))
             return Value(true);
     }
@@ -1091,10 +1149,8 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::find)
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kValue be ? Get(O, Pk).
-        auto k_value = TRY(object->get(property_name));
+        auto k_value = TRY(element_at(*object, k));
 
         // c. Let testResult be ! ToBoolean(? Call(predicate, thisArg, « kValue, 𝔽(k), O »)).
         auto test_result = TRY(vm.call(predicate.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
@@ -1130,10 +1186,8 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::find_index)
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kValue be ? Get(O, Pk).
-        auto k_value = TRY(object->get(property_name));
+        auto k_value = TRY(element_at(*object, k));
 
         // c. Let testResult be ! ToBoolean(? Call(predicate, thisArg, « kValue, 𝔽(k), O »)).
         auto test_result = TRY(vm.call(predicate.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
@@ -1169,10 +1223,8 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::find_last)
     // 5. Repeat, while k ≥ 0,
     for (i64 k = static_cast<i64>(length) - 1; k >= 0; --k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kValue be ? Get(O, Pk).
-        auto k_value = TRY(object->get(property_name));
+        auto k_value = TRY(element_at(*object, k));
 
         // c. Let testResult be ! ToBoolean(? Call(predicate, thisArg, « kValue, 𝔽(k), O »)).
         auto test_result = TRY(vm.call(predicate.as_function(), this_arg, k_value, Value((double)k), object)).to_boolean();
@@ -1208,10 +1260,8 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::find_last_index)
     // 5. Repeat, while k ≥ 0,
     for (i64 k = static_cast<i64>(length) - 1; k >= 0; --k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kValue be ? Get(O, Pk).
-        auto k_value = TRY(object->get(property_name));
+        auto k_value = TRY(element_at(*object, k));
 
         // c. Let testResult be ! ToBoolean(? Call(predicate, thisArg, « kValue, 𝔽(k), O »)).
         auto test_result = TRY(vm.call(predicate.as_function(), this_arg, k_value, Value((double)k), object)).to_boolean();
@@ -1247,15 +1297,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::some)
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // c. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_name));
+            auto k_value = element.release_value();
 
             // ii. Let testResult be ! ToBoolean(? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »)).
             auto test_result = TRY(vm.call(callback_function.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
@@ -1292,15 +1340,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::every)
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_name = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_name));
+        auto element = TRY(element_if_present(*object, k));
 
         // c. If kPresent is true, then
-        if (k_present) {
+        if (element.has_value()) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_name));
+            auto k_value = element.release_value();
 
             // ii. Let testResult be ! ToBoolean(? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »)).
             auto test_result = TRY(vm.call(callback_function.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
@@ -8,9 +8,11 @@
 #include <AK/Function.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
@@ -673,18 +675,49 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
     auto& vm = this->vm();
     auto* bytecode_interpreter = Bytecode::Interpreter::current();
 
+    // The parser may have skipped over our body, in which case we have to parse it now.
+    if (m_ecmascript_code->fast_is<FunctionBody>()) {
+        auto& function_body = static_cast<FunctionBody const&>(*m_ecmascript_code);
+        if (function_body.needs_parsing())
+            Parser::parse_skipped_function_body(function_body, m_formal_parameters);
+        if (!function_body.deferred_syntax_error().is_null())
+            return vm.throw_completion<SyntaxError>(global_object(), function_body.deferred_syntax_error());
+    }
+
     if (bytecode_interpreter) {
         // FIXME: pass something to evaluate default arguments with
         TRY(function_declaration_instantiation(nullptr));
         if (!m_bytecode_executable.has_value()) {
-            m_bytecode_executable = Bytecode::Generator::generate(m_ecmascript_code, m_kind == FunctionKind::Generator);
-            m_bytecode_executable->name = m_name;
-            auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
-            passes.perform(*m_bytecode_executable);
-            if constexpr (JS_BYTECODE_DEBUG) {
-                dbgln("Optimisation passes took {}us", passes.elapsed());
-                dbgln("Compiled Bytecode::Block for function '{}':", m_name);
+            // Only bodies that were parsed lazily know their own source text, which is what cached bytecode is looked up by.
+            auto* cache = Bytecode::ExecutableCache::the();
+            Bytecode::ExecutableCache::Key cache_key;
+            FunctionBody const* function_body = nullptr;
+            if (cache && m_ecmascript_code->fast_is<FunctionBody>()) {
+                function_body = &static_cast<FunctionBody const&>(*m_ecmascript_code);
+                if (auto* skipped_source = function_body->skipped_source()) {
+                    cache_key.source_text = skipped_source->text();
+                    cache_key.is_strict = function_body->in_strict_mode();
+                    cache_key.is_generator = m_kind == FunctionKind::Generator;
+                    cache_key.is_module = skipped_source->program_type == Program::Type::Module;
+                    cache_key.is_optimized = true;
+                    m_bytecode_executable = cache->load(cache_key, function_body->function_nodes());
+                } else {
+                    function_body = nullptr;
+                }
             }
+
+            if (!m_bytecode_executable.has_value()) {
+                m_bytecode_executable = Bytecode::Generator::generate(m_ecmascript_code, m_kind == FunctionKind::Generator);
+                auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
+                passes.perform(*m_bytecode_executable);
+                if constexpr (JS_BYTECODE_DEBUG) {
+                    dbgln("Optimisation passes took {}us", passes.elapsed());
+                    dbgln("Compiled Bytecode::Block for function '{}':", m_name);
+                }
+                if (function_body)
+                    cache->store(cache_key, *m_bytecode_executable, function_body->function_nodes());
+            }
+            m_bytecode_executable->name = m_name;
             if (JS::Bytecode::g_dump_bytecode)
                 m_bytecode_executable->dump();
         }
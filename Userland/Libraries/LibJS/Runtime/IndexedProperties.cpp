@@ -4,86 +4,242 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/QuickSort.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/IndexedProperties.h>
 
 namespace JS {
 
-constexpr const size_t SPARSE_ARRAY_HOLE_THRESHOLD = 200;
+// Writing this far past the end of an array leaves so many holes that it's better off as a hash map.
+constexpr const size_t SPARSE_ARRAY_HOLE_THRESHOLD = 1024;
 constexpr const size_t LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD = 4 * MiB;
 
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
     : m_array_size(initial_values.size())
-    , m_packed_elements(move(initial_values))
 {
+    auto elements_kind = ElementsKind::PackedInt32;
+    for (auto& value : initial_values)
+        elements_kind = max(elements_kind, value.is_empty() ? ElementsKind::Value : elements_kind_needed_for(value));
+
+    m_elements_kind = elements_kind;
+    switch (elements_kind) {
+    case ElementsKind::PackedInt32:
+        m_int32_elements.ensure_capacity(initial_values.size());
+        for (auto& value : initial_values)
+            m_int32_elements.unchecked_append(value.as_i32());
+        break;
+    case ElementsKind::Double:
+        m_double_elements.ensure_capacity(initial_values.size());
+        for (auto& value : initial_values)
+            m_double_elements.unchecked_append(value.is_nan() ? js_nan().as_double() : value.as_double());
+        break;
+    case ElementsKind::Value:
+        m_value_elements = move(initial_values);
+        break;
+    }
+}
+
+ElementsKind SimpleIndexedPropertyStorage::elements_kind_needed_for(Value value) const
+{
+    if (value.type() == Value::Type::Int32)
+        return ElementsKind::PackedInt32;
+    if (value.is_number())
+        return ElementsKind::Double;
+    return ElementsKind::Value;
+}
+
+void SimpleIndexedPropertyStorage::transition_to(ElementsKind elements_kind)
+{
+    VERIFY(elements_kind > m_elements_kind);
+
+    if (elements_kind == ElementsKind::Double) {
+        m_double_elements.ensure_capacity(m_int32_elements.capacity());
+        for (auto element : m_int32_elements)
+            m_double_elements.unchecked_append(element);
+    } else if (m_elements_kind == ElementsKind::PackedInt32) {
+        m_value_elements.ensure_capacity(m_int32_elements.capacity());
+        for (auto element : m_int32_elements)
+            m_value_elements.unchecked_append(Value(element));
+    } else {
+        m_value_elements.ensure_capacity(m_double_elements.capacity());
+        for (auto element : m_double_elements)
+            m_value_elements.unchecked_append(is_hole(element) ? Value {} : Value(element));
+    }
+
+    // Let go of the elements we just converted, but not of the ones we converted them to.
+    m_int32_elements.clear();
+    if (elements_kind == ElementsKind::Value)
+        m_double_elements.clear();
+    m_elements_kind = elements_kind;
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
 {
-    return index < m_array_size && !m_packed_elements[index].is_empty();
+    if (index >= m_array_size)
+        return false;
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        return true;
+    case ElementsKind::Double:
+        return !is_hole(m_double_elements[index]);
+    case ElementsKind::Value:
+        return !m_value_elements[index].is_empty();
+    }
+    VERIFY_NOT_REACHED();
 }
 
 Optional<ValueAndAttributes> SimpleIndexedPropertyStorage::get(u32 index) const
 {
     if (!has_index(index))
         return {};
-    return ValueAndAttributes { m_packed_elements[index], default_attributes };
-}
-
-void SimpleIndexedPropertyStorage::grow_storage_if_needed()
-{
-    if (m_array_size <= m_packed_elements.size())
-        return;
-    // Grow storage by 25% at a time.
-    m_packed_elements.resize(m_array_size + (m_array_size / 4));
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        return ValueAndAttributes { Value(m_int32_elements[index]), default_attributes };
+    case ElementsKind::Double:
+        return ValueAndAttributes { Value(m_double_elements[index]), default_attributes };
+    case ElementsKind::Value:
+        return ValueAndAttributes { m_value_elements[index], default_attributes };
+    }
+    VERIFY_NOT_REACHED();
 }
 
 void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttributes attributes)
 {
     VERIFY(attributes == default_attributes);
 
-    if (index >= m_array_size) {
-        m_array_size = index + 1;
-        grow_storage_if_needed();
+    // Putting an empty value makes a hole.
+    if (value.is_empty()) {
+        if (index >= m_array_size)
+            set_array_like_size(index + 1);
+        remove(index);
+        return;
+    }
+
+    auto elements_kind = max(m_elements_kind, elements_kind_needed_for(value));
+    // Writing past the end leaves holes, which int32 elements can't have.
+    if (index > m_array_size)
+        elements_kind = max(elements_kind, ElementsKind::Double);
+    if (elements_kind != m_elements_kind)
+        transition_to(elements_kind);
+
+    // Appending doesn't leave a hole behind, so unlike growing the array with set_array_like_size(), it keeps int32 elements packed.
+    if (index == m_array_size) {
+        ++m_array_size;
+        switch (m_elements_kind) {
+        case ElementsKind::PackedInt32:
+            m_int32_elements.append(value.as_i32());
+            break;
+        case ElementsKind::Double:
+            m_double_elements.append(value.is_nan() ? js_nan().as_double() : value.as_double());
+            break;
+        case ElementsKind::Value:
+            m_value_elements.append(value);
+            break;
+        }
+        return;
+    }
+
+    if (index > m_array_size)
+        set_array_like_size(index + 1);
+
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        m_int32_elements[index] = value.as_i32();
+        break;
+    case ElementsKind::Double:
+        m_double_elements[index] = value.is_nan() ? js_nan().as_double() : value.as_double();
+        break;
+    case ElementsKind::Value:
+        m_value_elements[index] = value;
+        break;
     }
-    m_packed_elements[index] = value;
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
-    m_packed_elements[index] = {};
+    if (m_elements_kind == ElementsKind::PackedInt32)
+        transition_to(ElementsKind::Double);
+
+    if (m_elements_kind == ElementsKind::Double)
+        m_double_elements[index] = hole();
+    else
+        m_value_elements[index] = {};
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
+    VERIFY(m_array_size > 0);
+    auto first_element = get(0);
     m_array_size--;
-    return { m_packed_elements.take_first(), default_attributes };
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        m_int32_elements.remove(0);
+        break;
+    case ElementsKind::Double:
+        m_double_elements.remove(0);
+        break;
+    case ElementsKind::Value:
+        m_value_elements.remove(0);
+        break;
+    }
+    return first_element.value_or({});
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
-    m_array_size--;
-    auto last_element = m_packed_elements[m_array_size];
-    m_packed_elements[m_array_size] = {};
-    return { last_element, default_attributes };
+    VERIFY(m_array_size > 0);
+    auto last_element = get(m_array_size - 1);
+    set_array_like_size(m_array_size - 1);
+    return last_element.value_or({});
 }
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    // Growing the array leaves holes at the end, which int32 elements can't have.
+    if (new_size > m_array_size && m_elements_kind == ElementsKind::PackedInt32)
+        transition_to(ElementsKind::Double);
+
     m_array_size = new_size;
-    m_packed_elements.resize(new_size);
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        m_int32_elements.resize_and_keep_capacity(new_size);
+        break;
+    case ElementsKind::Double:
+        m_double_elements.grow_capacity(new_size);
+        if (new_size < m_double_elements.size())
+            m_double_elements.shrink(new_size, true);
+        while (m_double_elements.size() < new_size)
+            m_double_elements.unchecked_append(hole());
+        break;
+    case ElementsKind::Value:
+        m_value_elements.grow_capacity(new_size);
+        m_value_elements.resize_and_keep_capacity(new_size);
+        break;
+    }
     return true;
 }
 
+bool SimpleIndexedPropertyStorage::has_holes() const
+{
+    switch (m_elements_kind) {
+    case ElementsKind::PackedInt32:
+        return false;
+    case ElementsKind::Double:
+        return any_of(m_double_elements, [](auto element) { return is_hole(element); });
+    case ElementsKind::Value:
+        return any_of(m_value_elements, [](auto& element) { return element.is_empty(); });
+    }
+    VERIFY_NOT_REACHED();
+}
+
 GenericIndexedPropertyStorage::GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&& storage)
 {
     m_array_size = storage.array_like_size();
-    for (size_t i = 0; i < storage.m_packed_elements.size(); ++i) {
-        auto value = storage.m_packed_elements[i];
-        if (!value.is_empty())
-            m_sparse_elements.set(i, { value, default_attributes });
+    for (size_t i = 0; i < m_array_size; ++i) {
+        if (auto element = storage.get(i); element.has_value())
+            m_sparse_elements.set(i, element.release_value());
     }
 }
 
@@ -203,6 +359,15 @@ bool IndexedPropertyIterator::operator!=(const IndexedPropertyIterator& other) c
 
 void IndexedPropertyIterator::skip_empty_indices()
 {
+    // Simple storage can tell us about each index right away, so there's no need to collect (and sort) all of them.
+    if (m_indexed_properties.is_simple_storage()) {
+        auto array_like_size = m_indexed_properties.array_like_size();
+        while (m_index < array_like_size && !m_indexed_properties.has_index(m_index))
+            ++m_index;
+        m_index = min<size_t>(m_index, array_like_size);
+        return;
+    }
+
     auto indices = m_indexed_properties.indices();
     for (auto i : indices) {
         if (i < m_index)
@@ -218,9 +383,17 @@ Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
     return m_storage->get(index);
 }
 
+// Holes are fine in simple storage, as long as there aren't too many of them compared to the elements we already have.
+// Past the size at which the length setter gives up on simple storage, it may no longer double with every write.
+static size_t largest_simple_storage_index(size_t array_like_size)
+{
+    auto allowed_size = min(array_like_size * 2, max(array_like_size, LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD));
+    return allowed_size + SPARSE_ARRAY_HOLE_THRESHOLD;
+}
+
 void IndexedProperties::put(u32 index, Value value, PropertyAttributes attributes)
 {
-    if (m_storage->is_simple_storage() && (attributes != default_attributes || index > (array_like_size() + SPARSE_ARRAY_HOLE_THRESHOLD))) {
+    if (m_storage->is_simple_storage() && (attributes != default_attributes || index > largest_simple_storage_index(array_like_size()))) {
         switch_to_generic_storage();
     }
 
@@ -268,10 +441,12 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
 size_t IndexedProperties::real_size() const
 {
     if (m_storage->is_simple_storage()) {
-        auto& packed_elements = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements();
+        auto& storage = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage);
+        if (storage.elements_kind() == ElementsKind::PackedInt32)
+            return storage.array_like_size();
         size_t size = 0;
-        for (auto& element : packed_elements) {
-            if (!element.is_empty())
+        for (size_t i = 0; i < storage.array_like_size(); ++i) {
+            if (storage.has_index(i))
                 ++size;
         }
         return size;
@@ -283,11 +458,10 @@ Vector<u32> IndexedProperties::indices() const
 {
     if (m_storage->is_simple_storage()) {
         const auto& storage = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage);
-        const auto& elements = storage.elements();
         Vector<u32> indices;
         indices.ensure_capacity(storage.array_like_size());
-        for (size_t i = 0; i < elements.size(); ++i) {
-            if (!elements.at(i).is_empty())
+        for (size_t i = 0; i < storage.array_like_size(); ++i) {
+            if (storage.has_index(i))
                 indices.unchecked_append(i);
         }
         return indices;
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BitCast.h>
 #include <AK/NonnullOwnPtr.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/Value.h>
@@ -40,6 +41,17 @@ public:
     virtual bool is_simple_storage() const { return false; }
 };
 
+// The kinds of elements a SimpleIndexedPropertyStorage can hold, from the most to the least specialized.
+// Storage only ever moves down this list (and from there to a GenericIndexedPropertyStorage), never back up.
+enum class ElementsKind : u8 {
+    // Every element is present and an int32.
+    PackedInt32,
+    // Every present element is a number, holes are marked with a special NaN.
+    Double,
+    // Anything goes, holes are empty values.
+    Value,
+};
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     SimpleIndexedPropertyStorage() = default;
@@ -53,20 +65,36 @@ public:
     virtual ValueAndAttributes take_first() override;
     virtual ValueAndAttributes take_last() override;
 
-    virtual size_t size() const override { return m_packed_elements.size(); }
+    virtual size_t size() const override { return m_array_size; }
     virtual size_t array_like_size() const override { return m_array_size; }
     virtual bool set_array_like_size(size_t new_size) override;
 
     virtual bool is_simple_storage() const override { return true; }
-    const Vector<Value>& elements() const { return m_packed_elements; }
+
+    ElementsKind elements_kind() const { return m_elements_kind; }
+    Vector<i32> const& int32_elements() const { return m_int32_elements; }
+    Vector<double> const& double_elements() const { return m_double_elements; }
+    Vector<Value> const& value_elements() const { return m_value_elements; }
+
+    bool has_holes() const;
+
+    static bool is_hole(double element) { return bit_cast<u64>(element) == hole_nan_bits; }
 
 private:
     friend GenericIndexedPropertyStorage;
 
-    void grow_storage_if_needed();
+    // A NaN with a payload that no arithmetic produces. NaNs that are actually stored get canonicalized, so they can't be confused with it.
+    static constexpr u64 hole_nan_bits = 0x7ff4'0000'0000'0001;
+    static double hole() { return bit_cast<double>(hole_nan_bits); }
+
+    void transition_to(ElementsKind);
+    ElementsKind elements_kind_needed_for(Value) const;
 
     size_t m_array_size { 0 };
-    Vector<Value> m_packed_elements;
+    ElementsKind m_elements_kind { ElementsKind::PackedInt32 };
+    Vector<i32> m_int32_elements;
+    Vector<double> m_double_elements;
+    Vector<Value> m_value_elements;
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -133,6 +161,8 @@ public:
     IndexedPropertyIterator end() const { return IndexedPropertyIterator(*this, array_like_size(), false); };
 
     bool is_empty() const { return array_like_size() == 0; }
+    bool is_simple_storage() const { return m_storage->is_simple_storage(); }
+    IndexedPropertyStorage const& storage() const { return *m_storage; }
     size_t array_like_size() const { return m_storage->array_like_size(); }
     bool set_array_like_size(size_t);
 
@@ -144,7 +174,8 @@ public:
     void for_each_value(Callback callback)
     {
         if (m_storage->is_simple_storage()) {
-            for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
+            // NOTE: This is only used to find the cells an object points to. Numbers never point to any, so only the generic kind of elements is visited.
+            for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).value_elements())
                 callback(value);
         } else {
             for (auto& element : static_cast<const GenericIndexedPropertyStorage&>(*m_storage).sparse_elements())
@@ -1017,6 +1017,13 @@ void Object::storage_set(PropertyKey const& property_name, ValueAndAttributes co
     m_storage[metadata->offset] = value;
 }
 
+void Object::append_direct_with_transition(Shape& new_shape, Value value)
+{
+    VERIFY(new_shape.property_count() == m_storage.size() + 1);
+    set_shape(new_shape);
+    m_storage.append(value);
+}
+
 void Object::storage_delete(PropertyKey const& property_name)
 {
     VERIFY(property_name.is_valid());
@@ -155,6 +155,7 @@ public:
     void define_native_function(PropertyKey const&, Function<ThrowCompletionOr<Value>(VM&, GlobalObject&)>, i32 length, PropertyAttributes attributes);
     void define_native_accessor(PropertyKey const&, Function<ThrowCompletionOr<Value>(VM&, GlobalObject&)> getter, Function<ThrowCompletionOr<Value>(VM&, GlobalObject&)> setter, PropertyAttributes attributes);
 
+    virtual bool is_array_exotic_object() const { return false; }
     virtual bool is_function() const { return false; }
     virtual bool is_typed_array() const { return false; }
     virtual bool is_string_object() const { return false; }
@@ -169,11 +170,17 @@ public:
     bool has_parameter_map() const { return m_has_parameter_map; }
     void set_has_parameter_map() { m_has_parameter_map = true; }
 
+    bool has_cacheable_property_lookups() const { return m_has_cacheable_property_lookups; }
+
     virtual const char* class_name() const override { return "Object"; }
     virtual void visit_edges(Cell::Visitor&) override;
     virtual Value value_of() const { return Value(const_cast<Object*>(this)); }
 
     Value get_direct(size_t index) const { return m_storage[index]; }
+    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+
+    // Adds a new property at the end of our storage. The new shape must be the put transition for it from our current shape.
+    void append_direct_with_transition(Shape& new_shape, Value);
 
     const IndexedProperties& indexed_properties() const { return m_indexed_properties; }
     IndexedProperties& indexed_properties() { return m_indexed_properties; }
@@ -203,6 +210,10 @@ protected:
     // [[ParameterMap]]
     bool m_has_parameter_map { false };
 
+    // Objects that don't keep their named properties where their shape says (or that have to be asked about them every time)
+    // must clear this, so that the bytecode interpreter doesn't cache where their properties are.
+    bool m_has_cacheable_property_lookups { true };
+
 private:
     void set_shape(Shape& shape) { m_shape = &shape; }
 
@@ -5,12 +5,20 @@
  */
 
 #include <AK/CharacterTypes.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf16View.h>
+#include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/VM.h>
 
 namespace JS {
 
+// Below this length, copying the characters is cheaper than keeping track of the pieces.
+static constexpr size_t min_rope_length = 256;
+
+// Marking a rope marks its pieces recursively, so we don't let ropes get arbitrarily deep.
+static constexpr u32 max_rope_depth = 512;
+
 PrimitiveString::PrimitiveString(String string)
     : m_utf8_string(move(string))
     , m_has_utf8_string(true)
@@ -23,13 +31,95 @@ PrimitiveString::PrimitiveString(Utf16String string)
 {
 }
 
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_rope_depth(max(lhs.m_rope_depth, rhs.m_rope_depth) + 1)
+    , m_rope_length(lhs.length_in_any_encoding() + rhs.length_in_any_encoding())
+    , m_rope_lhs(&lhs)
+    , m_rope_rhs(&rhs)
+{
+}
+
 PrimitiveString::~PrimitiveString()
 {
-    vm().string_cache().remove(m_utf8_string);
+    // NOTE: Only strings created by js_string() are in the cache, but any other string may have the same contents.
+    if (!m_has_utf8_string)
+        return;
+    auto& string_cache = vm().string_cache();
+    if (auto it = string_cache.find(m_utf8_string); it != string_cache.end() && it->value == this)
+        string_cache.remove(it);
+}
+
+void PrimitiveString::visit_edges(Cell::Visitor& visitor)
+{
+    Cell::visit_edges(visitor);
+    visitor.visit(m_rope_lhs);
+    visitor.visit(m_rope_rhs);
+}
+
+size_t PrimitiveString::length_in_any_encoding() const
+{
+    if (m_is_rope)
+        return m_rope_length;
+    if (m_has_utf16_string)
+        return m_utf16_string.length_in_code_units();
+    return m_utf8_string.length();
+}
+
+template<typename Callback>
+void PrimitiveString::for_each_rope_leaf(Callback callback) const
+{
+    // NOTE: We keep our own stack here, since the rope may be deeper than we'd like to recurse.
+    Vector<PrimitiveString const*, 32> pieces;
+    pieces.append(this);
+    while (!pieces.is_empty()) {
+        auto const* piece = pieces.take_last();
+        if (!piece->m_is_rope) {
+            callback(const_cast<PrimitiveString&>(*piece));
+            continue;
+        }
+        pieces.append(piece->m_rope_rhs);
+        pieces.append(piece->m_rope_lhs);
+    }
+}
+
+void PrimitiveString::resolve_rope(Encoding preferred_encoding) const
+{
+    VERIFY(m_is_rope);
+
+    // A surrogate pair may have been split between two UTF-16 pieces, so unless every piece is UTF-8 already,
+    // we put the string together as UTF-16 (and convert it from there if need be).
+    bool all_pieces_have_utf8_string = preferred_encoding == Encoding::Utf8;
+    if (all_pieces_have_utf8_string) {
+        for_each_rope_leaf([&](auto& piece) {
+            all_pieces_have_utf8_string &= piece.m_has_utf8_string;
+        });
+    }
+
+    if (all_pieces_have_utf8_string) {
+        StringBuilder builder(m_rope_length);
+        for_each_rope_leaf([&](auto& piece) { builder.append(piece.m_utf8_string); });
+        m_utf8_string = builder.build();
+        m_has_utf8_string = true;
+    } else {
+        Vector<u16, 1> code_units;
+        code_units.ensure_capacity(m_rope_length);
+        for_each_rope_leaf([&](auto& piece) { code_units.extend(piece.utf16_string().string()); });
+        m_utf16_string = Utf16String(move(code_units));
+        m_has_utf16_string = true;
+    }
+
+    // From now on we're a regular string, and the pieces can go away.
+    m_is_rope = false;
+    m_rope_depth = 0;
+    m_rope_lhs = nullptr;
+    m_rope_rhs = nullptr;
 }
 
 String const& PrimitiveString::string() const
 {
+    if (m_is_rope)
+        resolve_rope(Encoding::Utf8);
     if (!m_has_utf8_string) {
         m_utf8_string = m_utf16_string.to_utf8();
         m_has_utf8_string = true;
@@ -39,6 +129,8 @@ String const& PrimitiveString::string() const
 
 Utf16String const& PrimitiveString::utf16_string() const
 {
+    if (m_is_rope)
+        resolve_rope(Encoding::Utf16);
     if (!m_has_utf16_string) {
         m_utf16_string = Utf16String(m_utf8_string);
         m_has_utf16_string = true;
@@ -106,4 +198,70 @@ PrimitiveString* js_string(VM& vm, String string)
     return js_string(vm.heap(), move(string));
 }
 
+static PrimitiveString* concatenate_flat_strings(VM& vm, PrimitiveString const& lhs, PrimitiveString const& rhs)
+{
+    if (lhs.has_utf16_string() && rhs.has_utf16_string()) {
+        auto const& lhs_utf16_string = lhs.utf16_string();
+        auto const& rhs_utf16_string = rhs.utf16_string();
+
+        Vector<u16, 1> combined;
+        combined.ensure_capacity(lhs_utf16_string.length_in_code_units() + rhs_utf16_string.length_in_code_units());
+        combined.extend(lhs_utf16_string.string());
+        combined.extend(rhs_utf16_string.string());
+        return js_string(vm, Utf16String(move(combined)));
+    }
+
+    auto const& lhs_string = lhs.string();
+    auto const& rhs_string = rhs.string();
+    StringBuilder builder(lhs_string.length() + rhs_string.length());
+    builder.append(lhs_string);
+    builder.append(rhs_string);
+    return js_string(vm, builder.to_string());
+}
+
+static PrimitiveString* build_balanced_rope(Heap& heap, Span<PrimitiveString*> pieces)
+{
+    if (pieces.size() == 1)
+        return pieces[0];
+    auto middle = pieces.size() / 2;
+    auto* lhs = build_balanced_rope(heap, pieces.slice(0, middle));
+    auto* rhs = build_balanced_rope(heap, pieces.slice(middle));
+    return heap.allocate_without_global_object<PrimitiveString>(*lhs, *rhs);
+}
+
+PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    auto lhs_length = lhs.length_in_any_encoding();
+    auto rhs_length = rhs.length_in_any_encoding();
+    if (lhs_length == 0)
+        return &rhs;
+    if (rhs_length == 0)
+        return &lhs;
+
+    // NOTE: Ropes are never shorter than this, so both sides are regular strings here.
+    if (lhs_length + rhs_length < min_rope_length)
+        return concatenate_flat_strings(vm, lhs, rhs);
+
+    // When a string is built up a little at a time, we glue each new bit onto the last piece until that one is long enough,
+    // instead of making the rope one level deeper every time.
+    if (lhs.is_rope() && !rhs.is_rope()) {
+        auto& last_piece = *lhs.m_rope_rhs;
+        if (!last_piece.is_rope() && last_piece.length_in_any_encoding() + rhs_length < min_rope_length) {
+            auto* glued_piece = concatenate_flat_strings(vm, last_piece, rhs);
+            return vm.heap().allocate_without_global_object<PrimitiveString>(*lhs.m_rope_lhs, *glued_piece);
+        }
+    }
+
+    if (max(lhs.m_rope_depth, rhs.m_rope_depth) < max_rope_depth)
+        return vm.heap().allocate_without_global_object<PrimitiveString>(lhs, rhs);
+
+    // The rope is getting too deep (most likely from appending to it in a loop), so we rebuild it as a balanced tree of the same pieces.
+    Vector<PrimitiveString*> pieces;
+    lhs.for_each_rope_leaf([&](auto& piece) { pieces.append(&piece); });
+    rhs.for_each_rope_leaf([&](auto& piece) { pieces.append(&piece); });
+    // NOTE: Nothing points to the new rope's nodes until we return it, so they'd get collected halfway through.
+    DeferGC defer_gc(vm.heap());
+    return build_balanced_rope(vm.heap(), pieces.span());
+}
+
 }
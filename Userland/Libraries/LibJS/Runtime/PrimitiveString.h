@@ -16,6 +16,7 @@ class PrimitiveString final : public Cell {
 public:
     explicit PrimitiveString(String);
     explicit PrimitiveString(Utf16String);
+    PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs);
     virtual ~PrimitiveString();
 
     PrimitiveString(PrimitiveString const&) = delete;
@@ -28,8 +29,32 @@ public:
     Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_has_utf16_string; }
 
+    // A rope is the concatenation of two other strings, which is only put together once someone looks at it.
+    bool is_rope() const { return m_is_rope; }
+
 private:
+    friend PrimitiveString* js_rope_string(VM&, PrimitiveString&, PrimitiveString&);
+
+    enum class Encoding {
+        Utf8,
+        Utf16,
+    };
+
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    // The length of the string in whatever encoding we already have it in, which is good enough to decide how to concatenate.
+    size_t length_in_any_encoding() const;
+
+    template<typename Callback>
+    void for_each_rope_leaf(Callback) const;
+    void resolve_rope(Encoding preferred_encoding) const;
+
+    mutable bool m_is_rope { false };
+    mutable u32 m_rope_depth { 0 };
+    mutable size_t m_rope_length { 0 };
+    mutable PrimitiveString* m_rope_lhs { nullptr };
+    mutable PrimitiveString* m_rope_rhs { nullptr };
 
     mutable String m_utf8_string;
     mutable bool m_has_utf8_string { false };
@@ -47,4 +72,6 @@ PrimitiveString* js_string(VM&, Utf16String);
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(VM&, String);
 
+PrimitiveString* js_rope_string(VM&, PrimitiveString& lhs, PrimitiveString& rhs);
+
 }
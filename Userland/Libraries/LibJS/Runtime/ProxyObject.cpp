@@ -25,6 +25,8 @@ ProxyObject::ProxyObject(Object& target, Object& handler, Object& prototype)
     , m_target(target)
     , m_handler(handler)
 {
+    // Every property access has to go through the handler's traps.
+    m_has_cacheable_property_lookups = false;
 }
 
 ProxyObject::~ProxyObject()
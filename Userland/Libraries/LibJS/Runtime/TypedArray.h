@@ -61,6 +61,7 @@ protected:
     explicit TypedArrayBase(Object& prototype)
         : Object(prototype)
     {
+        m_has_cacheable_property_lookups = false;
     }
 
     u32 m_array_length { 0 };
@@ -995,28 +995,11 @@ ThrowCompletionOr<Value> add(GlobalObject& global_object, Value lhs, Value rhs)
     auto lhs_primitive = TRY(lhs.to_primitive(global_object));
     auto rhs_primitive = TRY(rhs.to_primitive(global_object));
 
-    if (lhs_primitive.is_string() && rhs_primitive.is_string()) {
-        auto const& lhs_string = lhs_primitive.as_string();
-        auto const& rhs_string = rhs_primitive.as_string();
-
-        if (lhs_string.has_utf16_string() && rhs_string.has_utf16_string()) {
-            auto const& lhs_utf16_string = lhs_string.utf16_string();
-            auto const& rhs_utf16_string = rhs_string.utf16_string();
-
-            Vector<u16, 1> combined;
-            combined.ensure_capacity(lhs_utf16_string.length_in_code_units() + rhs_utf16_string.length_in_code_units());
-            combined.extend(lhs_utf16_string.string());
-            combined.extend(rhs_utf16_string.string());
-            return Value(js_string(vm.heap(), Utf16String(move(combined))));
-        }
-    }
     if (lhs_primitive.is_string() || rhs_primitive.is_string()) {
-        auto lhs_string = TRY(lhs_primitive.to_string(global_object));
-        auto rhs_string = TRY(rhs_primitive.to_string(global_object));
-        StringBuilder builder(lhs_string.length() + rhs_string.length());
-        builder.append(lhs_string);
-        builder.append(rhs_string);
-        return Value(js_string(vm, builder.to_string()));
+        // NOTE: This doesn't copy the strings, see js_rope_string(). That keeps building up a string one bit at a time from being quadratic.
+        auto* lhs_string = lhs_primitive.is_string() ? &lhs_primitive.as_string() : js_string(vm, TRY(lhs_primitive.to_string(global_object)));
+        auto* rhs_string = rhs_primitive.is_string() ? &rhs_primitive.as_string() : js_string(vm, TRY(rhs_primitive.to_string(global_object)));
+        return Value(js_rope_string(vm, *lhs_string, *rhs_string));
     }
 
     auto lhs_numeric = TRY(lhs_primitive.to_numeric(global_object));
@@ -0,0 +1,113 @@
+test("int32 elements turning into doubles and other values", () => {
+    const a = [1, 2, 3];
+    a.push(4.5);
+    expect(a).toEqual([1, 2, 3, 4.5]);
+    a[1] = -0;
+    expect(Object.is(a[1], -0)).toBeTrue();
+    a[2] = NaN;
+    expect(a[2]).toBeNaN();
+    a.push("foo");
+    expect(a).toHaveLength(5);
+    expect(a[0]).toBe(1);
+    expect(a[3]).toBe(4.5);
+    expect(a[4]).toBe("foo");
+});
+
+test("holes stay holes", () => {
+    const a = [1, 2, 3];
+    a[6] = 7;
+    expect(a).toHaveLength(7);
+    expect(3 in a).toBeFalse();
+    expect(a[4]).toBeUndefined();
+    expect(Object.keys(a)).toEqual(["0", "1", "2", "6"]);
+
+    delete a[0];
+    expect(0 in a).toBeFalse();
+    a.push({});
+    expect(0 in a).toBeFalse();
+    expect(Object.keys(a)).toEqual(["1", "2", "6", "7"]);
+
+    const b = new Array(5);
+    b[2] = 1.5;
+    expect(Object.keys(b)).toEqual(["2"]);
+    expect(b.indexOf(undefined)).toBe(-1);
+    expect(b.includes(undefined)).toBeTrue();
+});
+
+test("holes are looked up on the prototype", () => {
+    const a = [1, , 3];
+    Array.prototype[1] = "from prototype";
+    try {
+        expect(a[1]).toBe("from prototype");
+        expect(a.indexOf("from prototype")).toBe(1);
+        expect(a.map(x => x)).toEqual([1, "from prototype", 3]);
+        expect(a.shift()).toBe(1);
+        expect(Object.keys(a)).toEqual(["0", "1"]);
+        expect(a[0]).toBe("from prototype");
+    } finally {
+        delete Array.prototype[1];
+    }
+});
+
+test("elements far past the end", () => {
+    const a = [];
+    a[100000] = 1;
+    expect(a).toHaveLength(100001);
+    expect(Object.keys(a)).toEqual(["100000"]);
+
+    const b = [];
+    for (let i = 0; i < 1000; i += 2) b[i] = i;
+    expect(b).toHaveLength(999);
+    expect(Object.keys(b)).toHaveLength(500);
+    expect(b.reduce((sum, x) => sum + x, 0)).toBe(249500);
+
+    // Each of these doubles the length, which must not keep growing the elements in one block of memory.
+    const c = [];
+    for (let i = 0; i < 22; ++i) c[c.length * 2 + 1024] = i;
+    // The last write is past the largest array index, so it's just a property.
+    expect(c).toHaveLength(2149579775);
+    expect(c[c.length - 1]).toBe(20);
+    expect(Object.keys(c)).toHaveLength(22);
+});
+
+test("callbacks changing the array", () => {
+    const a = [1, 2, 3, 4];
+    const seen = [];
+    a.forEach((x, i) => {
+        seen.push(x);
+        if (i === 0) {
+            a.length = 2;
+            a[1] = 2.5;
+        }
+    });
+    expect(seen).toEqual([1, 2.5]);
+});
+
+test("default sort of numbers", () => {
+    expect([10, 9, 1, 100, -1, 2.5].sort()).toEqual([-1, 1, 10, 100, 2.5, 9]);
+    expect([NaN, Infinity, -Infinity, 1e21, 0].sort()).toEqual([-Infinity, 0, 1e21, Infinity, NaN]);
+
+    const zeros = [0, -0, 0, -0].sort();
+    expect(Object.is(zeros[0], 0)).toBeTrue();
+    expect(Object.is(zeros[1], -0)).toBeTrue();
+    expect(Object.is(zeros[2], 0)).toBeTrue();
+    expect(Object.is(zeros[3], -0)).toBeTrue();
+
+    const holey = [3, , 1, undefined, 2];
+    holey.sort();
+    expect(holey).toHaveLength(5);
+    expect(holey.slice(0, 4)).toEqual([1, 2, 3, undefined]);
+    expect(4 in holey).toBeFalse();
+});
+
+test("pop and shift", () => {
+    const a = [1, 2.5, "three"];
+    expect(a.pop()).toBe("three");
+    expect(a.shift()).toBe(1);
+    expect(a).toEqual([2.5]);
+
+    const b = [1, 2, 3];
+    Object.defineProperty(b, "length", { writable: false });
+    expect(() => b.pop()).toThrow(TypeError);
+    expect(() => b.shift()).toThrow(TypeError);
+});
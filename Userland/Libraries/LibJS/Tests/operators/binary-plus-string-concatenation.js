@@ -0,0 +1,44 @@
+test("basic functionality", () => {
+    expect("foo" + "bar").toBe("foobar");
+    expect("foo" + 1).toBe("foo1");
+    expect(1 + "foo").toBe("1foo");
+    expect("" + "").toBe("");
+    expect("foo" + "").toBe("foo");
+    expect("" + "foo").toBe("foo");
+    expect("a" + null + undefined + true).toBe("anullundefinedtrue");
+});
+
+test("long strings", () => {
+    const a = "a".repeat(1000);
+    const b = "b".repeat(1000);
+    const ab = a + b;
+    expect(ab).toHaveLength(2000);
+    expect(ab[999]).toBe("a");
+    expect(ab[1000]).toBe("b");
+    expect(ab === "a".repeat(1000) + "b".repeat(1000)).toBeTrue();
+    expect(ab + ab).toBe(a + b + a + b);
+    expect(ab < ab + "c").toBeTrue();
+});
+
+test("appending in a loop", () => {
+    let s = "";
+    for (let i = 0; i < 20000; ++i) s += i % 10;
+    expect(s).toHaveLength(20000);
+    expect(s.substring(0, 12)).toBe("012345678901");
+    expect(s.lastIndexOf("9")).toBe(19999);
+
+    let t = "";
+    for (let i = 0; i < 2000; ++i) t += "x".repeat(300) + i;
+    expect(t.endsWith("x1999")).toBeTrue();
+    expect(t.indexOf("1999")).toBe(t.length - 4);
+});
+
+test("surrogate pairs split between the two sides", () => {
+    const high = "\ud83d".repeat(300);
+    const low = "\ude00" + "x".repeat(300);
+    const s = high + low;
+    expect(s).toHaveLength(601);
+    expect(s.codePointAt(299)).toBe(0x1f600);
+    expect(s.charCodeAt(298)).toBe(0xd83d);
+    expect(s.charCodeAt(300)).toBe(0xde00);
+});
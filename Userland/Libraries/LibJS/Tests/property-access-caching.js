@@ -0,0 +1,258 @@
+// Property accesses in the same place in the code are cached, so each of these warms up an accessor function first and
+// then checks that the cached access notices the object (or its prototype chain) has changed.
+
+function getX(object) {
+    return object.x;
+}
+
+function setX(object, value) {
+    object.x = value;
+}
+
+function setXStrict(object, value) {
+    "use strict";
+    object.x = value;
+}
+
+function warmUp(callback) {
+    for (let i = 0; i < 10; ++i) callback();
+}
+
+describe("cached gets", () => {
+    test("own data property redefined as an accessor", () => {
+        const object = { x: 1 };
+        warmUp(() => expect(getX(object)).toBe(1));
+
+        Object.defineProperty(object, "x", {
+            get() {
+                return 2;
+            },
+        });
+        expect(getX(object)).toBe(2);
+    });
+
+    test("prototype data property redefined as an accessor", () => {
+        const prototype = { x: 1 };
+        const object = Object.create(prototype);
+        warmUp(() => expect(getX(object)).toBe(1));
+
+        Object.defineProperty(prototype, "x", {
+            get() {
+                return 2;
+            },
+        });
+        expect(getX(object)).toBe(2);
+    });
+
+    test("accessor redefined as a data property", () => {
+        const object = {
+            get x() {
+                return 1;
+            },
+        };
+        warmUp(() => expect(getX(object)).toBe(1));
+
+        Object.defineProperty(object, "x", { value: 2 });
+        expect(getX(object)).toBe(2);
+    });
+
+    test("value changed on the prototype", () => {
+        const prototype = { x: 1 };
+        const object = Object.create(prototype);
+        warmUp(() => expect(getX(object)).toBe(1));
+
+        prototype.x = 2;
+        expect(getX(object)).toBe(2);
+    });
+
+    test("prototype reassigned", () => {
+        const object = Object.create({ x: 1 });
+        warmUp(() => expect(getX(object)).toBe(1));
+
+        Object.setPrototypeOf(object, { x: 2 });
+        expect(getX(object)).toBe(2);
+
+        Object.setPrototypeOf(object, null);
+        expect(getX(object)).toBeUndefined();
+    });
+
+    test("property added further up the prototype chain", () => {
+        const grandparent = {};
+        const parent = Object.create(grandparent);
+        const object = Object.create(parent);
+        warmUp(() => expect(getX(object)).toBeUndefined());
+
+        grandparent.x = 1;
+        expect(getX(object)).toBe(1);
+
+        parent.x = 2;
+        expect(getX(object)).toBe(2);
+    });
+
+    test("own property shadowing the prototype", () => {
+        const object = Object.create({ x: 1 });
+        warmUp(() => expect(getX(object)).toBe(1));
+
+        object.x = 2;
+        expect(getX(object)).toBe(2);
+    });
+
+    test("delete followed by re-adding", () => {
+        const object = { x: 1, y: 2 };
+        const getY = object => object.y;
+        warmUp(() => {
+            expect(getX(object)).toBe(1);
+            expect(getY(object)).toBe(2);
+        });
+
+        delete object.x;
+        expect(getX(object)).toBeUndefined();
+        expect(getY(object)).toBe(2);
+
+        object.x = 3;
+        expect(getX(object)).toBe(3);
+        expect(getY(object)).toBe(2);
+
+        delete object.y;
+        object.y = 4;
+        expect(getX(object)).toBe(3);
+        expect(getY(object)).toBe(4);
+    });
+
+    test("delete uncovers the prototype", () => {
+        const object = Object.create({ x: 1 });
+        object.x = 2;
+        warmUp(() => expect(getX(object)).toBe(2));
+
+        delete object.x;
+        expect(getX(object)).toBe(1);
+    });
+});
+
+describe("cached puts", () => {
+    test("own data property redefined as an accessor", () => {
+        const object = { x: 1 };
+        warmUp(() => setX(object, 2));
+
+        let setterValue;
+        Object.defineProperty(object, "x", {
+            get() {
+                return 3;
+            },
+            set(value) {
+                setterValue = value;
+            },
+        });
+        setX(object, 4);
+        expect(setterValue).toBe(4);
+        expect(object.x).toBe(3);
+    });
+
+    test("setter added on the prototype", () => {
+        const prototype = {};
+        warmUp(() => {
+            const object = Object.create(prototype);
+            setX(object, 1);
+            expect(Object.getOwnPropertyNames(object)).toEqual(["x"]);
+        });
+
+        let setterValue;
+        Object.defineProperty(prototype, "x", {
+            set(value) {
+                setterValue = value;
+            },
+        });
+        const object = Object.create(prototype);
+        setX(object, 2);
+        expect(setterValue).toBe(2);
+        expect(Object.getOwnPropertyNames(object)).toEqual([]);
+    });
+
+    test("non-writable property added on the prototype", () => {
+        const prototype = {};
+        warmUp(() => setX(Object.create(prototype), 1));
+
+        Object.defineProperty(prototype, "x", { value: 2, writable: false });
+        const object = Object.create(prototype);
+        setX(object, 3);
+        expect(object.x).toBe(2);
+        expect(Object.getOwnPropertyNames(object)).toEqual([]);
+        expect(() => setXStrict(object, 3)).toThrow(TypeError);
+    });
+
+    test("prototype reassigned", () => {
+        const object = {};
+        warmUp(() => setX(object, 1));
+
+        let setterValue;
+        delete object.x;
+        Object.setPrototypeOf(object, {
+            set x(value) {
+                setterValue = value;
+            },
+        });
+        setX(object, 2);
+        expect(setterValue).toBe(2);
+        expect(object.hasOwnProperty("x")).toBeFalse();
+    });
+
+    test("frozen object", () => {
+        const object = { x: 1 };
+        warmUp(() => {
+            setX(object, 2);
+            setXStrict(object, 2);
+        });
+
+        Object.freeze(object);
+        setX(object, 3);
+        expect(object.x).toBe(2);
+        expect(() => setXStrict(object, 3)).toThrow(TypeError);
+        expect(object.x).toBe(2);
+    });
+
+    test("adding a property to a frozen object", () => {
+        warmUp(() => {
+            const object = {};
+            setX(object, 1);
+            expect(object.x).toBe(1);
+        });
+
+        const object = Object.freeze({});
+        setX(object, 1);
+        expect(object.x).toBeUndefined();
+        expect(() => setXStrict(object, 1)).toThrow(TypeError);
+        expect(object.x).toBeUndefined();
+    });
+
+    test("adding a property to an object that can't be extended", () => {
+        warmUp(() => {
+            const object = {};
+            setX(object, 1);
+            setXStrict({}, 1);
+        });
+
+        const object = Object.preventExtensions({});
+        setX(object, 1);
+        expect(object.x).toBeUndefined();
+        expect(Object.isExtensible(object)).toBeFalse();
+        expect(() => setXStrict(object, 1)).toThrow(TypeError);
+        expect(Object.getOwnPropertyNames(object)).toEqual([]);
+    });
+
+    test("delete followed by re-adding", () => {
+        const object = { x: 1, y: 2 };
+        warmUp(() => setX(object, 3));
+
+        delete object.x;
+        setX(object, 4);
+        expect(object.x).toBe(4);
+        expect(object.y).toBe(2);
+        expect(Object.keys(object)).toEqual(["y", "x"]);
+
+        delete object.y;
+        object.y = 5;
+        setX(object, 6);
+        expect(object.x).toBe(6);
+        expect(object.y).toBe(5);
+    });
+});
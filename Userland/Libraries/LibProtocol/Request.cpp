@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibIPC/File.h>
 #include <LibProtocol/Request.h>
 #include <LibProtocol/RequestClient.h>
 
@@ -24,13 +25,27 @@ void Request::stream_into(OutputStream& stream)
 {
     VERIFY(!m_internal_stream_data);
 
+    if (fd() < 0) {
+        // The response came out of RequestServer's disk cache, so there is no pipe to read from.
+        auto user_on_finish = move(on_finish);
+        on_finish = [this, &stream, user_on_finish = move(user_on_finish)](auto success, auto total_size) {
+            if (!write_cached_body_into(stream))
+                success = false;
+            user_on_finish(success, total_size);
+        };
+        return;
+    }
+
     auto notifier = Core::Notifier::construct(fd(), Core::Notifier::Read);
 
     m_internal_stream_data = make<InternalStreamData>(fd());
     m_internal_stream_data->read_notifier = notifier;
 
     auto user_on_finish = move(on_finish);
-    on_finish = [this](auto success, auto total_size) {
+    on_finish = [this, &stream](auto success, auto total_size) {
+        // NOTE: This is a revalidated response from the disk cache, the pipe won't have anything but EOF for us.
+        if (!write_cached_body_into(stream))
+            success = false;
         m_internal_stream_data->success = success;
         m_internal_stream_data->total_size = total_size;
         m_internal_stream_data->request_done = true;
@@ -41,8 +56,12 @@ void Request::stream_into(OutputStream& stream)
         static char buf[buffer_size];
         auto nread = m_internal_stream_data->read_stream.read({ buf, buffer_size });
         if (!stream.write_or_error({ buf, nread })) {
-            // FIXME: What do we do here?
-            TODO();
+            // Whoever we're streaming into can't take any more, so there's no point in reading the rest.
+            dbgln("Request: Failed to write {} bytes of the response", nread);
+            m_internal_stream_data->read_notifier->close();
+            stop();
+            user_on_finish(false, m_internal_stream_data->total_size);
+            return;
         }
 
         if (m_internal_stream_data->read_stream.eof() && m_internal_stream_data->request_done) {
@@ -68,7 +87,7 @@ void Request::set_should_buffer_all_input(bool value)
     VERIFY(!m_internal_stream_data);
     VERIFY(!m_internal_buffered_data);
     VERIFY(on_buffered_request_finish); // Not having this set makes no sense.
-    m_internal_buffered_data = make<InternalBufferedData>(fd());
+    m_internal_buffered_data = make<InternalBufferedData>();
     m_should_buffer_all_input = true;
 
     on_headers_received = [this](auto& headers, auto response_code) {
@@ -77,13 +96,21 @@ void Request::set_should_buffer_all_input(bool value)
     };
 
     on_finish = [this](auto success, u32 total_size) {
-        auto output_buffer = m_internal_buffered_data->payload_stream.copy_into_contiguous_buffer();
+        // Bodies from the disk cache are mapped straight from the cache's body file, so they are handed out without copying them.
+        ByteBuffer output_buffer;
+        ReadonlyBytes payload;
+        if (m_cached_body) {
+            payload = m_cached_body->bytes();
+        } else {
+            output_buffer = m_internal_buffered_data->payload_stream.copy_into_contiguous_buffer();
+            payload = output_buffer;
+        }
         on_buffered_request_finish(
             success,
             total_size,
             m_internal_buffered_data->response_headers,
             m_internal_buffered_data->response_code,
-            output_buffer);
+            payload);
     };
 
     stream_into(m_internal_buffered_data->payload_stream);
@@ -109,6 +136,28 @@ void Request::did_receive_headers(Badge<RequestClient>, const HashMap<String, St
         on_headers_received(response_headers, response_code);
 }
 
+void Request::did_receive_cached_body(Badge<RequestClient>, IPC::File const& body_file)
+{
+    auto mapped_file_or_error = MappedFile::map_from_fd_and_close(body_file.take_fd(), "Cached response body");
+    if (mapped_file_or_error.is_error()) {
+        dbgln("Request: Failed to map the cached response: {}", mapped_file_or_error.error());
+        return;
+    }
+    m_cached_body = mapped_file_or_error.release_value();
+}
+
+bool Request::write_cached_body_into(OutputStream& stream)
+{
+    // In buffered mode, the body is passed to on_buffered_request_finish directly instead.
+    if (!m_cached_body || m_should_buffer_all_input)
+        return true;
+    if (!stream.write_or_error(m_cached_body->bytes())) {
+        dbgln("Request: Failed to write {} bytes of the cached response", m_cached_body->size());
+        return false;
+    }
+    return true;
+}
+
 void Request::did_request_certificates(Badge<RequestClient>)
 {
     if (on_certificate_requested) {
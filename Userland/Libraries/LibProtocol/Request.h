@@ -10,6 +10,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/FileStream.h>
 #include <AK/Function.h>
+#include <AK/MappedFile.h>
 #include <AK/MemoryStream.h>
 #include <AK/RefCounted.h>
 #include <AK/String.h>
@@ -54,25 +55,25 @@ public:
     void did_progress(Badge<RequestClient>, Optional<u32> total_size, u32 downloaded_size);
     void did_receive_headers(Badge<RequestClient>, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> response_code);
     void did_request_certificates(Badge<RequestClient>);
+    void did_receive_cached_body(Badge<RequestClient>, IPC::File const&);
 
     RefPtr<Core::Notifier>& write_notifier(Badge<RequestClient>) { return m_write_notifier; }
     void set_request_fd(Badge<RequestClient>, int fd) { m_fd = fd; }
 
 private:
     explicit Request(RequestClient&, i32 request_id);
+    bool write_cached_body_into(OutputStream&);
     WeakPtr<RequestClient> m_client;
     int m_request_id { -1 };
     RefPtr<Core::Notifier> m_write_notifier;
     int m_fd { -1 };
     bool m_should_buffer_all_input { false };
 
-    struct InternalBufferedData {
-        InternalBufferedData(int fd)
-            : read_stream(fd)
-        {
-        }
+    // Set when RequestServer answered the request from its disk cache. The fd (if any) doesn't carry the body then.
+    // NOTE: This is a read-only mapping of the cache's own body file, which every client of the cache shares.
+    RefPtr<MappedFile> m_cached_body;
 
-        InputFileStream read_stream;
+    struct InternalBufferedData {
         DuplexMemoryStream payload_stream;
         HashMap<String, String, CaseInsensitiveStringTraits> response_headers;
         Optional<u32> response_code;
@@ -27,17 +27,19 @@ RefPtr<Request> RequestClient::start_request(String const& method, URL const& ur
     for (auto& it : request_headers)
         header_dictionary.add(it.key, it.value);
 
-    auto body_result = ByteBuffer::copy(request_body);
+    // Large bodies go straight into a buffer that RequestServer can map, instead of into a ByteBuffer first.
+    auto body_result = IPC::ReadonlyBuffer::copy(request_body);
     if (!body_result.has_value())
         return nullptr;
 
     auto response = IPCProxy::start_request(method, url, header_dictionary, body_result.release_value());
     auto request_id = response.request_id();
-    if (request_id < 0 || !response.response_fd().has_value())
+    if (request_id < 0)
         return nullptr;
-    auto response_fd = response.response_fd().value().take_fd();
     auto request = Request::create_from_id({}, *this, request_id);
-    request->set_request_fd({}, response_fd);
+    // NOTE: Responses from RequestServer's disk cache don't come with an fd, see cached_body_available().
+    if (response.response_fd().has_value())
+        request->set_request_fd({}, response.response_fd().value().take_fd());
     m_requests.set(request_id, request);
     return request;
     return nullptr;
@@ -82,6 +84,13 @@ void RequestClient::headers_became_available(i32 request_id, IPC::Dictionary con
     }
 }
 
+void RequestClient::cached_body_available(i32 request_id, IPC::File const& body_file)
+{
+    if (auto request = const_cast<Request*>(m_requests.get(request_id).value_or(nullptr))) {
+        request->did_receive_cached_body({}, body_file);
+    }
+}
+
 void RequestClient::certificate_requested(i32 request_id)
 {
     if (auto request = const_cast<Request*>(m_requests.get(request_id).value_or(nullptr))) {
@@ -36,6 +36,7 @@ private:
     virtual void request_finished(i32, bool, u32) override;
     virtual void certificate_requested(i32) override;
     virtual void headers_became_available(i32, IPC::Dictionary const&, Optional<u32> const&) override;
+    virtual void cached_body_available(i32, IPC::File const&) override;
 
     HashMap<i32, RefPtr<Request>> m_requests;
 };
@@ -511,6 +511,10 @@ struct MatchInput {
 
     size_t global_offset { 0 }; // For multiline matching, knowing the offset from start could be important
 
+    // Set when the caller goes on to try every later start position if matching at this one fails. Once the search has
+    // done this many operations, the NFA simulation takes over and tries all the remaining start positions in one pass.
+    Optional<size_t> search_nfa_fallback_operations;
+
     mutable size_t fail_counter { 0 };
     mutable Vector<size_t> saved_positions;
     mutable Vector<size_t> saved_code_unit_positions;
@@ -519,6 +523,7 @@ struct MatchInput {
 };
 
 struct MatchState {
+    size_t start_position { 0 };
     size_t string_position_before_match { 0 };
     size_t string_position { 0 };
     size_t string_position_in_code_units { 0 };
@@ -181,6 +181,18 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
         continue_search = false;
 
+    // Matches that are rejected after the fact make us look for another one, which a single pass can't do.
+    bool can_search_as_nfa = continue_search
+        && m_pattern->parser_result.can_be_simulated_as_nfa
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine)
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine);
+    auto start_search_at = [&](size_t position) {
+        // The backtracking VM gets the same budget for the whole search as it would for a single attempt at the first position,
+        // so that trying one start position after another can't add up to more than that either.
+        if (can_search_as_nfa)
+            input.search_nfa_fallback_operations = operations + m_pattern->parser_result.bytecode.size() * (input.view.length() - position + 1);
+    };
+
     for (auto& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -188,6 +200,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             continue;
         }
         input.view = view;
+        input.search_nfa_fallback_operations.clear();
         dbgln_if(REGEX_DEBUG, "[match] Starting match with view ({}): _{}_", view.length(), view);
 
         auto view_length = view.length();
@@ -224,6 +237,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
+        start_search_at(view_index);
         for (; view_index < view_length; ++view_index) {
             auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
@@ -238,6 +252,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             input.column = match_count;
             input.match_index = match_count;
 
+            state.start_position = view_index;
             state.string_position = view_index;
             state.string_position_in_code_units = view_index;
             state.instruction_position = 0;
@@ -247,6 +262,9 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (!success.has_value())
                 return { false, 0, {}, {}, {}, operations };
 
+            // If the NFA simulation took over the search, it has tried the later start positions as well.
+            view_index = state.start_position;
+
             if (success.value()) {
                 succeeded = true;
 
@@ -271,6 +289,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
                     bool has_zero_length = state.string_position == view_index;
                     view_index = state.string_position - (has_zero_length ? 0 : 1);
+                    start_search_at(view_index + 1);
                     continue;
 
                 } else if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful)) {
@@ -415,7 +434,21 @@ Optional<bool> Matcher<Parser>::execute(MatchInput const& input, MatchState& sta
 
     auto& bytecode = m_pattern->parser_result.bytecode;
 
+    // The NFA simulation runs every instruction at most once per input position, so once backtracking
+    // has done more work than that, it's likely stuck in an exponential blowup and we switch over.
+    auto start_position = state.string_position;
+    auto start_position_in_code_units = state.string_position_in_code_units;
+    size_t nfa_fallback_operations = 0;
+    if (m_pattern->parser_result.can_be_simulated_as_nfa)
+        nfa_fallback_operations = input.search_nfa_fallback_operations.value_or(operations + bytecode.size() * (input.view.length() - start_position + 1));
+
     for (;;) {
+        if (nfa_fallback_operations != 0 && operations > nfa_fallback_operations) {
+            state.string_position = start_position;
+            state.string_position_in_code_units = start_position_in_code_units;
+            return execute_as_nfa(input, state, operations);
+        }
+
         auto& opcode = bytecode.get_opcode(state);
         ++operations;
 
@@ -506,6 +539,173 @@ Optional<bool> Matcher<Parser>::execute(MatchInput const& input, MatchState& sta
     VERIFY_NOT_REACHED();
 }
 
+static bool have_same_repetition_marks(Vector<u64> const& a, Vector<u64> const& b)
+{
+    // Marks are only added on demand, so a missing one is the same as a mark of zero.
+    for (size_t i = 0; i < max(a.size(), b.size()); ++i) {
+        if ((i < a.size() ? a[i] : 0) != (i < b.size() ? b[i] : 0))
+            return false;
+    }
+    return true;
+}
+
+template<class Parser>
+Optional<bool> Matcher<Parser>::execute_as_nfa(MatchInput const& input, MatchState& state, size_t& operations) const
+{
+    // This runs all the paths the backtracking VM would try in lockstep, one input position at a time (a "Pike VM").
+    // Threads are kept in the order the backtracking VM would try them in, so the first thread to reach the end of
+    // the bytecode is the match the backtracking VM would have found, and any thread that reaches an instruction
+    // some higher priority thread already ran at the same position (with the same repetition counts) is dropped.
+    // When searching, a thread for every later start position joins in with the lowest priority, which is the order
+    // the caller would have tried them in. That way, the input is only run through once, no matter where the match is.
+    struct Thread {
+        MatchState state;
+        HashMap<u64, u64> checkpoints;
+    };
+
+    struct VisitedInstruction {
+        size_t string_position { NumericLimits<size_t>::max() };
+        Vector<Vector<u64>, 1> repetition_marks;
+    };
+
+    auto& bytecode = m_pattern->parser_result.bytecode;
+
+    Vector<VisitedInstruction> visited_instructions;
+    visited_instructions.resize(bytecode.size());
+
+    auto visit = [&](MatchState const& thread_state) {
+        auto& visited = visited_instructions[thread_state.instruction_position];
+        if (visited.string_position != thread_state.string_position) {
+            visited.string_position = thread_state.string_position;
+            visited.repetition_marks.clear_with_capacity();
+        } else if (any_of(visited.repetition_marks, [&](auto& marks) { return have_same_repetition_marks(marks, thread_state.repetition_marks); })) {
+            return false;
+        }
+        visited.repetition_marks.append(thread_state.repetition_marks);
+        return true;
+    };
+
+    // Threads only carry the capture groups of the match being looked for, which are moved into place once it's found.
+    MatchInput thread_input = input;
+    thread_input.match_index = 0;
+    thread_input.checkpoints.clear();
+    thread_input.fork_to_replace.clear();
+
+    auto can_start_at = [&](size_t string_position) {
+        if (string_position == state.string_position)
+            return true;
+        if (!input.search_nfa_fallback_operations.has_value() || string_position >= input.view.length())
+            return false;
+        auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
+        return !match_length_minimum || match_length_minimum <= input.view.length() - string_position;
+    };
+
+    Vector<Thread> current_threads;
+    Vector<Thread> next_threads;
+    Vector<Thread> lower_priority_threads;
+    Optional<MatchState> matched_state;
+
+    for (auto string_position = state.string_position;; ++string_position) {
+        if (!matched_state.has_value() && can_start_at(string_position)) {
+            Thread thread;
+            thread.state.start_position = string_position;
+            thread.state.string_position = string_position;
+            thread.state.string_position_in_code_units = string_position == state.string_position ? state.string_position_in_code_units : string_position;
+            current_threads.append(move(thread));
+        }
+        if (current_threads.is_empty())
+            break;
+
+        bool matched_at_this_position = false;
+        for (auto& current_thread : current_threads) {
+            // This thread is still in the middle of a multi-character compare.
+            if (current_thread.state.string_position != string_position) {
+                next_threads.append(move(current_thread));
+                continue;
+            }
+
+            lower_priority_threads.append(move(current_thread));
+            while (!lower_priority_threads.is_empty()) {
+                auto thread = lower_priority_threads.take_last();
+                for (;;) {
+                    if (thread.state.instruction_position >= bytecode.size()) {
+                        matched_state = move(thread.state);
+                        matched_at_this_position = true;
+                        break;
+                    }
+                    if (!visit(thread.state))
+                        break;
+
+                    auto& opcode = bytecode.get_opcode(thread.state);
+                    ++operations;
+
+                    swap(thread_input.checkpoints, thread.checkpoints);
+                    auto result = opcode.execute(thread_input, thread.state);
+                    swap(thread_input.checkpoints, thread.checkpoints);
+                    // Only one thread takes any given path, so there's never a fork to replace.
+                    thread_input.fork_to_replace.clear();
+
+                    thread.state.instruction_position += opcode.size();
+
+                    if (result == ExecutionResult::Fork_PrioHigh) {
+                        lower_priority_threads.append(thread);
+                        thread.state.instruction_position = thread.state.fork_at_position;
+                        continue;
+                    }
+                    if (result == ExecutionResult::Fork_PrioLow) {
+                        lower_priority_threads.append(thread);
+                        lower_priority_threads.last().state.instruction_position = thread.state.fork_at_position;
+                        continue;
+                    }
+                    if (result != ExecutionResult::Continue)
+                        break;
+                    if (thread.state.string_position != string_position) {
+                        next_threads.append(move(thread));
+                        break;
+                    }
+                }
+
+                // Everything left to try at this position has a lower priority than the match we just found.
+                if (matched_at_this_position)
+                    break;
+            }
+            lower_priority_threads.clear_with_capacity();
+
+            if (matched_at_this_position)
+                break;
+        }
+
+        swap(current_threads, next_threads);
+        next_threads.clear_with_capacity();
+    }
+
+    if (!matched_state.has_value()) {
+        // There's nothing left to try at any later start position either.
+        if (input.search_nfa_fallback_operations.has_value())
+            state.start_position = input.view.length();
+        if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
+            return {};
+        return false;
+    }
+
+    state.start_position = matched_state->start_position;
+    state.string_position = matched_state->string_position;
+    state.string_position_in_code_units = matched_state->string_position_in_code_units;
+    state.instruction_position = matched_state->instruction_position;
+    state.repetition_marks = move(matched_state->repetition_marks);
+
+    if (input.match_index < state.capture_group_matches.size() || !matched_state->capture_group_matches.is_empty()) {
+        if (input.match_index >= state.capture_group_matches.size())
+            state.capture_group_matches.resize(input.match_index + 1);
+        if (matched_state->capture_group_matches.is_empty())
+            state.capture_group_matches[input.match_index].clear();
+        else
+            state.capture_group_matches[input.match_index] = move(matched_state->capture_group_matches.first());
+    }
+
+    return true;
+}
+
 template class Matcher<PosixBasicParser>;
 template class Regex<PosixBasicParser>;
 
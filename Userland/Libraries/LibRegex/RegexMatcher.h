@@ -75,6 +75,7 @@ public:
 
 private:
     Optional<bool> execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    Optional<bool> execute_as_nfa(MatchInput const& input, MatchState& state, size_t& operations) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
@@ -232,6 +233,7 @@ private:
     using BasicBlockList = Vector<Detail::Block>;
     BasicBlockList split_basic_blocks();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
+    static bool has_backtracking_only_features(ByteCode const&);
 };
 
 // free standing functions for match, search and has_match
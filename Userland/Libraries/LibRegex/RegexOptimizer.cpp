@@ -24,6 +24,37 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(split_basic_blocks());
 
     parser_result.bytecode.flatten();
+
+    // Without backreferences and lookarounds, the pattern describes a regular language,
+    // so the matcher can fall back to simulating it as an NFA, which doesn't need to backtrack.
+    parser_result.can_be_simulated_as_nfa = !has_backtracking_only_features(parser_result.bytecode);
+}
+
+template<typename Parser>
+bool Regex<Parser>::has_backtracking_only_features(ByteCode const& bytecode)
+{
+    MatchState state;
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
+            if (any_of(compares, [](auto& compare) { return compare.type == CharacterCompareType::Reference; }))
+                return true;
+            break;
+        }
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+            // These implement lookarounds, which need the backtracking state of the VM.
+            return true;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    return false;
 }
 
 template<typename Parser>
@@ -54,6 +54,7 @@ public:
         Error error;
         Token error_token;
         Vector<FlyString> capture_groups;
+        bool can_be_simulated_as_nfa { false };
     };
 
     explicit Parser(Lexer& lexer)
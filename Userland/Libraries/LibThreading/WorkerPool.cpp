@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibThreading/WorkerPool.h>
+
+namespace Threading {
+
+WorkerPool::WorkerPool(size_t thread_count, StringView name)
+{
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto thread = Thread::construct([this] { return worker_loop(); }, String::formatted("{} #{}", name, i));
+        thread->start();
+        m_threads.append(move(thread));
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        MutexLocker locker(m_mutex);
+        m_exiting = true;
+        m_job_available.broadcast();
+    }
+    for (auto& thread : m_threads)
+        (void)thread.join();
+}
+
+void WorkerPool::enqueue(Function<void()> job)
+{
+    MutexLocker locker(m_mutex);
+    m_jobs.enqueue(move(job));
+    ++m_jobs_in_flight;
+    m_job_available.signal();
+}
+
+// Must be called with the mutex held. Returns false if there was nothing to run.
+bool WorkerPool::run_one_job(MutexLocker& locker)
+{
+    if (m_jobs.is_empty())
+        return false;
+    auto job = m_jobs.dequeue();
+    locker.unlock();
+    job();
+    locker.lock();
+    if (--m_jobs_in_flight == 0)
+        m_all_jobs_done.broadcast();
+    return true;
+}
+
+void WorkerPool::wait_for_all()
+{
+    MutexLocker locker(m_mutex);
+    while (run_one_job(locker))
+        ;
+    while (m_jobs_in_flight > 0)
+        m_all_jobs_done.wait();
+}
+
+intptr_t WorkerPool::worker_loop()
+{
+    MutexLocker locker(m_mutex);
+    for (;;) {
+        while (m_jobs.is_empty() && !m_exiting)
+            m_job_available.wait();
+        if (m_exiting)
+            return 0;
+        run_one_job(locker);
+    }
+}
+
+}
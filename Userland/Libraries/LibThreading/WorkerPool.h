@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Queue.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A fixed set of threads that run short jobs in parallel.
+// The thread waiting for the jobs to finish lends a hand, so a pool with N threads runs up to N + 1 jobs at once.
+class WorkerPool : public RefCounted<WorkerPool> {
+    AK_MAKE_NONCOPYABLE(WorkerPool);
+    AK_MAKE_NONMOVABLE(WorkerPool);
+
+public:
+    static NonnullRefPtr<WorkerPool> create(size_t thread_count, StringView name)
+    {
+        return adopt_ref(*new WorkerPool(thread_count, name));
+    }
+
+    ~WorkerPool();
+
+    size_t thread_count() const { return m_threads.size(); }
+
+    void enqueue(Function<void()>);
+
+    // Runs queued jobs on the calling thread until every job enqueued so far has finished.
+    void wait_for_all();
+
+    // Convenience wrapper for the common case of running a batch of jobs to completion.
+    template<typename Callback>
+    void for_each_in_parallel(size_t job_count, Callback callback)
+    {
+        for (size_t i = 0; i < job_count; ++i)
+            enqueue([&callback, i] { callback(i); });
+        wait_for_all();
+    }
+
+private:
+    WorkerPool(size_t thread_count, StringView name);
+
+    bool run_one_job(MutexLocker&);
+    intptr_t worker_loop();
+
+    NonnullRefPtrVector<Thread> m_threads;
+    Queue<Function<void()>> m_jobs;
+    Mutex m_mutex;
+    ConditionVariable m_job_available { m_mutex };
+    ConditionVariable m_all_jobs_done { m_mutex };
+    size_t m_jobs_in_flight { 0 };
+    bool m_exiting { false };
+};
+
+}
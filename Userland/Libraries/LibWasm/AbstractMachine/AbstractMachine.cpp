@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibThreading/WorkerPool.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
@@ -379,6 +380,35 @@ Optional<InstantiationError> AbstractMachine::allocate_all_initial_phase(Module
             index++;
         }
     });
+
+    // Now that everything the code refers to exists, lower the functions of this module to the register-based IR.
+    // Functions are lowered independently of each other, so the work for big modules is spread over the worker pool.
+    auto functions = module_instance.functions().span().slice_from_end(module.functions().size());
+    auto lower_functions = [this](Span<FunctionAddress> addresses) {
+        for (auto& address : addresses) {
+            auto& function = m_store.get(address)->get<WasmFunction>();
+            function.set_compiled_code(CompiledFunction::try_create(function, m_store));
+        }
+    };
+    Threading::WorkerPool* worker_pool = nullptr;
+    size_t job_start = 0;
+    size_t job_instruction_count = 0;
+    for (size_t i = 0; i + 1 < functions.size(); ++i) {
+        job_instruction_count += m_store.get(functions[i])->get<WasmFunction>().code().body().instructions().size();
+        if (job_instruction_count < Constants::parallel_job_instruction_count)
+            continue;
+        if (!worker_pool)
+            worker_pool = shared_worker_pool();
+        if (!worker_pool)
+            break;
+        worker_pool->enqueue([=] { lower_functions(functions.slice(job_start, i + 1 - job_start)); });
+        job_start = i + 1;
+        job_instruction_count = 0;
+    }
+    lower_functions(functions.slice(job_start));
+    if (worker_pool)
+        worker_pool->wait_for_all();
+
     module.for_each_section_of_type<ExportSection>([&](ExportSection const& section) {
         for (auto& entry : section.entries()) {
             Variant<FunctionAddress, TableAddress, MemoryAddress, GlobalAddress, Empty> address {};
@@ -11,6 +11,7 @@
 #include <AK/HashTable.h>
 #include <AK/OwnPtr.h>
 #include <AK/Result.h>
+#include <LibWasm/AbstractMachine/CompiledFunction.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -264,11 +265,14 @@ public:
     auto& type() const { return m_type; }
     auto& module() const { return m_module; }
     auto& code() const { return m_code; }
+    auto& compiled_code() const { return m_compiled_code; }
+    void set_compiled_code(RefPtr<CompiledFunction> compiled_code) { m_compiled_code = move(compiled_code); }
 
 private:
     FunctionType m_type;
     ModuleInstance const& m_module;
     Module::Function const& m_code;
+    RefPtr<CompiledFunction> m_compiled_code;
 };
 
 class HostFunction {
@@ -342,13 +346,19 @@ public:
             return true;
         auto new_size = m_data.size() + size_to_grow;
         // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
+        auto maximum_size = Constants::page_size * 65536;
+        if (new_size >= maximum_size)
             return false;
         if (auto max = m_type.limits().max(); max.has_value()) {
-            if (max.value() * Constants::page_size < new_size)
+            maximum_size = min(maximum_size, max.value() * Constants::page_size);
+            if (maximum_size < new_size)
                 return false;
         }
         auto previous_size = m_size;
+        // Leave room for the next few grows, so that growing page by page doesn't copy the whole memory every time.
+        // Not getting the extra space is fine, only the requested size is a must.
+        if (new_size > m_data.capacity())
+            (void)m_data.try_ensure_capacity(min(maximum_size, max(new_size, m_data.capacity() * 2)));
         if (!m_data.try_resize(new_size))
             return false;
         m_size = new_size;
@@ -55,6 +55,13 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
+Optional<Result> BytecodeInterpreter::call_compiled_function(Configuration& configuration, WasmFunction const& function, Vector<Value>& arguments)
+{
+    if (!function.compiled_code())
+        return {};
+    return function.compiled_code()->call(configuration, *this, m_stack_info, arguments);
+}
+
 void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
@@ -963,6 +970,14 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     }
 }
 
+Optional<Result> DebuggerBytecodeInterpreter::call_compiled_function(Configuration& configuration, WasmFunction const& function, Vector<Value>& arguments)
+{
+    // The hooks want to see every instruction, which the compiled code doesn't have.
+    if (pre_interpret_hook || post_interpret_hook)
+        return {};
+    return BytecodeInterpreter::call_compiled_function(configuration, function, arguments);
+}
+
 void DebuggerBytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     if (pre_interpret_hook) {
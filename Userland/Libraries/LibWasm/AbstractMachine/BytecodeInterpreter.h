@@ -18,6 +18,7 @@ struct BytecodeInterpreter : public Interpreter {
     virtual bool did_trap() const override { return m_trap.has_value(); }
     virtual String trap_reason() const override { return m_trap.value().reason; }
     virtual void clear_trap() override { m_trap.clear(); }
+    virtual Optional<Result> call_compiled_function(Configuration&, WasmFunction const&, Vector<Value>&) override;
 
     struct CallFrameHandle {
         explicit CallFrameHandle(BytecodeInterpreter& interpreter, Configuration& configuration)
@@ -75,6 +76,8 @@ struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     Function<bool(Configuration&, InstructionPointer&, Instruction const&)> pre_interpret_hook;
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
 
+    virtual Optional<Result> call_compiled_function(Configuration&, WasmFunction const&, Vector<Value>&) override;
+
 private:
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&) override;
 };
@@ -0,0 +1,1203 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
+#include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/HashMap.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/CompiledFunction.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/Interpreter.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/Opcode.h>
+#include <LibWasm/Printer/Printer.h>
+
+namespace Wasm {
+
+template<typename T>
+static constexpr ValueType::Kind value_kind()
+{
+    if constexpr (IsSame<T, float>)
+        return ValueType::F32;
+    else if constexpr (IsSame<T, double>)
+        return ValueType::F64;
+    else if constexpr (sizeof(T) == sizeof(u64))
+        return ValueType::I64;
+    else
+        return ValueType::I32;
+}
+
+template<typename T>
+ALWAYS_INLINE static T read_slot(u64 const& slot)
+{
+    T value;
+    __builtin_memcpy(&value, &slot, sizeof(T));
+    return value;
+}
+
+template<typename T>
+ALWAYS_INLINE static void write_slot(u64& slot, T value)
+{
+    __builtin_memcpy(&slot, &value, sizeof(T));
+}
+
+static u64 slot_from_value(Value const& value)
+{
+    u64 slot = 0;
+    value.value().visit(
+        [&](Reference const&) { VERIFY_NOT_REACHED(); },
+        [&](auto number) { write_slot(slot, number); });
+    return slot;
+}
+
+static Value value_from_slot(ValueType::Kind kind, u64 slot)
+{
+    switch (kind) {
+    case ValueType::I32:
+        return Value(read_slot<i32>(slot));
+    case ValueType::I64:
+        return Value(read_slot<i64>(slot));
+    case ValueType::F32:
+        return Value(read_slot<float>(slot));
+    case ValueType::F64:
+        return Value(read_slot<double>(slot));
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool has_only_numeric_types(Vector<ValueType> const& types)
+{
+    return all_of(types, [](auto& type) { return type.is_numeric(); });
+}
+
+class FunctionLowering {
+public:
+    FunctionLowering(CompiledFunction& function, WasmFunction const& wasm_function, Store& store)
+        : m_function(function)
+        , m_wasm_function(wasm_function)
+        , m_module(wasm_function.module())
+        , m_store(store)
+    {
+    }
+
+    bool lower();
+
+private:
+    struct StackEntry {
+        u32 slot { 0 };
+        ValueType::Kind kind { ValueType::I32 };
+    };
+
+    struct ControlFrame {
+        enum class Kind {
+            Block,
+            Loop,
+            If,
+            Function,
+        };
+        Kind kind { Kind::Block };
+        size_t height { 0 };
+        Vector<ValueType::Kind, 1> results;
+        // Where branches to this frame go; the start of a loop, the end of everything else.
+        size_t label { 0 };
+        // Where the condition of an `if` jumps to if it's false, until the `else` is seen.
+        Optional<size_t> else_label;
+        bool unreachable { false };
+    };
+
+    struct Condition {
+        IR::OpCode jump_if_true;
+        IR::OpCode jump_if_false;
+        u32 lhs { 0 };
+        u32 rhs { 0 };
+    };
+
+    bool lower(Instruction const&);
+    bool lower_block(Instruction const&);
+    bool lower_end_of_block(bool is_else);
+    bool lower_call(FunctionType const&, IR::Instruction);
+    bool set_local(size_t index, StackEntry value);
+    bool is_known_in_bounds(StackEntry address, u64 offset, size_t access_size) const;
+
+    void allocate_constants();
+    template<typename T>
+    void push_constant(T value)
+    {
+        // Constants live in slots of their own (set up on every call), so they can be used as operands directly.
+        u64 raw_value = 0;
+        write_slot(raw_value, value);
+        push({ m_local_count + m_constant_slots.get(raw_value).value(), value_kind<T>() });
+    }
+    u32 stack_slot(size_t height) const { return m_temporaries_base + height; }
+
+    size_t emit(IR::Instruction instruction)
+    {
+        m_instructions.append(instruction);
+        m_can_retarget_last_instruction = false;
+        return m_instructions.size() - 1;
+    }
+    // Emits an instruction that puts its result into the slot for the current top of the stack, and pushes that result.
+    void emit_with_result(IR::Instruction instruction, ValueType::Kind kind)
+    {
+        instruction.destination = push_result(kind);
+        emit(instruction);
+        m_can_retarget_last_instruction = true;
+    }
+
+    size_t make_label()
+    {
+        m_labels.append({});
+        return m_labels.size() - 1;
+    }
+    void bind_label(size_t label)
+    {
+        m_labels[label] = m_instructions.size();
+        m_can_retarget_last_instruction = false;
+    }
+
+    void push(StackEntry entry)
+    {
+        m_stack.append(entry);
+        m_max_height = max(m_max_height, m_stack.size());
+    }
+    u32 push_result(ValueType::Kind kind)
+    {
+        auto slot = stack_slot(m_stack.size());
+        push({ slot, kind });
+        return slot;
+    }
+    Optional<StackEntry> pop()
+    {
+        if (m_stack.size() <= m_frames.last().height)
+            return {};
+        return m_stack.take_last();
+    }
+    Optional<StackEntry> pop(ValueType::Kind kind)
+    {
+        auto entry = pop();
+        if (!entry.has_value() || entry->kind != kind)
+            return {};
+        return entry;
+    }
+
+    void materialize(size_t height)
+    {
+        auto& entry = m_stack[height];
+        if (entry.slot == stack_slot(height))
+            return;
+        emit({ IR::OpCode::move, stack_slot(height), entry.slot });
+        entry.slot = stack_slot(height);
+    }
+    // Moves every local and constant that is still only referred to on the stack into its stack slot,
+    // so all paths that meet at a label agree on where each value lives.
+    void materialize_all()
+    {
+        for (size_t i = 0; i < m_stack.size(); ++i)
+            materialize(i);
+    }
+
+    Condition take_condition(StackEntry);
+    void emit_conditional_jump(Condition const& condition, bool jump_if, size_t label)
+    {
+        emit({ jump_if ? condition.jump_if_true : condition.jump_if_false, 0, condition.lhs, condition.rhs, label });
+    }
+
+    ControlFrame& frame_for_label(size_t label_index) { return m_frames[m_frames.size() - label_index - 1]; }
+    static Vector<ValueType::Kind, 1> const& branch_kinds(ControlFrame const& frame)
+    {
+        static Vector<ValueType::Kind, 1> const no_kinds;
+        return frame.kind == ControlFrame::Kind::Loop ? no_kinds : frame.results;
+    }
+    bool check_branch_values(ControlFrame const&);
+    bool are_branch_values_in_place(ControlFrame const&);
+    void emit_branch(ControlFrame const&);
+    void mark_unreachable()
+    {
+        m_frames.last().unreachable = true;
+        m_skipped_blocks = 0;
+    }
+
+    CompiledFunction& m_function;
+    WasmFunction const& m_wasm_function;
+    ModuleInstance const& m_module;
+    Store& m_store;
+
+    Vector<ValueType::Kind> m_local_kinds;
+    HashMap<u64, u32> m_constant_slots;
+    u32 m_local_count { 0 };
+    u32 m_temporaries_base { 0 };
+    size_t m_minimum_memory_size { 0 };
+
+    Vector<IR::Instruction> m_instructions;
+    Vector<Optional<size_t>> m_labels;
+    Vector<StackEntry> m_stack;
+    Vector<ControlFrame> m_frames;
+    size_t m_max_height { 0 };
+    size_t m_skipped_blocks { 0 };
+    bool m_can_retarget_last_instruction { false };
+};
+
+void FunctionLowering::allocate_constants()
+{
+    for (auto& instruction : m_wasm_function.code().body().instructions()) {
+        u64 raw_value = 0;
+        switch (instruction.opcode().value()) {
+        case Instructions::i32_const.value():
+            write_slot(raw_value, instruction.arguments().get<i32>());
+            break;
+        case Instructions::i64_const.value():
+            write_slot(raw_value, instruction.arguments().get<i64>());
+            break;
+        case Instructions::f32_const.value():
+            write_slot(raw_value, instruction.arguments().get<float>());
+            break;
+        case Instructions::f64_const.value():
+            write_slot(raw_value, instruction.arguments().get<double>());
+            break;
+        default:
+            continue;
+        }
+        if (m_constant_slots.contains(raw_value))
+            continue;
+        m_constant_slots.set(raw_value, m_function.m_constants.size());
+        m_function.m_constants.append(raw_value);
+    }
+}
+
+// Memories can only ever grow, so a constant address that lies within the size the memory had when the module
+// got instantiated will stay valid for as long as the function exists.
+bool FunctionLowering::is_known_in_bounds(StackEntry address, u64 offset, size_t access_size) const
+{
+    if (address.slot < m_local_count || address.slot >= m_temporaries_base)
+        return false;
+    auto constant = read_slot<u32>(m_function.m_constants[address.slot - m_local_count]);
+    return static_cast<u64>(constant) + offset + access_size <= m_minimum_memory_size;
+}
+
+bool FunctionLowering::lower()
+{
+    auto& type = m_wasm_function.type();
+    if (!has_only_numeric_types(type.parameters()) || !has_only_numeric_types(type.results()) || !has_only_numeric_types(m_wasm_function.code().locals()))
+        return false;
+
+    for (auto& parameter : type.parameters())
+        m_local_kinds.append(parameter.kind());
+    for (auto& local : m_wasm_function.code().locals())
+        m_local_kinds.append(local.kind());
+    m_local_count = m_local_kinds.size();
+
+    allocate_constants();
+    m_temporaries_base = m_local_count + m_function.m_constants.size();
+    if (!m_module.memories().is_empty()) {
+        if (auto* memory = m_store.get(m_module.memories().first()))
+            m_minimum_memory_size = memory->size();
+    }
+
+    ControlFrame function_frame { ControlFrame::Kind::Function, 0, {}, make_label(), {}, false };
+    for (auto& result : type.results())
+        function_frame.results.append(result.kind());
+    m_frames.append(move(function_frame));
+
+    for (auto& instruction : m_wasm_function.code().body().instructions()) {
+        if (m_frames.last().unreachable) {
+            // Skip over everything up to the `else` or `end` that makes the code reachable again.
+            auto opcode = instruction.opcode();
+            if (opcode == Instructions::block || opcode == Instructions::loop || opcode == Instructions::if_) {
+                ++m_skipped_blocks;
+                continue;
+            }
+            if (opcode != Instructions::structured_else && opcode != Instructions::structured_end)
+                continue;
+            if (m_skipped_blocks > 0) {
+                if (opcode == Instructions::structured_end)
+                    --m_skipped_blocks;
+                continue;
+            }
+        }
+
+        if (!lower(instruction)) {
+            dbgln_if(WASM_TRACE_DEBUG, "Could not lower instruction {}, leaving the function to the interpreter", instruction_name(instruction.opcode()));
+            return false;
+        }
+    }
+
+    if (m_frames.size() != 1)
+        return false;
+
+    auto& frame = m_frames.last();
+    if (!frame.unreachable) {
+        if (m_stack.size() != frame.results.size() || !check_branch_values(frame))
+            return false;
+        materialize_all();
+    }
+    bind_label(frame.label);
+    emit({ IR::OpCode::return_ });
+
+    // Now that all labels are known, resolve the jump targets.
+    for (auto& instruction : m_instructions) {
+        switch (instruction.opcode) {
+#define __ENUMERATE_OPERATION(name, ...) case IR::OpCode::jump_if_##name:
+            ENUMERATE_WASM_IR_FUSED_COMPARISONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+        case IR::OpCode::jump:
+        case IR::OpCode::jump_if_zero:
+        case IR::OpCode::jump_if_not_zero: {
+            auto target = m_labels[instruction.immediate];
+            if (!target.has_value())
+                return false;
+            instruction.immediate = *target;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    for (auto& table : m_function.m_branch_tables) {
+        for (auto& entry : table) {
+            auto target = m_labels[entry.target];
+            if (!target.has_value())
+                return false;
+            entry.target = *target;
+        }
+    }
+
+    m_function.m_instructions = move(m_instructions);
+    m_function.m_local_count = m_local_count;
+    m_function.m_frame_size = m_temporaries_base + m_max_height;
+    for (auto& parameter : type.parameters())
+        m_function.m_parameter_kinds.append(parameter.kind());
+    for (auto& result : type.results())
+        m_function.m_result_kinds.append(result.kind());
+    return true;
+}
+
+FunctionLowering::Condition FunctionLowering::take_condition(StackEntry condition)
+{
+    // If the condition was just computed by a comparison, fold the comparison into the jump instead.
+    if (m_can_retarget_last_instruction && m_instructions.last().destination == condition.slot) {
+        auto last = m_instructions.last();
+        Optional<Condition> fused_condition;
+        switch (last.opcode) {
+#define __ENUMERATE_OPERATION(name, type, operator_, inverse)                                                       \
+    case IR::OpCode::name:                                                                                          \
+        fused_condition = Condition { IR::OpCode::jump_if_##name, IR::OpCode::jump_if_##inverse, last.lhs, last.rhs }; \
+        break;
+            ENUMERATE_WASM_IR_FUSED_COMPARISONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+        case IR::OpCode::i32_eqz:
+            fused_condition = Condition { IR::OpCode::jump_if_zero, IR::OpCode::jump_if_not_zero, last.lhs, 0 };
+            break;
+        default:
+            break;
+        }
+        if (fused_condition.has_value()) {
+            m_instructions.take_last();
+            m_can_retarget_last_instruction = false;
+            return *fused_condition;
+        }
+    }
+    return Condition { IR::OpCode::jump_if_not_zero, IR::OpCode::jump_if_zero, condition.slot, 0 };
+}
+
+bool FunctionLowering::check_branch_values(ControlFrame const& target)
+{
+    auto& kinds = branch_kinds(target);
+    if (m_stack.size() < m_frames.last().height + kinds.size())
+        return false;
+    auto values = m_stack.span().slice_from_end(kinds.size());
+    for (size_t i = 0; i < kinds.size(); ++i) {
+        if (values[i].kind != kinds[i])
+            return false;
+    }
+    return true;
+}
+
+bool FunctionLowering::are_branch_values_in_place(ControlFrame const& target)
+{
+    auto count = branch_kinds(target).size();
+    for (size_t i = 0; i < count; ++i) {
+        if (m_stack[m_stack.size() - count + i].slot != stack_slot(target.height + i))
+            return false;
+    }
+    return true;
+}
+
+void FunctionLowering::emit_branch(ControlFrame const& target)
+{
+    // The result slots of the target are below the values that are moved there, so copying upwards never clobbers a value that is yet to be moved.
+    auto count = branch_kinds(target).size();
+    for (size_t i = 0; i < count; ++i) {
+        auto source = m_stack[m_stack.size() - count + i].slot;
+        auto destination = stack_slot(target.height + i);
+        if (source != destination)
+            emit({ IR::OpCode::move, destination, source });
+    }
+    if (target.kind == ControlFrame::Kind::Function)
+        emit({ IR::OpCode::return_ });
+    else
+        emit({ IR::OpCode::jump, 0, 0, 0, target.label });
+}
+
+bool FunctionLowering::lower_block(Instruction const& instruction)
+{
+    auto& block_type = instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type;
+    ControlFrame frame;
+    switch (block_type.kind()) {
+    case BlockType::Empty:
+        break;
+    case BlockType::Type:
+        if (!block_type.value_type().is_numeric())
+            return false;
+        frame.results.append(block_type.value_type().kind());
+        break;
+    case BlockType::Index:
+        // FIXME: Blocks with parameters or multiple results.
+        return false;
+    }
+
+    Optional<Condition> condition;
+    if (instruction.opcode() == Instructions::if_) {
+        auto value = pop(ValueType::I32);
+        if (!value.has_value())
+            return false;
+        condition = take_condition(*value);
+    }
+
+    materialize_all();
+    frame.height = m_stack.size();
+    frame.label = make_label();
+
+    if (instruction.opcode() == Instructions::loop) {
+        frame.kind = ControlFrame::Kind::Loop;
+        bind_label(frame.label);
+    } else if (instruction.opcode() == Instructions::if_) {
+        frame.kind = ControlFrame::Kind::If;
+        frame.else_label = make_label();
+        emit_conditional_jump(*condition, false, *frame.else_label);
+    }
+
+    m_frames.append(move(frame));
+    return true;
+}
+
+bool FunctionLowering::lower_end_of_block(bool is_else)
+{
+    if (m_frames.size() < 2)
+        return false;
+    auto& frame = m_frames.last();
+    if (is_else && (frame.kind != ControlFrame::Kind::If || !frame.else_label.has_value()))
+        return false;
+
+    if (!frame.unreachable) {
+        if (m_stack.size() != frame.height + frame.results.size())
+            return false;
+        for (size_t i = 0; i < frame.results.size(); ++i) {
+            if (m_stack[frame.height + i].kind != frame.results[i])
+                return false;
+        }
+        materialize_all();
+        if (is_else)
+            emit({ IR::OpCode::jump, 0, 0, 0, frame.label });
+    }
+    m_stack.shrink(frame.height);
+
+    if (is_else) {
+        bind_label(frame.else_label.release_value());
+        frame.unreachable = false;
+        return true;
+    }
+
+    if (frame.else_label.has_value()) {
+        // An `if` without an `else` can't produce a value.
+        if (!frame.results.is_empty())
+            return false;
+        bind_label(*frame.else_label);
+    }
+    if (frame.kind != ControlFrame::Kind::Loop)
+        bind_label(frame.label);
+
+    auto frame_to_leave = m_frames.take_last();
+    for (auto kind : frame_to_leave.results)
+        push_result(kind);
+    return true;
+}
+
+bool FunctionLowering::lower_call(FunctionType const& type, IR::Instruction instruction)
+{
+    if (!has_only_numeric_types(type.parameters()) || !has_only_numeric_types(type.results()))
+        return false;
+
+    auto& parameters = type.parameters();
+    if (m_stack.size() < m_frames.last().height + parameters.size())
+        return false;
+    auto base = m_stack.size() - parameters.size();
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (m_stack[base + i].kind != parameters[i].kind())
+            return false;
+        materialize(base + i);
+    }
+
+    // The arguments are passed in, and the results come back in, the stack slots starting at the first argument.
+    instruction.destination = stack_slot(base);
+    emit(instruction);
+    m_stack.shrink(base);
+    for (auto& result : type.results())
+        push_result(result.kind());
+    return true;
+}
+
+bool FunctionLowering::set_local(size_t index, StackEntry value)
+{
+    if (value.slot == index)
+        return true;
+
+    bool is_still_on_the_stack = any_of(m_stack, [&](auto& entry) { return entry.slot == index; });
+    if (!is_still_on_the_stack && m_can_retarget_last_instruction && m_instructions.last().destination == value.slot) {
+        // Have the instruction that computed the value write it into the local directly.
+        m_instructions.last().destination = index;
+        m_can_retarget_last_instruction = false;
+        return true;
+    }
+
+    for (size_t i = 0; i < m_stack.size(); ++i) {
+        if (m_stack[i].slot == index)
+            materialize(i);
+    }
+    emit({ IR::OpCode::move, static_cast<u32>(index), value.slot });
+    return true;
+}
+
+bool FunctionLowering::lower(Instruction const& instruction)
+{
+    auto opcode = instruction.opcode();
+    switch (opcode.value()) {
+    case Instructions::unreachable.value():
+        emit({ IR::OpCode::unreachable });
+        mark_unreachable();
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::if_.value():
+        return lower_block(instruction);
+    case Instructions::structured_else.value():
+        return lower_end_of_block(true);
+    case Instructions::structured_end.value():
+        return lower_end_of_block(false);
+    case Instructions::br.value(): {
+        auto label_index = instruction.arguments().get<LabelIndex>().value();
+        if (label_index >= m_frames.size())
+            return false;
+        auto& target = frame_for_label(label_index);
+        if (!check_branch_values(target))
+            return false;
+        emit_branch(target);
+        mark_unreachable();
+        return true;
+    }
+    case Instructions::br_if.value(): {
+        auto label_index = instruction.arguments().get<LabelIndex>().value();
+        if (label_index >= m_frames.size())
+            return false;
+        auto value = pop(ValueType::I32);
+        if (!value.has_value())
+            return false;
+        auto condition = take_condition(*value);
+        auto& target = frame_for_label(label_index);
+        if (!check_branch_values(target))
+            return false;
+        if (are_branch_values_in_place(target)) {
+            emit_conditional_jump(condition, true, target.label);
+            return true;
+        }
+        auto fallthrough_label = make_label();
+        emit_conditional_jump(condition, false, fallthrough_label);
+        emit_branch(target);
+        bind_label(fallthrough_label);
+        return true;
+    }
+    case Instructions::br_table.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto index = pop(ValueType::I32);
+        if (!index.has_value() || arguments.default_.value() >= m_frames.size())
+            return false;
+        auto& default_target = frame_for_label(arguments.default_.value());
+        if (!check_branch_values(default_target))
+            return false;
+        auto count = branch_kinds(default_target).size();
+        for (size_t i = m_stack.size() - count; i < m_stack.size(); ++i)
+            materialize(i);
+
+        Vector<IR::BranchTableEntry> table;
+        table.ensure_capacity(arguments.labels.size() + 1);
+        auto append_entry = [&](LabelIndex label_index) {
+            if (label_index.value() >= m_frames.size())
+                return false;
+            auto& target = frame_for_label(label_index.value());
+            if (branch_kinds(target) != branch_kinds(default_target))
+                return false;
+            table.unchecked_append({ static_cast<u32>(target.label), stack_slot(target.height) });
+            return true;
+        };
+        for (auto& label_index : arguments.labels) {
+            if (!append_entry(label_index))
+                return false;
+        }
+        if (!append_entry(arguments.default_))
+            return false;
+
+        emit({ IR::OpCode::branch_table, static_cast<u32>(count), index->slot, stack_slot(m_stack.size() - count), m_function.m_branch_tables.size() });
+        m_function.m_branch_tables.append(move(table));
+        mark_unreachable();
+        return true;
+    }
+    case Instructions::return_.value(): {
+        auto& target = m_frames.first();
+        if (!check_branch_values(target))
+            return false;
+        emit_branch(target);
+        mark_unreachable();
+        return true;
+    }
+    case Instructions::call.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>();
+        if (index.value() >= m_module.functions().size())
+            return false;
+        auto* callee = m_store.get(m_module.functions()[index.value()]);
+        if (!callee)
+            return false;
+        FunctionType const* type { nullptr };
+        callee->visit([&](auto& function) { type = &function.type(); });
+        return lower_call(*type, { IR::OpCode::call, 0, 0, 0, index.value() });
+    }
+    case Instructions::call_indirect.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::IndirectCallArgs>();
+        if (arguments.type.value() >= m_module.types().size() || arguments.table.value() >= m_module.tables().size())
+            return false;
+        auto index = pop(ValueType::I32);
+        if (!index.has_value())
+            return false;
+        return lower_call(m_module.types()[arguments.type.value()], { IR::OpCode::call_indirect, 0, index->slot, static_cast<u32>(arguments.table.value()), arguments.type.value() });
+    }
+    case Instructions::drop.value():
+        return pop().has_value();
+    case Instructions::select.value():
+    case Instructions::select_typed.value(): {
+        auto condition = pop(ValueType::I32);
+        if (!condition.has_value())
+            return false;
+        auto rhs = pop();
+        if (!rhs.has_value())
+            return false;
+        auto lhs = pop(rhs->kind);
+        if (!lhs.has_value())
+            return false;
+        emit_with_result({ IR::OpCode::select, 0, lhs->slot, rhs->slot, condition->slot }, lhs->kind);
+        return true;
+    }
+    case Instructions::local_get.value(): {
+        auto index = instruction.arguments().get<LocalIndex>().value();
+        if (index >= m_local_count)
+            return false;
+        // Locals are used in place, until something would overwrite them.
+        push({ static_cast<u32>(index), m_local_kinds[index] });
+        return true;
+    }
+    case Instructions::local_set.value():
+    case Instructions::local_tee.value(): {
+        auto index = instruction.arguments().get<LocalIndex>().value();
+        if (index >= m_local_count)
+            return false;
+        auto value = pop(m_local_kinds[index]);
+        if (!value.has_value() || !set_local(index, *value))
+            return false;
+        if (opcode == Instructions::local_tee)
+            push({ static_cast<u32>(index), m_local_kinds[index] });
+        return true;
+    }
+    case Instructions::global_get.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (index >= m_module.globals().size())
+            return false;
+        auto address = m_module.globals()[index];
+        auto* global = m_store.get(address);
+        if (!global || !global->value().type().is_numeric())
+            return false;
+        emit_with_result({ IR::OpCode::global_get, 0, 0, 0, address.value() }, global->value().type().kind());
+        return true;
+    }
+    case Instructions::global_set.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (index >= m_module.globals().size())
+            return false;
+        auto address = m_module.globals()[index];
+        auto* global = m_store.get(address);
+        if (!global || !global->is_mutable() || !global->value().type().is_numeric())
+            return false;
+        auto value = pop(global->value().type().kind());
+        if (!value.has_value())
+            return false;
+        emit({ IR::OpCode::global_set, 0, value->slot, 0, address.value() });
+        return true;
+    }
+    case Instructions::memory_size.value():
+        if (m_module.memories().is_empty())
+            return false;
+        emit_with_result({ IR::OpCode::memory_size }, ValueType::I32);
+        return true;
+    case Instructions::memory_grow.value(): {
+        auto pages = pop(ValueType::I32);
+        if (m_module.memories().is_empty() || !pages.has_value())
+            return false;
+        emit_with_result({ IR::OpCode::memory_grow, 0, pages->slot }, ValueType::I32);
+        return true;
+    }
+    case Instructions::i32_const.value():
+        push_constant(instruction.arguments().get<i32>());
+        return true;
+    case Instructions::i64_const.value():
+        push_constant(instruction.arguments().get<i64>());
+        return true;
+    case Instructions::f32_const.value():
+        push_constant(instruction.arguments().get<float>());
+        return true;
+    case Instructions::f64_const.value():
+        push_constant(instruction.arguments().get<double>());
+        return true;
+
+#define __ENUMERATE_OPERATION(name, OperandType, ResultType, ...)                         \
+    case Instructions::name.value(): {                                                    \
+        auto rhs = pop(value_kind<OperandType>());                                        \
+        auto lhs = pop(value_kind<OperandType>());                                        \
+        if (!lhs.has_value() || !rhs.has_value())                                         \
+            return false;                                                                 \
+        emit_with_result({ IR::OpCode::name, 0, lhs->slot, rhs->slot }, value_kind<ResultType>()); \
+        return true;                                                                      \
+    }
+        ENUMERATE_WASM_IR_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+#define __ENUMERATE_OPERATION(name, OperandType, ResultType, ...)                      \
+    case Instructions::name.value(): {                                                 \
+        auto value = pop(value_kind<OperandType>());                                   \
+        if (!value.has_value())                                                        \
+            return false;                                                              \
+        emit_with_result({ IR::OpCode::name, 0, value->slot }, value_kind<ResultType>()); \
+        return true;                                                                   \
+    }
+        ENUMERATE_WASM_IR_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+#define __ENUMERATE_OPERATION(name, MemoryType, StackType)                                                 \
+    case Instructions::name.value(): {                                                                     \
+        auto address = pop(ValueType::I32);                                                                \
+        if (m_module.memories().is_empty() || !address.has_value())                                        \
+            return false;                                                                                  \
+        auto offset = instruction.arguments().get<Instruction::MemoryArgument>().offset;                   \
+        auto opcode = is_known_in_bounds(*address, offset, sizeof(MemoryType))                             \
+            ? IR::OpCode::name##_in_bounds                                                                 \
+            : IR::OpCode::name;                                                                            \
+        emit_with_result({ opcode, 0, address->slot, 0, offset }, value_kind<StackType>());                \
+        return true;                                                                                       \
+    }
+        ENUMERATE_WASM_IR_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+#define __ENUMERATE_OPERATION(name, StackType, MemoryType)                               \
+    case Instructions::name.value(): {                                                   \
+        auto value = pop(value_kind<StackType>());                                       \
+        auto address = pop(ValueType::I32);                                              \
+        if (m_module.memories().is_empty() || !value.has_value() || !address.has_value()) \
+            return false;                                                                \
+        auto offset = instruction.arguments().get<Instruction::MemoryArgument>().offset; \
+        auto opcode = is_known_in_bounds(*address, offset, sizeof(MemoryType))           \
+            ? IR::OpCode::name##_in_bounds                                               \
+            : IR::OpCode::name;                                                          \
+        emit({ opcode, 0, address->slot, value->slot, offset });                         \
+        return true;                                                                     \
+    }
+        ENUMERATE_WASM_IR_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+    default:
+        // Reference types, tables and bulk memory operations are left to the interpreter.
+        return false;
+    }
+}
+
+RefPtr<CompiledFunction> CompiledFunction::try_create(WasmFunction const& wasm_function, Store& store)
+{
+    auto function = adopt_ref(*new CompiledFunction(wasm_function.module()));
+    FunctionLowering lowering { *function, wasm_function, store };
+    if (!lowering.lower())
+        return {};
+    return function;
+}
+
+template<typename T>
+ALWAYS_INLINE static T read_from_memory(u8 const* data)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        using RawType = Conditional<IsSame<T, float>, u32, u64>;
+        return bit_cast<T>(read_from_memory<RawType>(data));
+    } else {
+        T value;
+        __builtin_memcpy(&value, data, sizeof(T));
+        return AK::convert_between_host_and_little_endian(value);
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE static void write_to_memory(u8* data, T value)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        using RawType = Conditional<IsSame<T, float>, u32, u64>;
+        write_to_memory(data, bit_cast<RawType>(value));
+    } else {
+        value = AK::convert_between_host_and_little_endian(value);
+        __builtin_memcpy(data, &value, sizeof(T));
+    }
+}
+
+static MemoryInstance* memory_of(Configuration& configuration, ModuleInstance const& module)
+{
+    if (module.memories().is_empty())
+        return nullptr;
+    return configuration.store().get(module.memories().first());
+}
+
+static bool have_same_kinds(Vector<ValueType> const& lhs, Vector<ValueType> const& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i].kind() != rhs[i].kind())
+            return false;
+    }
+    return true;
+}
+
+static Optional<Trap> call_address(Configuration& configuration, Interpreter& interpreter, StackInfo const& stack_info, FunctionAddress address, u64* arguments_and_results)
+{
+    auto* instance = configuration.store().get(address);
+    if (!instance)
+        return Trap { "Call to a nonexistent function" };
+
+    if (auto* wasm_function = instance->get_pointer<WasmFunction>(); wasm_function && wasm_function->compiled_code())
+        return wasm_function->compiled_code()->call_with_slots(configuration, interpreter, stack_info, arguments_and_results);
+
+    // Anything else goes through the configuration (and possibly the interpreter), which wants Values.
+    FunctionType const* type { nullptr };
+    instance->visit([&](auto const& function) { type = &function.type(); });
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type->parameters().size());
+    for (size_t i = 0; i < type->parameters().size(); ++i)
+        arguments.unchecked_append(value_from_slot(type->parameters()[i].kind(), arguments_and_results[i]));
+
+    Result result { Trap { ""sv } };
+    {
+        Configuration::CallFrameHandle handle { configuration };
+        result = configuration.call(interpreter, address, move(arguments));
+    }
+    if (result.is_trap())
+        return move(result.trap());
+
+    if (result.values().size() != type->results().size())
+        return Trap { "Function returned the wrong number of values" };
+    for (size_t i = 0; i < type->results().size(); ++i) {
+        auto& value = result.values()[i];
+        if (value.type().kind() != type->results()[i].kind())
+            return Trap { "Function returned a value of the wrong type" };
+        arguments_and_results[i] = slot_from_value(value);
+    }
+    return {};
+}
+
+Result CompiledFunction::call(Configuration& configuration, Interpreter& interpreter, StackInfo const& stack_info, Vector<Value>& arguments) const
+{
+    if (arguments.size() != m_parameter_kinds.size())
+        return Trap { "Function called with the wrong number of arguments" };
+
+    Vector<u64, 8> slots;
+    slots.resize(max(m_parameter_kinds.size(), m_result_kinds.size()));
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i].type().kind() != m_parameter_kinds[i])
+            return Trap { "Function called with an argument of the wrong type" };
+        slots[i] = slot_from_value(arguments[i]);
+    }
+
+    if (auto trap = call_with_slots(configuration, interpreter, stack_info, slots.data()); trap.has_value())
+        return trap.release_value();
+
+    Vector<Value> results;
+    results.ensure_capacity(m_result_kinds.size());
+    for (size_t i = 0; i < m_result_kinds.size(); ++i)
+        results.unchecked_append(value_from_slot(m_result_kinds[i], slots[i]));
+    return Result { move(results) };
+}
+
+Optional<Trap> CompiledFunction::call_with_slots(Configuration& configuration, Interpreter& interpreter, StackInfo const& stack_info, u64* arguments_and_results) const
+{
+    if (stack_info.size_free() < Constants::minimum_stack_space_to_keep_free)
+        return Trap { "Call stack exhausted" };
+
+    // Locals start out as zero, which resize() takes care of.
+    Vector<u64, 64> slots;
+    slots.resize(m_frame_size);
+    __builtin_memcpy(slots.data(), arguments_and_results, m_parameter_kinds.size() * sizeof(u64));
+    __builtin_memcpy(slots.data() + m_local_count, m_constants.data(), m_constants.size() * sizeof(u64));
+
+    if (auto trap = execute(configuration, interpreter, stack_info, slots.data()); trap.has_value())
+        return trap;
+
+    auto results_base = m_local_count + m_constants.size();
+    __builtin_memcpy(arguments_and_results, slots.data() + results_base, m_result_kinds.size() * sizeof(u64));
+    return {};
+}
+
+template<typename OperandType, typename ResultType, typename Operator>
+ALWAYS_INLINE static bool binary_operation(IR::Instruction const& instruction, u64* slots, StringView& error)
+{
+    auto lhs = read_slot<OperandType>(slots[instruction.lhs]);
+    auto rhs = read_slot<OperandType>(slots[instruction.rhs]);
+    auto result = Operator {}(lhs, rhs);
+    if constexpr (IsSpecializationOf<decltype(result), AK::Result>) {
+        if (result.is_error()) {
+            error = result.error();
+            return false;
+        }
+        write_slot(slots[instruction.destination], static_cast<ResultType>(result.value()));
+    } else {
+        write_slot(slots[instruction.destination], static_cast<ResultType>(result));
+    }
+    return true;
+}
+
+template<typename OperandType, typename ResultType, typename Operator>
+ALWAYS_INLINE static bool unary_operation(IR::Instruction const& instruction, u64* slots, StringView& error)
+{
+    auto result = Operator {}(read_slot<OperandType>(slots[instruction.lhs]));
+    if constexpr (IsSpecializationOf<decltype(result), AK::Result>) {
+        if (result.is_error()) {
+            error = result.error();
+            return false;
+        }
+        write_slot(slots[instruction.destination], static_cast<ResultType>(result.value()));
+    } else {
+        write_slot(slots[instruction.destination], static_cast<ResultType>(result));
+    }
+    return true;
+}
+
+Optional<Trap> CompiledFunction::execute(Configuration& configuration, Interpreter& interpreter, StackInfo const& stack_info, u64* slots) const
+{
+    auto const* instructions = m_instructions.data();
+    auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+    u64 executed_backward_jumps = 0;
+    auto* memory = memory_of(configuration, m_module);
+    size_t ip = 0;
+    StringView error;
+
+    // Calls and memory.grow may resize (and thereby move) the memory, these are refreshed after every one of them.
+    u8* memory_data = nullptr;
+    size_t memory_size = 0;
+    auto refresh_memory = [&] {
+        memory = memory_of(configuration, m_module);
+        memory_data = memory ? memory->data().data() : nullptr;
+        memory_size = memory ? memory->size() : 0;
+    };
+    refresh_memory();
+
+    // Only backward jumps can make a function run forever, so that's where the instruction limit gets enforced.
+#define JUMP_TO(target)                                                                                                              \
+    do {                                                                                                                             \
+        auto new_ip = (target);                                                                                                      \
+        if (should_limit_instruction_count && new_ip <= ip) {                                                                        \
+            if (executed_backward_jumps++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]]                     \
+                return Trap { "Exceeded maximum allowed number of instructions" };                                                   \
+        }                                                                                                                            \
+        ip = new_ip;                                                                                                                 \
+    } while (false)
+
+    for (;;) {
+        auto& instruction = instructions[ip];
+        switch (instruction.opcode) {
+#define __ENUMERATE_OPERATION(name, OperandType, ResultType, Operator)                         \
+    case IR::OpCode::name:                                                                     \
+        if (!binary_operation<OperandType, ResultType, Operator>(instruction, slots, error)) \
+            return Trap { error };                                                             \
+        ++ip;                                                                                  \
+        continue;
+            ENUMERATE_WASM_IR_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+#define __ENUMERATE_OPERATION(name, OperandType, ResultType, Operator)                        \
+    case IR::OpCode::name:                                                                    \
+        if (!unary_operation<OperandType, ResultType, Operator>(instruction, slots, error)) \
+            return Trap { error };                                                            \
+        ++ip;                                                                                 \
+        continue;
+            ENUMERATE_WASM_IR_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+#define __ENUMERATE_OPERATION(name, MemoryType, StackType)                                               \
+    case IR::OpCode::name: {                                                                             \
+        auto address = static_cast<u64>(read_slot<u32>(slots[instruction.lhs])) + instruction.immediate; \
+        if (address + sizeof(MemoryType) > memory_size)                                                  \
+            return Trap { "Memory access out of bounds" };                                               \
+        auto value = read_from_memory<MemoryType>(memory_data + address);                                \
+        write_slot(slots[instruction.destination], static_cast<StackType>(value));                       \
+        ++ip;                                                                                            \
+        continue;                                                                                        \
+    }                                                                                                    \
+    case IR::OpCode::name##_in_bounds: {                                                                 \
+        auto address = static_cast<u64>(read_slot<u32>(slots[instruction.lhs])) + instruction.immediate; \
+        auto value = read_from_memory<MemoryType>(memory_data + address);                                \
+        write_slot(slots[instruction.destination], static_cast<StackType>(value));                       \
+        ++ip;                                                                                            \
+        continue;                                                                                        \
+    }
+            ENUMERATE_WASM_IR_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+#define __ENUMERATE_OPERATION(name, StackType, MemoryType)                                               \
+    case IR::OpCode::name: {                                                                             \
+        auto address = static_cast<u64>(read_slot<u32>(slots[instruction.lhs])) + instruction.immediate; \
+        if (address + sizeof(MemoryType) > memory_size)                                                  \
+            return Trap { "Memory access out of bounds" };                                               \
+        auto value = static_cast<MemoryType>(read_slot<StackType>(slots[instruction.rhs]));              \
+        write_to_memory(memory_data + address, value);                                                   \
+        ++ip;                                                                                            \
+        continue;                                                                                        \
+    }                                                                                                    \
+    case IR::OpCode::name##_in_bounds: {                                                                 \
+        auto address = static_cast<u64>(read_slot<u32>(slots[instruction.lhs])) + instruction.immediate; \
+        auto value = static_cast<MemoryType>(read_slot<StackType>(slots[instruction.rhs]));              \
+        write_to_memory(memory_data + address, value);                                                   \
+        ++ip;                                                                                            \
+        continue;                                                                                        \
+    }
+            ENUMERATE_WASM_IR_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+#define __ENUMERATE_OPERATION(name, OperandType, Operator, inverse)                                                                 \
+    case IR::OpCode::jump_if_##name:                                                                                                \
+        if (Operator {}(read_slot<OperandType>(slots[instruction.lhs]), read_slot<OperandType>(slots[instruction.rhs]))) \
+            JUMP_TO(instruction.immediate);                                                                                         \
+        else                                                                                                                        \
+            ++ip;                                                                                                                   \
+        continue;
+            ENUMERATE_WASM_IR_FUSED_COMPARISONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+
+        case IR::OpCode::move:
+            slots[instruction.destination] = slots[instruction.lhs];
+            ++ip;
+            continue;
+        case IR::OpCode::select:
+            slots[instruction.destination] = read_slot<i32>(slots[instruction.immediate]) != 0 ? slots[instruction.lhs] : slots[instruction.rhs];
+            ++ip;
+            continue;
+        case IR::OpCode::jump:
+            JUMP_TO(instruction.immediate);
+            continue;
+        case IR::OpCode::jump_if_zero:
+            if (read_slot<i32>(slots[instruction.lhs]) == 0)
+                JUMP_TO(instruction.immediate);
+            else
+                ++ip;
+            continue;
+        case IR::OpCode::jump_if_not_zero:
+            if (read_slot<i32>(slots[instruction.lhs]) != 0)
+                JUMP_TO(instruction.immediate);
+            else
+                ++ip;
+            continue;
+        case IR::OpCode::branch_table: {
+            auto& table = m_branch_tables[instruction.immediate];
+            auto index = read_slot<u32>(slots[instruction.lhs]);
+            auto& entry = index < table.size() - 1 ? table[index] : table.last();
+            for (size_t i = 0; i < instruction.destination; ++i)
+                slots[entry.result_slot + i] = slots[instruction.rhs + i];
+            JUMP_TO(entry.target);
+            continue;
+        }
+        case IR::OpCode::call: {
+            auto address = m_module.functions()[instruction.immediate];
+            if (auto trap = call_address(configuration, interpreter, stack_info, address, slots + instruction.destination); trap.has_value())
+                return trap;
+            refresh_memory();
+            ++ip;
+            continue;
+        }
+        case IR::OpCode::call_indirect: {
+            auto* table = configuration.store().get(m_module.tables()[instruction.rhs]);
+            if (!table)
+                return Trap { "Indirect call through a nonexistent table" };
+            auto index = read_slot<u32>(slots[instruction.lhs]);
+            if (index >= table->elements().size())
+                return Trap { "Indirect call to an out of bounds table element" };
+            auto& element = table->elements()[index];
+            if (!element.has_value() || !element->ref().has<Reference::Func>())
+                return Trap { "Indirect call to an uninitialized table element" };
+            auto address = element->ref().get<Reference::Func>().address;
+            auto* callee = configuration.store().get(address);
+            if (!callee)
+                return Trap { "Indirect call to a nonexistent function" };
+            FunctionType const* callee_type { nullptr };
+            callee->visit([&](auto const& function) { callee_type = &function.type(); });
+            auto& expected_type = m_module.types()[instruction.immediate];
+            if (!have_same_kinds(callee_type->parameters(), expected_type.parameters()) || !have_same_kinds(callee_type->results(), expected_type.results()))
+                return Trap { "Indirect call to a function of the wrong type" };
+            if (auto trap = call_address(configuration, interpreter, stack_info, address, slots + instruction.destination); trap.has_value())
+                return trap;
+            refresh_memory();
+            ++ip;
+            continue;
+        }
+        case IR::OpCode::global_get: {
+            auto* global = configuration.store().get(GlobalAddress { instruction.immediate });
+            slots[instruction.destination] = slot_from_value(global->value());
+            ++ip;
+            continue;
+        }
+        case IR::OpCode::global_set: {
+            auto* global = configuration.store().get(GlobalAddress { instruction.immediate });
+            global->set_value(value_from_slot(global->value().type().kind(), slots[instruction.lhs]));
+            ++ip;
+            continue;
+        }
+        case IR::OpCode::memory_size:
+            write_slot(slots[instruction.destination], static_cast<i32>(memory_size / Constants::page_size));
+            ++ip;
+            continue;
+        case IR::OpCode::memory_grow: {
+            auto old_pages = static_cast<i32>(memory->size() / Constants::page_size);
+            auto new_pages = read_slot<u32>(slots[instruction.lhs]);
+            if (memory->grow(static_cast<size_t>(new_pages) * Constants::page_size))
+                write_slot(slots[instruction.destination], old_pages);
+            else
+                write_slot(slots[instruction.destination], static_cast<i32>(-1));
+            refresh_memory();
+            ++ip;
+            continue;
+        }
+        case IR::OpCode::return_:
+            return {};
+        case IR::OpCode::unreachable:
+            return Trap { "Unreachable" };
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+#undef JUMP_TO
+}
+
+}
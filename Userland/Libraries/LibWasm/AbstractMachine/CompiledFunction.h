@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/StackInfo.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+class Configuration;
+class FunctionLowering;
+class ModuleInstance;
+class Result;
+class Store;
+class Value;
+class WasmFunction;
+struct Interpreter;
+struct Trap;
+
+// Numeric instructions that pop two operands and push one result: (name, operand type, result type, operator).
+#define ENUMERATE_WASM_IR_BINARY_OPERATIONS(M)                              \
+    M(i32_eq, i32, i32, Operators::Equals)                                  \
+    M(i32_ne, i32, i32, Operators::NotEquals)                               \
+    M(i32_lts, i32, i32, Operators::LessThan)                               \
+    M(i32_ltu, u32, i32, Operators::LessThan)                               \
+    M(i32_gts, i32, i32, Operators::GreaterThan)                            \
+    M(i32_gtu, u32, i32, Operators::GreaterThan)                            \
+    M(i32_les, i32, i32, Operators::LessThanOrEquals)                       \
+    M(i32_leu, u32, i32, Operators::LessThanOrEquals)                       \
+    M(i32_ges, i32, i32, Operators::GreaterThanOrEquals)                    \
+    M(i32_geu, u32, i32, Operators::GreaterThanOrEquals)                    \
+    M(i64_eq, i64, i32, Operators::Equals)                                  \
+    M(i64_ne, i64, i32, Operators::NotEquals)                               \
+    M(i64_lts, i64, i32, Operators::LessThan)                               \
+    M(i64_ltu, u64, i32, Operators::LessThan)                               \
+    M(i64_gts, i64, i32, Operators::GreaterThan)                            \
+    M(i64_gtu, u64, i32, Operators::GreaterThan)                            \
+    M(i64_les, i64, i32, Operators::LessThanOrEquals)                       \
+    M(i64_leu, u64, i32, Operators::LessThanOrEquals)                       \
+    M(i64_ges, i64, i32, Operators::GreaterThanOrEquals)                    \
+    M(i64_geu, u64, i32, Operators::GreaterThanOrEquals)                    \
+    M(f32_eq, float, i32, Operators::Equals)                                \
+    M(f32_ne, float, i32, Operators::NotEquals)                             \
+    M(f32_lt, float, i32, Operators::LessThan)                              \
+    M(f32_gt, float, i32, Operators::GreaterThan)                           \
+    M(f32_le, float, i32, Operators::LessThanOrEquals)                      \
+    M(f32_ge, float, i32, Operators::GreaterThanOrEquals)                   \
+    M(f64_eq, double, i32, Operators::Equals)                               \
+    M(f64_ne, double, i32, Operators::NotEquals)                            \
+    M(f64_lt, double, i32, Operators::LessThan)                             \
+    M(f64_gt, double, i32, Operators::GreaterThan)                          \
+    M(f64_le, double, i32, Operators::LessThanOrEquals)                     \
+    M(f64_ge, double, i32, Operators::GreaterThanOrEquals)                  \
+    M(i32_add, u32, i32, Operators::Add)                                    \
+    M(i32_sub, u32, i32, Operators::Subtract)                               \
+    M(i32_mul, u32, i32, Operators::Multiply)                               \
+    M(i32_divs, i32, i32, Operators::Divide)                                \
+    M(i32_divu, u32, i32, Operators::Divide)                                \
+    M(i32_rems, i32, i32, Operators::Modulo)                                \
+    M(i32_remu, u32, i32, Operators::Modulo)                                \
+    M(i32_and, i32, i32, Operators::BitAnd)                                 \
+    M(i32_or, i32, i32, Operators::BitOr)                                   \
+    M(i32_xor, i32, i32, Operators::BitXor)                                 \
+    M(i32_shl, u32, i32, Operators::BitShiftLeft)                           \
+    M(i32_shrs, i32, i32, Operators::BitShiftRight)                         \
+    M(i32_shru, u32, i32, Operators::BitShiftRight)                         \
+    M(i32_rotl, u32, i32, Operators::BitRotateLeft)                         \
+    M(i32_rotr, u32, i32, Operators::BitRotateRight)                        \
+    M(i64_add, u64, i64, Operators::Add)                                    \
+    M(i64_sub, u64, i64, Operators::Subtract)                               \
+    M(i64_mul, u64, i64, Operators::Multiply)                               \
+    M(i64_divs, i64, i64, Operators::Divide)                                \
+    M(i64_divu, u64, i64, Operators::Divide)                                \
+    M(i64_rems, i64, i64, Operators::Modulo)                                \
+    M(i64_remu, u64, i64, Operators::Modulo)                                \
+    M(i64_and, i64, i64, Operators::BitAnd)                                 \
+    M(i64_or, i64, i64, Operators::BitOr)                                   \
+    M(i64_xor, i64, i64, Operators::BitXor)                                 \
+    M(i64_shl, u64, i64, Operators::BitShiftLeft)                           \
+    M(i64_shrs, i64, i64, Operators::BitShiftRight)                         \
+    M(i64_shru, u64, i64, Operators::BitShiftRight)                         \
+    M(i64_rotl, u64, i64, Operators::BitRotateLeft)                         \
+    M(i64_rotr, u64, i64, Operators::BitRotateRight)                        \
+    M(f32_add, float, float, Operators::Add)                                \
+    M(f32_sub, float, float, Operators::Subtract)                           \
+    M(f32_mul, float, float, Operators::Multiply)                           \
+    M(f32_div, float, float, Operators::Divide)                             \
+    M(f32_min, float, float, Operators::Minimum)                            \
+    M(f32_max, float, float, Operators::Maximum)                            \
+    M(f32_copysign, float, float, Operators::CopySign)                      \
+    M(f64_add, double, double, Operators::Add)                              \
+    M(f64_sub, double, double, Operators::Subtract)                         \
+    M(f64_mul, double, double, Operators::Multiply)                         \
+    M(f64_div, double, double, Operators::Divide)                           \
+    M(f64_min, double, double, Operators::Minimum)                          \
+    M(f64_max, double, double, Operators::Maximum)                          \
+    M(f64_copysign, double, double, Operators::CopySign)
+
+// Numeric instructions that pop one operand and push one result: (name, operand type, result type, operator).
+#define ENUMERATE_WASM_IR_UNARY_OPERATIONS(M)                                   \
+    M(i32_eqz, i32, i32, Operators::EqualsZero)                                 \
+    M(i64_eqz, i64, i32, Operators::EqualsZero)                                 \
+    M(i32_clz, i32, i32, Operators::CountLeadingZeros)                          \
+    M(i32_ctz, i32, i32, Operators::CountTrailingZeros)                         \
+    M(i32_popcnt, i32, i32, Operators::PopCount)                                \
+    M(i64_clz, i64, i64, Operators::CountLeadingZeros)                          \
+    M(i64_ctz, i64, i64, Operators::CountTrailingZeros)                         \
+    M(i64_popcnt, i64, i64, Operators::PopCount)                                \
+    M(f32_abs, float, float, Operators::Absolute)                               \
+    M(f32_neg, float, float, Operators::Negate)                                 \
+    M(f32_ceil, float, float, Operators::Ceil)                                  \
+    M(f32_floor, float, float, Operators::Floor)                                \
+    M(f32_trunc, float, float, Operators::Truncate)                             \
+    M(f32_nearest, float, float, Operators::NearbyIntegral)                     \
+    M(f32_sqrt, float, float, Operators::SquareRoot)                            \
+    M(f64_abs, double, double, Operators::Absolute)                             \
+    M(f64_neg, double, double, Operators::Negate)                               \
+    M(f64_ceil, double, double, Operators::Ceil)                                \
+    M(f64_floor, double, double, Operators::Floor)                              \
+    M(f64_trunc, double, double, Operators::Truncate)                           \
+    M(f64_nearest, double, double, Operators::NearbyIntegral)                   \
+    M(f64_sqrt, double, double, Operators::SquareRoot)                          \
+    M(i32_wrap_i64, i64, i32, Operators::Wrap<i32>)                             \
+    M(i32_trunc_sf32, float, i32, Operators::CheckedTruncate<i32>)              \
+    M(i32_trunc_uf32, float, i32, Operators::CheckedTruncate<u32>)              \
+    M(i32_trunc_sf64, double, i32, Operators::CheckedTruncate<i32>)             \
+    M(i32_trunc_uf64, double, i32, Operators::CheckedTruncate<u32>)             \
+    M(i64_trunc_sf32, float, i64, Operators::CheckedTruncate<i64>)              \
+    M(i64_trunc_uf32, float, i64, Operators::CheckedTruncate<u64>)              \
+    M(i64_trunc_sf64, double, i64, Operators::CheckedTruncate<i64>)             \
+    M(i64_trunc_uf64, double, i64, Operators::CheckedTruncate<u64>)             \
+    M(i64_extend_si32, i32, i64, Operators::Extend<i64>)                        \
+    M(i64_extend_ui32, u32, i64, Operators::Extend<i64>)                        \
+    M(f32_convert_si32, i32, float, Operators::Convert<float>)                  \
+    M(f32_convert_ui32, u32, float, Operators::Convert<float>)                  \
+    M(f32_convert_si64, i64, float, Operators::Convert<float>)                  \
+    M(f32_convert_ui64, u64, float, Operators::Convert<float>)                  \
+    M(f32_demote_f64, double, float, Operators::Demote)                         \
+    M(f64_convert_si32, i32, double, Operators::Convert<double>)                \
+    M(f64_convert_ui32, u32, double, Operators::Convert<double>)                \
+    M(f64_convert_si64, i64, double, Operators::Convert<double>)                \
+    M(f64_convert_ui64, u64, double, Operators::Convert<double>)                \
+    M(f64_promote_f32, float, double, Operators::Promote)                       \
+    M(i32_reinterpret_f32, float, i32, Operators::Reinterpret<i32>)             \
+    M(i64_reinterpret_f64, double, i64, Operators::Reinterpret<i64>)            \
+    M(f32_reinterpret_i32, i32, float, Operators::Reinterpret<float>)           \
+    M(f64_reinterpret_i64, i64, double, Operators::Reinterpret<double>)         \
+    M(i32_extend8_s, i32, i32, Operators::SignExtend<i8>)                       \
+    M(i32_extend16_s, i32, i32, Operators::SignExtend<i16>)                     \
+    M(i64_extend8_s, i64, i64, Operators::SignExtend<i8>)                       \
+    M(i64_extend16_s, i64, i64, Operators::SignExtend<i16>)                     \
+    M(i64_extend32_s, i64, i64, Operators::SignExtend<i32>)                     \
+    M(i32_trunc_sat_f32_s, float, i32, Operators::SaturatingTruncate<i32>)      \
+    M(i32_trunc_sat_f32_u, float, i32, Operators::SaturatingTruncate<u32>)      \
+    M(i32_trunc_sat_f64_s, double, i32, Operators::SaturatingTruncate<i32>)     \
+    M(i32_trunc_sat_f64_u, double, i32, Operators::SaturatingTruncate<u32>)     \
+    M(i64_trunc_sat_f32_s, float, i64, Operators::SaturatingTruncate<i64>)      \
+    M(i64_trunc_sat_f32_u, float, i64, Operators::SaturatingTruncate<u64>)      \
+    M(i64_trunc_sat_f64_s, double, i64, Operators::SaturatingTruncate<i64>)     \
+    M(i64_trunc_sat_f64_u, double, i64, Operators::SaturatingTruncate<u64>)
+
+// (name, type in memory, type on the stack)
+#define ENUMERATE_WASM_IR_LOAD_OPERATIONS(M) \
+    M(i32_load, i32, i32)                    \
+    M(i64_load, i64, i64)                    \
+    M(f32_load, float, float)                \
+    M(f64_load, double, double)              \
+    M(i32_load8_s, i8, i32)                  \
+    M(i32_load8_u, u8, i32)                  \
+    M(i32_load16_s, i16, i32)                \
+    M(i32_load16_u, u16, i32)                \
+    M(i64_load8_s, i8, i64)                  \
+    M(i64_load8_u, u8, i64)                  \
+    M(i64_load16_s, i16, i64)                \
+    M(i64_load16_u, u16, i64)                \
+    M(i64_load32_s, i32, i64)                \
+    M(i64_load32_u, u32, i64)
+
+// (name, type on the stack, type in memory)
+#define ENUMERATE_WASM_IR_STORE_OPERATIONS(M) \
+    M(i32_store, i32, i32)                    \
+    M(i64_store, i64, i64)                    \
+    M(f32_store, float, float)                \
+    M(f64_store, double, double)              \
+    M(i32_store8, i32, i8)                    \
+    M(i32_store16, i32, i16)                  \
+    M(i64_store8, i64, i8)                    \
+    M(i64_store16, i64, i16)                  \
+    M(i64_store32, i64, i32)
+
+// i32 comparisons that can be folded into the conditional jump that consumes them: (name, operand type, operator, inverse).
+#define ENUMERATE_WASM_IR_FUSED_COMPARISONS(M)                      \
+    M(i32_eq, i32, Operators::Equals, i32_ne)                       \
+    M(i32_ne, i32, Operators::NotEquals, i32_eq)                    \
+    M(i32_lts, i32, Operators::LessThan, i32_ges)                   \
+    M(i32_ltu, u32, Operators::LessThan, i32_geu)                   \
+    M(i32_gts, i32, Operators::GreaterThan, i32_les)                \
+    M(i32_gtu, u32, Operators::GreaterThan, i32_leu)                \
+    M(i32_les, i32, Operators::LessThanOrEquals, i32_gts)           \
+    M(i32_leu, u32, Operators::LessThanOrEquals, i32_gtu)           \
+    M(i32_ges, i32, Operators::GreaterThanOrEquals, i32_lts)        \
+    M(i32_geu, u32, Operators::GreaterThanOrEquals, i32_ltu)
+
+namespace IR {
+
+// Operands name slots in the frame of the function, which are laid out as [locals][constants][value stack].
+// The value stack slots belong to fixed stack heights, so operand stack traffic turns into plain slot accesses.
+enum class OpCode : u16 {
+#define __ENUMERATE_OPERATION(name, ...) name,
+    // clang-format off
+    ENUMERATE_WASM_IR_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+    ENUMERATE_WASM_IR_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+    ENUMERATE_WASM_IR_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+    ENUMERATE_WASM_IR_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+#define __ENUMERATE_OPERATION(name, ...) jump_if_##name,
+    ENUMERATE_WASM_IR_FUSED_COMPARISONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+    // Accesses that are known to stay within the initial size of the memory (which can never shrink) skip the bounds check.
+#define __ENUMERATE_OPERATION(name, ...) name##_in_bounds,
+    ENUMERATE_WASM_IR_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+    ENUMERATE_WASM_IR_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+    // clang-format on
+    move,
+    select,
+    jump,
+    jump_if_zero,
+    jump_if_not_zero,
+    branch_table,
+    call,
+    call_indirect,
+    global_get,
+    global_set,
+    memory_size,
+    memory_grow,
+    return_,
+    unreachable,
+};
+
+struct Instruction {
+    OpCode opcode;
+    u32 destination { 0 };
+    u32 lhs { 0 };
+    u32 rhs { 0 };
+    // Jump target, memory offset, function index, global address, ... depending on the opcode.
+    u64 immediate { 0 };
+};
+
+struct BranchTableEntry {
+    u32 target { 0 };
+    u32 result_slot { 0 };
+};
+
+}
+
+// A function body lowered to the register-based IR, with all branch targets resolved ahead of time.
+// Functions that make use of anything the IR doesn't cover (or that don't validate) simply don't get one,
+// and keep being run by the BytecodeInterpreter.
+class CompiledFunction : public RefCounted<CompiledFunction> {
+public:
+    static RefPtr<CompiledFunction> try_create(WasmFunction const&, Store&);
+
+    Result call(Configuration&, Interpreter&, StackInfo const&, Vector<Value>& arguments) const;
+    // Runs the function with the arguments in the given slots, and leaves the results in them.
+    Optional<Trap> call_with_slots(Configuration&, Interpreter&, StackInfo const&, u64* arguments_and_results) const;
+
+    auto& instructions() const { return m_instructions; }
+    size_t frame_size() const { return m_frame_size; }
+
+private:
+    friend class FunctionLowering;
+
+    explicit CompiledFunction(ModuleInstance const& module)
+        : m_module(module)
+    {
+    }
+
+    Optional<Trap> execute(Configuration&, Interpreter&, StackInfo const&, u64* slots) const;
+
+    ModuleInstance const& m_module;
+    Vector<IR::Instruction> m_instructions;
+    // The last entry of each table is the default target.
+    Vector<Vector<IR::BranchTableEntry>> m_branch_tables;
+    Vector<u64> m_constants;
+    Vector<ValueType::Kind> m_parameter_kinds;
+    Vector<ValueType::Kind> m_result_kinds;
+    size_t m_local_count { 0 };
+    size_t m_frame_size { 0 };
+};
+
+}
@@ -42,6 +42,9 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
     if (!function)
         return Trap {};
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
+        if (auto result = interpreter.call_compiled_function(*this, *wasm_function, arguments); result.has_value())
+            return result.release_value();
+
         Vector<Value> locals = move(arguments);
         locals.ensure_capacity(locals.size() + wasm_function->code().locals().size());
         for (auto& type : wasm_function->code().locals())
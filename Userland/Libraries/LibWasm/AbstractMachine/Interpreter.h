@@ -16,6 +16,9 @@ struct Interpreter {
     virtual bool did_trap() const = 0;
     virtual String trap_reason() const = 0;
     virtual void clear_trap() = 0;
+
+    // Runs a function that has been lowered to the register-based IR, returns nothing if this interpreter wants to run it instruction by instruction instead.
+    virtual Optional<Result> call_compiled_function(Configuration&, WasmFunction const&, Vector<Value>&) { return {}; }
 };
 
 }
@@ -43,4 +43,10 @@ static constexpr auto max_allowed_executed_instructions_per_call = 256 * 1024 *
 static constexpr auto max_allowed_vector_size = 2 * MiB;
 static constexpr auto max_allowed_function_locals_per_type = 420; // Note: VERY arbitrary.
 
+// Work that can be spread over multiple threads (parsing function bodies, lowering them to the IR) is handed out in jobs of about this much code.
+// Anything smaller than a single job is done right away, as it isn't worth the overhead of involving other threads.
+static constexpr auto parallel_job_code_size = 16 * KiB;
+static constexpr auto parallel_job_instruction_count = 4096;
+static constexpr auto max_worker_thread_count = 8;
+
 }
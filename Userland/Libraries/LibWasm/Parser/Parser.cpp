@@ -5,9 +5,12 @@
  */
 
 #include <AK/LEB128.h>
+#include <AK/NonnullOwnPtrVector.h>
 #include <AK/ScopeGuard.h>
 #include <AK/ScopeLogger.h>
+#include <LibThreading/WorkerPool.h>
 #include <LibWasm/Types.h>
+#include <unistd.h>
 
 namespace Wasm {
 
@@ -1139,13 +1142,111 @@ ParseResult<CodeSection::Code> CodeSection::Code::parse(InputStream& stream)
     return Code { static_cast<u32>(size), func.release_value() };
 }
 
+// A run of consecutive function bodies, copied out of the stream so that they can be parsed on another thread.
+struct CodeBatch {
+    ByteBuffer bytes;
+    Vector<u32> body_sizes;
+    Vector<CodeSection::Code> codes;
+    Optional<ParseError> error;
+
+    void parse()
+    {
+        codes.ensure_capacity(body_sizes.size());
+        size_t offset = 0;
+        for (auto size : body_sizes) {
+            InputMemoryStream body_stream { bytes.bytes().slice(offset, size) };
+            ScopeGuard drain_errors {
+                [&] {
+                    body_stream.handle_any_error();
+                }
+            };
+            auto func = CodeSection::Func::parse(body_stream);
+            if (func.is_error()) {
+                error = func.error();
+                return;
+            }
+            codes.unchecked_append(CodeSection::Code { size, func.release_value() });
+            offset += size;
+        }
+    }
+};
+
 ParseResult<CodeSection> CodeSection::parse(InputStream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("CodeSection");
-    auto result = parse_vector<Code>(stream);
-    if (result.is_error())
-        return result.error();
-    return CodeSection { result.release_value() };
+    size_t count;
+    if (!LEB128::read_unsigned(stream, count))
+        return with_eof_check(stream, ParseError::ExpectedSize);
+
+    // Function bodies don't depend on each other, so they are cut out of the stream as it comes in,
+    // and every batch of them gets parsed on the worker pool while the following ones are still being read.
+    NonnullOwnPtrVector<CodeBatch> batches;
+    Threading::WorkerPool* worker_pool = nullptr;
+    ScopeGuard wait_for_batches {
+        [&] {
+            if (worker_pool)
+                worker_pool->wait_for_all();
+        }
+    };
+
+    auto start_batch = [&] {
+        auto batch = make<CodeBatch>();
+        (void)batch->bytes.try_ensure_capacity(Constants::parallel_job_code_size);
+        batches.append(move(batch));
+    };
+
+    auto read_error = [&]() -> Optional<ParseError> {
+        start_batch();
+        for (size_t i = 0; i < count; ++i) {
+            size_t size;
+            if (!LEB128::read_unsigned(stream, size) || size > NumericLimits<u32>::max())
+                return with_eof_check(stream, ParseError::InvalidSize);
+
+            // Read the body a bit at a time, so that a bogus size can't make us allocate more than the stream actually contains.
+            auto& batch = batches.last();
+            for (size_t size_left = size; size_left > 0;) {
+                auto offset = batch.bytes.size();
+                auto chunk_size = min(size_left, 4 * KiB);
+                if (offset + chunk_size > batch.bytes.capacity())
+                    (void)batch.bytes.try_ensure_capacity(max(offset + chunk_size, batch.bytes.capacity() * 2));
+                if (!batch.bytes.try_resize(offset + chunk_size))
+                    return ParseError::OutOfMemory;
+                if (stream.read(batch.bytes.bytes().slice(offset, chunk_size)) != chunk_size)
+                    return with_eof_check(stream, ParseError::InvalidInput);
+                size_left -= chunk_size;
+            }
+            batch.body_sizes.append(size);
+
+            if (batch.bytes.size() < Constants::parallel_job_code_size || i == count - 1)
+                continue;
+            if (!worker_pool)
+                worker_pool = shared_worker_pool();
+            if (!worker_pool)
+                continue;
+            worker_pool->enqueue([&batch] { batch.parse(); });
+            start_batch();
+        }
+        return {};
+    }();
+
+    // The last batch is left to this thread, as it would be waiting for the others anyway.
+    batches.last().parse();
+    if (worker_pool)
+        worker_pool->wait_for_all();
+
+    size_t parsed_count = 0;
+    for (auto& batch : batches)
+        parsed_count += batch.codes.size();
+    Vector<Code> codes;
+    codes.ensure_capacity(parsed_count);
+    for (auto& batch : batches) {
+        if (batch.error.has_value())
+            return batch.error.value();
+        codes.extend(move(batch.codes));
+    }
+    if (read_error.has_value())
+        return read_error.value();
+    return CodeSection { move(codes) };
 }
 
 ParseResult<DataSection::Data> DataSection::Data::parse(InputStream& stream)
@@ -1385,6 +1486,20 @@ void Module::populate_sections()
     });
 }
 
+Threading::WorkerPool* shared_worker_pool()
+{
+    static Threading::WorkerPool* s_worker_pool = []() -> Threading::WorkerPool* {
+        auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+        if (processor_count <= 1)
+            return nullptr;
+        // The thread that waits for the jobs to finish runs some of them as well.
+        auto thread_count = min(static_cast<size_t>(processor_count - 1), static_cast<size_t>(Constants::max_worker_thread_count));
+        // Intentionally leaked, as modules can be parsed and instantiated up until the very end of the process.
+        return &Threading::WorkerPool::create(thread_count, "Wasm").leak_ref();
+    }();
+    return s_worker_pool;
+}
+
 String parse_error_to_string(ParseError error)
 {
     switch (error) {
@@ -0,0 +1,126 @@
+// prettier-ignore
+const controlModuleBinary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x1a, 0x05, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7e, 0x01, 0x7e, 0x60, 0x02, 0x7c, 0x7c, 0x01,
+    0x7c, 0x60, 0x00, 0x00, 0x03, 0x0d, 0x0c, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03,
+    0x01, 0x04, 0x00, 0x07, 0x6a, 0x0c, 0x03, 0x66, 0x69, 0x62, 0x00, 0x00, 0x03, 0x73, 0x75, 0x6d,
+    0x00, 0x01, 0x08, 0x73, 0x77, 0x61, 0x70, 0x5f, 0x73, 0x75, 0x62, 0x00, 0x02, 0x03, 0x74, 0x65,
+    0x65, 0x00, 0x03, 0x08, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x69, 0x66, 0x79, 0x00, 0x04, 0x05, 0x63,
+    0x6c, 0x61, 0x6d, 0x70, 0x00, 0x05, 0x03, 0x6d, 0x61, 0x78, 0x00, 0x06, 0x09, 0x66, 0x61, 0x63,
+    0x74, 0x6f, 0x72, 0x69, 0x61, 0x6c, 0x00, 0x07, 0x05, 0x68, 0x79, 0x70, 0x6f, 0x74, 0x00, 0x08,
+    0x06, 0x64, 0x69, 0x76, 0x69, 0x64, 0x65, 0x00, 0x09, 0x04, 0x74, 0x72, 0x61, 0x70, 0x00, 0x0a,
+    0x0c, 0x65, 0x61, 0x72, 0x6c, 0x79, 0x5f, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x00, 0x0b, 0x0a,
+    0xfd, 0x01, 0x0c, 0x1c, 0x00, 0x20, 0x00, 0x41, 0x02, 0x49, 0x04, 0x7f, 0x20, 0x00, 0x05, 0x20,
+    0x00, 0x41, 0x01, 0x6b, 0x10, 0x00, 0x20, 0x00, 0x41, 0x02, 0x6b, 0x10, 0x00, 0x6a, 0x0b, 0x0b,
+    0x25, 0x02, 0x01, 0x7f, 0x01, 0x7f, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4f, 0x0d,
+    0x01, 0x20, 0x02, 0x20, 0x01, 0x6a, 0x21, 0x02, 0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01, 0x0c,
+    0x00, 0x0b, 0x0b, 0x20, 0x02, 0x0b, 0x0f, 0x00, 0x20, 0x00, 0x20, 0x01, 0x21, 0x00, 0x21, 0x01,
+    0x20, 0x00, 0x20, 0x01, 0x6b, 0x0b, 0x0e, 0x01, 0x01, 0x7f, 0x20, 0x00, 0x41, 0x03, 0x6c, 0x22,
+    0x01, 0x20, 0x01, 0x6a, 0x0b, 0x1d, 0x00, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x0e,
+    0x02, 0x00, 0x01, 0x02, 0x0b, 0x41, 0xe4, 0x00, 0x0f, 0x0b, 0x41, 0xc8, 0x01, 0x0f, 0x0b, 0x41,
+    0xac, 0x02, 0x0b, 0x11, 0x00, 0x02, 0x7f, 0x41, 0x0a, 0x20, 0x00, 0x41, 0x0a, 0x4a, 0x0d, 0x00,
+    0x1a, 0x20, 0x00, 0x0b, 0x0b, 0x0c, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x00, 0x20, 0x01, 0x4a,
+    0x1b, 0x0b, 0x25, 0x01, 0x01, 0x7e, 0x42, 0x01, 0x21, 0x01, 0x02, 0x40, 0x03, 0x40, 0x20, 0x00,
+    0x50, 0x0d, 0x01, 0x20, 0x01, 0x20, 0x00, 0x7e, 0x21, 0x01, 0x20, 0x00, 0x42, 0x01, 0x7d, 0x21,
+    0x00, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b, 0x0e, 0x00, 0x20, 0x00, 0x20, 0x00, 0xa2, 0x20,
+    0x01, 0x20, 0x01, 0xa2, 0xa0, 0x9f, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6e, 0x0b, 0x03,
+    0x00, 0x00, 0x0b, 0x1b, 0x00, 0x03, 0x40, 0x20, 0x00, 0x41, 0x07, 0x46, 0x04, 0x40, 0x41, 0x2a,
+    0x0f, 0x0b, 0x20, 0x00, 0x41, 0x01, 0x6a, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x41, 0x00, 0x0b,
+]);
+
+// prettier-ignore
+const memoryModuleBinary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x11, 0x03, 0x60, 0x02, 0x7f, 0x7f, 0x01,
+    0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7c, 0x01, 0x7c, 0x03, 0x09, 0x08, 0x00, 0x01,
+    0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x05, 0x03, 0x01, 0x00, 0x01, 0x06, 0x06, 0x01, 0x7f, 0x01,
+    0x41, 0x05, 0x0b, 0x07, 0x76, 0x08, 0x0a, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x5f, 0x6c, 0x6f, 0x61,
+    0x64, 0x00, 0x00, 0x05, 0x62, 0x79, 0x74, 0x65, 0x73, 0x00, 0x01, 0x0d, 0x66, 0x36, 0x34, 0x5f,
+    0x72, 0x6f, 0x75, 0x6e, 0x64, 0x74, 0x72, 0x69, 0x70, 0x00, 0x02, 0x04, 0x67, 0x72, 0x6f, 0x77,
+    0x00, 0x03, 0x0b, 0x62, 0x75, 0x6d, 0x70, 0x5f, 0x67, 0x6c, 0x6f, 0x62, 0x61, 0x6c, 0x00, 0x04,
+    0x12, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x5f, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73,
+    0x73, 0x65, 0x73, 0x00, 0x05, 0x11, 0x70, 0x61, 0x73, 0x74, 0x5f, 0x69, 0x6e, 0x69, 0x74, 0x69,
+    0x61, 0x6c, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x00, 0x06, 0x0f, 0x67, 0x72, 0x6f, 0x77, 0x5f, 0x6f,
+    0x6e, 0x65, 0x5f, 0x62, 0x79, 0x5f, 0x6f, 0x6e, 0x65, 0x00, 0x07, 0x0a, 0xa4, 0x01, 0x08, 0x0e,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0x36, 0x02, 0x04, 0x20, 0x00, 0x28, 0x02, 0x04, 0x0b, 0x15, 0x00,
+    0x20, 0x00, 0x41, 0xff, 0x03, 0x3b, 0x01, 0x00, 0x20, 0x00, 0x2d, 0x00, 0x00, 0x20, 0x00, 0x2c,
+    0x00, 0x01, 0x6a, 0x0b, 0x0e, 0x00, 0x41, 0x08, 0x20, 0x00, 0x39, 0x03, 0x00, 0x41, 0x08, 0x2b,
+    0x03, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x40, 0x00, 0x1a, 0x3f, 0x00, 0x0b, 0x0b, 0x00, 0x23,
+    0x00, 0x20, 0x00, 0x6a, 0x24, 0x00, 0x23, 0x00, 0x0b, 0x13, 0x00, 0x41, 0xf8, 0xff, 0x03, 0x20,
+    0x00, 0xad, 0x37, 0x03, 0x00, 0x41, 0xf4, 0xff, 0x03, 0x28, 0x02, 0x04, 0x0b, 0x12, 0x00, 0x41,
+    0x80, 0x80, 0x04, 0x20, 0x00, 0x36, 0x02, 0x00, 0x41, 0x80, 0x80, 0x04, 0x28, 0x02, 0x00, 0x0b,
+    0x31, 0x01, 0x01, 0x7f, 0x41, 0xe4, 0x00, 0x41, 0xd2, 0x09, 0x36, 0x02, 0x00, 0x02, 0x40, 0x03,
+    0x40, 0x20, 0x01, 0x20, 0x00, 0x4f, 0x0d, 0x01, 0x41, 0x01, 0x40, 0x00, 0x1a, 0x20, 0x01, 0x41,
+    0x01, 0x6a, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x3f, 0x00, 0x41, 0xe4, 0x00, 0x28, 0x02, 0x00,
+    0x6a, 0x0b,
+]);
+
+// prettier-ignore
+const indirectModuleBinary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0e, 0x02, 0x60, 0x02, 0x7f, 0x7f, 0x01,
+    0x7f, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00, 0x00, 0x01, 0x04, 0x04,
+    0x01, 0x70, 0x00, 0x02, 0x07, 0x09, 0x01, 0x05, 0x61, 0x70, 0x70, 0x6c, 0x79, 0x00, 0x02, 0x09,
+    0x08, 0x01, 0x00, 0x41, 0x00, 0x0b, 0x02, 0x00, 0x01, 0x0a, 0x1d, 0x03, 0x07, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x6a, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6b, 0x0b, 0x0b, 0x00, 0x20, 0x01,
+    0x20, 0x02, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0b,
+]);
+
+const call = (module, name, ...args) => module.invoke(module.getExport(name), ...args);
+
+test("recursion and control flow", () => {
+    const module = parseWebAssemblyModule(controlModuleBinary);
+    expect(call(module, "fib", 20)).toBe(6765);
+    expect(call(module, "sum", 100)).toBe(4950);
+    expect(call(module, "sum", 0)).toBe(0);
+    expect(call(module, "swap_sub", 10, 3)).toBe(-7);
+    expect(call(module, "tee", 5)).toBe(30);
+    expect(call(module, "classify", 0)).toBe(100);
+    expect(call(module, "classify", 1)).toBe(200);
+    expect(call(module, "classify", 2)).toBe(300);
+    expect(call(module, "classify", 1000)).toBe(300);
+    expect(call(module, "clamp", 4)).toBe(4);
+    expect(call(module, "clamp", 40)).toBe(10);
+    expect(call(module, "max", 3, 9)).toBe(9);
+    expect(call(module, "max", 9, 3)).toBe(9);
+    expect(call(module, "factorial", 20n)).toBe(2432902008176640000n);
+    expect(call(module, "hypot", 3, 4)).toBe(5);
+    expect(call(module, "divide", 42, 5)).toBe(8);
+    expect(call(module, "early_return", 0)).toBe(42);
+});
+
+test("traps", () => {
+    const module = parseWebAssemblyModule(controlModuleBinary);
+    expect(() => call(module, "divide", 1, 0)).toThrow(TypeError, "Execution trapped");
+    expect(() => call(module, "trap")).toThrow(TypeError, "Execution trapped");
+});
+
+test("memory and globals", () => {
+    const module = parseWebAssemblyModule(memoryModuleBinary);
+    expect(call(module, "store_load", 16, 123456)).toBe(123456);
+    expect(call(module, "bytes", 32)).toBe(0xff + 1);
+    expect(call(module, "f64_roundtrip", 1.5)).toBe(1.5);
+    expect(() => call(module, "store_load", 65532, 1)).toThrow(TypeError, "Execution trapped");
+    expect(call(module, "grow", 2)).toBe(3);
+    expect(call(module, "store_load", 65532, 1)).toBe(1);
+    expect(call(module, "bump_global", 10)).toBe(15);
+    expect(call(module, "bump_global", 10)).toBe(25);
+});
+
+test("memory accesses at constant addresses", () => {
+    const module = parseWebAssemblyModule(memoryModuleBinary);
+    expect(call(module, "constant_addresses", 77)).toBe(77);
+    expect(() => call(module, "past_initial_size", 1)).toThrow(TypeError, "Execution trapped");
+    expect(call(module, "grow", 1)).toBe(2);
+    expect(call(module, "past_initial_size", 5)).toBe(5);
+});
+
+test("growing memory keeps its contents", () => {
+    const module = parseWebAssemblyModule(memoryModuleBinary);
+    expect(call(module, "grow_one_by_one", 40)).toBe(41 + 1234);
+});
+
+test("indirect calls", () => {
+    const module = parseWebAssemblyModule(indirectModuleBinary);
+    expect(call(module, "apply", 0, 7, 2)).toBe(9);
+    expect(call(module, "apply", 1, 7, 2)).toBe(5);
+    expect(() => call(module, "apply", 2, 7, 2)).toThrow(TypeError, "Execution trapped");
+});
@@ -0,0 +1,76 @@
+// Builds a module big enough for its function bodies to be parsed and lowered in several batches.
+
+function unsignedLEB128(value) {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+}
+
+function signedLEB128(value) {
+    const bytes = [];
+    for (;;) {
+        const byte = value & 0x7f;
+        value >>= 7;
+        if ((value === 0 && (byte & 0x40) === 0) || (value === -1 && (byte & 0x40) !== 0)) {
+            bytes.push(byte);
+            return bytes;
+        }
+        bytes.push(byte | 0x80);
+    }
+}
+
+function section(id, contents) {
+    return [id, ...unsignedLEB128(contents.length), ...contents];
+}
+
+function name(string) {
+    return [...unsignedLEB128(string.length), ...Array.from(string, c => c.charCodeAt(0))];
+}
+
+const functionCount = 200;
+const additionsPerFunction = 100;
+const exportedFunctions = [0, 1, 99, 100, 199];
+
+// Function `i` returns its argument plus `additionsPerFunction` plus `i`, so a mixed up order of bodies shows.
+function buildModule(invalidFunction = -1) {
+    const body = [0x00, 0x20, 0x00];
+    for (let i = 0; i < additionsPerFunction; ++i) body.push(0x41, 0x01, 0x6a);
+
+    const code = [];
+    for (let i = 0; i < functionCount; ++i) {
+        let functionBody = [...body, 0x41, ...signedLEB128(i), 0x6a, 0x0b];
+        if (i === invalidFunction) functionBody = [0x00, 0xff, 0x0b];
+        code.push(...unsignedLEB128(functionBody.length), ...functionBody);
+    }
+
+    const exports = [];
+    for (const index of exportedFunctions) exports.push(...name(`f${index}`), 0x00, ...unsignedLEB128(index));
+
+    return new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        ...section(1, [0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f]),
+        ...section(3, [...unsignedLEB128(functionCount), ...new Array(functionCount).fill(0x00)]),
+        ...section(7, [...unsignedLEB128(exportedFunctions.length), ...exports]),
+        ...section(10, [...unsignedLEB128(functionCount), ...code]),
+    ]);
+}
+
+test("function bodies keep their order", () => {
+    const module = parseWebAssemblyModule(buildModule());
+    for (const index of exportedFunctions)
+        expect(module.invoke(module.getExport(`f${index}`), 5)).toBe(5 + additionsPerFunction + index);
+});
+
+test("truncated code section", () => {
+    const binary = buildModule();
+    expect(() => parseWebAssemblyModule(binary.slice(0, binary.length - 100))).toThrow(SyntaxError);
+});
+
+test("invalid function body", () => {
+    expect(() => parseWebAssemblyModule(buildModule(150))).toThrow(SyntaxError);
+});
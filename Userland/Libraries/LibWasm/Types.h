@@ -16,6 +16,10 @@
 #include <LibWasm/Constants.h>
 #include <LibWasm/Opcode.h>
 
+namespace Threading {
+class WorkerPool;
+}
+
 namespace Wasm {
 
 enum class ParseError {
@@ -43,6 +47,10 @@ enum class ParseError {
 
 String parse_error_to_string(ParseError);
 
+// Threads shared by everything in LibWasm that can run in parallel, created on first use.
+// Returns null if there's only one processor to run things on.
+Threading::WorkerPool* shared_worker_pool();
+
 template<typename T>
 using ParseResult = Result<T, ParseError>;
 
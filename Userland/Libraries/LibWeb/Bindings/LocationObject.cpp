@@ -17,6 +17,7 @@ namespace Web::Bindings {
 LocationObject::LocationObject(JS::GlobalObject& global_object)
     : Object(*global_object.object_prototype())
 {
+    m_has_cacheable_property_lookups = false;
 }
 
 void LocationObject::initialize(JS::GlobalObject& global_object)
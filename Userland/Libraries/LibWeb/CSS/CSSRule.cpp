@@ -5,6 +5,7 @@
  */
 
 #include <LibWeb/CSS/CSSRule.h>
+#include <LibWeb/CSS/CSSStyleSheet.h>
 
 namespace Web::CSS {
 
@@ -12,6 +13,11 @@ CSSRule::~CSSRule()
 {
 }
 
+void CSSRule::set_parent_style_sheet(CSSStyleSheet* style_sheet)
+{
+    m_parent_style_sheet = style_sheet;
+}
+
 // https://www.w3.org/TR/cssom/#dom-cssrule-csstext
 String CSSRule::css_text() const
 {
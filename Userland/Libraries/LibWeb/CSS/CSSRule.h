@@ -8,9 +8,11 @@
 
 #include <AK/RefCounted.h>
 #include <AK/String.h>
+#include <AK/WeakPtr.h>
 #include <LibWeb/Bindings/Wrappable.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
 #include <LibWeb/CSS/Selector.h>
+#include <LibWeb/Forward.h>
 
 namespace Web::CSS {
 
@@ -36,11 +38,16 @@ public:
     String css_text() const;
     void set_css_text(StringView);
 
+    CSSStyleSheet* parent_style_sheet() { return m_parent_style_sheet.ptr(); }
+    void set_parent_style_sheet(CSSStyleSheet*);
+
     template<typename T>
     bool fast_is() const = delete;
 
 protected:
     virtual String serialized() const = 0;
+
+    WeakPtr<CSSStyleSheet> m_parent_style_sheet;
 };
 
 }
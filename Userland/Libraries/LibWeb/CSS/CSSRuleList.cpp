@@ -65,15 +65,16 @@ DOM::ExceptionOr<void> CSSRuleList::remove_a_css_rule(u32 index)
         return DOM::IndexSizeError::create("CSS rule index out of bounds.");
 
     // 3. Set old rule to the indexth item in list.
-    auto& old_rule = m_rules[index];
+    NonnullRefPtr<CSSRule> old_rule = m_rules[index];
 
     // FIXME: 4. If old rule is an @namespace at-rule, and list contains anything other than @import at-rules, and @namespace at-rules, throw an InvalidStateError exception.
-    (void)old_rule;
 
     // 5. Remove rule old rule from list at the zero-indexed position index.
     m_rules.remove(index);
 
-    // FIXME: 6. Set old rule’s parent CSS rule and parent CSS style sheet to null.
+    // 6. Set old rule’s parent CSS rule and parent CSS style sheet to null.
+    // FIXME: We don't keep track of the parent CSS rule yet.
+    old_rule->set_parent_style_sheet(nullptr);
 
     return {};
 }
@@ -126,34 +127,42 @@ bool CSSRuleList::for_first_not_loaded_import_rule(Function<void(CSSImportRule&)
     return false;
 }
 
-void CSSRuleList::evaluate_media_queries(DOM::Window const& window)
+bool CSSRuleList::evaluate_media_queries(DOM::Window const& window)
 {
+    bool any_media_queries_changed_match_state = false;
+
     for (auto& rule : m_rules) {
         switch (rule.type()) {
         case CSSRule::Type::Style:
             break;
         case CSSRule::Type::Import: {
             auto& import_rule = verify_cast<CSSImportRule>(rule);
-            if (import_rule.has_import_result())
-                import_rule.loaded_style_sheet()->evaluate_media_queries(window);
+            if (import_rule.has_import_result() && import_rule.loaded_style_sheet()->evaluate_media_queries(window))
+                any_media_queries_changed_match_state = true;
             break;
         }
         case CSSRule::Type::Media: {
             auto& media_rule = verify_cast<CSSMediaRule>(rule);
-            if (media_rule.evaluate(window))
-                media_rule.css_rules().evaluate_media_queries(window);
+            bool did_match = media_rule.condition_matches();
+            bool now_matches = media_rule.evaluate(window);
+            if (did_match != now_matches)
+                any_media_queries_changed_match_state = true;
+            if (now_matches && media_rule.css_rules().evaluate_media_queries(window))
+                any_media_queries_changed_match_state = true;
             break;
         }
         case CSSRule::Type::Supports: {
             auto& supports_rule = verify_cast<CSSSupportsRule>(rule);
-            if (supports_rule.condition_matches())
-                supports_rule.css_rules().evaluate_media_queries(window);
+            if (supports_rule.condition_matches() && supports_rule.css_rules().evaluate_media_queries(window))
+                any_media_queries_changed_match_state = true;
             break;
         }
         case CSSRule::Type::__Count:
             VERIFY_NOT_REACHED();
         }
     }
+
+    return any_media_queries_changed_match_state;
 }
 
 }
@@ -66,6 +66,7 @@ public:
 
     const Vector<StyleProperty>& properties() const { return m_properties; }
     Optional<StyleProperty> custom_property(const String& custom_property_name) const { return m_custom_properties.get(custom_property_name); }
+    HashMap<String, StyleProperty> const& custom_properties() const { return m_custom_properties; }
     size_t custom_property_count() const { return m_custom_properties.size(); }
 
     virtual String serialized() const final override;
@@ -5,6 +5,7 @@
  */
 
 #include <LibWeb/CSS/CSSStyleRule.h>
+#include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 
 namespace Web::CSS {
@@ -83,8 +84,11 @@ void CSSStyleRule::set_selector_text(StringView selector_text)
     auto parsed_selectors = parse_selector({}, selector_text);
 
     // 2. If the algorithm returns a non-null value replace the associated group of selectors with the returned value.
-    if (parsed_selectors.has_value())
+    if (parsed_selectors.has_value()) {
         m_selectors = parsed_selectors.release_value();
+        if (m_parent_style_sheet)
+            m_parent_style_sheet->invalidate_owners();
+    }
 
     // 3. Otherwise, if the algorithm returns a null value, do nothing.
 }
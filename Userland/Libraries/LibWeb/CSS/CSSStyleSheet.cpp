@@ -4,8 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/CSS/CSSGroupingRule.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/CSS/StyleComputer.h>
+#include <LibWeb/CSS/StyleSheetList.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/ExceptionOr.h>
 
 namespace Web::CSS {
@@ -13,6 +17,7 @@ namespace Web::CSS {
 CSSStyleSheet::CSSStyleSheet(NonnullRefPtrVector<CSSRule> rules)
     : m_rules(CSSRuleList::create(move(rules)))
 {
+    adopt_rules(m_rules);
 }
 
 CSSStyleSheet::~CSSStyleSheet()
@@ -36,7 +41,11 @@ DOM::ExceptionOr<unsigned> CSSStyleSheet::insert_rule(StringView rule, unsigned
     // FIXME: 5. If parsed rule is an @import rule, and the constructed flag is set, throw a SyntaxError DOMException.
 
     // 6. Return the result of invoking insert a CSS rule rule in the CSS rules at index.
-    return m_rules->insert_a_css_rule(parsed_rule.release_nonnull(), index);
+    parsed_rule->set_parent_style_sheet(this);
+    auto result = m_rules->insert_a_css_rule(parsed_rule.release_nonnull(), index);
+    if (!result.is_exception())
+        invalidate_owners();
+    return result;
 }
 
 // https://www.w3.org/TR/cssom/#dom-cssstylesheet-deleterule
@@ -47,7 +56,10 @@ DOM::ExceptionOr<void> CSSStyleSheet::delete_rule(unsigned index)
     // FIXME: 2. If the disallow modification flag is set, throw a NotAllowedError DOMException.
 
     // 3. Remove a CSS rule in the CSS rules at index.
-    return m_rules->remove_a_css_rule(index);
+    auto result = m_rules->remove_a_css_rule(index);
+    if (!result.is_exception())
+        invalidate_owners();
+    return result;
 }
 
 // https://www.w3.org/TR/cssom/#dom-cssstylesheet-removerule
@@ -67,9 +79,40 @@ bool CSSStyleSheet::for_first_not_loaded_import_rule(Function<void(CSSImportRule
     return m_rules->for_first_not_loaded_import_rule(callback);
 }
 
-void CSSStyleSheet::evaluate_media_queries(DOM::Window const& window)
+bool CSSStyleSheet::evaluate_media_queries(DOM::Window const& window)
 {
-    m_rules->evaluate_media_queries(window);
+    return m_rules->evaluate_media_queries(window);
+}
+
+void CSSStyleSheet::set_rules(NonnullRefPtr<CSSRuleList> rules)
+{
+    m_rules = move(rules);
+    adopt_rules(m_rules);
+    invalidate_owners();
+}
+
+void CSSStyleSheet::adopt_rules(CSSRuleList& rules)
+{
+    for (auto& rule : rules) {
+        rule.set_parent_style_sheet(this);
+        if (rule.type() == CSSRule::Type::Media || rule.type() == CSSRule::Type::Supports)
+            adopt_rules(static_cast<CSSGroupingRule&>(rule).css_rules());
+    }
+}
+
+void CSSStyleSheet::set_style_sheet_list(Badge<StyleSheetList>, StyleSheetList* list)
+{
+    m_style_sheet_list = list;
+}
+
+void CSSStyleSheet::invalidate_owners()
+{
+    // The sheet (or the list it was in) may have outlived the document it belonged to.
+    if (!m_style_sheet_list || !m_style_sheet_list->document())
+        return;
+    auto& document = *m_style_sheet_list->document();
+    document.style_computer().invalidate_rule_cache();
+    document.invalidate_style();
 }
 
 }
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/Function.h>
 #include <AK/NonnullRefPtrVector.h>
+#include <AK/WeakPtr.h>
+#include <AK/Weakable.h>
 #include <LibWeb/CSS/CSSRule.h>
 #include <LibWeb/CSS/CSSRuleList.h>
 #include <LibWeb/CSS/CSSStyleRule.h>
@@ -18,7 +21,9 @@ namespace Web::CSS {
 
 class CSSImportRule;
 
-class CSSStyleSheet final : public StyleSheet {
+class CSSStyleSheet final
+    : public StyleSheet
+    , public Weakable<CSSStyleSheet> {
 public:
     using WrapperType = Bindings::CSSStyleSheetWrapper;
 
@@ -35,7 +40,7 @@ public:
 
     CSSRuleList const& rules() const { return m_rules; }
     CSSRuleList& rules() { return m_rules; }
-    void set_rules(NonnullRefPtr<CSSRuleList> rules) { m_rules = move(rules); }
+    void set_rules(NonnullRefPtr<CSSRuleList>);
 
     CSSRuleList* css_rules() { return m_rules; }
     CSSRuleList const* css_rules() const { return m_rules; }
@@ -46,13 +51,22 @@ public:
 
     void for_each_effective_style_rule(Function<void(CSSStyleRule const&)> const& callback) const;
     bool for_first_not_loaded_import_rule(Function<void(CSSImportRule&)> const& callback);
-    void evaluate_media_queries(DOM::Window const&);
+    bool evaluate_media_queries(DOM::Window const&);
+
+    void set_style_sheet_list(Badge<StyleSheetList>, StyleSheetList*);
+
+    // Lets the document know that the set of effective style rules has changed.
+    void invalidate_owners();
 
 private:
     explicit CSSStyleSheet(NonnullRefPtrVector<CSSRule>);
 
+    void adopt_rules(CSSRuleList&);
+
     NonnullRefPtr<CSSRuleList> m_rules;
 
+    WeakPtr<StyleSheetList> m_style_sheet_list;
+
     // FIXME: Use WeakPtr.
     CSSRule* m_owner_css_rule { nullptr };
 };
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <AK/Types.h>
+
+namespace Web::CSS {
+
+// A Bloom filter whose entries can be removed again, by keeping a small counter per bucket
+// instead of a single bit. Each key sets two buckets, taken from the low and high bits of its hash.
+// Counters saturate, after which their bucket stays set until the filter is cleared.
+template<typename CounterType, size_t key_bits>
+class CountingBloomFilter {
+public:
+    static_assert(key_bits <= 16);
+
+    void clear() { m_buckets.fill(0); }
+
+    void increment(u32 key)
+    {
+        increment_bucket(first_bucket(key));
+        increment_bucket(second_bucket(key));
+    }
+
+    void decrement(u32 key)
+    {
+        decrement_bucket(first_bucket(key));
+        decrement_bucket(second_bucket(key));
+    }
+
+    [[nodiscard]] bool may_contain(u32 key) const
+    {
+        return m_buckets[first_bucket(key)] && m_buckets[second_bucket(key)];
+    }
+
+private:
+    static constexpr u32 bucket_count = 1 << key_bits;
+    static constexpr u32 key_mask = bucket_count - 1;
+
+    static u32 first_bucket(u32 key) { return key & key_mask; }
+    static u32 second_bucket(u32 key) { return (key >> 16) & key_mask; }
+
+    void increment_bucket(u32 index)
+    {
+        if (m_buckets[index] != NumericLimits<CounterType>::max())
+            ++m_buckets[index];
+    }
+
+    void decrement_bucket(u32 index)
+    {
+        // A saturated counter may have lost increments, so it has to stay put.
+        if (m_buckets[index] != NumericLimits<CounterType>::max() && m_buckets[index] != 0)
+            --m_buckets[index];
+    }
+
+    Array<CounterType, bucket_count> m_buckets {};
+};
+
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <LibWeb/CSS/CSSStyleDeclaration.h>
+
+namespace Web::CSS {
+
+// The custom properties in effect for an element, including the inherited ones.
+// An element that doesn't declare any custom properties itself shares the map of its parent,
+// so a copy is only made where a custom property is actually declared.
+class CustomProperties : public RefCounted<CustomProperties> {
+public:
+    static NonnullRefPtr<CustomProperties> create() { return adopt_ref(*new CustomProperties); }
+
+    NonnullRefPtr<CustomProperties> clone() const
+    {
+        auto clone = create();
+        clone->m_properties = m_properties;
+        return clone;
+    }
+
+    Optional<StyleProperty> get(String const& name) const { return m_properties.get(name); }
+    void set(String const& name, StyleProperty const& property) { m_properties.set(name, property); }
+
+    size_t size() const { return m_properties.size(); }
+
+private:
+    CustomProperties() = default;
+
+    HashMap<String, StyleProperty> m_properties;
+};
+
+}
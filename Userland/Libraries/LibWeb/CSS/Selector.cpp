@@ -5,6 +5,7 @@
  */
 
 #include "Selector.h"
+#include <AK/CharacterTypes.h>
 #include <LibWeb/CSS/Serialize.h>
 
 namespace Web::CSS {
@@ -12,6 +13,60 @@ namespace Web::CSS {
 Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     : m_compound_selectors(move(compound_selectors))
 {
+    collect_ancestor_hashes();
+}
+
+u32 Selector::ancestor_hash_for_class(StringView const& class_name)
+{
+    u32 hash = 0;
+    for (auto ch : class_name) {
+        hash += (u32)to_ascii_lowercase(ch);
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    hash += hash << 3;
+    hash ^= hash >> 11;
+    hash += hash << 15;
+    return pair_int_hash(hash, 3);
+}
+
+void Selector::collect_ancestor_hashes()
+{
+    size_t next_hash_index = 0;
+    auto append_hash = [&](u32 hash) {
+        if (!hash || next_hash_index >= max_ancestor_hashes)
+            return;
+        for (size_t i = 0; i < next_hash_index; ++i) {
+            if (m_ancestor_hashes[i] == hash)
+                return;
+        }
+        m_ancestor_hashes[next_hash_index++] = hash;
+    };
+
+    // Walk the compound selectors right to left. A compound selector has to match an ancestor if its right
+    // neighbor is joined to it by a descendant or child combinator. Compounds reached through sibling
+    // combinators match siblings instead, but anything to the left of those is still relevant, since
+    // siblings share their ancestors.
+    for (ssize_t i = (ssize_t)m_compound_selectors.size() - 2; i >= 0; --i) {
+        auto relation_to_right_neighbor = m_compound_selectors[i + 1].combinator;
+        if (relation_to_right_neighbor != Combinator::Descendant && relation_to_right_neighbor != Combinator::ImmediateChild)
+            continue;
+        for (auto& simple_selector : m_compound_selectors[i].simple_selectors) {
+            switch (simple_selector.type) {
+            case SimpleSelector::Type::Id:
+                append_hash(ancestor_hash_for_id(simple_selector.value));
+                break;
+            case SimpleSelector::Type::Class:
+                append_hash(ancestor_hash_for_class(simple_selector.value));
+                break;
+            case SimpleSelector::Type::TagName:
+                append_hash(ancestor_hash_for_tag_name(simple_selector.value));
+                break;
+            default:
+                break;
+            }
+        }
+    }
 }
 
 Selector::~Selector()
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/FlyString.h>
+#include <AK/HashFunctions.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/RefCounted.h>
 #include <AK/String.h>
@@ -134,10 +136,23 @@ public:
     u32 specificity() const;
     String serialize() const;
 
+    // Hashes of id, class and tag name selectors which must all be present on the ancestors of a matching
+    // element, used to reject the selector early with an ancestor filter. Unused entries are 0.
+    static constexpr size_t max_ancestor_hashes = 8;
+    Array<u32, max_ancestor_hashes> const& ancestor_hashes() const { return m_ancestor_hashes; }
+
+    static u32 ancestor_hash_for_tag_name(FlyString const& tag_name) { return pair_int_hash(tag_name.hash(), 1); }
+    static u32 ancestor_hash_for_id(StringView const& id) { return pair_int_hash(id.hash(), 2); }
+    // Class names match case-insensitively in quirks mode, so they are always hashed in lowercase.
+    static u32 ancestor_hash_for_class(StringView const& class_name);
+
 private:
     explicit Selector(Vector<CompoundSelector>&&);
 
+    void collect_ancestor_hashes();
+
     Vector<CompoundSelector> m_compound_selectors;
+    Array<u32, max_ancestor_hashes> m_ancestor_hashes {};
 };
 
 constexpr StringView pseudo_element_name(Selector::SimpleSelector::PseudoElement);
@@ -18,6 +18,7 @@
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/Dump.h>
 #include <LibWeb/FontCache.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/Page/BrowsingContext.h>
 #include <ctype.h>
 #include <stdio.h>
@@ -72,26 +73,175 @@ void StyleComputer::for_each_stylesheet(CascadeOrigin cascade_origin, Callback c
 
 Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin declaration_type) const
 {
+    auto collect_candidates = [&](RuleCache const& rule_cache, Vector<MatchingRule>& candidates) {
+        if (auto id = element.attribute(HTML::AttributeNames::id); !id.is_null()) {
+            if (auto it = rule_cache.rules_by_id.find(id); it != rule_cache.rules_by_id.end())
+                candidates.extend(it->value);
+        }
+        for (auto& class_name : element.class_names()) {
+            if (auto it = rule_cache.rules_by_class.find(class_name); it != rule_cache.rules_by_class.end())
+                candidates.extend(it->value);
+        }
+        if (auto it = rule_cache.rules_by_tag_name.find(element.local_name()); it != rule_cache.rules_by_tag_name.end())
+            candidates.extend(it->value);
+        candidates.extend(rule_cache.other_rules);
+    };
+
+    Vector<MatchingRule> candidates;
+    if (declaration_type == CascadeOrigin::Any || declaration_type == CascadeOrigin::UserAgent)
+        collect_candidates(rule_cache_for_cascade_origin(CascadeOrigin::UserAgent), candidates);
+    if (declaration_type == CascadeOrigin::Any || declaration_type == CascadeOrigin::Author)
+        collect_candidates(rule_cache_for_cascade_origin(CascadeOrigin::Author), candidates);
+
+    // Like a full scan of all rules, only consider the first matching selector of every rule.
+    // The candidates for one rule may come from several buckets, so bring them back into rule order first.
+    quick_sort(candidates, [](MatchingRule const& a, MatchingRule const& b) {
+        if (a.style_sheet_index != b.style_sheet_index)
+            return a.style_sheet_index < b.style_sheet_index;
+        if (a.rule_index != b.rule_index)
+            return a.rule_index < b.rule_index;
+        return a.selector_index < b.selector_index;
+    });
+
+    bool use_ancestor_filter = can_use_ancestor_filter_for(element);
+
     Vector<MatchingRule> matching_rules;
+    for (auto& candidate : candidates) {
+        if (!matching_rules.is_empty()) {
+            auto& last_match = matching_rules.last();
+            if (last_match.style_sheet_index == candidate.style_sheet_index && last_match.rule_index == candidate.rule_index)
+                continue;
+        }
+        auto& selector = candidate.rule->selectors()[candidate.selector_index];
+        if (use_ancestor_filter && should_reject_with_ancestor_filter(selector))
+            continue;
+        if (SelectorEngine::matches(selector, element))
+            matching_rules.append(candidate);
+    }
+
+    return matching_rules;
+}
+
+void StyleComputer::build_rule_cache_if_needed() const
+{
+    if (m_author_rule_cache && m_user_agent_rule_cache)
+        return;
+
+    auto user_agent_rule_cache = make<RuleCache>();
+    auto author_rule_cache = make<RuleCache>();
 
     size_t style_sheet_index = 0;
-    for_each_stylesheet(declaration_type, [&](auto& sheet) {
+    auto add_style_sheet = [&](RuleCache& rule_cache, StyleSheet const& sheet) {
         size_t rule_index = 0;
         static_cast<CSSStyleSheet const&>(sheet).for_each_effective_style_rule([&](auto const& rule) {
             size_t selector_index = 0;
             for (auto& selector : rule.selectors()) {
-                if (SelectorEngine::matches(selector, element)) {
-                    matching_rules.append({ rule, style_sheet_index, rule_index, selector_index, selector.specificity() });
-                    break;
+                MatchingRule matching_rule { rule, style_sheet_index, rule_index, selector_index, selector.specificity() };
+                bool added_to_bucket = false;
+                auto& rightmost_compound_selector = selector.compound_selectors().last();
+                for (auto const& simple_selector : rightmost_compound_selector.simple_selectors) {
+                    if (simple_selector.type == Selector::SimpleSelector::Type::Id) {
+                        rule_cache.rules_by_id.ensure(simple_selector.value).append(move(matching_rule));
+                        added_to_bucket = true;
+                        break;
+                    }
+                }
+                if (!added_to_bucket) {
+                    for (auto const& simple_selector : rightmost_compound_selector.simple_selectors) {
+                        if (simple_selector.type == Selector::SimpleSelector::Type::Class) {
+                            rule_cache.rules_by_class.ensure(simple_selector.value).append(move(matching_rule));
+                            added_to_bucket = true;
+                            break;
+                        }
+                    }
+                }
+                if (!added_to_bucket) {
+                    for (auto const& simple_selector : rightmost_compound_selector.simple_selectors) {
+                        if (simple_selector.type == Selector::SimpleSelector::Type::TagName) {
+                            rule_cache.rules_by_tag_name.ensure(simple_selector.value).append(move(matching_rule));
+                            added_to_bucket = true;
+                            break;
+                        }
+                    }
                 }
+                if (!added_to_bucket)
+                    rule_cache.other_rules.append(move(matching_rule));
                 ++selector_index;
             }
             ++rule_index;
         });
         ++style_sheet_index;
-    });
+    };
 
-    return matching_rules;
+    for_each_stylesheet(CascadeOrigin::UserAgent, [&](auto& sheet) { add_style_sheet(*user_agent_rule_cache, sheet); });
+    for_each_stylesheet(CascadeOrigin::Author, [&](auto& sheet) { add_style_sheet(*author_rule_cache, sheet); });
+
+    m_user_agent_rule_cache = move(user_agent_rule_cache);
+    m_author_rule_cache = move(author_rule_cache);
+}
+
+StyleComputer::RuleCache const& StyleComputer::rule_cache_for_cascade_origin(CascadeOrigin cascade_origin) const
+{
+    build_rule_cache_if_needed();
+    switch (cascade_origin) {
+    case CascadeOrigin::Author:
+        return *m_author_rule_cache;
+    case CascadeOrigin::UserAgent:
+        return *m_user_agent_rule_cache;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void StyleComputer::invalidate_rule_cache()
+{
+    m_author_rule_cache = nullptr;
+    m_user_agent_rule_cache = nullptr;
+}
+
+void StyleComputer::push_ancestor(DOM::Element const& element)
+{
+    size_t hash_count = 0;
+    auto add_hash = [&](u32 hash) {
+        m_ancestor_filter.increment(hash);
+        m_ancestor_filter_hashes.append(hash);
+        ++hash_count;
+    };
+    add_hash(Selector::ancestor_hash_for_tag_name(element.local_name()));
+    if (auto id = element.attribute(HTML::AttributeNames::id); !id.is_null())
+        add_hash(Selector::ancestor_hash_for_id(id));
+    for (auto& class_name : element.class_names())
+        add_hash(Selector::ancestor_hash_for_class(class_name));
+    m_ancestor_filter_entries.append({ &element, hash_count });
+}
+
+void StyleComputer::pop_ancestor(DOM::Element const& element)
+{
+    auto entry = m_ancestor_filter_entries.take_last();
+    VERIFY(entry.element == &element);
+    for (size_t i = 0; i < entry.hash_count; ++i)
+        m_ancestor_filter.decrement(m_ancestor_filter_hashes.take_last());
+}
+
+bool StyleComputer::can_use_ancestor_filter_for(DOM::Element const& element) const
+{
+    // The filter must know about every ancestor of the element, which is only the case for children
+    // of the innermost pushed ancestor.
+    if (m_ancestor_filter_entries.is_empty())
+        return false;
+    auto* parent = element.parent_element();
+    return parent && parent == m_ancestor_filter_entries.last().element;
+}
+
+bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+{
+    for (auto hash : selector.ancestor_hashes()) {
+        if (!hash)
+            break;
+        if (!m_ancestor_filter.may_contain(hash))
+            return true;
+    }
+    return false;
 }
 
 void StyleComputer::sort_matching_rules(Vector<MatchingRule>& matching_rules) const
@@ -473,39 +623,48 @@ static void set_property_expanding_shorthands(StyleProperties& style, CSS::Prope
     style.set_property(property_id, value);
 }
 
-StyleComputer::CustomPropertyResolutionTuple StyleComputer::resolve_custom_property_with_specificity(DOM::Element& element, String const& custom_property_name) const
+void StyleComputer::compute_custom_properties(DOM::Element& element, MatchingRuleSet const& matching_rule_set) const
 {
-    if (auto maybe_property = element.resolve_custom_property(custom_property_name); maybe_property.has_value())
-        return maybe_property.value();
-
-    auto parent_element = element.parent_element();
-    CustomPropertyResolutionTuple parent_resolved {};
-    if (parent_element)
-        parent_resolved = resolve_custom_property_with_specificity(*parent_element, custom_property_name);
-
-    auto matching_rules = collect_matching_rules(element);
-    sort_matching_rules(matching_rules);
-
-    for (int i = matching_rules.size() - 1; i >= 0; --i) {
-        auto& match = matching_rules[i];
-        if (match.specificity < parent_resolved.specificity)
-            continue;
-
-        auto custom_property_style = verify_cast<PropertyOwningCSSStyleDeclaration>(match.rule->declaration()).custom_property(custom_property_name);
-        if (custom_property_style.has_value()) {
-            element.add_custom_property(custom_property_name, { custom_property_style.value(), match.specificity });
-            return { custom_property_style.value(), match.specificity };
-        }
+    RefPtr<CustomProperties const> inherited_custom_properties;
+    if (auto* parent_element = element.parent_element()) {
+        // Parents are normally styled before their children, but e.g. a detached subtree may not have been styled yet.
+        if (!parent_element->custom_properties())
+            compute_custom_properties(*parent_element, collect_sorted_matching_rules(*parent_element));
+        inherited_custom_properties = parent_element->custom_properties();
     }
 
-    return parent_resolved;
-}
-
-Optional<StyleProperty> StyleComputer::resolve_custom_property(DOM::Element& element, String const& custom_property_name) const
-{
-    auto resolved_with_specificity = resolve_custom_property_with_specificity(element, custom_property_name);
-
-    return resolved_with_specificity.style;
+    // Only copy the inherited custom properties once the element turns out to declare some of its own.
+    RefPtr<CustomProperties> custom_properties;
+    auto cascade_custom_properties = [&](PropertyOwningCSSStyleDeclaration const& declaration, bool important) {
+        for (auto& it : declaration.custom_properties()) {
+            if (important != it.value.important)
+                continue;
+            if (!custom_properties)
+                custom_properties = inherited_custom_properties ? inherited_custom_properties->clone() : CustomProperties::create();
+            custom_properties->set(it.key, it.value);
+        }
+    };
+    auto cascade_matching_rules = [&](Vector<MatchingRule> const& matching_rules, bool important) {
+        for (auto& match : matching_rules)
+            cascade_custom_properties(verify_cast<PropertyOwningCSSStyleDeclaration>(match.rule->declaration()), important);
+    };
+    auto const* inline_style = verify_cast<ElementInlineCSSStyleDeclaration>(element.inline_style());
+
+    cascade_matching_rules(matching_rule_set.user_agent_rules, false);
+    cascade_matching_rules(matching_rule_set.author_rules, false);
+    if (inline_style)
+        cascade_custom_properties(*inline_style, false);
+    cascade_matching_rules(matching_rule_set.author_rules, true);
+    if (inline_style)
+        cascade_custom_properties(*inline_style, true);
+    cascade_matching_rules(matching_rule_set.user_agent_rules, true);
+
+    if (custom_properties)
+        element.set_custom_properties(custom_properties.release_nonnull());
+    else if (inherited_custom_properties)
+        element.set_custom_properties(inherited_custom_properties.release_nonnull());
+    else
+        element.set_custom_properties(CustomProperties::create());
 }
 
 struct MatchingDeclarations {
@@ -522,10 +681,8 @@ void StyleComputer::cascade_declarations(StyleProperties& style, DOM::Element& e
             auto property_value = property.value;
             if (property.value->is_custom_property()) {
                 auto custom_property_name = property.value->as_custom_property().custom_property_name();
-                auto resolved = resolve_custom_property(element, custom_property_name);
-                if (resolved.has_value()) {
+                if (auto resolved = element.custom_properties()->get(custom_property_name); resolved.has_value())
                     property_value = resolved.value().value;
-                }
             }
             set_property_expanding_shorthands(style, property.property_id, property_value, m_document);
         }
@@ -542,15 +699,24 @@ void StyleComputer::cascade_declarations(StyleProperties& style, DOM::Element& e
     }
 }
 
-// https://www.w3.org/TR/css-cascade/#cascading
-void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element& element) const
+StyleComputer::MatchingRuleSet StyleComputer::collect_sorted_matching_rules(DOM::Element const& element) const
 {
-    // First, we collect all the CSS rules whose selectors match `element`:
     MatchingRuleSet matching_rule_set;
     matching_rule_set.user_agent_rules = collect_matching_rules(element, CascadeOrigin::UserAgent);
     sort_matching_rules(matching_rule_set.user_agent_rules);
     matching_rule_set.author_rules = collect_matching_rules(element, CascadeOrigin::Author);
     sort_matching_rules(matching_rule_set.author_rules);
+    return matching_rule_set;
+}
+
+// https://www.w3.org/TR/css-cascade/#cascading
+void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element& element) const
+{
+    // First, we collect all the CSS rules whose selectors match `element`:
+    auto matching_rule_set = collect_sorted_matching_rules(element);
+
+    // Custom properties are cascaded up front, since var() references in the other declarations need their values.
+    compute_custom_properties(element, matching_rule_set);
 
     // Then we apply the declarations from the matched rules in cascade order:
 
@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
+#include <LibWeb/CSS/CountingBloomFilter.h>
+#include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/Forward.h>
 
@@ -45,12 +49,14 @@ public:
 
     Vector<MatchingRule> collect_matching_rules(DOM::Element const&, CascadeOrigin = CascadeOrigin::Any) const;
     void sort_matching_rules(Vector<MatchingRule>&) const;
-    struct CustomPropertyResolutionTuple {
-        Optional<StyleProperty> style {};
-        u32 specificity { 0 };
-    };
-    CustomPropertyResolutionTuple resolve_custom_property_with_specificity(DOM::Element&, String const&) const;
-    Optional<StyleProperty> resolve_custom_property(DOM::Element&, String const&) const;
+    // Must be called whenever the set of effective style rules changes.
+    void invalidate_rule_cache();
+
+    // While styling a subtree, the ancestor filter tracks the ids, classes and tag names of the ancestors
+    // of the element being styled, so that selectors with descendant or child combinators can often be
+    // rejected without walking up the tree.
+    void push_ancestor(DOM::Element const&);
+    void pop_ancestor(DOM::Element const&);
 
 private:
     void compute_cascaded_values(StyleProperties&, DOM::Element&) const;
@@ -68,9 +74,42 @@ private:
         Vector<MatchingRule> author_rules;
     };
 
+    MatchingRuleSet collect_sorted_matching_rules(DOM::Element const&) const;
+    void compute_custom_properties(DOM::Element&, MatchingRuleSet const&) const;
+
     void cascade_declarations(StyleProperties&, DOM::Element&, Vector<MatchingRule> const&, CascadeOrigin, bool important) const;
 
+    struct CaseInsensitiveClassNameTraits : public Traits<FlyString> {
+        static unsigned hash(FlyString const& class_name) { return Selector::ancestor_hash_for_class(class_name); }
+        static bool equals(FlyString const& a, FlyString const& b) { return a.equals_ignoring_case(b); }
+    };
+
+    // Every selector is filed under one id, class or tag name from its rightmost compound selector,
+    // so that an element only has to be tested against the rules that could possibly match it.
+    struct RuleCache {
+        HashMap<FlyString, Vector<MatchingRule>> rules_by_id;
+        HashMap<FlyString, Vector<MatchingRule>, CaseInsensitiveClassNameTraits> rules_by_class;
+        HashMap<FlyString, Vector<MatchingRule>> rules_by_tag_name;
+        Vector<MatchingRule> other_rules;
+    };
+
+    void build_rule_cache_if_needed() const;
+    RuleCache const& rule_cache_for_cascade_origin(CascadeOrigin) const;
+    bool can_use_ancestor_filter_for(DOM::Element const&) const;
+    bool should_reject_with_ancestor_filter(Selector const&) const;
+
     DOM::Document& m_document;
+
+    mutable OwnPtr<RuleCache> m_author_rule_cache;
+    mutable OwnPtr<RuleCache> m_user_agent_rule_cache;
+
+    struct AncestorFilterEntry {
+        DOM::Element const* element { nullptr };
+        size_t hash_count { 0 };
+    };
+    CountingBloomFilter<u8, 14> m_ancestor_filter;
+    Vector<u32> m_ancestor_filter_hashes;
+    Vector<AncestorFilterEntry> m_ancestor_filter_entries;
 };
 
 }
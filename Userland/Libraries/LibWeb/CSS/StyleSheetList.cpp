@@ -4,19 +4,27 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleSheetList.h>
+#include <LibWeb/DOM/Document.h>
 
 namespace Web::CSS {
 
 void StyleSheetList::add_sheet(NonnullRefPtr<CSSStyleSheet> sheet)
 {
     VERIFY(!m_sheets.contains_slow(sheet));
+    sheet->set_style_sheet_list({}, this);
     m_sheets.append(move(sheet));
+    if (m_document)
+        m_document->style_computer().invalidate_rule_cache();
 }
 
 void StyleSheetList::remove_sheet(CSSStyleSheet& sheet)
 {
+    sheet.set_style_sheet_list({}, nullptr);
     m_sheets.remove_first_matching([&](auto& entry) { return &*entry == &sheet; });
+    if (m_document)
+        m_document->style_computer().invalidate_rule_cache();
 }
 
 StyleSheetList::StyleSheetList(DOM::Document& document)
@@ -8,6 +8,8 @@
 
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/RefCounted.h>
+#include <AK/WeakPtr.h>
+#include <AK/Weakable.h>
 #include <LibWeb/Bindings/Wrappable.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/Forward.h>
@@ -16,6 +18,7 @@ namespace Web::CSS {
 
 class StyleSheetList
     : public RefCounted<StyleSheetList>
+    , public Weakable<StyleSheetList>
     , public Bindings::Wrappable {
 public:
     using WrapperType = Bindings::StyleSheetListWrapper;
@@ -42,10 +45,14 @@ public:
 
     bool is_supported_property_index(u32) const;
 
+    // The document may be gone already if the bindings are keeping us alive.
+    DOM::Document* document() { return m_document.ptr(); }
+    DOM::Document const* document() const { return m_document.ptr(); }
+
 private:
     explicit StyleSheetList(DOM::Document&);
 
-    DOM::Document& m_document;
+    WeakPtr<DOM::Document> m_document;
     NonnullRefPtrVector<CSSStyleSheet> m_sheets;
 };
 
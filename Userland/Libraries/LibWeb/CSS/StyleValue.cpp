@@ -9,6 +9,7 @@
 #include <LibGfx/Palette.h>
 #include <LibWeb/CSS/StyleValue.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Loader/LoadRequest.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/BrowsingContext.h>
@@ -388,6 +389,14 @@ void ImageStyleValue::resource_did_load()
     if (!m_document)
         return;
     m_bitmap = resource()->bitmap();
+    // Only the display lists that paint this image have to be recorded again.
+    if (auto* layout_root = m_document->layout_node()) {
+        layout_root->for_each_in_inclusive_subtree_of_type<Layout::NodeWithStyle>([&](auto& layout_node) {
+            if (layout_node.background_image() == this || layout_node.list_style_image() == this)
+                layout_node.invalidate_enclosing_display_list();
+            return IterationDecision::Continue;
+        });
+    }
     // FIXME: Do less than a full repaint if possible?
     if (m_document && m_document->browsing_context())
         m_document->browsing_context()->set_needs_display({});
@@ -6,6 +6,7 @@
 
 #include <LibWeb/DOM/CharacterData.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/Layout/Node.h>
 
 namespace Web::DOM {
 
@@ -25,6 +26,8 @@ void CharacterData::set_data(String data)
         return;
     m_data = move(data);
     set_needs_style_update(true);
+    if (layout_node())
+        layout_node()->set_needs_layout();
 }
 
 }
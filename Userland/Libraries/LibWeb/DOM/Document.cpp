@@ -8,6 +8,7 @@
  */
 
 #include <AK/CharacterTypes.h>
+#include <AK/HashTable.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
@@ -53,6 +54,8 @@
 #include <LibWeb/HTML/MessageEvent.h>
 #include <LibWeb/Layout/BlockFormattingContext.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
+#include <LibWeb/Layout/Label.h>
+#include <LibWeb/Layout/LabelableNode.h>
 #include <LibWeb/Layout/TreeBuilder.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Origin.h>
@@ -81,7 +84,7 @@ Document::Document(const AK::URL& url)
     });
 
     m_layout_update_timer = Core::Timer::create_single_shot(0, [this] {
-        force_layout();
+        update_layout();
     });
 }
 
@@ -404,29 +407,105 @@ AK::URL Document::parse_url(String const& url) const
 
 void Document::set_needs_layout()
 {
-    if (m_needs_layout)
+    if (!m_layout_root) {
+        schedule_layout_update();
         return;
-    m_needs_layout = true;
-    schedule_layout_update();
+    }
+
+    // Lengths relative to the viewport can change the size of anything, so the cached intrinsic widths are no good either.
+    m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& box) {
+        box.clear_cached_intrinsic_widths();
+        return IterationDecision::Continue;
+    });
+    m_layout_root->set_needs_layout();
 }
 
-void Document::force_layout()
+void Document::ensure_layout()
 {
-    tear_down_layout_tree();
     update_layout();
 }
 
-void Document::ensure_layout()
+// Returns the node whose layout node has to have its children built again for the children of the given node to be up to date.
+static Node* layout_tree_rebuild_root(Node& node)
 {
-    if (m_needs_layout || !m_layout_root)
-        update_layout();
+    auto* layout_node = node.layout_node();
+    if (!layout_node || !layout_node->can_have_children())
+        return nullptr;
+
+    // Block-level children of an inline box end up in its nearest block container, so that one has to be rebuilt instead.
+    for (Node* ancestor = &node; ancestor; ancestor = ancestor->parent_or_shadow_host()) {
+        auto* ancestor_layout_node = ancestor->layout_node();
+        if (!ancestor_layout_node)
+            return nullptr;
+        if (!ancestor_layout_node->is_inline() || ancestor_layout_node->is_inline_block())
+            return ancestor;
+    }
+    return nullptr;
 }
 
-void Document::update_layout()
+static void collect_layout_tree_rebuild_roots(Node& node, HashTable<Node*>& rebuild_roots)
+{
+    if (node.needs_layout_tree_update()) {
+        // Everything below the rebuild root gets built again, so there's no need to look any further.
+        if (auto* rebuild_root = layout_tree_rebuild_root(node))
+            rebuild_roots.set(rebuild_root);
+        return;
+    }
+    if (!node.child_needs_layout_tree_update())
+        return;
+
+    if (is<Element>(node)) {
+        if (auto* shadow_root = static_cast<Element&>(node).shadow_root())
+            collect_layout_tree_rebuild_roots(*shadow_root, rebuild_roots);
+    }
+    node.for_each_child([&](auto& child) {
+        collect_layout_tree_rebuild_roots(child, rebuild_roots);
+        return IterationDecision::Continue;
+    });
+}
+
+static void clear_layout_tree_update_flags(Node& node)
 {
-    if (!m_needs_layout && m_layout_root)
+    if (!node.needs_layout_tree_update() && !node.child_needs_layout_tree_update())
         return;
+    node.set_needs_layout_tree_update(false);
+    node.set_child_needs_layout_tree_update(false);
+
+    if (is<Element>(node)) {
+        if (auto* shadow_root = static_cast<Element&>(node).shadow_root())
+            clear_layout_tree_update_flags(*shadow_root);
+    }
+    node.for_each_child([&](auto& child) {
+        clear_layout_tree_update_flags(child);
+        return IterationDecision::Continue;
+    });
+}
 
+void Document::update_layout_tree()
+{
+    if (!needs_layout_tree_update() && !child_needs_layout_tree_update())
+        return;
+
+    HashTable<Node*> rebuild_roots;
+    collect_layout_tree_rebuild_roots(*this, rebuild_roots);
+
+    for (auto* rebuild_root : rebuild_roots) {
+        // A root inside of another one is rebuilt along with it.
+        bool is_inside_other_root = false;
+        for (auto* ancestor = rebuild_root->parent_or_shadow_host(); ancestor && !is_inside_other_root; ancestor = ancestor->parent_or_shadow_host())
+            is_inside_other_root = rebuild_roots.contains(ancestor);
+        if (is_inside_other_root)
+            continue;
+
+        Layout::TreeBuilder tree_builder;
+        tree_builder.rebuild_children(*rebuild_root);
+    }
+
+    clear_layout_tree_update_flags(*this);
+}
+
+void Document::update_layout()
+{
     if (!browsing_context())
         return;
 
@@ -435,11 +514,33 @@ void Document::update_layout()
     if (!m_layout_root) {
         Layout::TreeBuilder tree_builder;
         m_layout_root = static_ptr_cast<Layout::InitialContainingBlock>(tree_builder.build(*this));
+        clear_layout_tree_update_flags(*this);
+    } else {
+        update_layout_tree();
     }
 
-    Layout::BlockFormattingContext root_formatting_context(*m_layout_root, nullptr);
-    root_formatting_context.run(*m_layout_root, Layout::LayoutMode::Default);
+    if (!m_layout_root->needs_layout() && !m_layout_root->child_needs_layout()) {
+        m_layout_update_timer->stop();
+        return;
+    }
 
+    // Boxes may have been added, removed or restyled, so the stacking context tree has to be built again.
+    m_layout_root->invalidate_stacking_context_tree();
+
+    if (auto layout_roots = m_layout_root->collect_layout_roots(); layout_roots.has_value()) {
+        // Only lay out the subtrees that need it. Their size is fixed, so nothing else can move.
+        for (auto* layout_root : *layout_roots) {
+            Layout::BlockFormattingContext formatting_context(verify_cast<Layout::BlockContainer>(*layout_root), nullptr);
+            formatting_context.run(*layout_root, Layout::LayoutMode::Default);
+        }
+        m_layout_root->build_stacking_context_tree();
+        m_layout_root->recompute_scrollable_overflow();
+    } else {
+        Layout::BlockFormattingContext root_formatting_context(*m_layout_root, nullptr);
+        root_formatting_context.run(*m_layout_root, Layout::LayoutMode::Default);
+    }
+
+    m_layout_root->clear_needs_layout();
     m_layout_root->set_needs_display();
 
     if (browsing_context()->is_top_level()) {
@@ -447,7 +548,6 @@ void Document::update_layout()
             page->client().page_did_layout();
     }
 
-    m_needs_layout = false;
     m_layout_update_timer->stop();
 }
 
@@ -458,11 +558,16 @@ static void update_style_recursively(DOM::Node& node)
     node.set_needs_style_update(false);
 
     if (node.child_needs_style_update()) {
+        auto* element = is<Element>(node) ? static_cast<Element*>(&node) : nullptr;
+        if (element)
+            node.document().style_computer().push_ancestor(*element);
         node.for_each_child([&](auto& child) {
             if (child.needs_style_update() || child.child_needs_style_update())
                 update_style_recursively(child);
             return IterationDecision::Continue;
         });
+        if (element)
+            node.document().style_computer().pop_ancestor(*element);
     }
 
     node.set_child_needs_style_update(false);
@@ -476,7 +581,6 @@ void Document::update_style()
         return;
     update_style_recursively(*this);
     m_style_update_timer->stop();
-    set_needs_layout();
 }
 
 RefPtr<Layout::Node> Document::create_layout_node()
@@ -523,6 +627,30 @@ void Document::set_inspected_node(Node* node)
         m_inspected_node->layout_node()->set_needs_display();
 }
 
+// Hover, focus and active state are partly painted without going through style,
+// so the display lists that paint them have to be recorded again by hand.
+static void invalidate_display_lists_painting_state_of(Node* node)
+{
+    if (!node)
+        return;
+
+    // Controls paint themselves as hovered while their label (or its text) is, see Layout::Label::is_associated_label_hovered().
+    for (auto* label_candidate : { node, node->parent() }) {
+        if (!label_candidate || !label_candidate->layout_node() || !is<Layout::Label>(*label_candidate->layout_node()))
+            continue;
+        if (auto* control = verify_cast<Layout::Label>(*label_candidate->layout_node()).control_node())
+            control->invalidate_enclosing_display_list();
+    }
+
+    auto* layout_node = node->layout_node();
+    if (!layout_node)
+        return;
+    layout_node->invalidate_enclosing_display_list();
+    // The focus outline of inline content is painted along with the lines of its containing block.
+    if (auto* containing_block = layout_node->containing_block())
+        containing_block->invalidate_enclosing_display_list();
+}
+
 void Document::set_hovered_node(Node* node)
 {
     if (m_hovered_node == node)
@@ -532,6 +660,9 @@ void Document::set_hovered_node(Node* node)
     m_hovered_node = node;
 
     invalidate_style();
+
+    invalidate_display_lists_painting_state_of(old_hovered_node.ptr());
+    invalidate_display_lists_painting_state_of(m_hovered_node.ptr());
 }
 
 NonnullRefPtr<HTMLCollection> Document::get_elements_by_name(String const& name)
@@ -922,7 +1053,9 @@ void Document::set_focused_element(Element* element)
     if (m_focused_element == element)
         return;
 
+    invalidate_display_lists_painting_state_of(m_focused_element.ptr());
     m_focused_element = element;
+    invalidate_display_lists_painting_state_of(m_focused_element.ptr());
 
     if (m_layout_root)
         m_layout_root->set_needs_display();
@@ -933,7 +1066,9 @@ void Document::set_active_element(Element* element)
     if (m_active_element == element)
         return;
 
+    invalidate_display_lists_painting_state_of(m_active_element.ptr());
     m_active_element = element;
+    invalidate_display_lists_painting_state_of(m_active_element.ptr());
 
     if (m_layout_root)
         m_layout_root->set_needs_display();
@@ -1160,8 +1295,15 @@ void Document::evaluate_media_queries_and_report_changes()
     }
 
     // Also not in the spec, but this is as good a place as any to evaluate @media rules!
+    bool any_media_queries_changed_match_state = false;
     for (auto& style_sheet : style_sheets().sheets()) {
-        style_sheet.evaluate_media_queries(window());
+        if (style_sheet.evaluate_media_queries(window()))
+            any_media_queries_changed_match_state = true;
+    }
+
+    if (any_media_queries_changed_match_state) {
+        style_computer().invalidate_rule_cache();
+        invalidate_style();
     }
 }
 
@@ -143,7 +143,6 @@ public:
     Color visited_link_color() const;
     void set_visited_link_color(Color);
 
-    void force_layout();
     void ensure_layout();
 
     void update_style();
@@ -201,7 +200,12 @@ public:
 
     QuirksMode mode() const { return m_quirks_mode; }
     bool in_quirks_mode() const { return m_quirks_mode == QuirksMode::Yes; }
-    void set_quirks_mode(QuirksMode mode) { m_quirks_mode = mode; }
+    void set_quirks_mode(QuirksMode mode)
+    {
+        m_quirks_mode = mode;
+        // The user agent style sheets depend on the mode.
+        m_style_computer->invalidate_rule_cache();
+    }
 
     ExceptionOr<NonnullRefPtr<Node>> import_node(NonnullRefPtr<Node> node, bool deep);
     void adopt_node(Node&);
@@ -317,6 +321,7 @@ private:
     virtual EventTarget& global_event_handlers_to_event_target() final { return *this; }
 
     void tear_down_layout_tree();
+    void update_layout_tree();
 
     void increment_referencing_node_count()
     {
@@ -400,8 +405,6 @@ private:
 
     // Used by evaluate_media_queries_and_report_changes().
     Vector<WeakPtr<CSS::MediaQueryList>> m_media_query_lists;
-
-    bool m_needs_layout { false };
 };
 
 }
@@ -26,11 +26,11 @@
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/InlineNode.h>
 #include <LibWeb/Layout/ListItemBox.h>
+#include <LibWeb/Layout/ReplacedBox.h>
 #include <LibWeb/Layout/TableBox.h>
 #include <LibWeb/Layout/TableCellBox.h>
 #include <LibWeb/Layout/TableRowBox.h>
 #include <LibWeb/Layout/TableRowGroupBox.h>
-#include <LibWeb/Layout/TreeBuilder.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/BrowsingContext.h>
 
@@ -93,6 +93,10 @@ ExceptionOr<void> Element::set_attribute(const FlyString& name, const String& va
     }
 
     parse_attribute(attribute->local_name(), value);
+
+    // Replaced elements may take their intrinsic size from attributes, which doesn't show up as a style change.
+    if (layout_node() && is<Layout::ReplacedBox>(*layout_node()))
+        layout_node()->set_needs_layout();
     return {};
 }
 
@@ -101,6 +105,9 @@ void Element::remove_attribute(const FlyString& name)
 {
     CSS::StyleInvalidator style_invalidator(document());
     m_attributes->remove_attribute(name);
+
+    if (layout_node() && is<Layout::ReplacedBox>(*layout_node()))
+        layout_node()->set_needs_layout();
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattribute
@@ -120,8 +127,7 @@ bool Element::has_class(const FlyString& class_name, CaseSensitivity case_sensit
 
 RefPtr<Layout::Node> Element::create_layout_node()
 {
-    auto style = document().style_computer().compute_style(*this);
-    const_cast<Element&>(*this).m_specified_css_values = style;
+    auto style = ensure_specified_css_values();
     auto display = style->display();
 
     if (display.is_none())
@@ -192,24 +198,59 @@ enum class StyleDifference {
     None,
     NeedsRepaint,
     NeedsRelayout,
+    NeedsLayoutTreeUpdate,
 };
 
-static StyleDifference compute_style_difference(CSS::StyleProperties const& old_style, CSS::StyleProperties const& new_style, Layout::NodeWithStyle const& node)
+static bool property_affects_only_painting(CSS::PropertyID property_id)
+{
+    switch (property_id) {
+    case CSS::PropertyID::Color:
+    case CSS::PropertyID::BackgroundColor:
+    case CSS::PropertyID::BackgroundImage:
+    case CSS::PropertyID::BorderTopColor:
+    case CSS::PropertyID::BorderRightColor:
+    case CSS::PropertyID::BorderBottomColor:
+    case CSS::PropertyID::BorderLeftColor:
+    case CSS::PropertyID::OutlineColor:
+    case CSS::PropertyID::TextDecorationColor:
+    case CSS::PropertyID::Cursor:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static StyleDifference compute_style_difference(CSS::StyleProperties const& old_style, CSS::StyleProperties const& new_style)
 {
     if (old_style == new_style)
         return StyleDifference::None;
 
     bool needs_repaint = false;
     bool needs_relayout = false;
+    bool needs_layout_tree_update = false;
+
+    auto property_did_change = [&](CSS::PropertyID property_id) {
+        // The type of layout node we create depends on the display value.
+        if (property_id == CSS::PropertyID::Display)
+            needs_layout_tree_update = true;
+        else if (property_affects_only_painting(property_id))
+            needs_repaint = true;
+        else
+            needs_relayout = true;
+    };
+
+    for (auto& it : old_style.properties()) {
+        auto new_value = new_style.properties().get(it.key);
+        if (!new_value.has_value() || new_value.value()->type() != it.value->type() || *new_value.value() != *it.value)
+            property_did_change(it.key);
+    }
+    for (auto& it : new_style.properties()) {
+        if (!old_style.properties().contains(it.key))
+            property_did_change(it.key);
+    }
 
-    if (new_style.display() != old_style.display())
-        needs_relayout = true;
-
-    if (new_style.color_or_fallback(CSS::PropertyID::Color, node, Color::Black) != old_style.color_or_fallback(CSS::PropertyID::Color, node, Color::Black))
-        needs_repaint = true;
-    else if (new_style.color_or_fallback(CSS::PropertyID::BackgroundColor, node, Color::Black) != old_style.color_or_fallback(CSS::PropertyID::BackgroundColor, node, Color::Black))
-        needs_repaint = true;
-
+    if (needs_layout_tree_update)
+        return StyleDifference::NeedsLayoutTreeUpdate;
     if (needs_relayout)
         return StyleDifference::NeedsRelayout;
     if (needs_repaint)
@@ -227,20 +268,32 @@ void Element::recompute_style()
     if (!layout_node()) {
         if (new_specified_css_values->display().is_none())
             return;
-        // We need a new layout tree here!
-        Layout::TreeBuilder tree_builder;
-        tree_builder.build(*this);
+        // We need a new layout node here!
+        parent_or_shadow_host()->set_needs_layout_tree_update(true);
         return;
     }
 
     auto diff = StyleDifference::NeedsRelayout;
-    if (old_specified_css_values && layout_node())
-        diff = compute_style_difference(*old_specified_css_values, *new_specified_css_values, *layout_node());
+    if (old_specified_css_values)
+        diff = compute_style_difference(*old_specified_css_values, *new_specified_css_values);
     if (diff == StyleDifference::None)
         return;
+    if (diff == StyleDifference::NeedsLayoutTreeUpdate) {
+        parent_or_shadow_host()->set_needs_layout_tree_update(true);
+        return;
+    }
     layout_node()->apply_style(*new_specified_css_values);
     if (diff == StyleDifference::NeedsRelayout) {
-        document().set_needs_layout();
+        layout_node()->set_needs_layout();
+
+        // Anonymous wrappers inherit their style from us when they are created, so they have to be created again.
+        bool has_anonymous_children = false;
+        layout_node()->for_each_child([&](auto& child) {
+            if (child.is_anonymous())
+                has_anonymous_children = true;
+        });
+        if (has_anonymous_children)
+            set_needs_layout_tree_update(true);
         return;
     }
     if (diff == StyleDifference::NeedsRepaint) {
@@ -248,6 +301,13 @@ void Element::recompute_style()
     }
 }
 
+NonnullRefPtr<CSS::StyleProperties> Element::ensure_specified_css_values()
+{
+    if (!m_specified_css_values || needs_style_update())
+        m_specified_css_values = document().style_computer().compute_style(*this);
+    return *m_specified_css_values;
+}
+
 NonnullRefPtr<CSS::StyleProperties> Element::computed_style()
 {
     auto element_computed_style = CSS::ResolvedCSSStyleDeclaration::create(*this);
@@ -370,6 +430,9 @@ NonnullRefPtr<Geometry::DOMRect> Element::get_bounding_client_rect() const
 {
     // FIXME: Support inline layout nodes as well.
 
+    // NOTE: Ensure that layout is up-to-date before looking at metrics.
+    const_cast<DOM::Document&>(document()).ensure_layout();
+
     if (!layout_node() || !layout_node()->is_box())
         return Geometry::DOMRect::create(0, 0, 0, 0);
 
@@ -382,6 +445,9 @@ NonnullRefPtr<Geometry::DOMRect> Element::get_bounding_client_rect() const
 
 int Element::client_top() const
 {
+    // NOTE: Ensure that layout is up-to-date before looking at metrics.
+    const_cast<DOM::Document&>(document()).ensure_layout();
+
     if (!layout_node() || !layout_node()->is_box())
         return 0;
     auto& box = static_cast<Layout::Box const&>(*layout_node());
@@ -390,6 +456,9 @@ int Element::client_top() const
 
 int Element::client_left() const
 {
+    // NOTE: Ensure that layout is up-to-date before looking at metrics.
+    const_cast<DOM::Document&>(document()).ensure_layout();
+
     if (!layout_node() || !layout_node()->is_box())
         return 0;
     auto& box = static_cast<Layout::Box const&>(*layout_node());
@@ -398,6 +467,9 @@ int Element::client_left() const
 
 int Element::client_width() const
 {
+    // NOTE: Ensure that layout is up-to-date before looking at metrics.
+    const_cast<DOM::Document&>(document()).ensure_layout();
+
     if (!layout_node() || !layout_node()->is_box())
         return 0;
     auto& box = static_cast<Layout::Box const&>(*layout_node());
@@ -406,6 +478,9 @@ int Element::client_width() const
 
 int Element::client_height() const
 {
+    // NOTE: Ensure that layout is up-to-date before looking at metrics.
+    const_cast<DOM::Document&>(document()).ensure_layout();
+
     if (!layout_node() || !layout_node()->is_box())
         return 0;
     auto& box = static_cast<Layout::Box const&>(*layout_node());
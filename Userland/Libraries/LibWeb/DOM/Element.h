@@ -9,6 +9,7 @@
 #include <AK/FlyString.h>
 #include <AK/String.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
+#include <LibWeb/CSS/CustomProperties.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Attribute.h>
 #include <LibWeb/DOM/ChildNode.h>
@@ -90,6 +91,10 @@ public:
     String name() const { return attribute(HTML::AttributeNames::name); }
 
     const CSS::StyleProperties* specified_css_values() const { return m_specified_css_values.ptr(); }
+
+    // Returns the specified values, only computing them if they aren't up to date.
+    NonnullRefPtr<CSS::StyleProperties> ensure_specified_css_values();
+
     NonnullRefPtr<CSS::StyleProperties> computed_style();
 
     const CSS::CSSStyleDeclaration* inline_style() const { return m_inline_style; }
@@ -110,14 +115,9 @@ public:
     const ShadowRoot* shadow_root() const { return m_shadow_root; }
     void set_shadow_root(RefPtr<ShadowRoot>);
 
-    Optional<CSS::StyleComputer::CustomPropertyResolutionTuple> resolve_custom_property(const String& custom_property_name) const
-    {
-        return m_custom_properties.get(custom_property_name);
-    }
-    void add_custom_property(const String& custom_property_name, CSS::StyleComputer::CustomPropertyResolutionTuple style_property)
-    {
-        m_custom_properties.set(custom_property_name, style_property);
-    }
+    // Null until the element has been styled for the first time.
+    CSS::CustomProperties const* custom_properties() const { return m_custom_properties; }
+    void set_custom_properties(NonnullRefPtr<CSS::CustomProperties const> custom_properties) { m_custom_properties = move(custom_properties); }
 
     void queue_an_element_task(HTML::Task::Source, Function<void()>);
 
@@ -140,7 +140,7 @@ private:
     RefPtr<CSS::CSSStyleDeclaration> m_inline_style;
 
     RefPtr<CSS::StyleProperties> m_specified_css_values;
-    HashMap<String, CSS::StyleComputer::CustomPropertyResolutionTuple> m_custom_properties;
+    RefPtr<CSS::CustomProperties const> m_custom_properties;
 
     RefPtr<DOMTokenList> m_class_list;
     Vector<FlyString> m_classes;
@@ -308,6 +308,8 @@ void Node::insert_before(NonnullRefPtr<Node> node, RefPtr<Node> child, bool supp
         // FIXME: queue a tree mutation record for parent with nodes, « », previousSibling, and child.
     }
 
+    set_needs_layout_tree_update(true);
+
     children_changed();
 }
 
@@ -392,6 +394,8 @@ void Node::remove(bool suppress_observers)
         // FIXME: queue a tree mutation record for parent with « », « node », oldPreviousSibling, and oldNextSibling.
     }
 
+    parent->set_needs_layout_tree_update(true);
+
     parent->children_changed();
 }
 
@@ -587,6 +591,20 @@ void Node::set_needs_style_update(bool value)
     }
 }
 
+void Node::set_needs_layout_tree_update(bool value)
+{
+    if (m_needs_layout_tree_update == value)
+        return;
+    m_needs_layout_tree_update = value;
+
+    if (m_needs_layout_tree_update) {
+        // NOTE: Unlike style, the layout tree includes shadow trees, so we have to get from those to their host.
+        for (auto* ancestor = parent_or_shadow_host(); ancestor && !ancestor->m_child_needs_layout_tree_update; ancestor = ancestor->parent_or_shadow_host())
+            ancestor->m_child_needs_layout_tree_update = true;
+        document().schedule_layout_update();
+    }
+}
+
 void Node::inserted()
 {
     set_needs_style_update(true);
@@ -60,6 +60,7 @@ class StringStyleValue;
 class StyleComputer;
 class StyleProperties;
 class StyleSheet;
+class StyleSheetList;
 class StyleValue;
 class StyleValueList;
 class Supports;
@@ -214,6 +215,11 @@ namespace Web::NavigationTiming {
 class PerformanceTiming;
 }
 
+namespace Web::Painting {
+class DisplayList;
+class RecordingPainter;
+}
+
 namespace Web::RequestIdleCallback {
 class IdleDeadline;
 }
@@ -254,6 +260,7 @@ class Node;
 class NodeWithStyle;
 class RadioButton;
 class ReplacedBox;
+class StackingContext;
 class TextNode;
 }
 
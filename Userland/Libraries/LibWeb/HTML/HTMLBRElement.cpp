@@ -21,7 +21,7 @@ HTMLBRElement::~HTMLBRElement()
 
 RefPtr<Layout::Node> HTMLBRElement::create_layout_node()
 {
-    auto style = document().style_computer().compute_style(*this);
+    auto style = ensure_specified_css_values();
     if (style->display().is_none())
         return nullptr;
     return adopt_ref(*new Layout::BreakNode(document(), *this, move(style)));
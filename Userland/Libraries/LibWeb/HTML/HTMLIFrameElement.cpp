@@ -24,7 +24,7 @@ HTMLIFrameElement::~HTMLIFrameElement()
 
 RefPtr<Layout::Node> HTMLIFrameElement::create_layout_node()
 {
-    auto style = document().style_computer().compute_style(*this);
+    auto style = ensure_specified_css_values();
     return adopt_ref(*new Layout::FrameBox(document(), *this, move(style)));
 }
 
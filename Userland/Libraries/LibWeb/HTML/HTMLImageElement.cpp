@@ -22,6 +22,8 @@ HTMLImageElement::HTMLImageElement(DOM::Document& document, QualifiedName qualif
 {
     m_image_loader.on_load = [this] {
         set_needs_style_update(true);
+        if (layout_node())
+            layout_node()->set_needs_layout();
         queue_an_element_task(HTML::Task::Source::DOMManipulation, [this] {
             dispatch_event(DOM::Event::create(EventNames::load));
         });
@@ -30,6 +32,8 @@ HTMLImageElement::HTMLImageElement(DOM::Document& document, QualifiedName qualif
     m_image_loader.on_fail = [this] {
         dbgln("HTMLImageElement: Resource did fail: {}", src());
         set_needs_style_update(true);
+        if (layout_node())
+            layout_node()->set_needs_layout();
         queue_an_element_task(HTML::Task::Source::DOMManipulation, [this] {
             dispatch_event(DOM::Event::create(EventNames::error));
         });
@@ -70,7 +74,7 @@ void HTMLImageElement::parse_attribute(const FlyString& name, const String& valu
 
 RefPtr<Layout::Node> HTMLImageElement::create_layout_node()
 {
-    auto style = document().style_computer().compute_style(*this);
+    auto style = ensure_specified_css_values();
     if (style->display().is_none())
         return nullptr;
     return adopt_ref(*new Layout::ImageBox(document(), *this, move(style), m_image_loader));
@@ -46,7 +46,7 @@ RefPtr<Layout::Node> HTMLInputElement::create_layout_node()
     if (type() == "hidden")
         return nullptr;
 
-    auto style = document().style_computer().compute_style(*this);
+    auto style = ensure_specified_css_values();
     if (style->display().is_none())
         return nullptr;
 
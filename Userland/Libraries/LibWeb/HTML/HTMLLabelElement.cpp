@@ -21,7 +21,7 @@ HTMLLabelElement::~HTMLLabelElement()
 
 RefPtr<Layout::Node> HTMLLabelElement::create_layout_node()
 {
-    auto style = document().style_computer().compute_style(*this);
+    auto style = ensure_specified_css_values();
     if (style->display().is_none())
         return nullptr;
 
@@ -21,11 +21,16 @@ HTMLObjectElement::HTMLObjectElement(DOM::Document& document, QualifiedName qual
     m_image_loader.on_load = [this] {
         m_should_show_fallback_content = false;
         set_needs_style_update(true);
+        // Whether we show the image or the fallback content decides what kind of layout node we get.
+        if (auto* parent = parent_or_shadow_host())
+            parent->set_needs_layout_tree_update(true);
     };
 
     m_image_loader.on_fail = [this] {
         m_should_show_fallback_content = true;
         set_needs_style_update(true);
+        if (auto* parent = parent_or_shadow_host())
+            parent->set_needs_layout_tree_update(true);
     };
 }
 
@@ -46,7 +51,7 @@ RefPtr<Layout::Node> HTMLObjectElement::create_layout_node()
     if (m_should_show_fallback_content)
         return HTMLElement::create_layout_node();
 
-    auto style = document().style_computer().compute_style(*this);
+    auto style = ensure_specified_css_values();
     if (style->display().is_none())
         return nullptr;
     if (m_image_loader.has_image())
@@ -113,6 +113,28 @@ static bool is_javascript_mime_type_essence_match(const String& string)
     return lowercase_string.is_one_of("application/ecmascript", "application/javascript", "application/x-ecmascript", "application/x-javascript", "text/ecmascript", "text/javascript", "text/javascript1.0", "text/javascript1.1", "text/javascript1.2", "text/javascript1.3", "text/javascript1.4", "text/javascript1.5", "text/jscript", "text/livescript", "text/x-ecmascript", "text/x-javascript");
 }
 
+void HTMLScriptElement::external_script_did_load(Resource const& resource)
+{
+    if (!resource.has_encoded_data()) {
+        dbgln("HTMLScriptElement: Failed to load {}", resource.url());
+        return;
+    }
+
+    // FIXME: This is all ad-hoc and needs work.
+    auto script = ClassicScript::create(resource.url().to_string(), StringView { resource.encoded_data() }, document().realm(), AK::URL());
+
+    // When the chosen algorithm asynchronously completes, set the script's script to the result. At that time, the script is ready.
+    m_script = script;
+    script_became_ready();
+}
+
+void HTMLScriptElement::external_script_did_fail(Resource const&)
+{
+    m_failed_to_load = true;
+    dbgln("HONK! Failed to load script, but ready nonetheless.");
+    script_became_ready();
+}
+
 // https://html.spec.whatwg.org/multipage/scripting.html#prepare-a-script
 void HTMLScriptElement::prepare_script()
 {
@@ -292,26 +314,12 @@ void HTMLScriptElement::prepare_script()
             //    Fetch a classic script given url, settings object, options, classic script CORS setting, and encoding.
             auto request = LoadRequest::create_for_url_on_page(url, document().page());
 
-            ResourceLoader::the().load(
-                request,
-                [this, url](auto data, auto&, auto) {
-                    if (data.is_null()) {
-                        dbgln("HTMLScriptElement: Failed to load {}", url);
-                        return;
-                    }
-
-                    // FIXME: This is all ad-hoc and needs work.
-                    auto script = ClassicScript::create(url.to_string(), data, document().realm(), AK::URL());
-
-                    // When the chosen algorithm asynchronously completes, set the script's script to the result. At that time, the script is ready.
-                    m_script = script;
-                    script_became_ready();
-                },
-                [this](auto&, auto) {
-                    m_failed_to_load = true;
-                    dbgln("HONK! Failed to load script, but ready nonetheless.");
-                    script_became_ready();
-                });
+            auto resource = ResourceLoader::the().load_resource(Resource::Type::Generic, request);
+            if (!resource) {
+                dbgln("HTMLScriptElement: Failed to load {}", url);
+                return;
+            }
+            m_external_script_client = make<ExternalScriptClient>(*this, *resource);
         } else if (m_script_type == ScriptType::Module) {
             // FIXME: -> "module"
             //        Fetch an external module script graph given url, settings object, and options.
@@ -10,6 +10,7 @@
 #include <LibWeb/DOM/DocumentLoadEventDelayer.h>
 #include <LibWeb/HTML/HTMLElement.h>
 #include <LibWeb/HTML/Scripting/Script.h>
+#include <LibWeb/Loader/Resource.h>
 
 namespace Web::HTML {
 
@@ -45,6 +46,25 @@ private:
     void script_became_ready();
     void when_the_script_is_ready(Function<void()>);
 
+    void external_script_did_load(Resource const&);
+    void external_script_did_fail(Resource const&);
+
+    // Goes through the ResourceLoader's cache, so a fetch started by the speculative HTML parser is picked up here.
+    class ExternalScriptClient final : public ResourceClient {
+    public:
+        ExternalScriptClient(HTMLScriptElement& element, Resource& resource)
+            : m_element(element)
+        {
+            set_resource(&resource);
+        }
+
+    private:
+        virtual void resource_did_load() override { m_element.external_script_did_load(*resource()); }
+        virtual void resource_did_fail() override { m_element.external_script_did_fail(*resource()); }
+
+        HTMLScriptElement& m_element;
+    };
+
     WeakPtr<DOM::Document> m_parser_document;
     WeakPtr<DOM::Document> m_preparation_time_document;
     bool m_non_blocking { false };
@@ -65,6 +85,8 @@ private:
 
     RefPtr<Script> m_script;
 
+    OwnPtr<ExternalScriptClient> m_external_script_client;
+
     Optional<DOM::DocumentLoadEventDelayer> m_document_load_event_delayer;
 };
 
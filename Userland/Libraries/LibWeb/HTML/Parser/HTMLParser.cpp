@@ -27,6 +27,7 @@
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/SVG/TagNames.h>
 
@@ -189,12 +190,28 @@ void HTMLParser::run(const AK::URL& url)
     the_end();
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::run_speculative_parser_if_needed()
+{
+    // NOTE: We always have the whole input up front, so a single pass over everything after the blocking script
+    //       finds every resource the speculative parser could ever find. Once the resources are in the
+    //       ResourceLoader's cache, the elements that tree construction creates later simply pick them up.
+    if (m_has_run_speculative_parser || m_parsing_fragment || m_invoked_via_document_write)
+        return;
+    m_has_run_speculative_parser = true;
+
+    SpeculativeHTMLParser speculative_parser(*m_document, m_tokenizer.unconsumed_input());
+    speculative_parser.run();
+    dbgln_if(PARSER_DEBUG, "Speculative HTML parser started {} fetch(es)", speculative_parser.fetch_count());
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-end
 void HTMLParser::the_end()
 {
     // Once the user agent stops parsing the document, the user agent must run the following steps:
 
-    // FIXME: 1. If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
+    // 1. If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
+    // NOTE: Our speculative HTML parser runs to completion before the parser continues, so there is never an active one here.
 
     // FIXME: 2. Set the insertion point to undefined.
 
@@ -2020,6 +2037,7 @@ void HTMLParser::handle_text(HTMLToken& token)
                 // that is blocking scripts and the script's "ready to be parser-executed"
                 // flag is set.
                 if (m_document->has_a_style_sheet_that_is_blocking_scripts() || !script->is_ready_to_be_parser_executed()) {
+                    run_speculative_parser_if_needed();
                     main_thread_event_loop().spin_until([&] {
                         return !m_document->has_a_style_sheet_that_is_blocking_scripts() && script->is_ready_to_be_parser_executed();
                     });
@@ -128,6 +128,7 @@ private:
     void decrement_script_nesting_level();
     size_t script_nesting_level() const { return m_script_nesting_level; }
     void reset_the_insertion_mode_appropriately();
+    void run_speculative_parser_if_needed();
 
     void adjust_mathml_attributes(HTMLToken&);
     void adjust_svg_tag_names(HTMLToken&);
@@ -162,6 +163,7 @@ private:
     bool m_aborted { false };
     bool m_parser_pause_flag { false };
     bool m_stop_parsing { false };
+    bool m_has_run_speculative_parser { false };
     size_t m_script_nesting_level { 0 };
 
     NonnullRefPtr<DOM::Document> m_document;
@@ -6,6 +6,7 @@
 
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
+#include <AK/SIMD.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -215,6 +216,60 @@ Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
     return *it;
 }
 
+// Returns the offset of the first '&', '<' or NUL byte at or after the given offset, or the size of the input if there is none.
+// These are the only characters that make the data state do anything other than emit the character, and UTF-8
+// continuation bytes never look like them, so this can look at the input 16 bytes at a time.
+static size_t find_end_of_character_run_in_data_state(ReadonlyBytes input, size_t offset)
+{
+    using AK::SIMD::u8x16;
+
+    for (; offset + sizeof(u8x16) <= input.size(); offset += sizeof(u8x16)) {
+        u8x16 chunk;
+        __builtin_memcpy(&chunk, input.offset_pointer(offset), sizeof(chunk));
+        auto matches = (chunk == '&') | (chunk == '<') | (chunk == 0);
+        u64 match_words[2];
+        __builtin_memcpy(match_words, &matches, sizeof(match_words));
+        if (match_words[0] | match_words[1])
+            break;
+    }
+
+    while (offset < input.size() && input[offset] != '&' && input[offset] != '<' && input[offset] != 0)
+        ++offset;
+    return offset;
+}
+
+void HTMLTokenizer::enqueue_character_run_in_data_state()
+{
+    // Don't let a huge text node turn into a huge queue of tokens.
+    static constexpr size_t max_run_length = 4096;
+
+    auto input = ReadonlyBytes { m_utf8_view.bytes(), m_utf8_view.byte_length() };
+    auto start = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto end = find_end_of_character_run_in_data_state(input.slice(0, min(input.size(), start + max_run_length)), start);
+    // The run may only have been cut short in the middle of a code point by the length limit.
+    while (end > start && end < input.size() && (input[end] & 0xc0) == 0x80)
+        --end;
+    if (end == start)
+        return;
+
+    // NOTE: Like the tokens emitted one at a time, each character token starts at the position after its code point.
+    auto position = m_source_positions.last();
+    for (auto code_point : m_utf8_view.substring_view(start, end - start)) {
+        if (code_point == '\n') {
+            position.column = 0;
+            position.line++;
+        } else {
+            position.column++;
+        }
+        auto token = HTMLToken::make_character(code_point);
+        token.set_start_position({}, position);
+        m_queued_tokens.enqueue(move(token));
+    }
+
+    m_source_positions.append(position);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset(end);
+}
+
 HTMLToken::Position HTMLTokenizer::nth_last_position(size_t n)
 {
     if (n + 1 > m_source_positions.size()) {
@@ -260,7 +315,13 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    // NOTE: Instead of going through the state machine for every code point, emit the whole run
+                    //       of characters up to the next '&', '<' or NUL at once.
+                    create_new_token(HTMLToken::Type::Character);
+                    m_current_token.set_code_point(current_input_character.value());
+                    m_queued_tokens.enqueue(move(m_current_token));
+                    enqueue_character_run_in_data_state();
+                    return m_queued_tokens.dequeue();
                 }
             }
             END_STATE
@@ -121,6 +121,9 @@ public:
 
     String source() const { return m_decoded_input; }
 
+    // The part of the input that hasn't been consumed yet.
+    StringView unconsumed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
+
 private:
     void skip(size_t count);
     Optional<u32> next_code_point();
@@ -148,6 +151,8 @@ private:
 
     bool consumed_as_part_of_an_attribute() const;
 
+    void enqueue_character_run_in_data_state();
+
     void restore_to(Utf8CodePointIterator const& new_iterator);
     HTMLToken::Position nth_last_position(size_t n = 0);
 
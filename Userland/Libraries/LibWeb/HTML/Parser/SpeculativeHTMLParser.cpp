@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+
+namespace Web::HTML {
+
+SpeculativeHTMLParser::SpeculativeHTMLParser(DOM::Document& document, StringView const& input)
+    : m_document(document)
+    , m_tokenizer(input, "utf-8")
+{
+}
+
+void SpeculativeHTMLParser::run()
+{
+    for (;;) {
+        auto token = m_tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (token->is_start_tag())
+            process_start_tag(*token);
+    }
+}
+
+static bool is_speculatively_fetchable_script_type(StringView const& type)
+{
+    // NOTE: This errs on the side of fetching. A script that turns out not to run only costs us a wasted fetch.
+    if (type.is_empty())
+        return true;
+    return type.contains("javascript"sv, CaseSensitivity::CaseInsensitive) || type.contains("ecmascript"sv, CaseSensitivity::CaseInsensitive);
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+void SpeculativeHTMLParser::process_start_tag(HTMLToken& token)
+{
+    auto& tag_name = token.tag_name();
+
+    if (tag_name == TagNames::script) {
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.is_null() && !token.has_attribute(AttributeNames::nomodule) && is_speculatively_fetchable_script_type(token.attribute(AttributeNames::type).trim_whitespace()))
+            speculatively_fetch(src, Resource::Type::Generic);
+        m_tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+        return;
+    }
+
+    if (tag_name == TagNames::link) {
+        auto rel = token.attribute(AttributeNames::rel);
+        if (rel.is_null())
+            return;
+        bool is_stylesheet = false;
+        bool is_alternate = false;
+        for (auto& keyword : rel.split_view(' ')) {
+            if (keyword.equals_ignoring_case("stylesheet"sv))
+                is_stylesheet = true;
+            else if (keyword.equals_ignoring_case("alternate"sv))
+                is_alternate = true;
+        }
+        auto href = token.attribute(AttributeNames::href);
+        if (is_stylesheet && !is_alternate && !href.is_null())
+            speculatively_fetch(href, Resource::Type::Generic);
+        return;
+    }
+
+    if (tag_name == TagNames::img) {
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.is_null())
+            speculatively_fetch(src, Resource::Type::Image);
+        return;
+    }
+
+    // The tokenizer can't tell where raw text ends on its own, so we mirror the state switches that tree construction would make.
+    if (tag_name.is_one_of(TagNames::title, TagNames::textarea)) {
+        m_tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        return;
+    }
+
+    if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes)) {
+        m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        return;
+    }
+
+    if (tag_name == TagNames::noscript) {
+        if (m_document->is_scripting_enabled())
+            m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        return;
+    }
+
+    if (tag_name == TagNames::plaintext) {
+        m_tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+        return;
+    }
+}
+
+void SpeculativeHTMLParser::speculatively_fetch(StringView const& url_string, Resource::Type type)
+{
+    // NOTE: Document::parse_url() is also what the elements use once they are inserted,
+    //       so the speculative fetches end up under the same key in the resource cache.
+    auto url = m_document->parse_url(url_string);
+    if (!url.is_valid())
+        return;
+
+    auto request = LoadRequest::create_for_url_on_page(url, m_document->page());
+    if (!ResourceLoader::the().load_resource(type, request))
+        return;
+
+    dbgln_if(PARSER_DEBUG, "SpeculativeHTMLParser: Speculatively fetching {}", url);
+    ++m_fetch_count;
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/StringView.h>
+#include <AK/URL.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/Loader/Resource.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// Tokenizes the part of the input that the HTML parser hasn't reached yet, while the parser is blocked on a script,
+// and starts fetching the scripts, style sheets and images it finds. The fetches go through the ResourceLoader's cache,
+// so the elements that the parser creates later pick up the resources that are already in flight.
+// Nothing the speculative parser does is observable by the document.
+class SpeculativeHTMLParser {
+public:
+    SpeculativeHTMLParser(DOM::Document&, StringView const& input);
+
+    void run();
+
+    size_t fetch_count() const { return m_fetch_count; }
+
+private:
+    void process_start_tag(HTMLToken&);
+    void speculatively_fetch(StringView const& url, Resource::Type);
+
+    NonnullRefPtr<DOM::Document> m_document;
+    HTMLTokenizer m_tokenizer;
+    size_t m_fetch_count { 0 };
+};
+
+}
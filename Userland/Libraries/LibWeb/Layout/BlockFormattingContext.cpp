@@ -537,24 +537,7 @@ void BlockFormattingContext::layout_initial_containing_block(LayoutMode layout_m
     VERIFY(!icb.children_are_inline());
     layout_block_level_children(root(), layout_mode);
 
-    // Compute scrollable overflow.
-    float bottom_edge = 0;
-    float right_edge = 0;
-    icb.for_each_in_subtree_of_type<Box>([&](Box& child) {
-        auto child_rect = child.bordered_rect();
-        bottom_edge = max(bottom_edge, child_rect.bottom());
-        right_edge = max(right_edge, child_rect.right());
-        return IterationDecision::Continue;
-    });
-
-    if (bottom_edge >= viewport_rect.height() || right_edge >= viewport_rect.width()) {
-        auto& overflow_data = icb.ensure_overflow_data();
-        overflow_data.scrollable_overflow_rect = viewport_rect.to_type<float>();
-        // NOTE: The edges are *within* the rectangle, so we add 1 to get the width and height.
-        overflow_data.scrollable_overflow_rect.set_size(right_edge + 1, bottom_edge + 1);
-    } else {
-        icb.clear_overflow_data();
-    }
+    icb.recompute_scrollable_overflow();
 }
 
 static Gfx::FloatRect rect_in_coordinate_space(const Box& box, const Box& context_box)
@@ -170,6 +170,7 @@ HitTestResult Box::hit_test(const Gfx::IntPoint& position, HitTestType type) con
 void Box::set_needs_display()
 {
     if (!is_inline()) {
+        invalidate_enclosing_display_list();
         browsing_context().set_needs_display(enclosing_int_rect(absolute_rect()));
         return;
     }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/Layout/Node.h>
@@ -126,6 +127,7 @@ public:
     StackingContext* stacking_context() { return m_stacking_context; }
     const StackingContext* stacking_context() const { return m_stacking_context; }
     void set_stacking_context(NonnullOwnPtr<StackingContext> context) { m_stacking_context = move(context); }
+    void clear_stacking_context() { m_stacking_context = nullptr; }
     StackingContext* enclosing_stacking_context();
 
     virtual void paint(PaintContext&, PaintPhase) override;
@@ -143,6 +145,16 @@ public:
     bool has_intrinsic_height() const { return intrinsic_height().has_value(); }
     bool has_intrinsic_aspect_ratio() const { return intrinsic_aspect_ratio().has_value(); }
 
+    // The preferred and preferred minimum widths of the box's content, as used for shrink-to-fit.
+    // These are kept until the box or one of its descendants needs layout.
+    struct IntrinsicWidths {
+        float preferred_width { 0 };
+        float preferred_minimum_width { 0 };
+    };
+    Optional<IntrinsicWidths> const& cached_intrinsic_widths() const { return m_cached_intrinsic_widths; }
+    void set_cached_intrinsic_widths(IntrinsicWidths widths) { m_cached_intrinsic_widths = widths; }
+    void clear_cached_intrinsic_widths() { m_cached_intrinsic_widths.clear(); }
+
     bool has_overflow() const { return m_overflow_data; }
 
     Optional<Gfx::FloatRect> scrollable_overflow_rect() const
@@ -189,6 +201,8 @@ private:
     OwnPtr<StackingContext> m_stacking_context;
 
     OwnPtr<OverflowData> m_overflow_data;
+
+    Optional<IntrinsicWidths> m_cached_intrinsic_widths;
 };
 
 template<>
@@ -42,7 +42,10 @@ void ButtonBox::paint(PaintContext& context, PaintPhase phase)
         if (!hovered)
             hovered = Label::is_associated_label_hovered(*this);
 
-        Gfx::StylePainter::paint_button(context.painter(), enclosing_int_rect(absolute_rect()), context.palette(), Gfx::ButtonStyle::Normal, m_being_pressed, hovered, dom_node().checked(), dom_node().enabled());
+        auto rect = enclosing_int_rect(absolute_rect());
+        context.painter().paint_with_painter(rect, [rect, being_pressed = m_being_pressed, hovered, checked = dom_node().checked(), enabled = dom_node().enabled()](Gfx::Painter& painter, PaintContext& context) {
+            Gfx::StylePainter::paint_button(painter, rect, context.palette(), Gfx::ButtonStyle::Normal, being_pressed, hovered, checked, enabled);
+        });
 
         auto text_rect = enclosing_int_rect(absolute_rect());
         if (m_being_pressed)
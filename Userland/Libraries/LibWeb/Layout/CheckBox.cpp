@@ -33,7 +33,10 @@ void CheckBox::paint(PaintContext& context, PaintPhase phase)
     LabelableNode::paint(context, phase);
 
     if (phase == PaintPhase::Foreground) {
-        Gfx::StylePainter::paint_check_box(context.painter(), enclosing_int_rect(absolute_rect()), context.palette(), dom_node().enabled(), dom_node().checked(), m_being_pressed);
+        auto rect = enclosing_int_rect(absolute_rect());
+        context.painter().paint_with_painter(rect, [rect, enabled = dom_node().enabled(), checked = dom_node().checked(), being_pressed = m_being_pressed](Gfx::Painter& painter, PaintContext& context) {
+            Gfx::StylePainter::paint_check_box(painter, rect, context.palette(), enabled, checked, being_pressed);
+        });
     }
 }
 
@@ -135,6 +135,10 @@ static float greatest_child_width(Box const& box)
 
 FormattingContext::ShrinkToFitResult FormattingContext::calculate_shrink_to_fit_widths(Box& box)
 {
+    // Both widths take a throwaway layout of the box's contents, so we hang on to them until something inside the box changes.
+    if (auto const& cached_widths = box.cached_intrinsic_widths(); cached_widths.has_value())
+        return { cached_widths->preferred_width, cached_widths->preferred_minimum_width };
+
     // Calculate the preferred width by formatting the content without breaking lines
     // other than where explicit line breaks occur.
     layout_inside(box, LayoutMode::OnlyRequiredLineBreaks);
@@ -146,6 +150,7 @@ FormattingContext::ShrinkToFitResult FormattingContext::calculate_shrink_to_fit_
     layout_inside(box, LayoutMode::AllPossibleLineBreaks);
     float preferred_minimum_width = greatest_child_width(box);
 
+    box.set_cached_intrinsic_widths({ preferred_width, preferred_minimum_width });
     return { preferred_width, preferred_minimum_width };
 }
 
@@ -36,30 +36,33 @@ void FrameBox::paint(PaintContext& context, PaintPhase phase)
     ReplacedBox::paint(context, phase);
 
     if (phase == PaintPhase::Foreground) {
-        auto* hosted_document = dom_node().content_document();
-        if (!hosted_document)
-            return;
-        auto* hosted_layout_tree = hosted_document->layout_node();
-        if (!hosted_layout_tree)
-            return;
-
-        context.painter().save();
-        auto old_viewport_rect = context.viewport_rect();
-
-        context.painter().add_clip_rect(enclosing_int_rect(absolute_rect()));
-        context.painter().translate(absolute_x(), absolute_y());
-
-        context.set_viewport_rect({ {}, dom_node().nested_browsing_context()->size() });
-        const_cast<Layout::InitialContainingBlock*>(hosted_layout_tree)->paint_all_phases(context);
-
-        context.set_viewport_rect(old_viewport_rect);
-        context.painter().restore();
+        // NOTE: The hosted document keeps display lists of its own, so it is looked up and painted on every replay.
+        auto rect = enclosing_int_rect(absolute_rect());
+        context.painter().paint_with_painter(rect, [element = NonnullRefPtr(dom_node()), rect, position = absolute_position().to_type<int>()](Gfx::Painter& painter, PaintContext& context) {
+            auto* hosted_document = element->content_document();
+            if (!hosted_document)
+                return;
+            auto* hosted_layout_tree = hosted_document->layout_node();
+            if (!hosted_layout_tree)
+                return;
+
+            {
+                Gfx::PainterStateSaver saver(painter);
+                painter.add_clip_rect(rect);
+                painter.translate(position);
+
+                PaintContext hosted_context(painter, context.palette(), {});
+                hosted_context.set_should_show_line_box_borders(context.should_show_line_box_borders());
+                hosted_context.set_has_focus(context.has_focus());
+                hosted_context.set_viewport_rect({ {}, element->nested_browsing_context()->size() });
+                const_cast<Layout::InitialContainingBlock*>(hosted_layout_tree)->paint_all_phases(hosted_context);
+            }
 
-        if constexpr (HIGHLIGHT_FOCUSED_FRAME_DEBUG) {
-            if (dom_node().nested_browsing_context()->is_focused_context()) {
-                context.painter().draw_rect(absolute_rect().to_type<int>(), Color::Cyan);
+            if constexpr (HIGHLIGHT_FOCUSED_FRAME_DEBUG) {
+                if (element->nested_browsing_context()->is_focused_context())
+                    painter.draw_rect(rect, Color::Cyan);
             }
-        }
+        });
     }
 }
 
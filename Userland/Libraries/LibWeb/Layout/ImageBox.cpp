@@ -85,7 +85,10 @@ void ImageBox::paint(PaintContext& context, PaintPhase phase)
         if (renders_as_alt_text()) {
             auto& image_element = verify_cast<HTML::HTMLImageElement>(dom_node());
             context.painter().set_font(Gfx::FontDatabase::default_font());
-            Gfx::StylePainter::paint_frame(context.painter(), enclosing_int_rect(absolute_rect()), context.palette(), Gfx::FrameShape::Container, Gfx::FrameShadow::Sunken, 2);
+            auto rect = enclosing_int_rect(absolute_rect());
+            context.painter().paint_with_painter(rect, [rect](Gfx::Painter& painter, PaintContext& context) {
+                Gfx::StylePainter::paint_frame(painter, rect, context.palette(), Gfx::FrameShape::Container, Gfx::FrameShadow::Sunken, 2);
+            });
             auto alt = image_element.alt();
             if (alt.is_empty())
                 alt = image_element.src();
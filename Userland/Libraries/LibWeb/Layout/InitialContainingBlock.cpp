@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashTable.h>
 #include <LibGfx/Painter.h>
 #include <LibWeb/Dump.h>
+#include <LibWeb/Layout/FormattingContext.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
+#include <LibWeb/Layout/ListItemBox.h>
 #include <LibWeb/Page/BrowsingContext.h>
 #include <LibWeb/Painting/StackingContext.h>
 
@@ -42,11 +45,123 @@ void InitialContainingBlock::build_stacking_context_tree()
     });
 }
 
+void InitialContainingBlock::invalidate_stacking_context_tree()
+{
+    for_each_in_inclusive_subtree_of_type<Box>([&](Box& box) {
+        box.clear_stacking_context();
+        return IterationDecision::Continue;
+    });
+}
+
+void InitialContainingBlock::recompute_scrollable_overflow()
+{
+    auto viewport_rect = browsing_context().viewport_rect();
+
+    float bottom_edge = 0;
+    float right_edge = 0;
+    for_each_in_subtree_of_type<Box>([&](Box& child) {
+        auto child_rect = child.bordered_rect();
+        bottom_edge = max(bottom_edge, child_rect.bottom());
+        right_edge = max(right_edge, child_rect.right());
+        return IterationDecision::Continue;
+    });
+
+    if (bottom_edge >= viewport_rect.height() || right_edge >= viewport_rect.width()) {
+        auto& overflow_data = ensure_overflow_data();
+        overflow_data.scrollable_overflow_rect = viewport_rect.to_type<float>();
+        // NOTE: The edges are *within* the rectangle, so we add 1 to get the width and height.
+        overflow_data.scrollable_overflow_rect.set_size(right_edge + 1, bottom_edge + 1);
+    } else {
+        clear_overflow_data();
+    }
+}
+
+// A box can be laid out on its own if doing so can't change the size or position of anything outside of it:
+// it has to establish an independent block formatting context, and its size must not depend on its contents.
+static bool can_be_layout_root(Box const& box)
+{
+    if (box.is_inline() || box.is_flex_item() || !is<BlockContainer>(box) || is<ListItemBox>(box))
+        return false;
+
+    auto display = box.computed_values().display();
+    if (display.is_internal() || display.is_flex_inside() || display.is_table_inside())
+        return false;
+
+    if (!FormattingContext::creates_block_formatting_context(box))
+        return false;
+
+    auto is_fixed = [](CSS::Length const& length) {
+        return !length.is_undefined_or_auto() && !length.is_percentage();
+    };
+    return is_fixed(box.computed_values().width()) && is_fixed(box.computed_values().height());
+}
+
+static Box* nearest_layout_root(Node& node)
+{
+    for (auto* ancestor = node.parent(); ancestor && !is<InitialContainingBlock>(*ancestor); ancestor = ancestor->parent()) {
+        if (is<Box>(*ancestor) && can_be_layout_root(verify_cast<Box>(*ancestor)))
+            return verify_cast<Box>(ancestor);
+    }
+    return nullptr;
+}
+
+static bool collect_layout_roots_in_subtree(Node& node, HashTable<Box*>& layout_roots)
+{
+    bool found_all = true;
+    node.for_each_child([&](Node& child) {
+        if (!found_all)
+            return;
+        if (child.needs_layout()) {
+            auto* layout_root = nearest_layout_root(child);
+            if (!layout_root)
+                found_all = false;
+            else
+                layout_roots.set(layout_root);
+        } else if (child.child_needs_layout()) {
+            found_all = collect_layout_roots_in_subtree(child, layout_roots);
+        }
+    });
+    return found_all;
+}
+
+Optional<Vector<Box*>> InitialContainingBlock::collect_layout_roots()
+{
+    if (needs_layout())
+        return {};
+
+    HashTable<Box*> layout_roots;
+    if (!collect_layout_roots_in_subtree(*this, layout_roots))
+        return {};
+
+    // A root inside of another one will be laid out along with it.
+    Vector<Box*> outermost_layout_roots;
+    for (auto* layout_root : layout_roots) {
+        bool is_inside_other_root = false;
+        for (auto* ancestor = layout_root->parent(); ancestor && !is_inside_other_root; ancestor = ancestor->parent()) {
+            if (is<Box>(*ancestor) && layout_roots.contains(verify_cast<Box>(ancestor)))
+                is_inside_other_root = true;
+        }
+        if (!is_inside_other_root)
+            outermost_layout_roots.append(layout_root);
+    }
+    return outermost_layout_roots;
+}
+
 void InitialContainingBlock::paint_all_phases(PaintContext& context)
 {
-    context.painter().fill_rect(enclosing_int_rect(absolute_rect()), context.palette().base());
-    context.painter().translate(-context.viewport_rect().location());
-    stacking_context()->paint(context);
+    auto& painter = context.target_painter();
+    painter.fill_rect(enclosing_int_rect(absolute_rect()), context.palette().base());
+    painter.translate(-context.viewport_rect().location());
+
+    // Display lists are recorded for the whole canvas instead of the visible part of it,
+    // so that scrolling only has to replay them.
+    auto viewport_rect = context.viewport_rect();
+    auto canvas_rect = enclosing_int_rect(absolute_rect());
+    if (auto overflow_rect = scrollable_overflow_rect(); overflow_rect.has_value())
+        canvas_rect.set_size(max(canvas_rect.width(), (int)overflow_rect->width()), max(canvas_rect.height(), (int)overflow_rect->height()));
+    context.set_viewport_rect(canvas_rect);
+    stacking_context()->paint(painter, context);
+    context.set_viewport_rect(viewport_rect);
 }
 
 HitTestResult InitialContainingBlock::hit_test(const Gfx::IntPoint& position, HitTestType type) const
@@ -60,6 +175,12 @@ void InitialContainingBlock::recompute_selection_states()
 
     auto selection = this->selection().normalized();
 
+    // The offsets may have moved within the nodes at either end of the old and the new selection,
+    // so their highlight has to be recorded again even if their state stays the same.
+    auto is_at_selection_boundary = [](SelectionState state) {
+        return state == SelectionState::Start || state == SelectionState::End || state == SelectionState::StartAndEnd;
+    };
+
     for_each_in_inclusive_subtree([&](auto& layout_node) {
         if (!selection.is_valid()) {
             // Everything gets SelectionState::None.
@@ -75,6 +196,10 @@ void InitialContainingBlock::recompute_selection_states()
             else if (state == SelectionState::End || state == SelectionState::StartAndEnd)
                 state = SelectionState::None;
         }
+        // Selection highlights are part of the recorded display lists.
+        auto old_state = layout_node.selection_state();
+        if (old_state != state || is_at_selection_boundary(old_state) || is_at_selection_boundary(state))
+            layout_node.invalidate_enclosing_display_list();
         layout_node.set_selection_state(state);
         return IterationDecision::Continue;
     });
@@ -27,6 +27,13 @@ public:
     void set_selection_end(const LayoutPosition&);
 
     void build_stacking_context_tree();
+    void invalidate_stacking_context_tree();
+
+    void recompute_scrollable_overflow();
+
+    // Returns the roots of the smallest subtrees that contain every node needing layout and can be laid out on their own,
+    // or nothing if the whole tree has to be laid out.
+    Optional<Vector<Box*>> collect_layout_roots();
 
     void recompute_selection_states();
 
@@ -26,11 +26,12 @@ public:
     void handle_mouseup_on_label(Badge<TextNode>, const Gfx::IntPoint&, unsigned button);
     void handle_mousemove_on_label(Badge<TextNode>, const Gfx::IntPoint&, unsigned button);
 
+    LabelableNode* control_node();
+
 private:
     virtual bool is_label() const override { return true; }
 
     static Label* label_for_control_node(LabelableNode&);
-    LabelableNode* control_node();
 
     bool m_tracking_mouse { false };
 };
@@ -16,6 +16,7 @@
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Layout/TextNode.h>
 #include <LibWeb/Page/BrowsingContext.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <typeinfo>
 
 namespace Web::Layout {
@@ -122,8 +123,23 @@ void Node::split_into_lines(InlineFormattingContext& context, LayoutMode layout_
     });
 }
 
+void Node::invalidate_enclosing_display_list()
+{
+    // Whatever this node paints is recorded into the display list of the nearest stacking context around it.
+    for (auto* ancestor = this; ancestor; ancestor = ancestor->parent()) {
+        if (!is<Box>(*ancestor))
+            continue;
+        if (auto* stacking_context = verify_cast<Box>(*ancestor).stacking_context()) {
+            stacking_context->invalidate_display_list();
+            return;
+        }
+    }
+}
+
 void Node::set_needs_display()
 {
+    invalidate_enclosing_display_list();
+
     if (auto* block = containing_block()) {
         block->for_each_fragment([&](auto& fragment) {
             if (&fragment.layout_node() == this || is_ancestor_of(fragment.layout_node())) {
@@ -134,6 +150,33 @@ void Node::set_needs_display()
     }
 }
 
+void Node::set_needs_layout()
+{
+    m_needs_layout = true;
+    if (is<Box>(*this))
+        verify_cast<Box>(*this).clear_cached_intrinsic_widths();
+
+    for (auto* ancestor = parent(); ancestor && !ancestor->m_child_needs_layout; ancestor = ancestor->parent()) {
+        ancestor->m_child_needs_layout = true;
+        // The intrinsic widths of an ancestor depend on the size of this node.
+        if (is<Box>(*ancestor))
+            verify_cast<Box>(*ancestor).clear_cached_intrinsic_widths();
+    }
+
+    document().schedule_layout_update();
+}
+
+void Node::clear_needs_layout()
+{
+    if (!m_needs_layout && !m_child_needs_layout)
+        return;
+    m_needs_layout = false;
+    m_child_needs_layout = false;
+    for_each_child([](auto& child) {
+        child.clear_needs_layout();
+    });
+}
+
 Gfx::FloatPoint Node::box_type_agnostic_position() const
 {
     if (is<Box>(*this))
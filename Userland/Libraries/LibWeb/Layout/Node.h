@@ -141,6 +141,16 @@ public:
 
     virtual void set_needs_display();
 
+    // Makes the nearest stacking context around this node record what it paints again.
+    void invalidate_enclosing_display_list();
+
+    // A node that needs layout has to be laid out again along with its whole subtree.
+    // Its ancestors are marked as having a child that needs layout, so the dirty parts of the tree can be found from the root.
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void set_needs_layout();
+    void clear_needs_layout();
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -189,6 +199,8 @@ private:
     bool m_has_style { false };
     bool m_visible { true };
     bool m_children_are_inline { false };
+    bool m_needs_layout { true };
+    bool m_child_needs_layout { false };
     SelectionState m_selection_state { SelectionState::None };
 
     bool m_is_flex_item { false };
@@ -33,7 +33,10 @@ void RadioButton::paint(PaintContext& context, PaintPhase phase)
     LabelableNode::paint(context, phase);
 
     if (phase == PaintPhase::Foreground) {
-        Gfx::StylePainter::paint_radio_button(context.painter(), enclosing_int_rect(absolute_rect()), context.palette(), dom_node().checked(), m_being_pressed);
+        auto rect = enclosing_int_rect(absolute_rect());
+        context.painter().paint_with_painter(rect, [rect, checked = dom_node().checked(), being_pressed = m_being_pressed](Gfx::Painter& painter, PaintContext& context) {
+            Gfx::StylePainter::paint_radio_button(painter, rect, context.palette(), checked, being_pressed);
+        });
     }
 }
 
@@ -35,23 +35,21 @@ void SVGPathBox::paint(PaintContext& context, PaintPhase phase)
     auto closed_path = path;
     closed_path.close();
 
-    // Fills are computed as though all paths are closed (https://svgwg.org/svg2-draft/painting.html#FillProperties)
-    Gfx::AntiAliasingPainter painter { context.painter() };
     auto& svg_context = context.svg_context();
+    auto fill_color = path_element.fill_color().value_or(svg_context.fill_color());
+    auto stroke_color = path_element.stroke_color().value_or(svg_context.stroke_color());
+    auto stroke_width = path_element.stroke_width().value_or(svg_context.stroke_width());
 
     auto offset = absolute_position();
-    painter.translate(offset);
-
-    painter.fill_path(
-        closed_path,
-        path_element.fill_color().value_or(svg_context.fill_color()),
-        Gfx::Painter::WindingRule::EvenOdd);
-    painter.stroke_path(
-        path,
-        path_element.stroke_color().value_or(svg_context.stroke_color()),
-        path_element.stroke_width().value_or(svg_context.stroke_width()));
-
-    painter.translate(-offset);
+    auto bounding_rect = enclosing_int_rect(path.bounding_box().translated(offset)).inflated((int)ceilf(stroke_width) * 2, (int)ceilf(stroke_width) * 2);
+
+    context.painter().paint_with_painter(bounding_rect, [offset, path, closed_path, fill_color, stroke_color, stroke_width](Gfx::Painter& target_painter, PaintContext&) mutable {
+        // Fills are computed as though all paths are closed (https://svgwg.org/svg2-draft/painting.html#FillProperties)
+        Gfx::AntiAliasingPainter painter { target_painter };
+        painter.translate(offset);
+        painter.fill_path(closed_path, fill_color, Gfx::Painter::WindingRule::EvenOdd);
+        painter.stroke_path(path, stroke_color, stroke_width);
+    });
 }
 
 }
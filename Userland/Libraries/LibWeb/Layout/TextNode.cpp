@@ -35,7 +35,7 @@ static bool is_all_whitespace(const StringView& string)
     return true;
 }
 
-void TextNode::paint_text_decoration(Gfx::Painter& painter, LineBoxFragment const& fragment) const
+void TextNode::paint_text_decoration(Painting::RecordingPainter& painter, LineBoxFragment const& fragment) const
 {
     Gfx::IntPoint line_start_point {};
     Gfx::IntPoint line_end_point {};
@@ -95,7 +95,7 @@ void TextNode::paint_fragment(PaintContext& context, const LineBoxFragment& frag
         auto selection_rect = fragment.selection_rect(font());
         if (!selection_rect.is_empty()) {
             painter.fill_rect(enclosing_int_rect(selection_rect), context.palette().selection());
-            Gfx::PainterStateSaver saver(painter);
+            Painting::RecordingPainterStateSaver saver(painter);
             painter.add_clip_rect(enclosing_int_rect(selection_rect));
             painter.draw_text(enclosing_int_rect(fragment.absolute_rect()), text.substring_view(fragment.start(), fragment.length()), Gfx::TextAlignment::CenterLeft, context.palette().selection_text());
         }
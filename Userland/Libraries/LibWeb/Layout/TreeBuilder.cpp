@@ -141,12 +141,55 @@ RefPtr<Node> TreeBuilder::build(DOM::Node& dom_node)
     Context context;
     create_layout_tree(dom_node, context);
 
+    // NOTE: Even if we only do a partial build, we always do fixup from the root.
     if (auto* root = dom_node.document().layout_node())
         fixup_tables(*root);
 
     return move(m_layout_root);
 }
 
+void TreeBuilder::rebuild_children(DOM::Node& dom_node)
+{
+    auto& layout_node = verify_cast<NodeWithStyle>(*dom_node.layout_node());
+    VERIFY(layout_node.can_have_children());
+
+    while (RefPtr<Layout::Node> child = layout_node.first_child())
+        layout_node.remove_child(*child);
+    layout_node.set_children_are_inline(false);
+
+    for (Layout::Node* ancestor = &layout_node; ancestor; ancestor = ancestor->parent())
+        m_parent_stack.prepend(verify_cast<NodeWithStyle>(ancestor));
+
+    Context context;
+    for (auto* ancestor = &dom_node; ancestor; ancestor = ancestor->parent_or_shadow_host()) {
+        if (ancestor->is_svg_container()) {
+            context.has_svg_root = true;
+            break;
+        }
+    }
+
+    if (is<DOM::Element>(dom_node)) {
+        if (auto* shadow_root = verify_cast<DOM::Element>(dom_node).shadow_root())
+            create_layout_tree(*shadow_root, context);
+    }
+    verify_cast<DOM::ParentNode>(dom_node).for_each_child([&](auto& dom_child) {
+        create_layout_tree(dom_child, context);
+    });
+
+    // Only the rebuilt children can be missing table wrappers, but they may belong to a table further up,
+    // so we fix up from there. Nothing outside of that table is affected.
+    NodeWithStyle* fixup_root = &layout_node;
+    for (auto* ancestor = layout_node.parent(); ancestor; ancestor = ancestor->parent()) {
+        auto const& display = ancestor->computed_values().display();
+        if (display.it_outside_and_inside() && display.inside() == CSS::Display::Inside::Table) {
+            fixup_root = ancestor;
+            break;
+        }
+    }
+    fixup_tables(*fixup_root);
+    layout_node.set_needs_layout();
+}
+
 template<CSS::Display::Internal internal, typename Callback>
 void TreeBuilder::for_each_in_tree_with_internal_display(NodeWithStyle& root, Callback callback)
 {
@@ -171,8 +214,6 @@ void TreeBuilder::for_each_in_tree_with_inside_display(NodeWithStyle& root, Call
 
 void TreeBuilder::fixup_tables(NodeWithStyle& root)
 {
-    // NOTE: Even if we only do a partial build, we always do fixup from the root.
-
     remove_irrelevant_boxes(root);
     generate_missing_child_wrappers(root);
     generate_missing_parents(root);
@@ -19,6 +19,9 @@ public:
 
     RefPtr<Layout::Node> build(DOM::Node&);
 
+    // Throws away the layout nodes below the layout node of the given DOM node, and builds them again from its children.
+    void rebuild_children(DOM::Node&);
+
 private:
     struct Context {
         bool has_svg_root = false;
@@ -68,6 +68,8 @@ void CSSLoader::resource_did_load()
     // FIXME: @import rules need work.
     if (!was_imported) {
         m_style_sheet->set_rules(sheet->rules());
+    } else {
+        m_style_sheet->invalidate_owners();
     }
 
     if (on_load)
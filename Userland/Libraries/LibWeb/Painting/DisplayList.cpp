@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/PaintContext.h>
+#include <LibWeb/Painting/StackingContext.h>
+
+namespace Web::Painting {
+
+void DisplayList::replay(Gfx::Painter& painter, PaintContext& context) const
+{
+    for (auto& entry : m_commands) {
+        // NOTE: LibWeb always paints at scale 1, so translating is enough to get the physical bounding rect.
+        if (entry.bounding_rect.has_value() && !painter.clip_rect().intersects(entry.bounding_rect->translated(painter.translation())))
+            continue;
+
+        entry.command.visit(
+            [&](FillRect const& command) {
+                painter.fill_rect(command.rect, command.color);
+            },
+            [&](FillRectWithRoundedCorners const& command) {
+                painter.fill_rect_with_rounded_corners(command.rect, command.color, command.top_left_radius, command.top_right_radius, command.bottom_right_radius, command.bottom_left_radius);
+            },
+            [&](FillEllipse const& command) {
+                painter.fill_ellipse(command.rect, command.color);
+            },
+            [&](DrawRect const& command) {
+                painter.draw_rect(command.rect, command.color);
+            },
+            [&](DrawLine const& command) {
+                painter.draw_line(command.from, command.to, command.color, command.thickness, command.style);
+            },
+            [&](DrawEllipseIntersecting const& command) {
+                painter.draw_ellipse_intersecting(command.rect, command.color, command.thickness);
+            },
+            [&](DrawCircleArcIntersecting const& command) {
+                painter.draw_circle_arc_intersecting(command.intersecting_rect, command.center, command.radius, command.color, command.thickness);
+            },
+            [&](DrawText const& command) {
+                painter.draw_text(command.rect, command.text, *command.font, command.alignment, command.color, command.elision);
+            },
+            [&](Blit const& command) {
+                painter.blit(command.position, *command.bitmap, command.source_rect, command.opacity);
+            },
+            [&](BlitTiled const& command) {
+                painter.blit_tiled(command.rect, *command.bitmap, command.source_rect);
+            },
+            [&](DrawScaledBitmap const& command) {
+                painter.draw_scaled_bitmap(command.destination_rect, *command.bitmap, command.source_rect, command.opacity, command.scaling_mode);
+            },
+            [&](Save const&) {
+                painter.save();
+            },
+            [&](Restore const&) {
+                painter.restore();
+            },
+            [&](AddClipRect const& command) {
+                painter.add_clip_rect(command.rect);
+            },
+            [&](Translate const& command) {
+                painter.translate(command.delta);
+            },
+            [&](PaintWithPainter const& command) {
+                command.callback(painter, context);
+            },
+            [&](PaintStackingContext const& command) {
+                command.stacking_context->paint(painter, context);
+            });
+    }
+}
+
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Font.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Rect.h>
+#include <LibGfx/TextAlignment.h>
+#include <LibGfx/TextElision.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::Painting {
+
+// A flat list of drawing commands, recorded once by a RecordingPainter and replayed into a Gfx::Painter on every repaint.
+// Every stacking context records its own list, and a nested stacking context is a single command in it,
+// so a list only has to be recorded again when something painted directly by its stacking context changes.
+class DisplayList {
+public:
+    struct FillRect {
+        Gfx::IntRect rect;
+        Color color;
+    };
+
+    struct FillRectWithRoundedCorners {
+        Gfx::IntRect rect;
+        Color color;
+        int top_left_radius { 0 };
+        int top_right_radius { 0 };
+        int bottom_right_radius { 0 };
+        int bottom_left_radius { 0 };
+    };
+
+    struct FillEllipse {
+        Gfx::IntRect rect;
+        Color color;
+    };
+
+    struct DrawRect {
+        Gfx::IntRect rect;
+        Color color;
+    };
+
+    struct DrawLine {
+        Gfx::IntPoint from;
+        Gfx::IntPoint to;
+        Color color;
+        int thickness { 1 };
+        Gfx::Painter::LineStyle style { Gfx::Painter::LineStyle::Solid };
+    };
+
+    struct DrawEllipseIntersecting {
+        Gfx::IntRect rect;
+        Color color;
+        int thickness { 1 };
+    };
+
+    struct DrawCircleArcIntersecting {
+        Gfx::IntRect intersecting_rect;
+        Gfx::IntPoint center;
+        int radius { 0 };
+        Color color;
+        int thickness { 1 };
+    };
+
+    struct DrawText {
+        Gfx::IntRect rect;
+        String text;
+        NonnullRefPtr<Gfx::Font const> font;
+        Gfx::TextAlignment alignment;
+        Color color;
+        Gfx::TextElision elision;
+    };
+
+    struct Blit {
+        Gfx::IntPoint position;
+        NonnullRefPtr<Gfx::Bitmap const> bitmap;
+        Gfx::IntRect source_rect;
+        float opacity { 1.0f };
+    };
+
+    struct BlitTiled {
+        Gfx::IntRect rect;
+        NonnullRefPtr<Gfx::Bitmap const> bitmap;
+        Gfx::IntRect source_rect;
+    };
+
+    struct DrawScaledBitmap {
+        Gfx::IntRect destination_rect;
+        NonnullRefPtr<Gfx::Bitmap const> bitmap;
+        Gfx::IntRect source_rect;
+        float opacity { 1.0f };
+        Gfx::Painter::ScalingMode scaling_mode;
+    };
+
+    struct Save {
+    };
+
+    struct Restore {
+    };
+
+    struct AddClipRect {
+        Gfx::IntRect rect;
+    };
+
+    struct Translate {
+        Gfx::IntPoint delta;
+    };
+
+    // Drawing that can only be expressed with a Gfx::Painter, like the widget and path painters or a nested browsing context.
+    struct PaintWithPainter {
+        Function<void(Gfx::Painter&, PaintContext&)> callback;
+    };
+
+    // A nested stacking context, which replays its own display list.
+    struct PaintStackingContext {
+        Layout::StackingContext* stacking_context { nullptr };
+    };
+
+    using Command = Variant<
+        FillRect,
+        FillRectWithRoundedCorners,
+        FillEllipse,
+        DrawRect,
+        DrawLine,
+        DrawEllipseIntersecting,
+        DrawCircleArcIntersecting,
+        DrawText,
+        Blit,
+        BlitTiled,
+        DrawScaledBitmap,
+        Save,
+        Restore,
+        AddClipRect,
+        Translate,
+        PaintWithPainter,
+        PaintStackingContext>;
+
+    // Commands with a bounding rect are skipped during replay when that rect is outside the painter's clip rect.
+    void append(Command&& command, Optional<Gfx::IntRect> const& bounding_rect = {})
+    {
+        m_commands.append({ move(command), bounding_rect });
+    }
+
+    void replay(Gfx::Painter&, PaintContext&) const;
+
+    // The area all commands together paint to, in the coordinates the list is replayed in.
+    // Nested stacking contexts paint on their own, so what they paint isn't included.
+    Gfx::IntRect const& bounding_rect() const { return m_bounding_rect; }
+    void add_to_bounding_rect(Gfx::IntRect const& rect) { m_bounding_rect = m_bounding_rect.united(rect); }
+
+    void clear()
+    {
+        m_commands.clear();
+        m_bounding_rect = {};
+    }
+    bool is_empty() const { return m_commands.is_empty(); }
+    size_t size() const { return m_commands.size(); }
+
+private:
+    struct Entry {
+        Command command;
+        Optional<Gfx::IntRect> bounding_rect;
+    };
+
+    Vector<Entry> m_commands;
+    Gfx::IntRect m_bounding_rect;
+};
+
+}
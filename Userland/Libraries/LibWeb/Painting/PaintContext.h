@@ -10,6 +10,7 @@
 #include <LibGfx/Forward.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Rect.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/SVG/SVGContext.h>
 
 namespace Web {
@@ -17,13 +18,23 @@ namespace Web {
 class PaintContext {
 public:
     explicit PaintContext(Gfx::Painter& painter, const Palette& palette, const Gfx::IntPoint& scroll_offset)
-        : m_painter(painter)
+        : m_target_painter(painter)
         , m_palette(palette)
         , m_scroll_offset(scroll_offset)
     {
     }
 
-    Gfx::Painter& painter() const { return m_painter; }
+    // The painter that display lists are replayed into.
+    Gfx::Painter& target_painter() const { return m_target_painter; }
+
+    // The painter that records the display list of the stacking context currently being recorded.
+    Painting::RecordingPainter& painter() const
+    {
+        VERIFY(m_painter);
+        return *m_painter;
+    }
+    void set_painter(Painting::RecordingPainter* painter) { m_painter = painter; }
+
     const Palette& palette() const { return m_palette; }
 
     bool has_svg_context() const { return m_svg_context.has_value(); }
@@ -43,7 +54,8 @@ public:
     void set_has_focus(bool focus) { m_focus = focus; }
 
 private:
-    Gfx::Painter& m_painter;
+    Gfx::Painter& m_target_painter;
+    Painting::RecordingPainter* m_painter { nullptr };
     Palette m_palette;
     Optional<SVGContext> m_svg_context;
     Gfx::IntRect m_viewport_rect;
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/FontDatabase.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+namespace Web::Painting {
+
+RecordingPainter::RecordingPainter(DisplayList& display_list)
+    : m_display_list(display_list)
+{
+    m_state_stack.append({ &Gfx::FontDatabase::default_font(), {} });
+}
+
+void RecordingPainter::append(DisplayList::Command&& command, Optional<Gfx::IntRect> const& bounding_rect)
+{
+    if (bounding_rect.has_value())
+        m_display_list.add_to_bounding_rect(bounding_rect->translated(m_state_stack.last().translation));
+    m_display_list.append(move(command), bounding_rect);
+}
+
+void RecordingPainter::fill_rect(Gfx::IntRect const& rect, Color color)
+{
+    append(DisplayList::FillRect { rect, color }, rect);
+}
+
+void RecordingPainter::fill_rect_with_rounded_corners(Gfx::IntRect const& rect, Color color, int top_left_radius, int top_right_radius, int bottom_right_radius, int bottom_left_radius)
+{
+    append(DisplayList::FillRectWithRoundedCorners { rect, color, top_left_radius, top_right_radius, bottom_right_radius, bottom_left_radius }, rect);
+}
+
+void RecordingPainter::fill_ellipse(Gfx::IntRect const& rect, Color color)
+{
+    append(DisplayList::FillEllipse { rect, color }, rect);
+}
+
+void RecordingPainter::draw_rect(Gfx::IntRect const& rect, Color color)
+{
+    append(DisplayList::DrawRect { rect, color }, rect);
+}
+
+void RecordingPainter::draw_line(Gfx::IntPoint const& from, Gfx::IntPoint const& to, Color color, int thickness, Gfx::Painter::LineStyle style)
+{
+    auto bounding_rect = Gfx::IntRect::from_two_points(from, to).inflated(thickness * 2, thickness * 2);
+    append(DisplayList::DrawLine { from, to, color, thickness, style }, bounding_rect);
+}
+
+void RecordingPainter::draw_ellipse_intersecting(Gfx::IntRect const& rect, Color color, int thickness)
+{
+    append(DisplayList::DrawEllipseIntersecting { rect, color, thickness }, rect.inflated(thickness * 2, thickness * 2));
+}
+
+void RecordingPainter::draw_circle_arc_intersecting(Gfx::IntRect const& intersecting_rect, Gfx::IntPoint const& center, int radius, Color color, int thickness)
+{
+    append(DisplayList::DrawCircleArcIntersecting { intersecting_rect, center, radius, color, thickness }, intersecting_rect.inflated(thickness * 2, thickness * 2));
+}
+
+void RecordingPainter::draw_text(Gfx::IntRect const& rect, StringView const& text, Gfx::Font const& font, Gfx::TextAlignment alignment, Color color, Gfx::TextElision elision)
+{
+    // Glyphs may overhang the rect they are laid out in, so leave some room around it.
+    auto bounding_rect = rect.inflated(font.glyph_height(), font.glyph_height());
+    append(DisplayList::DrawText { rect, text, font, alignment, color, elision }, bounding_rect);
+}
+
+void RecordingPainter::draw_text(Gfx::IntRect const& rect, StringView const& text, Gfx::TextAlignment alignment, Color color, Gfx::TextElision elision)
+{
+    draw_text(rect, text, font(), alignment, color, elision);
+}
+
+void RecordingPainter::blit(Gfx::IntPoint const& position, Gfx::Bitmap const& bitmap, Gfx::IntRect const& src_rect, float opacity)
+{
+    append(DisplayList::Blit { position, bitmap, src_rect, opacity }, Gfx::IntRect { position, src_rect.size() });
+}
+
+void RecordingPainter::blit_tiled(Gfx::IntRect const& rect, Gfx::Bitmap const& bitmap, Gfx::IntRect const& src_rect)
+{
+    append(DisplayList::BlitTiled { rect, bitmap, src_rect }, rect);
+}
+
+void RecordingPainter::draw_scaled_bitmap(Gfx::IntRect const& dst_rect, Gfx::Bitmap const& bitmap, Gfx::IntRect const& src_rect, float opacity, Gfx::Painter::ScalingMode scaling_mode)
+{
+    append(DisplayList::DrawScaledBitmap { dst_rect, bitmap, src_rect, opacity, scaling_mode }, dst_rect);
+}
+
+void RecordingPainter::paint_with_painter(Gfx::IntRect const& bounding_rect, Function<void(Gfx::Painter&, PaintContext&)> callback)
+{
+    append(DisplayList::PaintWithPainter { move(callback) }, bounding_rect);
+}
+
+void RecordingPainter::paint_stacking_context(Layout::StackingContext& stacking_context)
+{
+    append(DisplayList::PaintStackingContext { &stacking_context });
+}
+
+void RecordingPainter::add_clip_rect(Gfx::IntRect const& rect)
+{
+    append(DisplayList::AddClipRect { rect });
+}
+
+void RecordingPainter::translate(Gfx::IntPoint const& delta)
+{
+    m_state_stack.last().translation.translate_by(delta);
+    append(DisplayList::Translate { delta });
+}
+
+void RecordingPainter::save()
+{
+    m_state_stack.append(m_state_stack.last());
+    append(DisplayList::Save {});
+}
+
+void RecordingPainter::restore()
+{
+    VERIFY(m_state_stack.size() > 1);
+    m_state_stack.take_last();
+    append(DisplayList::Restore {});
+}
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Rect.h>
+#include <LibGfx/TextAlignment.h>
+#include <LibGfx/TextElision.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+namespace Web::Painting {
+
+// Offers the subset of the Gfx::Painter API that layout nodes paint with, but appends to a DisplayList instead of drawing.
+class RecordingPainter {
+public:
+    explicit RecordingPainter(DisplayList&);
+
+    void fill_rect(Gfx::IntRect const&, Color);
+    void fill_rect_with_rounded_corners(Gfx::IntRect const&, Color, int top_left_radius, int top_right_radius, int bottom_right_radius, int bottom_left_radius);
+    void fill_ellipse(Gfx::IntRect const&, Color);
+    void draw_rect(Gfx::IntRect const&, Color);
+    void draw_line(Gfx::IntPoint const&, Gfx::IntPoint const&, Color, int thickness = 1, Gfx::Painter::LineStyle = Gfx::Painter::LineStyle::Solid);
+    void draw_ellipse_intersecting(Gfx::IntRect const&, Color, int thickness = 1);
+    void draw_circle_arc_intersecting(Gfx::IntRect const&, Gfx::IntPoint const&, int radius, Color, int thickness);
+    void draw_text(Gfx::IntRect const&, StringView const&, Gfx::Font const&, Gfx::TextAlignment = Gfx::TextAlignment::TopLeft, Color = Color::Black, Gfx::TextElision = Gfx::TextElision::None);
+    void draw_text(Gfx::IntRect const&, StringView const&, Gfx::TextAlignment = Gfx::TextAlignment::TopLeft, Color = Color::Black, Gfx::TextElision = Gfx::TextElision::None);
+    void blit(Gfx::IntPoint const&, Gfx::Bitmap const&, Gfx::IntRect const& src_rect, float opacity = 1.0f);
+    void blit_tiled(Gfx::IntRect const&, Gfx::Bitmap const&, Gfx::IntRect const& src_rect);
+    void draw_scaled_bitmap(Gfx::IntRect const& dst_rect, Gfx::Bitmap const&, Gfx::IntRect const& src_rect, float opacity = 1.0f, Gfx::Painter::ScalingMode = Gfx::Painter::ScalingMode::NearestNeighbor);
+
+    // Records drawing that needs a real Gfx::Painter. The callback runs on every replay that reaches the bounding rect.
+    void paint_with_painter(Gfx::IntRect const& bounding_rect, Function<void(Gfx::Painter&, PaintContext&)>);
+
+    void paint_stacking_context(Layout::StackingContext&);
+
+    Gfx::Font const& font() const { return *m_state_stack.last().font; }
+    void set_font(Gfx::Font const& font) { m_state_stack.last().font = &font; }
+
+    void add_clip_rect(Gfx::IntRect const&);
+    void translate(int dx, int dy) { translate({ dx, dy }); }
+    void translate(Gfx::IntPoint const&);
+
+    void save();
+    void restore();
+
+private:
+    void append(DisplayList::Command&&, Optional<Gfx::IntRect> const& bounding_rect = {});
+
+    struct State {
+        Gfx::Font const* font { nullptr };
+        Gfx::IntPoint translation;
+    };
+
+    DisplayList& m_display_list;
+    Vector<State, 4> m_state_stack;
+};
+
+class RecordingPainterStateSaver {
+public:
+    explicit RecordingPainterStateSaver(RecordingPainter& painter)
+        : m_painter(painter)
+    {
+        m_painter.save();
+    }
+
+    ~RecordingPainterStateSaver()
+    {
+        m_painter.restore();
+    }
+
+private:
+    RecordingPainter& m_painter;
+};
+
+}
@@ -84,7 +84,7 @@ void StackingContext::paint_internal(PaintContext& context)
     // Draw positioned descendants with negative z-indices (step 3)
     for (auto* child : m_children) {
         if (child->m_box.computed_values().z_index().has_value() && child->m_box.computed_values().z_index().value() < 0)
-            child->paint(context);
+            context.painter().paint_stacking_context(*child);
     }
     // Draw the background and borders for block-level children (step 4)
     paint_descendants(context, m_box, StackingContextPaintPhase::BackgroundAndBorders);
@@ -97,7 +97,7 @@ void StackingContext::paint_internal(PaintContext& context)
     for (auto* child : m_children) {
         if (child->m_box.computed_values().z_index().has_value() && child->m_box.computed_values().z_index().value() < 0)
             continue;
-        child->paint(context);
+        context.painter().paint_stacking_context(*child);
     }
 
     m_box.paint(context, PaintPhase::FocusOutline);
@@ -105,28 +105,65 @@ void StackingContext::paint_internal(PaintContext& context)
     paint_descendants(context, m_box, StackingContextPaintPhase::FocusAndOverlay);
 }
 
-void StackingContext::paint(PaintContext& context)
+void StackingContext::record_display_list_if_needed(PaintContext& context)
 {
-    Gfx::PainterStateSaver saver(context.painter());
-    if (m_box.is_fixed_position()) {
-        context.painter().translate(context.scroll_offset());
+    if (m_display_list_is_valid && m_display_list_has_focus == context.has_focus() && m_display_list_shows_line_box_borders == context.should_show_line_box_borders())
+        return;
+
+    m_display_list.clear();
+    Painting::RecordingPainter recording_painter(m_display_list);
+    context.set_painter(&recording_painter);
+    paint_internal(context);
+    context.set_painter(nullptr);
+
+    m_display_list_is_valid = true;
+    m_display_list_has_focus = context.has_focus();
+    m_display_list_shows_line_box_borders = context.should_show_line_box_borders();
+}
+
+Gfx::IntRect StackingContext::paint_bounds(PaintContext& context)
+{
+    record_display_list_if_needed(context);
+    auto bounds = m_display_list.bounding_rect();
+    for (auto* child : m_children) {
+        if (child->m_box.computed_values().opacity() == 0.0f)
+            continue;
+        auto child_bounds = child->paint_bounds(context);
+        if (child->m_box.is_fixed_position())
+            child_bounds.translate_by(context.scroll_offset());
+        bounds = bounds.united(child_bounds);
     }
+    return bounds;
+}
 
+void StackingContext::paint(Gfx::Painter& painter, PaintContext& context)
+{
     auto opacity = m_box.computed_values().opacity();
     if (opacity == 0.0f)
         return;
 
+    Gfx::PainterStateSaver saver(painter);
+    if (m_box.is_fixed_position()) {
+        // NOTE: The display list is recorded in document coordinates, so a fixed position box keeps its list while scrolling.
+        painter.translate(context.scroll_offset());
+    }
+
+    record_display_list_if_needed(context);
+
     if (opacity < 1.0f) {
-        auto bitmap = context.painter().target();
-        auto new_bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, bitmap->size());
-        if (!new_bitmap)
+        // Content can overflow the box, so the layer has to cover everything that is painted, but no more than is visible.
+        auto layer_rect = paint_bounds(context).intersected(painter.clip_rect().translated(-painter.translation()));
+        if (layer_rect.is_empty())
+            return;
+        auto layer = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, layer_rect.size());
+        if (!layer)
             return;
-        Gfx::Painter painter(*new_bitmap);
-        PaintContext paint_context(painter, context.palette(), context.scroll_offset());
-        paint_internal(paint_context);
-        context.painter().blit(Gfx::IntPoint(m_box.absolute_position()), *new_bitmap, Gfx::IntRect(m_box.absolute_rect()), opacity);
+        Gfx::Painter layer_painter(*layer);
+        layer_painter.translate(-layer_rect.location());
+        m_display_list.replay(layer_painter, context);
+        painter.blit(layer_rect.location(), *layer, layer->rect(), opacity);
     } else {
-        paint_internal(context);
+        m_display_list.replay(painter, context);
     }
 }
 
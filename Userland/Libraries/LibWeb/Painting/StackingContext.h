@@ -8,6 +8,7 @@
 
 #include <AK/Vector.h>
 #include <LibWeb/Layout/Node.h>
+#include <LibWeb/Painting/DisplayList.h>
 
 namespace Web::Layout {
 
@@ -26,7 +27,11 @@ public:
     };
 
     void paint_descendants(PaintContext&, Node&, StackingContextPaintPhase);
-    void paint(PaintContext&);
+
+    // Replays the display list of this stacking context into the painter, recording it first if it was invalidated.
+    void paint(Gfx::Painter&, PaintContext&);
+
+    void invalidate_display_list() { m_display_list_is_valid = false; }
     HitTestResult hit_test(const Gfx::IntPoint&, HitTestType) const;
 
     void dump(int indent = 0) const;
@@ -36,6 +41,14 @@ private:
     StackingContext* const m_parent { nullptr };
     Vector<StackingContext*> m_children;
 
+    Painting::DisplayList m_display_list;
+    bool m_display_list_is_valid { false };
+    bool m_display_list_has_focus { false };
+    bool m_display_list_shows_line_box_borders { false };
+
+    void record_display_list_if_needed(PaintContext&);
+    // Everything this stacking context paints, including nested ones, in the coordinates of the painter it's painted with.
+    Gfx::IntRect paint_bounds(PaintContext&);
     void paint_internal(PaintContext&);
 };
 
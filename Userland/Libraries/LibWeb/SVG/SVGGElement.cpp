@@ -18,7 +18,7 @@ SVGGElement::SVGGElement(DOM::Document& document, QualifiedName qualified_name)
 
 RefPtr<Layout::Node> SVGGElement::create_layout_node()
 {
-    auto style = document().style_computer().compute_style(*this);
+    auto style = ensure_specified_css_values();
     if (style->display().is_none())
         return nullptr;
     return adopt_ref(*new Layout::SVGGraphicsBox(document(), *this, move(style)));
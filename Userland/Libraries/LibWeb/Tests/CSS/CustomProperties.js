@@ -0,0 +1,38 @@
+describe("Custom properties", () => {
+    loadLocalPage("CustomProperties.html");
+
+    afterInitialPageLoad(page => {
+        const colorOf = elementOrId => {
+            const element = typeof elementOrId === "string" ? page.document.getElementById(elementOrId) : elementOrId;
+            return page.getComputedStyle(element).color;
+        };
+
+        const expectColor = (elementOrId, color) => {
+            const reference = page.document.getElementById("reference");
+            reference.setAttribute("style", "color: " + color);
+            expect(colorOf(elementOrId)).toBe(colorOf(reference));
+        };
+
+        test("inheritance", () => {
+            expectColor("root-accent", "rgb(1, 0, 0)");
+            expectColor("inherited-accent", "rgb(3, 0, 0)");
+            expectColor("inherited-text", "rgb(2, 0, 0)");
+        });
+
+        test("cascade order", () => {
+            expectColor("inline-accent", "rgb(5, 0, 0)");
+            expectColor("important", "rgb(4, 0, 0)");
+        });
+
+        test("changing an ancestor", () => {
+            const element = page.document.getElementById("inherited-accent");
+            const themed = element.parentNode.parentNode;
+            themed.classList.remove("themed");
+            expectColor(element, "rgb(1, 0, 0)");
+            themed.classList.add("themed");
+            expectColor(element, "rgb(3, 0, 0)");
+        });
+    });
+
+    waitForPageToLoad();
+});
@@ -0,0 +1,101 @@
+describe("Style recalc", () => {
+    loadLocalPage("StyleRecalc.html");
+
+    afterInitialPageLoad(page => {
+        const colorOf = elementOrId => {
+            const element = typeof elementOrId === "string" ? page.document.getElementById(elementOrId) : elementOrId;
+            return page.getComputedStyle(element).color;
+        };
+
+        const expectColor = (elementOrId, color) => {
+            const reference = page.document.getElementById("reference");
+            reference.setAttribute("style", "color: " + color);
+            expect(colorOf(elementOrId)).toBe(colorOf(reference));
+        };
+
+        test("id, class and tag selectors", () => {
+            expectColor("by-id", "rgb(9, 0, 0)");
+            expectColor("by-class", "rgb(2, 0, 0)");
+            expectColor("by-tag", "rgb(3, 0, 0)");
+            expectColor("compound", "rgb(8, 0, 0)");
+            expect(colorOf("partial-compound")).not.toBe(colorOf("compound"));
+        });
+
+        test("combinators", () => {
+            expectColor("descendant", "rgb(4, 0, 0)");
+            expectColor("child", "rgb(6, 0, 0)");
+            expectColor("sibling", "rgb(7, 0, 0)");
+            expect(colorOf("not-a-child")).not.toBe(colorOf("child"));
+        });
+
+        test("toggling a class on an ancestor", () => {
+            const outer = page.document.getElementById("outer");
+            outer.classList.add("toggled");
+            expectColor("descendant", "rgb(5, 0, 0)");
+            outer.classList.remove("toggled");
+            expectColor("descendant", "rgb(4, 0, 0)");
+        });
+
+        test("inserting and deleting rules", () => {
+            const sheet = page.document.styleSheets[0];
+            const index = sheet.insertRule(".outer p#descendant { color: rgb(10, 0, 0); }", sheet.cssRules.length);
+            expectColor("descendant", "rgb(10, 0, 0)");
+            sheet.deleteRule(index);
+            expectColor("descendant", "rgb(4, 0, 0)");
+        });
+
+        test("changing a selector", () => {
+            const sheet = page.document.styleSheets[0];
+            const index = sheet.insertRule("#nothing { color: rgb(11, 0, 0); }", sheet.cssRules.length);
+            sheet.cssRules[index].selectorText = "em";
+            expectColor("by-tag", "rgb(11, 0, 0)");
+            sheet.deleteRule(index);
+            expectColor("by-tag", "rgb(3, 0, 0)");
+        });
+
+        test("rules and sheets outliving what they belonged to", () => {
+            const style = page.document.createElement("style");
+            style.textContent = "#nothing { color: rgb(15, 0, 0); }";
+            page.document.head.appendChild(style);
+            const sheet = style.sheet;
+            const rule = sheet.cssRules[0];
+
+            sheet.deleteRule(0);
+            style.remove();
+            rule.selectorText = "em";
+            expectColor("by-tag", "rgb(3, 0, 0)");
+
+            sheet.insertRule("em { color: rgb(15, 0, 0); }", 0);
+            expectColor("by-tag", "rgb(3, 0, 0)");
+        });
+
+        test("many rules", () => {
+            let css = "";
+            for (let i = 0; i < 2000; ++i) {
+                css += "#generated-" + i + " { color: rgb(12, 0, 0); }\n";
+                css += ".generated-" + i + " { color: rgb(13, 0, 0); }\n";
+                css += ".outer .inner .generated-" + i + " { color: rgb(14, 0, 0); }\n";
+            }
+            const style = page.document.createElement("style");
+            style.textContent = css;
+            page.document.head.appendChild(style);
+
+            const element = page.document.createElement("p");
+            element.className = "generated-1999";
+            page.document.getElementById("descendant").parentNode.appendChild(element);
+            expectColor(element, "rgb(14, 0, 0)");
+
+            page.document.body.appendChild(element);
+            expectColor(element, "rgb(13, 0, 0)");
+
+            element.id = "generated-5";
+            element.className = "";
+            expectColor(element, "rgb(12, 0, 0)");
+
+            style.remove();
+            expectColor("descendant", "rgb(4, 0, 0)");
+        });
+    });
+
+    waitForPageToLoad();
+});
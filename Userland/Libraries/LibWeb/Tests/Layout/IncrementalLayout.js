@@ -0,0 +1,57 @@
+describe("Incremental layout", () => {
+    loadLocalPage("IncrementalLayout.html");
+
+    afterInitialPageLoad(page => {
+        const element = id => page.document.getElementById(id);
+        const top = id => element(id).getBoundingClientRect().top;
+
+        test("resizing a box in normal flow moves the boxes after it", () => {
+            const afterTop = top("after");
+            element("grow").setAttribute("style", "height: 50px");
+            expect(element("flow").offsetHeight).toBe(50);
+            expect(top("after")).toBe(afterTop + 40);
+            element("grow").setAttribute("style", "height: 10px");
+            expect(top("after")).toBe(afterTop);
+        });
+
+        test("resizing a box inside of a box with a fixed size", () => {
+            const afterTop = top("after");
+            element("inside").setAttribute("style", "height: 30px");
+            expect(element("inside").offsetHeight).toBe(30);
+            expect(element("fixed").offsetHeight).toBe(100);
+            expect(top("after")).toBe(afterTop);
+        });
+
+        test("inserting and removing elements", () => {
+            const afterTop = top("after");
+            const inserted = page.document.createElement("div");
+            inserted.setAttribute("style", "height: 20px");
+            page.document.body.insertBefore(inserted, element("after"));
+            expect(top("after")).toBe(afterTop + 20);
+            expect(inserted.getBoundingClientRect().top).toBe(afterTop);
+
+            inserted.remove();
+            expect(top("after")).toBe(afterTop);
+            expect(inserted.offsetHeight).toBe(0);
+        });
+
+        test("changing the display of an element", () => {
+            const afterTop = top("after");
+            element("flow").setAttribute("style", "display: none");
+            expect(element("flow").offsetHeight).toBe(0);
+            expect(top("after")).toBe(afterTop - 10);
+            element("flow").removeAttribute("style");
+            expect(element("flow").offsetHeight).toBe(10);
+            expect(top("after")).toBe(afterTop);
+        });
+
+        test("changing the text of a shrink-to-fit box", () => {
+            const text = element("shrink").firstChild;
+            const width = element("shrink").offsetWidth;
+            text.data = "abcabcabc";
+            expect(element("shrink").offsetWidth).toBeGreaterThan(width);
+            text.data = "abc";
+            expect(element("shrink").offsetWidth).toBe(width);
+        });
+    });
+});
@@ -55,4 +55,11 @@ Messages::LookupServer::LookupAddressResponse ClientConnection::lookup_address(S
         return { 1, String() };
     return { 0, answers[0].record_data() };
 }
+
+Messages::LookupServer::GetCacheStatisticsResponse ClientConnection::get_cache_statistics()
+{
+    auto& cache = LookupServer::the().cache();
+    auto& statistics = cache.statistics();
+    return { statistics.hits, statistics.negative_hits, statistics.misses, statistics.expirations, statistics.evictions, static_cast<u32>(cache.size()), static_cast<u32>(cache.capacity()) };
+}
 }
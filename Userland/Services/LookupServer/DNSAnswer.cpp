@@ -58,6 +58,9 @@ void AK::Formatter<LookupServer::DNSRecordType>::format(AK::FormatBuilder& build
     case LookupServer::DNSRecordType::SRV:
         builder.put_string("SRV");
         return;
+    case LookupServer::DNSRecordType::ANY:
+        builder.put_string("ANY");
+        return;
     }
 
     builder.put_string("DNS record type ");
@@ -23,6 +23,8 @@ enum class DNSRecordType : u16 {
     TXT = 16,
     AAAA = 28,
     SRV = 33,
+    // Only used in questions, to ask for records of any type.
+    ANY = 255,
 };
 
 enum class DNSRecordClass : u16 {
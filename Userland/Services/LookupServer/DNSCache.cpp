@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "DNSCache.h"
+#include <AK/Debug.h>
+
+namespace LookupServer {
+
+DNSCache::DNSCache(size_t capacity)
+    : m_capacity(capacity)
+    , m_wheel_time(time(nullptr))
+{
+}
+
+DNSCache::~DNSCache()
+{
+    clear();
+}
+
+Optional<Vector<DNSAnswer>> DNSCache::lookup(DNSName const& name, DNSRecordType type)
+{
+    auto now = time(nullptr);
+    advance_wheel(now);
+
+    auto* entry = find_entry({ name, type }, now);
+    if (!entry) {
+        // If the name doesn't exist at all, that answers questions about any type of record (RFC 2308, 5).
+        entry = find_entry({ name, DNSRecordType::ANY }, now);
+        if (entry && entry->negative_answer != NegativeAnswer::NoSuchName)
+            entry = nullptr;
+    }
+
+    if (!entry) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    m_lru_list.remove(*entry);
+    m_lru_list.append(*entry);
+
+    if (entry->negative_answer.has_value()) {
+        dbgln_if(LOOKUPSERVER_DEBUG, "Negative cache hit: {} ({})", name, type);
+        ++m_statistics.negative_hits;
+        return Vector<DNSAnswer> {};
+    }
+
+    dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} ({})", name, type);
+    ++m_statistics.hits;
+    u32 remaining_ttl = entry->expiration_time - now;
+    Vector<DNSAnswer> answers;
+    answers.ensure_capacity(entry->answers.size());
+    for (auto& answer : entry->answers)
+        answers.empend(answer.name(), answer.type(), answer.class_code(), remaining_ttl, answer.record_data(), answer.mdns_cache_flush());
+    return answers;
+}
+
+void DNSCache::put(DNSName const& name, DNSRecordType type, Vector<DNSAnswer> const& answers)
+{
+    VERIFY(!answers.is_empty());
+
+    // The answers form one set, so they all expire together, as soon as the first one of them does.
+    u32 ttl = max_ttl;
+    for (auto& answer : answers)
+        ttl = min(ttl, answer.ttl());
+
+    auto entry = make<Entry>(Key { name, type });
+    entry->answers = answers;
+    insert(move(entry), ttl, time(nullptr));
+}
+
+void DNSCache::put_negative(DNSName const& name, DNSRecordType type, NegativeAnswer negative_answer, u32 ttl)
+{
+    auto entry = make<Entry>(Key { name, negative_answer == NegativeAnswer::NoSuchName ? DNSRecordType::ANY : type });
+    entry->negative_answer = negative_answer;
+    insert(move(entry), min(ttl, max_negative_ttl), time(nullptr));
+}
+
+DNSCache::Entry* DNSCache::find_entry(Key const& key, time_t now)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return nullptr;
+    auto& entry = *it->value;
+    // NOTE: The wheel has already removed anything that expired before this second, but not what expires right now.
+    if (entry.expiration_time <= now)
+        return nullptr;
+    return &entry;
+}
+
+void DNSCache::insert(NonnullOwnPtr<Entry> entry, u32 ttl, time_t now)
+{
+    // A TTL of zero means that the answer may only be used for the transaction in progress (RFC 1035, 3.2.1).
+    if (m_capacity == 0 || ttl == 0)
+        return;
+
+    advance_wheel(now);
+
+    if (auto it = m_entries.find(entry->key); it != m_entries.end())
+        remove(*it->value);
+
+    while (m_entries.size() >= m_capacity) {
+        auto* least_recently_used = m_lru_list.first();
+        VERIFY(least_recently_used);
+        dbgln_if(LOOKUPSERVER_DEBUG, "Evicting cache entry: {} ({})", least_recently_used->key.name, least_recently_used->key.type);
+        ++m_statistics.evictions;
+        remove(*least_recently_used);
+    }
+
+    entry->expiration_time = now + min(ttl, max_ttl);
+    m_lru_list.append(*entry);
+    m_wheel[entry->expiration_time % wheel_slot_count].append(*entry);
+    auto key = entry->key;
+    m_entries.set(move(key), move(entry));
+}
+
+void DNSCache::remove(Entry& entry)
+{
+    m_lru_list.remove(entry);
+    entry.wheel_list_node.remove();
+    // NOTE: This destroys the entry, so we can't pass its own key along.
+    auto key = entry.key;
+    m_entries.remove(key);
+}
+
+void DNSCache::advance_wheel(time_t now)
+{
+    if (now <= m_wheel_time) {
+        // Either we've already been here this second, or the clock was set back and we start turning the wheel from here.
+        m_wheel_time = now;
+        return;
+    }
+
+    // Once a full turn is over, every slot has been looked at, so there's no point in going around again.
+    auto first_second = max(m_wheel_time + 1, now - static_cast<time_t>(wheel_slot_count) + 1);
+    for (auto second = first_second; second <= now; ++second) {
+        auto& slot = m_wheel[second % wheel_slot_count];
+        for (auto it = slot.begin(); it != slot.end();) {
+            auto& entry = *it;
+            ++it;
+            if (entry.expiration_time > now)
+                continue;
+            dbgln_if(LOOKUPSERVER_DEBUG, "Cache entry expired: {} ({})", entry.key.name, entry.key.type);
+            ++m_statistics.expirations;
+            remove(entry);
+        }
+    }
+    m_wheel_time = now;
+}
+
+void DNSCache::set_capacity(size_t capacity)
+{
+    m_capacity = capacity;
+    while (m_entries.size() > m_capacity) {
+        ++m_statistics.evictions;
+        remove(*m_lru_list.first());
+    }
+}
+
+void DNSCache::remove_expired_entries()
+{
+    advance_wheel(time(nullptr));
+}
+
+void DNSCache::clear()
+{
+    while (auto* entry = m_lru_list.first())
+        remove(*entry);
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "DNSAnswer.h"
+#include "DNSName.h"
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <time.h>
+
+namespace LookupServer {
+
+// Remembers the answers to the questions we've asked, including the fact that a question had no answers (RFC 2308).
+// Entries expire according to their TTL, and once the cache is full, the least recently used entry is evicted.
+class DNSCache {
+public:
+    static constexpr size_t default_capacity = 256;
+
+    explicit DNSCache(size_t capacity = default_capacity);
+    ~DNSCache();
+
+    enum class NegativeAnswer {
+        // NXDOMAIN: the name doesn't exist, so there are no records of any type for it.
+        NoSuchName,
+        // NODATA: the name exists, but has no records of the type we asked for.
+        NoData,
+        // None of the nameservers gave us a usable response (RFC 2308, 7).
+        ServerFailure,
+    };
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 negative_hits { 0 };
+        u64 misses { 0 };
+        u64 expirations { 0 };
+        u64 evictions { 0 };
+    };
+
+    // Returns the cached answers to a question, with their TTLs counting down since they were received.
+    // An empty vector means that we know there aren't any answers; an empty Optional means that we have to go and ask.
+    Optional<Vector<DNSAnswer>> lookup(DNSName const&, DNSRecordType);
+
+    void put(DNSName const&, DNSRecordType, Vector<DNSAnswer> const&);
+    void put_negative(DNSName const&, DNSRecordType, NegativeAnswer, u32 ttl);
+
+    void remove_expired_entries();
+    void clear();
+
+    size_t size() const { return m_entries.size(); }
+    size_t capacity() const { return m_capacity; }
+    void set_capacity(size_t);
+    Statistics const& statistics() const { return m_statistics; }
+
+private:
+    struct Key {
+        DNSName name;
+        DNSRecordType type;
+
+        bool operator==(Key const& other) const { return type == other.type && name == other.name; }
+    };
+
+    struct KeyTraits : public AK::Traits<Key> {
+        static unsigned hash(Key const& key) { return pair_int_hash(DNSName::Traits::hash(key.name), (u16)key.type); }
+        static bool equals(Key const& a, Key const& b) { return a == b; }
+    };
+
+    struct Entry {
+        explicit Entry(Key key)
+            : key(move(key))
+        {
+        }
+
+        Key key;
+        Vector<DNSAnswer> answers;
+        Optional<NegativeAnswer> negative_answer;
+        time_t expiration_time { 0 };
+
+        IntrusiveListNode<Entry> lru_list_node;
+        IntrusiveListNode<Entry> wheel_list_node;
+    };
+
+    using LRUList = IntrusiveList<&Entry::lru_list_node>;
+    using WheelSlot = IntrusiveList<&Entry::wheel_list_node>;
+
+    // Expiration times are hashed into a ring of one second slots (a "timer wheel"). Every second that passes, we only
+    // have to look at the entries in one slot, instead of at the whole cache. Entries that live longer than a full turn
+    // of the wheel just stay in their slot until it comes around often enough.
+    static constexpr size_t wheel_slot_count = 64;
+
+    // Longer TTLs are clamped to these, so that records that change anyway don't stick around forever.
+    static constexpr u32 max_ttl = 86400;
+    static constexpr u32 max_negative_ttl = 3 * 3600;
+
+    Entry* find_entry(Key const&, time_t now);
+    void insert(NonnullOwnPtr<Entry>, u32 ttl, time_t now);
+    void remove(Entry&);
+    void advance_wheel(time_t now);
+
+    size_t m_capacity { 0 };
+    HashMap<Key, NonnullOwnPtr<Entry>, KeyTraits> m_entries;
+    LRUList m_lru_list;
+    Array<WheelSlot, wheel_slot_count> m_wheel;
+    time_t m_wheel_time { 0 };
+    Statistics m_statistics;
+};
+
+}
@@ -115,8 +115,9 @@ Optional<DNSPacket> DNSPacket::from_raw_packet(const u8* raw_data, size_t raw_si
     packet.m_query_or_response = header.is_response();
     packet.m_code = header.response_code();
 
-    // FIXME: Should we parse further in this case?
-    if (packet.code() != Code::NOERROR)
+    // NOTE: Telling us that a name doesn't exist comes with the same question, and an SOA record saying how long we may remember that.
+    // FIXME: Should we parse further in other cases?
+    if (packet.code() != Code::NOERROR && packet.code() != Code::NXDOMAIN)
         return packet;
 
     size_t offset = sizeof(DNSPacketHeader);
@@ -136,7 +137,7 @@ Optional<DNSPacket> DNSPacket::from_raw_packet(const u8* raw_data, size_t raw_si
         dbgln_if(LOOKUPSERVER_DEBUG, "Question #{}: name=_{}_, type={}, class={}", i, question.name(), question.record_type(), question.class_code());
     }
 
-    for (u16 i = 0; i < header.answer_count(); ++i) {
+    auto parse_record = [&] {
         auto name = DNSName::parse(raw_data, offset, raw_size);
 
         auto& record = *(const DNSRecordWithoutName*)(&raw_data[offset]);
@@ -160,6 +161,9 @@ Optional<DNSPacket> DNSPacket::from_raw_packet(const u8* raw_data, size_t raw_si
         case DNSRecordType::AAAA:
             // Fall through
         case DNSRecordType::SRV:
+            // Fall through
+        case DNSRecordType::SOA:
+            // NOTE: The names at the start of an SOA record may be compressed, but we only care about the fixed size fields at its end.
             data = { record.data(), record.data_length() };
             break;
         default:
@@ -167,12 +171,18 @@ Optional<DNSPacket> DNSPacket::from_raw_packet(const u8* raw_data, size_t raw_si
             dbgln("data=(unimplemented record type {})", (u16)record.type());
         }
 
-        dbgln_if(LOOKUPSERVER_DEBUG, "Answer   #{}: name=_{}_, type={}, ttl={}, length={}, data=_{}_", i, name, record.type(), record.ttl(), record.data_length(), data);
+        dbgln_if(LOOKUPSERVER_DEBUG, "Record: name=_{}_, type={}, ttl={}, length={}, data=_{}_", name, record.type(), record.ttl(), record.data_length(), data);
         u16 class_code = record.record_class() & ~MDNS_CACHE_FLUSH;
         bool mdns_cache_flush = record.record_class() & MDNS_CACHE_FLUSH;
-        packet.m_answers.empend(name, (DNSRecordType)record.type(), (DNSRecordClass)class_code, record.ttl(), data, mdns_cache_flush);
         offset += record.data_length();
-    }
+        return DNSAnswer { name, (DNSRecordType)record.type(), (DNSRecordClass)class_code, record.ttl(), data, mdns_cache_flush };
+    };
+
+    for (u16 i = 0; i < header.answer_count(); ++i)
+        packet.m_answers.append(parse_record());
+
+    for (u16 i = 0; i < header.authority_count(); ++i)
+        packet.m_authorities.append(parse_record());
 
     return packet;
 }
@@ -43,6 +43,8 @@ public:
 
     const Vector<DNSQuestion>& questions() const { return m_questions; }
     const Vector<DNSAnswer>& answers() const { return m_answers; }
+    // NOTE: These are only parsed from responses, and never sent.
+    const Vector<DNSAnswer>& authorities() const { return m_authorities; }
 
     u16 question_count() const
     {
@@ -84,6 +86,7 @@ private:
     bool m_recursion_available { true };
     Vector<DNSQuestion> m_questions;
     Vector<DNSAnswer> m_answers;
+    Vector<DNSAnswer> m_authorities;
 };
 
 }
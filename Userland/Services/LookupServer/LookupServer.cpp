@@ -8,6 +8,7 @@
 #include "ClientConnection.h"
 #include "DNSPacket.h"
 #include <AK/Debug.h>
+#include <AK/Endian.h>
 #include <AK/HashMap.h>
 #include <AK/Random.h>
 #include <AK/String.h>
@@ -17,6 +18,7 @@
 #include <LibCore/LocalServer.h>
 #include <LibCore/UDPSocket.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -25,6 +27,9 @@ namespace LookupServer {
 static LookupServer* s_the;
 // NOTE: This is the TTL we return for the hostname or answers from /etc/hosts.
 static constexpr u32 s_static_ttl = 86400;
+// NOTE: This is how long we remember that none of the nameservers gave us a usable response, so that everyone who is
+//       waiting for the same name doesn't have to sit through all the retries again.
+static constexpr u32 s_server_failure_ttl = 5;
 
 LookupServer& LookupServer::the()
 {
@@ -41,6 +46,20 @@ LookupServer::LookupServer()
     dbgln("Using network config file at {}", config->filename());
     m_nameservers = config->read_entry("DNS", "Nameservers", "1.1.1.1,1.0.0.1").split(',');
 
+    auto cache_size = config->read_num_entry("DNS", "CacheSize", DNSCache::default_capacity);
+    if (cache_size < 0) {
+        dbgln("Invalid cache size {}, using the default", cache_size);
+        cache_size = DNSCache::default_capacity;
+    }
+    m_cache.set_capacity(cache_size);
+
+    // NOTE: Looking at the cache drops whatever has expired anyway, this is for when nobody asks us anything for a while.
+    m_cache_expiration_timer = Core::Timer::create_repeating(60 * 1000, [this] {
+        m_cache.remove_expired_entries();
+    },
+        this);
+    m_cache_expiration_timer->start();
+
     load_etc_hosts();
 
     auto maybe_file_watcher = Core::FileWatcher::create();
@@ -143,6 +162,24 @@ static String get_hostname()
     return buffer;
 }
 
+// RFC 2308, 5: A negative answer may be cached for as long as the SOA record that came with it says, which is the
+// smaller of the record's own TTL and its MINIMUM field.
+static Optional<u32> negative_answer_ttl(const DNSPacket& response)
+{
+    for (auto& record : response.authorities()) {
+        if (record.type() != DNSRecordType::SOA)
+            continue;
+        // MINIMUM is the last of the five 32-bit fields that follow the two names.
+        auto& data = record.record_data();
+        if (data.length() < 2 + 5 * sizeof(u32))
+            return {};
+        NetworkOrdered<u32> minimum;
+        memcpy(&minimum, data.characters() + data.length() - sizeof(u32), sizeof(u32));
+        return min(record.ttl(), static_cast<u32>(minimum));
+    }
+    return {};
+}
+
 Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record_type)
 {
     dbgln_if(LOOKUPSERVER_DEBUG, "Got request for '{}'", name.as_string());
@@ -180,24 +217,20 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
         return answers;
     }
 
-    // Third, try our cache.
-    if (auto cached_answers = m_lookup_cache.get(name); cached_answers.has_value()) {
-        for (auto& answer : cached_answers.value()) {
-            // TODO: Actually remove expired answers from the cache.
-            if (answer.type() == record_type && !answer.has_expired()) {
-                dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
-                add_answer(answer);
-            }
-        }
-        if (!answers.is_empty())
-            return answers;
+    // Third, try our cache. This may also tell us that there is no answer.
+    // NOTE: Lookups block the event loop, so clients asking for the same name at the same time are handled one after
+    //       the other, and everyone after the first one gets their answer from here.
+    if (auto cached_answers = m_cache.lookup(name, record_type); cached_answers.has_value()) {
+        for (auto& answer : cached_answers.value())
+            add_answer(answer);
+        return answers;
     }
 
     // Fourth, look up .local names using mDNS instead of DNS nameservers.
     if (name.as_string().ends_with(".local")) {
         answers = m_mdns->lookup(name, record_type);
-        for (auto& answer : answers)
-            put_in_cache(answer);
+        if (!answers.is_empty())
+            m_cache.put(name, record_type, answers);
         return answers;
     }
 
@@ -206,34 +239,52 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
         dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
         bool did_get_response = false;
         int retries = 3;
-        Vector<DNSAnswer> upstream_answers;
+        Optional<DNSPacket> response;
         do {
-            upstream_answers = lookup(name, nameserver, did_get_response, record_type);
+            response = lookup(name, nameserver, did_get_response, record_type);
             if (did_get_response)
                 break;
         } while (--retries);
-        if (!upstream_answers.is_empty()) {
-            for (auto& answer : upstream_answers)
-                add_answer(answer);
-            break;
-        } else {
+        if (!response.has_value()) {
             if (!did_get_response)
                 dbgln("Never got a response from '{}', trying next nameserver", nameserver);
             else
-                dbgln("Received response from '{}' but no result(s), trying next nameserver", nameserver);
+                dbgln("Received unusable response from '{}', trying next nameserver", nameserver);
+            continue;
         }
-    }
 
-    // Sixth, fail.
-    if (answers.is_empty()) {
-        dbgln("Tried all nameservers but never got a response :(");
+        Vector<DNSAnswer> upstream_answers;
+        for (auto& answer : response->answers()) {
+            if (answer.type() == record_type)
+                upstream_answers.append(answer);
+        }
+
+        if (!upstream_answers.is_empty()) {
+            m_cache.put(name, record_type, upstream_answers);
+            for (auto& answer : upstream_answers)
+                add_answer(answer);
+            return answers;
+        }
+
+        // The nameserver told us that there is no answer, which will be the same no matter who we ask.
+        // NOTE: If we were sent along a CNAME chain, it's the name at the end of it that doesn't exist, not the one we asked for.
+        auto negative_answer = response->code() == DNSPacket::Code::NXDOMAIN && response->answers().is_empty()
+            ? DNSCache::NegativeAnswer::NoSuchName
+            : DNSCache::NegativeAnswer::NoData;
+        if (auto ttl = negative_answer_ttl(response.value()); ttl.has_value())
+            m_cache.put_negative(name, record_type, negative_answer, ttl.value());
+        else
+            dbgln_if(LOOKUPSERVER_DEBUG, "Not caching negative answer for '{}' without an SOA record", name);
         return {};
     }
 
-    return answers;
+    // Sixth, fail.
+    dbgln("Tried all nameservers but never got a response :(");
+    m_cache.put_negative(name, record_type, DNSCache::NegativeAnswer::ServerFailure, s_server_failure_ttl);
+    return {};
 }
 
-Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, const String& nameserver, bool& did_get_response, DNSRecordType record_type, ShouldRandomizeCase should_randomize_case)
+Optional<DNSPacket> LookupServer::lookup(const DNSName& name, const String& nameserver, bool& did_get_response, DNSRecordType record_type, ShouldRandomizeCase should_randomize_case)
 {
     DNSPacket request;
     request.set_is_query();
@@ -290,6 +341,11 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, const String& namese
         return {};
     }
 
+    if (response.code() != DNSPacket::Code::NOERROR && response.code() != DNSPacket::Code::NXDOMAIN) {
+        dbgln("LookupServer: Response code {} :(", (u8)response.code());
+        return {};
+    }
+
     if (response.question_count() != request.question_count()) {
         dbgln("LookupServer: Question count ({} vs {}) :(", response.question_count(), request.question_count());
         return {};
@@ -310,52 +366,7 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, const String& namese
         }
     }
 
-    if (response.answer_count() < 1) {
-        dbgln("LookupServer: No answers :(");
-        return {};
-    }
-
-    Vector<DNSAnswer, 8> answers;
-    for (auto& answer : response.answers()) {
-        put_in_cache(answer);
-        if (answer.type() != record_type)
-            continue;
-        answers.append(answer);
-    }
-
-    return answers;
-}
-
-void LookupServer::put_in_cache(const DNSAnswer& answer)
-{
-    if (answer.has_expired())
-        return;
-
-    // Prevent the cache from growing too big.
-    // TODO: Evict least used entries.
-    if (m_lookup_cache.size() >= 256)
-        m_lookup_cache.remove(m_lookup_cache.begin());
-
-    auto it = m_lookup_cache.find(answer.name());
-    if (it == m_lookup_cache.end())
-        m_lookup_cache.set(answer.name(), { answer });
-    else {
-        if (answer.mdns_cache_flush()) {
-            auto now = time(nullptr);
-
-            it->value.remove_all_matching([&](DNSAnswer const& other_answer) {
-                if (other_answer.type() != answer.type() || other_answer.class_code() != answer.class_code())
-                    return false;
-
-                if (other_answer.received_time() >= now - 1)
-                    return false;
-
-                dbgln_if(LOOKUPSERVER_DEBUG, "Removing cache entry: {}", other_answer.name());
-                return true;
-            });
-        }
-        it->value.append(answer);
-    }
+    return response;
 }
 
 }
@@ -6,12 +6,14 @@
 
 #pragma once
 
+#include "DNSCache.h"
 #include "DNSName.h"
 #include "DNSPacket.h"
 #include "DNSServer.h"
 #include "MulticastDNS.h"
 #include <LibCore/FileWatcher.h>
 #include <LibCore/Object.h>
+#include <LibCore/Timer.h>
 
 namespace LookupServer {
 
@@ -24,13 +26,15 @@ public:
     static LookupServer& the();
     Vector<DNSAnswer> lookup(const DNSName& name, DNSRecordType record_type);
 
+    const DNSCache& cache() const { return m_cache; }
+
 private:
     LookupServer();
 
     void load_etc_hosts();
-    void put_in_cache(const DNSAnswer&);
 
-    Vector<DNSAnswer> lookup(const DNSName& hostname, const String& nameserver, bool& did_get_response, DNSRecordType record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
+    // Returns the response of the nameserver, if it either answered the question or told us that there is no answer.
+    Optional<DNSPacket> lookup(const DNSName& hostname, const String& nameserver, bool& did_get_response, DNSRecordType record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
 
     RefPtr<Core::LocalServer> m_local_server;
     RefPtr<DNSServer> m_dns_server;
@@ -38,7 +42,8 @@ private:
     Vector<String> m_nameservers;
     RefPtr<Core::FileWatcher> m_file_watcher;
     HashMap<DNSName, Vector<DNSAnswer>, DNSName::Traits> m_etc_hosts;
-    HashMap<DNSName, Vector<DNSAnswer>, DNSName::Traits> m_lookup_cache;
+    DNSCache m_cache;
+    RefPtr<Core::Timer> m_cache_expiration_timer;
 };
 
 }
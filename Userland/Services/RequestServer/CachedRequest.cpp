@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <RequestServer/CachedRequest.h>
+
+namespace RequestServer {
+
+CachedRequest::CachedRequest(ClientConnection& client, URL const& url, DiskCache::CachedResponse response)
+    : Request(client)
+    , m_response(move(response))
+{
+    set_url(url);
+}
+
+CachedRequest::~CachedRequest()
+{
+}
+
+NonnullOwnPtr<CachedRequest> CachedRequest::create(ClientConnection& client, URL const& url, DiskCache::CachedResponse response)
+{
+    return adopt_own(*new CachedRequest(client, url, move(response)));
+}
+
+void CachedRequest::start()
+{
+    auto size = m_response.body_size;
+    set_response_from_disk_cache(move(m_response));
+    did_progress(size, size);
+    did_finish(true);
+}
+
+}
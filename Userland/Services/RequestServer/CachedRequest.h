@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <RequestServer/DiskCache.h>
+#include <RequestServer/Request.h>
+
+namespace RequestServer {
+
+// A request that is answered from the disk cache without going to the network.
+class CachedRequest final : public Request {
+public:
+    virtual ~CachedRequest() override;
+    static NonnullOwnPtr<CachedRequest> create(ClientConnection&, URL const&, DiskCache::CachedResponse);
+
+    // NOTE: This finishes the request, which destroys it.
+    void start();
+
+private:
+    explicit CachedRequest(ClientConnection&, URL const&, DiskCache::CachedResponse);
+
+    DiskCache::CachedResponse m_response;
+};
+
+}
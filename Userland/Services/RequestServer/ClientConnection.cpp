@@ -5,7 +5,9 @@
  */
 
 #include <AK/Badge.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ClientConnection.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Protocol.h>
 #include <RequestServer/Request.h>
 #include <RequestServer/RequestClientEndpoint.h>
@@ -38,7 +40,7 @@ Messages::RequestServer::IsSupportedProtocolResponse ClientConnection::is_suppor
     return supported;
 }
 
-Messages::RequestServer::StartRequestResponse ClientConnection::start_request(String const& method, URL const& url, IPC::Dictionary const& request_headers, ByteBuffer const& request_body)
+Messages::RequestServer::StartRequestResponse ClientConnection::start_request(String const& method, URL const& url, IPC::Dictionary const& request_headers, IPC::ReadonlyBuffer const& request_body)
 {
     if (!url.is_valid()) {
         dbgln("StartRequest: Invalid URL requested: '{}'", url);
@@ -49,17 +51,66 @@ Messages::RequestServer::StartRequestResponse ClientConnection::start_request(St
         dbgln("StartRequest: No protocol handler for URL: '{}'", url);
         return { -1, Optional<IPC::File> {} };
     }
-    auto request = protocol->start_request(*this, method, url, request_headers.entries(), request_body);
+
+    auto headers = request_headers.entries();
+    auto disk_cache_mode = Request::DiskCacheMode::None;
+    Optional<DiskCache::CachedResponse> stale_response;
+    if (DiskCache::is_cacheable_request(method, url, headers)) {
+        auto& disk_cache = DiskCache::the();
+        switch (disk_cache.lookup(url)) {
+        case DiskCache::Lookup::Fresh:
+            if (auto cached_response = disk_cache.open(url); cached_response.has_value())
+                return start_cached_request(url, cached_response.release_value());
+            disk_cache_mode = Request::DiskCacheMode::Store;
+            break;
+        case DiskCache::Lookup::Stale:
+            // Open the stale response right away, so it can't disappear before the server tells us it's still good.
+            // If it's already gone, this is just a normal fetch.
+            stale_response = disk_cache.open(url);
+            if (stale_response.has_value()) {
+                disk_cache.add_revalidation_headers(url, headers);
+                disk_cache_mode = Request::DiskCacheMode::Revalidate;
+            } else {
+                disk_cache_mode = Request::DiskCacheMode::Store;
+            }
+            break;
+        case DiskCache::Lookup::Miss:
+            disk_cache_mode = Request::DiskCacheMode::Store;
+            break;
+        }
+    }
+
+    auto request = protocol->start_request(*this, method, url, headers, request_body.bytes());
     if (!request) {
         dbgln("StartRequest: Protocol handler failed to start request: '{}'", url);
         return { -1, Optional<IPC::File> {} };
     }
+    request->set_url(url);
+    request->set_disk_cache_mode(disk_cache_mode);
+    if (stale_response.has_value())
+        request->set_stale_response_from_disk_cache(stale_response.release_value());
     auto id = request->id();
     auto fd = request->request_fd();
     m_requests.set(id, move(request));
     return { id, IPC::File(fd, IPC::File::CloseAfterSending) };
 }
 
+Messages::RequestServer::StartRequestResponse ClientConnection::start_cached_request(URL const& url, DiskCache::CachedResponse cached_response)
+{
+    auto request = CachedRequest::create(*this, url, move(cached_response));
+    auto id = request->id();
+    m_requests.set(id, move(request));
+
+    // The client only learns about the request from our response, so anything we send before that would be dropped.
+    Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), id] {
+        if (auto* request = const_cast<Request*>(m_requests.get(id).value_or(nullptr)))
+            static_cast<CachedRequest&>(*request).start();
+    });
+
+    // NOTE: There is no response fd, the body is sent with cached_body_available() instead.
+    return { id, Optional<IPC::File> {} };
+}
+
 Messages::RequestServer::StopRequestResponse ClientConnection::stop_request(i32 request_id)
 {
     auto* request = const_cast<Request*>(m_requests.get(request_id).value_or(nullptr));
@@ -90,6 +141,11 @@ void ClientConnection::did_finish_request(Badge<Request>, Request& request, bool
     m_requests.remove(request.id());
 }
 
+void ClientConnection::did_load_body_from_disk_cache(Badge<Request>, Request& request, IPC::File const& body_file)
+{
+    async_cached_body_available(request.id(), IPC::File(body_file.fd()));
+}
+
 void ClientConnection::did_progress_request(Badge<Request>, Request& request)
 {
     async_request_progress(request.id(), request.total_size(), request.downloaded_size());
@@ -179,4 +235,26 @@ void ClientConnection::ensure_connection(URL const& url, ::RequestServer::CacheL
         dbgln("EnsureConnection: Invalid URL scheme: '{}'", url.scheme());
 }
 
+Messages::RequestServer::ConnectionCacheStatisticsResponse ClientConnection::connection_cache_statistics()
+{
+    u32 open_connections = 0;
+    u32 busy_connections = 0;
+    u32 queued_requests = 0;
+    auto count = [&](auto& cache) {
+        for (auto& it : cache) {
+            for (auto& connection : *it.value) {
+                ++open_connections;
+                if (connection.has_started)
+                    ++busy_connections;
+                queued_requests += connection.request_queue.size();
+            }
+        }
+    };
+    count(ConnectionCache::g_tcp_connection_cache);
+    count(ConnectionCache::g_tls_connection_cache);
+
+    auto& statistics = ConnectionCache::g_statistics;
+    return { open_connections, busy_connections, queued_requests, (u32)statistics.connections_created, (u32)statistics.connections_reused, (u32)statistics.connections_reaped };
+}
+
 }
@@ -8,6 +8,7 @@
 
 #include <AK/HashMap.h>
 #include <LibIPC/ClientConnection.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Forward.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #include <RequestServer/RequestServerEndpoint.h>
@@ -27,14 +28,18 @@ public:
     void did_receive_headers(Badge<Request>, Request&);
     void did_finish_request(Badge<Request>, Request&, bool success);
     void did_progress_request(Badge<Request>, Request&);
+    void did_load_body_from_disk_cache(Badge<Request>, Request&, IPC::File const& body_file);
     void did_request_certificates(Badge<Request>, Request&);
 
 private:
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(String const&) override;
-    virtual Messages::RequestServer::StartRequestResponse start_request(String const&, URL const&, IPC::Dictionary const&, ByteBuffer const&) override;
+    virtual Messages::RequestServer::StartRequestResponse start_request(String const&, URL const&, IPC::Dictionary const&, IPC::ReadonlyBuffer const&) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, String const&, String const&) override;
     virtual void ensure_connection(URL const& url, ::RequestServer::CacheLevel const& cache_level) override;
+    virtual Messages::RequestServer::ConnectionCacheStatisticsResponse connection_cache_statistics() override;
+
+    Messages::RequestServer::StartRequestResponse start_cached_request(URL const&, DiskCache::CachedResponse);
 
     HashMap<i32, OwnPtr<Request>> m_requests;
 };
@@ -11,6 +11,7 @@ namespace RequestServer::ConnectionCache {
 
 HashMap<ConnectionKey, NonnullOwnPtr<NonnullOwnPtrVector<Connection<Core::TCPSocket>>>> g_tcp_connection_cache {};
 HashMap<ConnectionKey, NonnullOwnPtr<NonnullOwnPtrVector<Connection<TLS::TLSv12>>>> g_tls_connection_cache {};
+Statistics g_statistics {};
 
 void request_did_finish(URL const& url, Core::Socket const* socket)
 {
@@ -43,23 +44,14 @@ void request_did_finish(URL const& url, Core::Socket const* socket)
                     dbgln("Removing no-longer-used connection {} (socket {})", ptr, ptr->socket);
                     auto did_remove = cache_entry.remove_first_matching([&](auto& entry) { return entry == ptr; });
                     VERIFY(did_remove);
+                    ++g_statistics.connections_reaped;
                     if (cache_entry.is_empty())
                         cache.remove(key);
                 });
             };
             connection->removal_timer->start();
         } else {
-            using SocketType = RemoveCVReference<decltype(*connection->socket)>;
-            bool is_connected;
-            if constexpr (IsSame<SocketType, TLS::TLSv12>)
-                is_connected = connection->socket->is_established();
-            else
-                is_connected = connection->socket->is_connected();
-            if (!is_connected) {
-                // Create another socket for the connection.
-                connection->socket = SocketType::construct(nullptr);
-                dbgln("Creating a new socket for {} -> {}", url, connection->socket);
-            }
+            recreate_socket_if_disconnected(*connection, url);
             dbgln("Running next job in queue for connection {} @{}", &connection, connection->socket);
             auto request = connection->request_queue.take_first();
             connection->timer.start();
@@ -78,6 +70,9 @@ void request_did_finish(URL const& url, Core::Socket const* socket)
 
 void dump_jobs()
 {
+    dbgln("=========== Connection Cache Statistics ==========");
+    dbgln(" Connections created: {}, reused: {}, reaped: {}", g_statistics.connections_created, g_statistics.connections_reused, g_statistics.connections_reaped);
+    dbgln(" Requests that had to queue: {}", g_statistics.requests_queued);
     dbgln("=========== TLS Connection Cache ==========");
     for (auto& connection : g_tls_connection_cache) {
         dbgln(" - {}:{}", connection.key.hostname, connection.key.port);
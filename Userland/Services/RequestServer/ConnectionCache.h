@@ -65,9 +65,37 @@ extern HashMap<ConnectionKey, NonnullOwnPtr<NonnullOwnPtrVector<Connection<TLS::
 void request_did_finish(URL const&, Core::Socket const*);
 void dump_jobs();
 
-constexpr static inline size_t MaxConcurrentConnectionsPerURL = 2;
+// Browsers settled on 6 connections per origin, which is enough to keep the pipe full without swamping the server.
+constexpr static inline size_t MaxConcurrentConnectionsPerURL = 6;
 constexpr static inline size_t ConnectionKeepAliveTimeMilliseconds = 10'000;
 
+struct Statistics {
+    size_t connections_created { 0 };
+    size_t connections_reused { 0 };
+    size_t connections_reaped { 0 };
+    size_t requests_queued { 0 };
+};
+
+extern Statistics g_statistics;
+
+template<typename ConnectionType>
+void recreate_socket_if_disconnected(ConnectionType& connection, URL const& url)
+{
+    using SocketType = typename ConnectionType::SocketType;
+    bool is_connected;
+    if constexpr (IsSame<SocketType, TLS::TLSv12>)
+        is_connected = connection.socket->is_established();
+    else
+        is_connected = connection.socket->is_connected();
+    if (!is_connected) {
+        // Create another socket for the connection.
+        connection.socket = SocketType::construct(nullptr);
+        dbgln("Creating a new socket for {} -> {}", url, connection.socket);
+    } else {
+        ++g_statistics.connections_reused;
+    }
+}
+
 decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job)
 {
     using CacheEntryType = RemoveCVReference<decltype(*cache.begin()->value)>;
@@ -75,7 +103,9 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job)
         job.start(socket);
     };
     auto& sockets_for_url = *cache.ensure({ url.host(), url.port_or_default() }, [] { return make<CacheEntryType>(); });
-    auto it = sockets_for_url.find_if([](auto& connection) { return connection->request_queue.is_empty(); });
+
+    // Prefer an idle connection, then a new one while we're below the limit, and only then queue up behind the least busy connection.
+    auto it = sockets_for_url.find_if([](auto& connection) { return !connection->has_started; });
     auto did_add_new_connection = false;
     if (it.is_end() && sockets_for_url.size() < ConnectionCache::MaxConcurrentConnectionsPerURL) {
         using ConnectionType = RemoveCVReference<decltype(cache.begin()->value->at(0))>;
@@ -84,6 +114,7 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job)
             typename ConnectionType::QueueType {},
             Core::Timer::create_single_shot(ConnectionKeepAliveTimeMilliseconds, nullptr)));
         did_add_new_connection = true;
+        ++g_statistics.connections_created;
     }
     size_t index;
     if (it.is_end()) {
@@ -106,6 +137,8 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job)
     auto& connection = sockets_for_url[index];
     if (!connection.has_started) {
         dbgln("Immediately start request for url {} in {} - {}", url, &connection, connection.socket);
+        if (!did_add_new_connection)
+            recreate_socket_if_disconnected(connection, url);
         connection.has_started = true;
         connection.removal_timer->stop();
         connection.timer.start();
@@ -113,6 +146,7 @@ decltype(auto) get_or_create_connection(auto& cache, URL const& url, auto& job)
         start_job(*connection.socket);
     } else {
         dbgln("Enqueue request for URL {} in {} - {}", url, &connection, connection.socket);
+        ++g_statistics.requests_queued;
         connection.request_queue.append(move(start_job));
     }
     return connection;
@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AllOf.h>
+#include <AK/CharacterTypes.h>
+#include <AK/Debug.h>
+#include <AK/GenericLexer.h>
+#include <AK/Hex.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/File.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/DiskCache.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace RequestServer {
+
+static constexpr i64 index_version = 1;
+
+DiskCache& DiskCache::the()
+{
+    static DiskCache s_the;
+    return s_the;
+}
+
+static i64 current_time()
+{
+    return time(nullptr);
+}
+
+// https://httpwg.org/specs/rfc7231.html#http.date
+// NOTE: We only understand the preferred IMF-fixdate format ("Sun, 06 Nov 1994 08:49:37 GMT").
+//       Anything else is treated as invalid, which makes the response stale, and that's always safe.
+static Optional<i64> parse_http_date(StringView const& string)
+{
+    GenericLexer lexer(string.trim_whitespace());
+
+    auto consume_number = [&](size_t digits) -> Optional<unsigned> {
+        auto number = lexer.consume(digits);
+        if (number.length() != digits)
+            return {};
+        return number.to_uint();
+    };
+
+    // NOTE: This also consumes the comma.
+    lexer.consume_until(',');
+    if (!lexer.consume_specific(' '))
+        return {};
+    auto day = consume_number(2);
+    if (!day.has_value() || !lexer.consume_specific(' '))
+        return {};
+
+    static constexpr StringView month_names[] = { "Jan"sv, "Feb"sv, "Mar"sv, "Apr"sv, "May"sv, "Jun"sv, "Jul"sv, "Aug"sv, "Sep"sv, "Oct"sv, "Nov"sv, "Dec"sv };
+    auto month_name = lexer.consume(3);
+    unsigned month = 0;
+    for (unsigned i = 0; i < 12; ++i) {
+        if (month_names[i] == month_name)
+            month = i + 1;
+    }
+    if (month == 0 || !lexer.consume_specific(' '))
+        return {};
+
+    auto year = consume_number(4);
+    if (!year.has_value() || !lexer.consume_specific(' '))
+        return {};
+    auto hours = consume_number(2);
+    if (!hours.has_value() || !lexer.consume_specific(':'))
+        return {};
+    auto minutes = consume_number(2);
+    if (!minutes.has_value() || !lexer.consume_specific(':'))
+        return {};
+    auto seconds = consume_number(2);
+    if (!seconds.has_value() || !lexer.consume_specific(" GMT"))
+        return {};
+
+    if (day.value() < 1 || day.value() > (unsigned)days_in_month(year.value(), month) || hours.value() > 23 || minutes.value() > 59 || seconds.value() > 60)
+        return {};
+
+    i64 days = years_to_days_since_epoch(year.value()) + day_of_year(year.value(), month, day.value());
+    return ((days * 24 + hours.value()) * 60 + minutes.value()) * 60 + seconds.value();
+}
+
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    Optional<i64> max_age;
+};
+
+// https://httpwg.org/specs/rfc7234.html#header.cache-control
+static CacheControl parse_cache_control(StringView const& value)
+{
+    CacheControl cache_control;
+    for (auto& directive : value.split_view(',')) {
+        auto name = directive;
+        StringView argument;
+        if (auto equals = directive.find('='); equals.has_value()) {
+            name = directive.substring_view(0, *equals);
+            argument = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+        }
+        name = name.trim_whitespace();
+
+        if (name.equals_ignoring_case("no-store"sv))
+            cache_control.no_store = true;
+        else if (name.equals_ignoring_case("no-cache"sv))
+            cache_control.no_cache = true;
+        else if (name.equals_ignoring_case("max-age"sv))
+            cache_control.max_age = argument.to_uint<u64>().value_or(0);
+    }
+    return cache_control;
+}
+
+static Optional<StringView> header_value(HashMap<String, String, CaseInsensitiveStringTraits> const& headers, StringView const& name)
+{
+    auto it = headers.find(name);
+    if (it == headers.end())
+        return {};
+    return it->value.view();
+}
+
+// https://httpwg.org/specs/rfc7231.html#status.codes (the ones that are "cacheable by default")
+static bool is_cacheable_status_code(u32 status_code)
+{
+    switch (status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 300:
+    case 301:
+    case 308:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// https://httpwg.org/specs/rfc7234.html#calculating.freshness.lifetime
+static i64 freshness_lifetime(u32 status_code, HashMap<String, String, CaseInsensitiveStringTraits> const& headers, i64 response_time)
+{
+    auto cache_control = parse_cache_control(header_value(headers, "Cache-Control"sv).value_or({}));
+    if (cache_control.no_cache)
+        return 0;
+    if (cache_control.max_age.has_value())
+        return cache_control.max_age.value();
+
+    auto date = parse_http_date(header_value(headers, "Date"sv).value_or({})).value_or(response_time);
+    if (auto expires = header_value(headers, "Expires"sv); expires.has_value())
+        return max(parse_http_date(*expires).value_or(0) - date, (i64)0);
+
+    // https://httpwg.org/specs/rfc7234.html#heuristic.freshness
+    // Like other browsers, we use 10% of the time since the document was last modified.
+    if (status_code == 200 || status_code == 203) {
+        if (auto last_modified = parse_http_date(header_value(headers, "Last-Modified"sv).value_or({})); last_modified.has_value() && *last_modified < date)
+            return (date - *last_modified) / 10;
+    }
+    return 0;
+}
+
+// https://httpwg.org/specs/rfc7234.html#age.calculations
+bool DiskCache::Entry::is_fresh(i64 now) const
+{
+    auto current_age = max(now - response_time, (i64)0) + age_at_response_time;
+    return freshness_lifetime > current_age;
+}
+
+bool DiskCache::Entry::can_be_revalidated() const
+{
+    return response_headers.contains("ETag"sv) || response_headers.contains("Last-Modified"sv);
+}
+
+void DiskCache::initialize(String directory, size_t max_size)
+{
+    if (mkdir(directory.characters(), 0700) < 0 && errno != EEXIST) {
+        dbgln("DiskCache: Failed to create {}: {}", directory, strerror(errno));
+        return;
+    }
+    m_directory = move(directory);
+    m_max_size = max_size;
+    m_enabled = true;
+    m_entries.clear();
+    m_body_reference_counts.clear();
+    m_total_size = 0;
+    load_index();
+    collect_orphaned_bodies();
+    evict_if_needed();
+}
+
+bool DiskCache::is_cacheable_request(String const& method, URL const& url, HashMap<String, String> const& request_headers)
+{
+    if (!method.equals_ignoring_case("GET"sv))
+        return false;
+    if (!url.protocol().is_one_of("http", "https"))
+        return false;
+
+    for (auto& it : request_headers) {
+        // These would make the response depend on more than the URL, and we don't keep track of that.
+        if (it.key.equals_ignoring_case("Authorization"sv) || it.key.equals_ignoring_case("Range"sv) || it.key.equals_ignoring_case("If-None-Match"sv) || it.key.equals_ignoring_case("If-Modified-Since"sv))
+            return false;
+        if (it.key.equals_ignoring_case("Cache-Control"sv) && parse_cache_control(it.value).no_store)
+            return false;
+    }
+    return true;
+}
+
+String DiskCache::key_for_url(URL const& url)
+{
+    // The fragment is never sent to the server, so it can't change the response.
+    auto url_without_fragment = url;
+    url_without_fragment.set_fragment({});
+    return url_without_fragment.to_string();
+}
+
+String DiskCache::path_for_body(String const& body_hash) const
+{
+    return String::formatted("{}/{}", m_directory, body_hash);
+}
+
+DiskCache::Lookup DiskCache::lookup(URL const& url)
+{
+    if (!m_enabled)
+        return Lookup::Miss;
+    auto it = m_entries.find(key_for_url(url));
+    if (it == m_entries.end())
+        return Lookup::Miss;
+    return it->value.is_fresh(current_time()) ? Lookup::Fresh : Lookup::Stale;
+}
+
+Optional<IPC::File> DiskCache::open_body(Entry const& entry)
+{
+    auto path = path_for_body(entry.body_hash);
+    int fd = ::open(path.characters(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        dbgln("DiskCache: Failed to open body {}: {}", entry.body_hash, strerror(errno));
+        return {};
+    }
+    IPC::File file(fd, IPC::File::CloseAfterSending);
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size != entry.body_size)
+        return {};
+    return file;
+}
+
+void DiskCache::did_access(Entry& entry)
+{
+    entry.last_access_time = current_time();
+    entry.access_order = ++m_next_access_order;
+}
+
+Optional<DiskCache::CachedResponse> DiskCache::open(URL const& url)
+{
+    if (!m_enabled)
+        return {};
+    auto key = key_for_url(url);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return {};
+
+    auto& entry = it->value;
+    auto body_file = open_body(entry);
+    if (!body_file.has_value()) {
+        remove_entry(key);
+        return {};
+    }
+
+    did_access(entry);
+    schedule_index_flush();
+    return CachedResponse { entry.status_code, entry.response_headers, body_file.release_value(), entry.body_size };
+}
+
+void DiskCache::add_revalidation_headers(URL const& url, HashMap<String, String>& request_headers) const
+{
+    auto it = m_entries.find(key_for_url(url));
+    if (it == m_entries.end())
+        return;
+
+    // https://httpwg.org/specs/rfc7234.html#validation.sent
+    if (auto etag = header_value(it->value.response_headers, "ETag"sv); etag.has_value())
+        request_headers.set("If-None-Match", *etag);
+    if (auto last_modified = header_value(it->value.response_headers, "Last-Modified"sv); last_modified.has_value())
+        request_headers.set("If-Modified-Since", *last_modified);
+}
+
+// https://httpwg.org/specs/rfc7234.html#freshening.responses
+void DiskCache::did_revalidate(URL const& url, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, CachedResponse& stale_response)
+{
+    auto update_headers = [&](auto& headers) {
+        for (auto& header : response_headers) {
+            // The 304 doesn't describe the body, so don't let it overwrite the headers that do.
+            if (header.key.equals_ignoring_case("Content-Length"sv) || header.key.equals_ignoring_case("Content-Encoding"sv) || header.key.equals_ignoring_case("Transfer-Encoding"sv))
+                continue;
+            headers.set(header.key, header.value);
+        }
+    };
+    update_headers(stale_response.response_headers);
+
+    // NOTE: The entry may have been evicted or replaced while we were waiting for the server,
+    //       the response we opened before asking is still good to hand out though.
+    auto it = m_entries.find(key_for_url(url));
+    if (it == m_entries.end())
+        return;
+
+    auto& entry = it->value;
+    update_headers(entry.response_headers);
+    entry.response_time = current_time();
+    entry.age_at_response_time = header_value(response_headers, "Age"sv).value_or({}).to_uint<u64>().value_or(0);
+    entry.freshness_lifetime = freshness_lifetime(entry.status_code, entry.response_headers, entry.response_time);
+    did_access(entry);
+    schedule_index_flush();
+
+    dbgln_if(CACHE_DEBUG, "DiskCache: Revalidated {}, fresh for {}s", url, entry.freshness_lifetime);
+}
+
+void DiskCache::store(URL const& url, u32 status_code, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, ReadonlyBytes body)
+{
+    if (!m_enabled)
+        return;
+
+    // https://httpwg.org/specs/rfc7234.html#response.cacheability
+    // NOTE: Whatever we had stored for this URL is outdated now, even if we can't store the new response.
+    auto cache_control = parse_cache_control(header_value(response_headers, "Cache-Control"sv).value_or({}));
+    // FIXME: Support Vary by keeping the selecting request headers around.
+    if (!is_cacheable_status_code(status_code) || cache_control.no_store || response_headers.contains("Vary"sv) || body.is_empty() || body.size() > max_entry_size()) {
+        remove(url);
+        return;
+    }
+
+    auto key = key_for_url(url);
+    auto now = current_time();
+    Entry entry;
+    entry.status_code = status_code;
+    entry.response_headers = response_headers;
+    entry.response_time = now;
+    entry.age_at_response_time = header_value(response_headers, "Age"sv).value_or({}).to_uint<u64>().value_or(0);
+    entry.freshness_lifetime = freshness_lifetime(status_code, response_headers, now);
+    did_access(entry);
+
+    // There is no point in keeping a response that can never be reused without downloading it again.
+    if (entry.freshness_lifetime == 0 && !entry.can_be_revalidated()) {
+        remove(url);
+        return;
+    }
+
+    auto digest = Crypto::Hash::SHA256::hash(body.data(), body.size());
+    entry.body_hash = encode_hex({ digest.immutable_data(), digest.data_length() });
+    entry.body_size = body.size();
+
+    if (!m_body_reference_counts.contains(entry.body_hash)) {
+        // Write to a temporary file first, so a crash never leaves a truncated body under its final name.
+        auto path = path_for_body(entry.body_hash);
+        auto temporary_path = String::formatted("{}.tmp", path);
+        auto file_or_error = Core::File::open(temporary_path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate, 0600);
+        if (file_or_error.is_error()) {
+            dbgln("DiskCache: Failed to create {}: {}", temporary_path, file_or_error.error());
+            return;
+        }
+        auto file = file_or_error.release_value();
+        if (!file->write(body.data(), body.size()) || !file->close() || rename(temporary_path.characters(), path.characters()) < 0) {
+            dbgln("DiskCache: Failed to write {}", path);
+            unlink(temporary_path.characters());
+            return;
+        }
+        m_total_size += body.size();
+    }
+
+    // NOTE: Take the new reference before dropping the old entry, which may well refer to the same body.
+    m_body_reference_counts.ensure(entry.body_hash, [] { return 0; })++;
+    if (m_entries.contains(key))
+        remove_entry(key);
+    dbgln_if(CACHE_DEBUG, "DiskCache: Stored {} ({} bytes), fresh for {}s", url, entry.body_size, entry.freshness_lifetime);
+    m_entries.set(key, move(entry));
+
+    evict_if_needed();
+    schedule_index_flush();
+}
+
+void DiskCache::remove(URL const& url)
+{
+    auto key = key_for_url(url);
+    if (!m_entries.contains(key))
+        return;
+    remove_entry(key);
+    schedule_index_flush();
+}
+
+void DiskCache::remove_entry(String const& key)
+{
+    auto it = m_entries.find(key);
+    VERIFY(it != m_entries.end());
+    auto body_hash = it->value.body_hash;
+    m_entries.remove(it);
+    release_body(body_hash);
+}
+
+void DiskCache::release_body(String const& body_hash)
+{
+    auto it = m_body_reference_counts.find(body_hash);
+    if (it == m_body_reference_counts.end())
+        return;
+    if (--it->value > 0)
+        return;
+    m_body_reference_counts.remove(it);
+
+    auto path = path_for_body(body_hash);
+    struct stat st;
+    if (stat(path.characters(), &st) == 0)
+        m_total_size -= min(m_total_size, (size_t)st.st_size);
+    // NOTE: Clients that still have the body open keep reading it just fine, the file only goes away once they're done.
+    unlink(path.characters());
+}
+
+void DiskCache::evict_if_needed()
+{
+    while (m_total_size > m_max_size && !m_entries.is_empty()) {
+        auto least_recently_used = m_entries.begin();
+        auto is_less_recently_used = [](Entry const& a, Entry const& b) {
+            if (a.last_access_time != b.last_access_time)
+                return a.last_access_time < b.last_access_time;
+            return a.access_order < b.access_order;
+        };
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (is_less_recently_used(it->value, least_recently_used->value))
+                least_recently_used = it;
+        }
+        dbgln_if(CACHE_DEBUG, "DiskCache: Evicting {}", least_recently_used->key);
+        remove_entry(least_recently_used->key);
+    }
+}
+
+static bool is_valid_body_hash(String const& body_hash)
+{
+    // Body hashes end up in paths, so anything but the hex encoding of a SHA-256 digest must not get through.
+    if (body_hash.length() != Crypto::Hash::SHA256::DigestSize * 2)
+        return false;
+    for (auto ch : body_hash.view()) {
+        if (!is_ascii_digit(ch) && !(ch >= 'a' && ch <= 'f'))
+            return false;
+    }
+    return true;
+}
+
+void DiskCache::load_index()
+{
+    auto file_or_error = Core::File::open(String::formatted("{}/index.json", m_directory), Core::OpenMode::ReadOnly);
+    if (file_or_error.is_error())
+        return;
+    auto json = JsonValue::from_string(file_or_error.value()->read_all());
+    if (!json.has_value() || !json->is_object() || json->as_object().get("version").to_i64() != index_version || !json->as_object().get("entries").is_array()) {
+        dbgln("DiskCache: Ignoring unreadable index in {}", m_directory);
+        return;
+    }
+
+    auto is_valid_entry = [](JsonValue const& value) {
+        if (!value.is_object())
+            return false;
+        auto& object = value.as_object();
+        if (!object.get("url").is_string() || !object.get("body_hash").is_string() || !object.get("response_headers").is_object())
+            return false;
+        for (auto name : { "body_size"sv, "status_code"sv, "response_time"sv, "age_at_response_time"sv, "freshness_lifetime"sv, "last_access_time"sv }) {
+            if (!object.get(name).is_number())
+                return false;
+        }
+        bool has_valid_headers = true;
+        object.get("response_headers").as_object().for_each_member([&](auto&, auto& header_value) {
+            if (!header_value.is_string())
+                has_valid_headers = false;
+        });
+        return has_valid_headers && is_valid_body_hash(object.get("body_hash").as_string());
+    };
+
+    // If any part of the index is malformed, none of it can be trusted.
+    auto& entries = json->as_object().get("entries").as_array();
+    if (!all_of(entries.values(), is_valid_entry)) {
+        dbgln("DiskCache: Ignoring malformed index in {}", m_directory);
+        return;
+    }
+
+    for (auto& value : entries.values()) {
+        auto& object = value.as_object();
+        Entry entry;
+        entry.body_hash = object.get("body_hash").as_string();
+        entry.body_size = object.get("body_size").to_u64();
+        entry.status_code = object.get("status_code").to_u32();
+        entry.response_time = object.get("response_time").to_i64();
+        entry.age_at_response_time = object.get("age_at_response_time").to_i64();
+        entry.freshness_lifetime = object.get("freshness_lifetime").to_i64();
+        entry.last_access_time = object.get("last_access_time").to_i64();
+        object.get("response_headers").as_object().for_each_member([&](auto& name, auto& header_value) {
+            entry.response_headers.set(name, header_value.as_string());
+        });
+
+        auto path = path_for_body(entry.body_hash);
+        struct stat st;
+        if (stat(path.characters(), &st) < 0 || (size_t)st.st_size != entry.body_size)
+            continue;
+
+        if (m_body_reference_counts.ensure(entry.body_hash, [] { return 0; })++ == 0)
+            m_total_size += entry.body_size;
+        m_entries.set(object.get("url").as_string(), move(entry));
+    }
+
+    dbgln_if(CACHE_DEBUG, "DiskCache: Loaded {} entries ({} bytes) from {}", m_entries.size(), m_total_size, m_directory);
+}
+
+// Bodies are written before the index that refers to them, so a crash in between leaves them behind.
+// Nothing would ever count them towards the size limit or delete them, so we do that here.
+void DiskCache::collect_orphaned_bodies()
+{
+    Core::DirIterator iterator(m_directory, Core::DirIterator::SkipDots);
+    if (iterator.has_error()) {
+        dbgln("DiskCache: Failed to list {}: {}", m_directory, iterator.error_string());
+        return;
+    }
+
+    while (iterator.has_next()) {
+        auto name = iterator.next_path();
+        auto body_hash = name;
+        if (name.ends_with(".tmp"sv))
+            body_hash = name.substring(0, name.length() - 4);
+        // Leave anything that isn't ours alone, the index included.
+        if (!is_valid_body_hash(body_hash))
+            continue;
+        if (body_hash == name && m_body_reference_counts.contains(body_hash))
+            continue;
+
+        dbgln_if(CACHE_DEBUG, "DiskCache: Deleting orphaned {}", name);
+        if (unlink(String::formatted("{}/{}", m_directory, name).characters()) < 0)
+            dbgln("DiskCache: Failed to delete orphaned {}: {}", name, strerror(errno));
+    }
+}
+
+void DiskCache::schedule_index_flush()
+{
+    // Many responses tend to arrive together, so we coalesce the writes.
+    if (!m_index_flush_timer) {
+        m_index_flush_timer = Core::Timer::create_single_shot(1000, [this] {
+            flush_index();
+        });
+    }
+    if (!m_index_flush_timer->is_active())
+        m_index_flush_timer->start();
+}
+
+void DiskCache::flush_index()
+{
+    JsonArray entries;
+    for (auto& it : m_entries) {
+        auto& entry = it.value;
+        JsonObject response_headers;
+        for (auto& header : entry.response_headers)
+            response_headers.set(header.key, header.value);
+
+        JsonObject object;
+        object.set("url", it.key);
+        object.set("body_hash", entry.body_hash);
+        object.set("body_size", (u64)entry.body_size);
+        object.set("status_code", entry.status_code);
+        object.set("response_time", entry.response_time);
+        object.set("age_at_response_time", entry.age_at_response_time);
+        object.set("freshness_lifetime", entry.freshness_lifetime);
+        object.set("last_access_time", entry.last_access_time);
+        object.set("response_headers", move(response_headers));
+        entries.append(move(object));
+    }
+
+    JsonObject index;
+    index.set("version", index_version);
+    index.set("entries", move(entries));
+
+    auto path = String::formatted("{}/index.json", m_directory);
+    auto temporary_path = String::formatted("{}.tmp", path);
+    auto file_or_error = Core::File::open(temporary_path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate, 0600);
+    if (file_or_error.is_error()) {
+        dbgln("DiskCache: Failed to write index: {}", file_or_error.error());
+        return;
+    }
+    if (!file_or_error.value()->write(index.to_string()) || !file_or_error.value()->close() || rename(temporary_path.characters(), path.characters()) < 0)
+        dbgln("DiskCache: Failed to write index to {}", path);
+}
+
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Stream.h>
+#include <AK/String.h>
+#include <AK/URL.h>
+#include <LibCore/Timer.h>
+#include <LibIPC/File.h>
+
+namespace RequestServer {
+
+// A private HTTP cache (RFC 7234) that outlives the WebContent processes using it.
+// Response bodies are stored content-addressed (named by their SHA-256), next to an index that
+// maps URLs to the bodies along with everything we need to decide whether they are still fresh.
+class DiskCache {
+public:
+    static DiskCache& the();
+
+    struct Entry {
+        String body_hash;
+        size_t body_size { 0 };
+        u32 status_code { 0 };
+        HashMap<String, String, CaseInsensitiveStringTraits> response_headers;
+
+        // When we received the response, or last revalidated it.
+        i64 response_time { 0 };
+        // The value of the Age header when we did.
+        i64 age_at_response_time { 0 };
+        i64 freshness_lifetime { 0 };
+        i64 last_access_time { 0 };
+        // Breaks ties between entries that were accessed within the same second. Not part of the index.
+        u64 access_order { 0 };
+
+        bool is_fresh(i64 now) const;
+        bool can_be_revalidated() const;
+    };
+
+    struct CachedResponse {
+        u32 status_code { 0 };
+        HashMap<String, String, CaseInsensitiveStringTraits> response_headers;
+        // A read-only fd of the body file, which the client maps itself.
+        // NOTE: Body files are never written to once they have their final name (see store()), so sharing them is safe.
+        IPC::File body_file;
+        size_t body_size { 0 };
+    };
+
+    enum class Lookup {
+        Miss,
+        Fresh,
+        Stale,
+    };
+
+    // Must be called before unveil(), since it has to create the cache directory.
+    void initialize(String directory, size_t max_size = default_max_size);
+    bool is_enabled() const { return m_enabled; }
+    String const& directory() const { return m_directory; }
+
+    static bool is_cacheable_request(String const& method, URL const&, HashMap<String, String> const& request_headers);
+
+    Lookup lookup(URL const&);
+    Optional<CachedResponse> open(URL const&);
+
+    // Adds If-None-Match and If-Modified-Since headers for the stale entry of this URL.
+    void add_revalidation_headers(URL const&, HashMap<String, String>& request_headers) const;
+
+    // Updates the entry (if it's still around) and the stale response we opened for it with the headers of a 304 response.
+    void did_revalidate(URL const&, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, CachedResponse&);
+
+    void store(URL const&, u32 status_code, HashMap<String, String, CaseInsensitiveStringTraits> const& response_headers, ReadonlyBytes body);
+    void remove(URL const&);
+
+    size_t max_entry_size() const { return m_max_size / 8; }
+
+    static constexpr size_t default_max_size = 64 * MiB;
+
+private:
+    DiskCache() = default;
+
+    static String key_for_url(URL const&);
+    String path_for_body(String const& body_hash) const;
+
+    Optional<IPC::File> open_body(Entry const&);
+    void did_access(Entry&);
+    void remove_entry(String const& key);
+    void release_body(String const& body_hash);
+    void evict_if_needed();
+
+    void load_index();
+    void collect_orphaned_bodies();
+    void schedule_index_flush();
+    void flush_index();
+
+    String m_directory;
+    size_t m_max_size { default_max_size };
+    size_t m_total_size { 0 };
+    bool m_enabled { false };
+
+    HashMap<String, Entry> m_entries;
+    // How many entries share a body. Identical bodies (think of the same library served from two URLs) are only stored once.
+    HashMap<String, size_t> m_body_reference_counts;
+    u64 m_next_access_order { 0 };
+
+    RefPtr<Core::Timer> m_index_flush_timer;
+};
+
+// Forwards everything written to it to another stream, and keeps a copy of it for the disk cache.
+class DiskCacheRecordingStream final : public OutputStream {
+public:
+    explicit DiskCacheRecordingStream(OutputStream& stream)
+        : m_stream(stream)
+    {
+    }
+
+    void start_recording(size_t max_size)
+    {
+        m_max_size = max_size;
+        m_is_recording = true;
+    }
+
+    bool has_complete_recording() const { return m_is_recording && !m_did_overflow; }
+    ReadonlyBytes recording() const { return m_recording.bytes(); }
+
+    virtual size_t write(ReadonlyBytes bytes) override
+    {
+        auto nwritten = m_stream.write(bytes);
+        record(bytes.trim(nwritten));
+        return nwritten;
+    }
+
+    virtual bool write_or_error(ReadonlyBytes bytes) override
+    {
+        if (!m_stream.write_or_error(bytes))
+            return false;
+        record(bytes);
+        return true;
+    }
+
+private:
+    void record(ReadonlyBytes bytes)
+    {
+        if (!m_is_recording || m_did_overflow)
+            return;
+        if (m_recording.size() + bytes.size() > m_max_size || !m_recording.try_append(bytes.data(), bytes.size())) {
+            m_did_overflow = true;
+            m_recording.clear();
+        }
+    }
+
+    OutputStream& m_stream;
+    ByteBuffer m_recording;
+    size_t m_max_size { 0 };
+    bool m_is_recording { false };
+    bool m_did_overflow { false };
+};
+
+}
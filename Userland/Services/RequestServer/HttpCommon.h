@@ -16,6 +16,7 @@
 #include <LibHTTP/HttpRequest.h>
 #include <RequestServer/ClientConnection.h>
 #include <RequestServer/ConnectionCache.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Request.h>
 
 namespace RequestServer::Detail {
@@ -81,8 +82,12 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ClientConnection& clie
 
     auto output_stream = make<OutputFileStream>(pipe_result.value().write_fd);
     output_stream->make_unbuffered();
-    auto job = TJob::construct(request, *output_stream);
+    // NOTE: This only starts recording once the client connection decides that the response should go into the disk cache.
+    auto recording_stream = make<DiskCacheRecordingStream>(*output_stream);
+    auto job = TJob::construct(request, *recording_stream);
+    job->set_output_stream_fd(pipe_result.value().write_fd);
     auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, move(output_stream));
+    protocol_request->set_disk_cache_recording_stream(move(recording_stream));
     protocol_request->set_request_fd(pipe_result.value().read_fd);
 
     if constexpr (IsSame<typename TBadgedProtocol::Type, HttpsProtocol>)
@@ -19,6 +19,12 @@ Request::Request(ClientConnection& client, NonnullOwnPtr<OutputFileStream>&& out
 {
 }
 
+Request::Request(ClientConnection& client)
+    : m_client(client)
+    , m_id(s_next_id++)
+{
+}
+
 Request::~Request()
 {
 }
@@ -30,16 +36,56 @@ void Request::stop()
 
 void Request::set_response_headers(const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers)
 {
+    if (m_disk_cache_mode == DiskCacheMode::Revalidate && m_status_code == 304u) {
+        // The server says that our copy is still good, so the client gets that instead of the 304.
+        if (m_body_from_disk_cache.has_value())
+            return;
+        if (m_stale_response_from_disk_cache.has_value()) {
+            auto stale_response = m_stale_response_from_disk_cache.release_value();
+            DiskCache::the().did_revalidate(m_url, response_headers, stale_response);
+            set_response_from_disk_cache(move(stale_response));
+            return;
+        }
+    }
+
     m_response_headers = response_headers;
     m_client.did_receive_headers({}, *this);
 }
 
+void Request::set_response_from_disk_cache(DiskCache::CachedResponse cached_response)
+{
+    m_status_code = cached_response.status_code;
+    m_response_headers = move(cached_response.response_headers);
+    m_total_size = cached_response.body_size;
+    m_body_from_disk_cache = move(cached_response.body_file);
+    m_body_from_disk_cache_size = cached_response.body_size;
+    m_client.did_receive_headers({}, *this);
+}
+
+void Request::set_disk_cache_mode(DiskCacheMode mode)
+{
+    m_disk_cache_mode = mode;
+    if (mode != DiskCacheMode::None && m_disk_cache_recording_stream)
+        m_disk_cache_recording_stream->start_recording(DiskCache::the().max_entry_size());
+}
+
 void Request::set_certificate(String, String)
 {
 }
 
 void Request::did_finish(bool success)
 {
+    if (m_body_from_disk_cache.has_value()) {
+        m_downloaded_size = m_body_from_disk_cache_size;
+        m_total_size = m_downloaded_size;
+        m_client.did_load_body_from_disk_cache({}, *this, *m_body_from_disk_cache);
+        m_client.did_finish_request({}, *this, true);
+        return;
+    }
+
+    if (success && m_disk_cache_mode != DiskCacheMode::None && m_status_code.has_value() && m_disk_cache_recording_stream && m_disk_cache_recording_stream->has_complete_recording())
+        DiskCache::the().store(m_url, m_status_code.value(), m_response_headers, m_disk_cache_recording_stream->recording());
+
     m_client.did_finish_request({}, *this, success);
 }
 
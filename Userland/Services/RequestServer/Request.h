@@ -12,6 +12,7 @@
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
 #include <AK/URL.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Forward.h>
 
 namespace RequestServer {
@@ -22,6 +23,7 @@ public:
 
     i32 id() const { return m_id; }
     URL url() const { return m_url; }
+    void set_url(URL url) { m_url = move(url); }
 
     Optional<u32> status_code() const { return m_status_code; }
     Optional<u32> total_size() const { return m_total_size; }
@@ -41,10 +43,30 @@ public:
     void did_request_certificates();
     void set_response_headers(const HashMap<String, String, CaseInsensitiveStringTraits>&);
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
-    const OutputFileStream& output_stream() const { return *m_output_stream; }
+    const OutputFileStream& output_stream() const
+    {
+        VERIFY(m_output_stream);
+        return *m_output_stream;
+    }
+
+    enum class DiskCacheMode {
+        None,
+        // The response should go into the disk cache.
+        Store,
+        // We asked the server whether the stale response in the disk cache is still good.
+        Revalidate,
+    };
+    DiskCacheMode disk_cache_mode() const { return m_disk_cache_mode; }
+    void set_disk_cache_mode(DiskCacheMode);
+    void set_stale_response_from_disk_cache(DiskCache::CachedResponse response) { m_stale_response_from_disk_cache = move(response); }
+    void set_disk_cache_recording_stream(NonnullOwnPtr<DiskCacheRecordingStream>&& stream) { m_disk_cache_recording_stream = move(stream); }
 
 protected:
     explicit Request(ClientConnection&, NonnullOwnPtr<OutputFileStream>&&);
+    // For requests that are answered without a body stream.
+    explicit Request(ClientConnection&);
+
+    void set_response_from_disk_cache(DiskCache::CachedResponse);
 
 private:
     ClientConnection& m_client;
@@ -54,8 +76,15 @@ private:
     Optional<u32> m_status_code;
     Optional<u32> m_total_size {};
     size_t m_downloaded_size { 0 };
-    NonnullOwnPtr<OutputFileStream> m_output_stream;
+    OwnPtr<OutputFileStream> m_output_stream;
     HashMap<String, String, CaseInsensitiveStringTraits> m_response_headers;
+    DiskCacheMode m_disk_cache_mode { DiskCacheMode::None };
+    // Must be destroyed before the output stream it writes to.
+    OwnPtr<DiskCacheRecordingStream> m_disk_cache_recording_stream;
+    Optional<IPC::File> m_body_from_disk_cache;
+    size_t m_body_from_disk_cache_size { 0 };
+    // What we're revalidating, in DiskCacheMode::Revalidate.
+    Optional<DiskCache::CachedResponse> m_stale_response_from_disk_cache;
 };
 
 }
@@ -7,10 +7,13 @@
 #include <AK/Debug.h>
 #include <AK/OwnPtr.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/StandardPaths.h>
 #include <LibIPC/ClientConnection.h>
 #include <LibTLS/Certificate.h>
 #include <RequestServer/ClientConnection.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/GeminiProtocol.h>
 #include <RequestServer/HttpProtocol.h>
 #include <RequestServer/HttpsProtocol.h>
@@ -18,7 +21,7 @@
 
 int main(int, char**)
 {
-    if (pledge("stdio inet accept unix rpath sendfd recvfd sigaction", nullptr) < 0) {
+    if (pledge("stdio inet accept unix rpath wpath cpath sendfd recvfd sigaction", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -28,9 +31,14 @@ int main(int, char**)
     // Ensure the certificates are read out here.
     [[maybe_unused]] auto& certs = DefaultRootCACertificates::the();
 
+    auto cache_directory = String::formatted("{}/.cache/RequestServer", Core::StandardPaths::home_directory());
+    if (!Core::File::ensure_parent_directories(cache_directory))
+        dbgln("Failed to create the parent directories of {}", cache_directory);
+    RequestServer::DiskCache::the().initialize(cache_directory);
+
     Core::EventLoop event_loop;
     // FIXME: Establish a connection to LookupServer and then drop "unix"?
-    if (pledge("stdio inet accept unix sendfd recvfd", nullptr) < 0) {
+    if (pledge("stdio inet accept unix rpath wpath cpath sendfd recvfd", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -38,6 +46,10 @@ int main(int, char**)
         perror("unveil");
         return 1;
     }
+    if (RequestServer::DiskCache::the().is_enabled() && unveil(cache_directory.characters(), "rwc") < 0) {
+        perror("unveil");
+        return 1;
+    }
     if (unveil(nullptr, nullptr) < 0) {
         perror("unveil");
         return 1;
@@ -17,6 +17,7 @@ namespace WebContent {
 ConsoleGlobalObject::ConsoleGlobalObject(Web::Bindings::WindowObject& parent_object)
     : m_window_object(&parent_object)
 {
+    m_has_cacheable_property_lookups = false;
 }
 
 ConsoleGlobalObject::~ConsoleGlobalObject()
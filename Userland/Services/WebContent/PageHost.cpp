@@ -49,6 +49,8 @@ Gfx::Palette PageHost::palette() const
 void PageHost::set_palette_impl(const Gfx::PaletteImpl& impl)
 {
     m_palette_impl = impl;
+    if (auto* layout_root = this->layout_root())
+        layout_root->invalidate_display_lists();
 }
 
 Web::Layout::InitialContainingBlock* PageHost::layout_root()
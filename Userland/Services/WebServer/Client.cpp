@@ -9,25 +9,75 @@
 #include <AK/Debug.h>
 #include <AK/LexicalPath.h>
 #include <AK/MappedFile.h>
-#include <AK/MemoryStream.h>
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
 #include <AK/URL.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/DirIterator.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
-#include <LibCore/FileStream.h>
-#include <LibCore/MimeData.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
+#include <LibThreading/Mutex.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace WebServer {
 
+// How long we keep an idle connection open, waiting for the next request.
+static constexpr int keep_alive_timeout_ms = 15000;
+
+// We don't accept request headers larger than this.
+static constexpr size_t max_request_header_size = 64 * KiB;
+
+static RefPtr<Threading::WorkerPool> s_worker_pool;
+
+// Responses that were built on the worker pool, and are waiting for the main thread to send them.
+// Workers write a byte into the wake pipe for every one they add, which wakes up the main thread's notifier.
+static Threading::Mutex s_built_responses_lock;
+static Vector<Function<void()>> s_built_responses;
+static int s_built_responses_wake_pipe_fds[2] { -1, -1 };
+static RefPtr<Core::Notifier> s_built_responses_notifier;
+
+static void did_build_responses()
+{
+    u8 buffer[64];
+    while (read(s_built_responses_wake_pipe_fds[0], buffer, sizeof(buffer)) > 0)
+        ;
+
+    Vector<Function<void()>> built_responses;
+    {
+        Threading::MutexLocker locker(s_built_responses_lock);
+        built_responses = move(s_built_responses);
+    }
+    for (auto& did_build_response : built_responses)
+        did_build_response();
+}
+
+void Client::set_worker_pool(RefPtr<Threading::WorkerPool> worker_pool)
+{
+    if (worker_pool && !s_built_responses_notifier) {
+        // NOTE: Neither end may block, the main thread drains the pipe until it's empty, and a full pipe already means it's going to wake up.
+        if (pipe(s_built_responses_wake_pipe_fds) < 0) {
+            perror("pipe");
+            return;
+        }
+        for (auto fd : s_built_responses_wake_pipe_fds)
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        s_built_responses_notifier = Core::Notifier::construct(s_built_responses_wake_pipe_fds[0], Core::Notifier::Event::Read);
+        s_built_responses_notifier->on_ready_to_read = [] {
+            did_build_responses();
+        };
+    }
+    s_worker_pool = move(worker_pool);
+}
+
 Client::Client(NonnullRefPtr<Core::TCPSocket> socket, Core::Object* parent)
     : Core::Object(parent)
     , m_socket(socket)
@@ -36,35 +86,228 @@ Client::Client(NonnullRefPtr<Core::TCPSocket> socket, Core::Object* parent)
 
 void Client::die()
 {
+    if (m_write_notifier)
+        m_write_notifier->set_enabled(false);
+    m_idle_timer->stop();
+    m_socket->on_ready_to_read = nullptr;
     deferred_invoke([this] { remove_from_parent(); });
 }
 
 void Client::start()
 {
+    m_idle_timer = Core::Timer::create_single_shot(
+        keep_alive_timeout_ms, [this] {
+            dbgln_if(WEBSERVER_DEBUG, "Closing idle connection");
+            die();
+        },
+        this);
+    m_idle_timer->start();
+
     m_socket->on_ready_to_read = [this] {
-        StringBuilder builder;
-        for (;;) {
-            auto line = m_socket->read_line();
-            if (line.is_empty())
-                break;
-            builder.append(line);
-            builder.append("\r\n");
+        read_from_socket();
+    };
+}
+
+void Client::read_from_socket()
+{
+    for (;;) {
+        auto data = m_socket->read(PAGE_SIZE);
+        if (data.is_empty())
+            break;
+        m_received_data.append(data.data(), data.size());
+        if (m_received_data.size() > max_request_header_size)
+            break;
+    }
+    if (m_socket->eof())
+        m_peer_closed = true;
+
+    handle_next_request();
+}
+
+static Optional<size_t> find_end_of_request_header(ReadonlyBytes data)
+{
+    for (size_t i = 0; i + 3 < data.size(); ++i) {
+        if (data[i] == '\r' && data[i + 1] == '\n' && data[i + 2] == '\r' && data[i + 3] == '\n')
+            return i;
+    }
+    return {};
+}
+
+static Optional<String> get_header(HTTP::HttpRequest const& request, StringView name)
+{
+    for (auto& header : request.headers()) {
+        if (header.name.equals_ignoring_case(name))
+            return header.value;
+    }
+    return {};
+}
+
+static bool has_header_token(HTTP::HttpRequest const& request, StringView header_name, StringView token)
+{
+    auto value = get_header(request, header_name);
+    if (!value.has_value())
+        return false;
+    for (auto& part : value->split_view(',')) {
+        auto parameters = part.split_view(';');
+        if (parameters.is_empty() || !parameters[0].trim_whitespace().equals_ignoring_case(token))
+            continue;
+        // "gzip;q=0" means that gzip is *not* acceptable.
+        for (size_t i = 1; i < parameters.size(); ++i) {
+            auto parameter = parameters[i].trim_whitespace();
+            if (!parameter.starts_with("q="sv, CaseSensitivity::CaseInsensitive))
+                continue;
+            auto quality = parameter.substring_view(2);
+            bool is_zero = !quality.is_empty();
+            for (auto ch : quality) {
+                if (ch != '0' && ch != '.')
+                    is_zero = false;
+            }
+            if (is_zero)
+                return false;
         }
+        return true;
+    }
+    return false;
+}
 
-        auto request = builder.to_byte_buffer();
-        dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", String::copy(request));
-        handle_request(request);
-        die();
-    };
+static bool wants_keep_alive(HTTP::HttpRequest const& request)
+{
+    // We don't read request bodies, so we can't tell where the next request would start.
+    if (request.method() != HTTP::HttpRequest::Method::GET && request.method() != HTTP::HttpRequest::Method::HEAD)
+        return false;
+    if (get_header(request, "Transfer-Encoding"sv).has_value())
+        return false;
+    if (auto content_length = get_header(request, "Content-Length"sv); content_length.has_value() && content_length->to_uint().value_or(1) != 0)
+        return false;
+
+    if (has_header_token(request, "Connection"sv, "close"sv))
+        return false;
+    if (has_header_token(request, "Connection"sv, "keep-alive"sv))
+        return true;
+    // Persistent connections are the default since HTTP/1.1.
+    return request.protocol() == "HTTP/1.1";
 }
 
-void Client::handle_request(ReadonlyBytes raw_request)
+void Client::handle_next_request()
 {
+    if (m_is_handling_request)
+        return;
+
+    auto end_of_header = find_end_of_request_header(m_received_data);
+    if (!end_of_header.has_value()) {
+        if (m_peer_closed || m_received_data.size() > max_request_header_size)
+            die();
+        return;
+    }
+
+    // NOTE: We leave out the empty line that ends the header.
+    auto raw_request = m_received_data.bytes().trim(end_of_header.value() + 2);
+    dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", StringView { raw_request });
     auto request_or_error = HTTP::HttpRequest::from_raw_request(raw_request);
-    if (!request_or_error.has_value())
+    m_received_data = m_received_data.slice(end_of_header.value() + 4, m_received_data.size() - end_of_header.value() - 4);
+    if (!request_or_error.has_value()) {
+        die();
+        return;
+    }
+
+    m_is_handling_request = true;
+    m_keep_alive = !m_peer_closed && wants_keep_alive(request_or_error.value());
+    m_idle_timer->stop();
+    // Don't read any further while we're busy, so a client can't make us buffer an arbitrary number of pipelined requests.
+    m_socket->set_idle(true);
+
+    if (!s_worker_pool) {
+        auto& request = request_or_error.value();
+        did_build_response(request, build_response(request, m_keep_alive));
+        return;
+    }
+
+    // NOTE: The client stays alive while it's handling a request, since it only dies once the response has been sent.
+    s_worker_pool->enqueue([this, request = request_or_error.release_value(), keep_alive = m_keep_alive]() mutable {
+        auto response = build_response(request, keep_alive);
+        {
+            Threading::MutexLocker locker(s_built_responses_lock);
+            s_built_responses.append([this, request = move(request), response = move(response)]() mutable {
+                did_build_response(request, move(response));
+            });
+        }
+        u8 wake_byte = 0;
+        [[maybe_unused]] auto nwritten = write(s_built_responses_wake_pipe_fds[1], &wake_byte, sizeof(wake_byte));
+    });
+}
+
+void Client::did_build_response(HTTP::HttpRequest const& request, Response&& response)
+{
+    log_response(response.code, request);
+    m_response = move(response);
+    m_response_offset = 0;
+    send_pending_response();
+}
+
+void Client::send_pending_response()
+{
+    VERIFY(m_response.has_value());
+    auto head = m_response->head.bytes();
+    auto body = m_response->body_bytes();
+    auto total_size = head.size() + body.size();
+
+    while (m_response_offset < total_size) {
+        // Headers and body go out together, so small responses only take a single write.
+        iovec iov[2];
+        int iov_count = 0;
+        if (m_response_offset < head.size()) {
+            iov[iov_count++] = { const_cast<u8*>(head.data()) + m_response_offset, head.size() - m_response_offset };
+            if (!body.is_empty())
+                iov[iov_count++] = { const_cast<u8*>(body.data()), body.size() };
+        } else {
+            auto body_offset = m_response_offset - head.size();
+            iov[iov_count++] = { const_cast<u8*>(body.data()) + body_offset, body.size() - body_offset };
+        }
+
+        auto nwritten = writev(m_socket->fd(), iov, iov_count);
+        if (nwritten < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // The client isn't keeping up, so wait until it can take some more.
+                if (!m_write_notifier) {
+                    m_write_notifier = Core::Notifier::construct(m_socket->fd(), Core::Notifier::Event::Write, this);
+                    m_write_notifier->on_ready_to_write = [this] {
+                        m_write_notifier->set_enabled(false);
+                        send_pending_response();
+                    };
+                }
+                m_write_notifier->set_enabled(true);
+                return;
+            }
+            dbgln_if(WEBSERVER_DEBUG, "Failed to send response: {}", strerror(errno));
+            die();
+            return;
+        }
+        m_response_offset += nwritten;
+    }
+
+    did_send_response();
+}
+
+void Client::did_send_response()
+{
+    m_response.clear();
+    m_is_handling_request = false;
+
+    if (!m_keep_alive) {
+        die();
         return;
-    auto& request = request_or_error.value();
+    }
+
+    m_idle_timer->restart();
+    m_socket->set_idle(false);
+    // The client may have pipelined its next request already.
+    handle_next_request();
+}
 
+Client::Response Client::build_response(HTTP::HttpRequest const& request, bool keep_alive)
+{
     if constexpr (WEBSERVER_DEBUG) {
         dbgln("Got HTTP request: {} {}", request.method_name(), request.resource());
         for (auto& header : request.headers()) {
@@ -72,18 +315,14 @@ void Client::handle_request(ReadonlyBytes raw_request)
         }
     }
 
-    if (request.method() != HTTP::HttpRequest::Method::GET) {
-        send_error_response(501, request);
-        return;
-    }
+    if (request.method() != HTTP::HttpRequest::Method::GET && request.method() != HTTP::HttpRequest::Method::HEAD)
+        return build_error_response(501, request, keep_alive);
 
     // Check for credentials if they are required
     if (Configuration::the().credentials().has_value()) {
         bool has_authenticated = verify_credentials(request.headers());
-        if (!has_authenticated) {
-            send_error_response(401, request, { "WWW-Authenticate: Basic realm=\"WebServer\", charset=\"UTF-8\"" });
-            return;
-        }
+        if (!has_authenticated)
+            return build_error_response(401, request, keep_alive, { "WWW-Authenticate: Basic realm=\"WebServer\", charset=\"UTF-8\"" });
     }
 
     auto requested_path = LexicalPath::join("/", request.resource()).string();
@@ -102,100 +341,77 @@ void Client::handle_request(ReadonlyBytes raw_request)
             red.append(requested_path);
             red.append("/");
 
-            send_redirect(red.to_string(), request);
-            return;
+            return build_redirect(red.to_string(), request, keep_alive);
         }
 
         StringBuilder index_html_path_builder;
         index_html_path_builder.append(real_path);
         index_html_path_builder.append("/index.html");
         auto index_html_path = index_html_path_builder.to_string();
-        if (!Core::File::exists(index_html_path)) {
-            handle_directory_listing(requested_path, real_path, request);
-            return;
-        }
+        if (!Core::File::exists(index_html_path))
+            return build_directory_listing(requested_path, real_path, request, keep_alive);
         real_path = index_html_path;
     }
 
-    auto file = Core::File::construct(real_path);
-    if (!file->open(Core::OpenMode::ReadOnly)) {
-        send_error_response(404, request);
-        return;
+    auto file_or_error = FileCache::the().open(real_path);
+    if (file_or_error.is_error()) {
+        if (file_or_error.error() == FileCache::Error::NotARegularFile)
+            return build_error_response(403, request, keep_alive);
+        return build_error_response(404, request, keep_alive);
     }
+    auto file = file_or_error.release_value();
 
-    if (file->is_device()) {
-        send_error_response(403, request);
-        return;
+    // If there's a gzipped copy of the file next to it (and it's not older than the file itself), we can send that instead.
+    if (has_header_token(request, "Accept-Encoding"sv, "gzip"sv)) {
+        auto gzipped_file_or_error = FileCache::the().open(String::formatted("{}.gz", real_path));
+        if (!gzipped_file_or_error.is_error() && gzipped_file_or_error.value()->modification_time() >= file->modification_time())
+            return build_file_response(gzipped_file_or_error.release_value(), file->mime_type(), request, keep_alive, true);
     }
 
-    Core::InputFileStream stream { file };
-
-    send_response(stream, request, Core::guess_mime_type_based_on_filename(real_path));
+    return build_file_response(file, file->mime_type(), request, keep_alive, false);
 }
 
-void Client::send_response(InputStream& response, HTTP::HttpRequest const& request, String const& content_type)
+Client::Response Client::build_file_response(NonnullRefPtr<CachedFile> file, StringView content_type, HTTP::HttpRequest const& request, bool keep_alive, bool is_gzip_encoded)
 {
-    StringBuilder builder;
-    builder.append("HTTP/1.0 200 OK\r\n");
-    builder.append("Server: WebServer (SerenityOS)\r\n");
-    builder.append("X-Frame-Options: SAMEORIGIN\r\n");
-    builder.append("X-Content-Type-Options: nosniff\r\n");
-    builder.append("Pragma: no-cache\r\n");
-    builder.append("Content-Type: ");
-    builder.append(content_type);
-    builder.append("\r\n");
-    builder.append("\r\n");
-
-    m_socket->write(builder.to_string());
-    log_response(200, request);
-
-    char buffer[PAGE_SIZE];
-    do {
-        auto size = response.read({ buffer, sizeof(buffer) });
-        if (response.unreliable_eof() && size == 0)
-            break;
-
-        m_socket->write({ buffer, size });
-    } while (true);
+    Vector<String> headers;
+    headers.append("X-Frame-Options: SAMEORIGIN");
+    headers.append("X-Content-Type-Options: nosniff");
+    headers.append("Pragma: no-cache");
+    headers.append(String::formatted("Content-Type: {}", content_type));
+    // Whether we send a gzipped copy depends on the Accept-Encoding header, so caches have to take it into account.
+    headers.append("Vary: Accept-Encoding");
+    if (is_gzip_encoded)
+        headers.append("Content-Encoding: gzip");
+    return make_response(200, request, keep_alive, headers, {}, move(file));
 }
 
-void Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
+Client::Response Client::build_redirect(StringView redirect_path, HTTP::HttpRequest const& request, bool keep_alive)
 {
-    StringBuilder builder;
-    builder.append("HTTP/1.0 301 Moved Permanently\r\n");
-    builder.append("Location: ");
-    builder.append(redirect_path);
-    builder.append("\r\n");
-    builder.append("\r\n");
-
-    m_socket->write(builder.to_string());
-
-    log_response(301, request);
+    return make_response(301, request, keep_alive, { String::formatted("Location: {}", redirect_path) }, {});
 }
 
-static String folder_image_data()
+static String const& folder_image_data()
 {
-    static String cache;
-    if (cache.is_empty()) {
+    // NOTE: Initialization of function-local statics is thread-safe, so this is fine to call from a worker thread.
+    static String const cache = [] {
         auto file_or_error = MappedFile::map("/res/icons/16x16/filetype-folder.png");
         VERIFY(!file_or_error.is_error());
-        cache = encode_base64(file_or_error.value()->bytes());
-    }
+        return encode_base64(file_or_error.value()->bytes());
+    }();
     return cache;
 }
 
-static String file_image_data()
+static String const& file_image_data()
 {
-    static String cache;
-    if (cache.is_empty()) {
+    static String const cache = [] {
         auto file_or_error = MappedFile::map("/res/icons/16x16/filetype-unknown.png");
         VERIFY(!file_or_error.is_error());
-        cache = encode_base64(file_or_error.value()->bytes());
-    }
+        return encode_base64(file_or_error.value()->bytes());
+    }();
     return cache;
 }
 
-void Client::handle_directory_listing(String const& requested_path, String const& real_path, HTTP::HttpRequest const& request)
+Client::Response Client::build_directory_listing(String const& requested_path, String const& real_path, HTTP::HttpRequest const& request, bool keep_alive)
 {
     StringBuilder builder;
 
@@ -268,33 +484,57 @@ void Client::handle_directory_listing(String const& requested_path, String const
     builder.append("</body>\n");
     builder.append("</html>\n");
 
-    auto response = builder.to_string();
-    InputMemoryStream stream { response.bytes() };
-    send_response(stream, request, "text/html");
+
+    Vector<String> headers;
+    headers.append("X-Frame-Options: SAMEORIGIN");
+    headers.append("X-Content-Type-Options: nosniff");
+    headers.append("Pragma: no-cache");
+    headers.append("Content-Type: text/html");
+    return make_response(200, request, keep_alive, headers, builder.to_byte_buffer());
 }
 
-void Client::send_error_response(unsigned code, HTTP::HttpRequest const& request, Vector<String> const& headers)
+Client::Response Client::build_error_response(unsigned code, HTTP::HttpRequest const& request, bool keep_alive, Vector<String> const& headers)
 {
     auto reason_phrase = HTTP::HttpResponse::reason_phrase_for_code(code);
+
+    Vector<String> response_headers = headers;
+    response_headers.append("Content-Type: text/html; charset=UTF-8");
+
     StringBuilder builder;
-    builder.appendff("HTTP/1.0 {} ", code);
+    builder.append("<!DOCTYPE html><html><body><h1>");
+    builder.appendff("{} ", code);
     builder.append(reason_phrase);
-    builder.append("\r\n");
+    builder.append("</h1></body></html>");
+    return make_response(code, request, keep_alive, response_headers, builder.to_byte_buffer());
+}
 
+Client::Response Client::make_response(unsigned code, HTTP::HttpRequest const& request, bool keep_alive, Vector<String> const& headers, ByteBuffer body, RefPtr<CachedFile> file)
+{
+    StringBuilder builder;
+    builder.appendff("HTTP/1.1 {} ", code);
+    builder.append(HTTP::HttpResponse::reason_phrase_for_code(code));
+    builder.append("\r\n");
+    builder.append("Server: WebServer (SerenityOS)\r\n");
     for (auto& header : headers) {
         builder.append(header);
         builder.append("\r\n");
     }
-    builder.append("Content-Type: text/html; charset=UTF-8\r\n");
-
+    builder.appendff("Content-Length: {}\r\n", file ? file->size() : body.size());
+    if (keep_alive)
+        builder.appendff("Connection: keep-alive\r\nKeep-Alive: timeout={}\r\n", keep_alive_timeout_ms / 1000);
+    else
+        builder.append("Connection: close\r\n");
     builder.append("\r\n");
-    builder.append("<!DOCTYPE html><html><body><h1>");
-    builder.appendff("{} ", code);
-    builder.append(reason_phrase);
-    builder.append("</h1></body></html>");
-    m_socket->write(builder.to_string());
 
-    log_response(code, request);
+    Response response;
+    response.code = code;
+    response.head = builder.to_byte_buffer();
+    // The response to a HEAD request is the same as to a GET request, just without the body.
+    if (request.method() != HTTP::HttpRequest::Method::HEAD) {
+        response.file = move(file);
+        response.body = move(body);
+    }
+    return response;
 }
 
 void Client::log_response(unsigned code, HTTP::HttpRequest const& request)
@@ -6,31 +6,71 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <LibCore/Notifier.h>
 #include <LibCore/Object.h>
 #include <LibCore/TCPSocket.h>
+#include <LibCore/Timer.h>
 #include <LibHTTP/Forward.h>
+#include <LibHTTP/HttpRequest.h>
+#include <LibThreading/WorkerPool.h>
+#include <WebServer/FileCache.h>
 
 namespace WebServer {
 
+// A connection to a client. It may carry any number of requests (HTTP/1.1 keep-alive), which are answered one after the other.
 class Client final : public Core::Object {
     C_OBJECT(Client);
 
 public:
     void start();
 
+    // When set, responses are put together on the pool's threads instead of the main thread.
+    // All reading from and writing to sockets still happens on the main thread.
+    static void set_worker_pool(RefPtr<Threading::WorkerPool>);
+
 private:
     Client(NonnullRefPtr<Core::TCPSocket>, Core::Object* parent);
 
-    void handle_request(ReadonlyBytes);
-    void send_response(InputStream&, HTTP::HttpRequest const&, String const& content_type);
-    void send_redirect(StringView redirect, HTTP::HttpRequest const&);
-    void send_error_response(unsigned code, HTTP::HttpRequest const&, Vector<String> const& headers = {});
+    struct Response {
+        unsigned code { 0 };
+        ByteBuffer head;
+        // The body either comes straight out of the file cache, or was generated for this response.
+        RefPtr<CachedFile> file;
+        ByteBuffer body;
+
+        ReadonlyBytes body_bytes() const { return file ? file->bytes() : body.bytes(); }
+    };
+
+    void read_from_socket();
+    void handle_next_request();
+    void did_build_response(HTTP::HttpRequest const&, Response&&);
+    void send_pending_response();
+    void did_send_response();
     void die();
     void log_response(unsigned code, HTTP::HttpRequest const&);
-    void handle_directory_listing(String const& requested_path, String const& real_path, HTTP::HttpRequest const&);
-    bool verify_credentials(Vector<HTTP::HttpRequest::Header> const&);
+
+    // NOTE: These may run on a worker thread, so they must not touch the client.
+    static Response build_response(HTTP::HttpRequest const&, bool keep_alive);
+    static Response build_file_response(NonnullRefPtr<CachedFile>, StringView content_type, HTTP::HttpRequest const&, bool keep_alive, bool is_gzip_encoded);
+    static Response build_redirect(StringView redirect, HTTP::HttpRequest const&, bool keep_alive);
+    static Response build_error_response(unsigned code, HTTP::HttpRequest const&, bool keep_alive, Vector<String> const& headers = {});
+    static Response build_directory_listing(String const& requested_path, String const& real_path, HTTP::HttpRequest const&, bool keep_alive);
+    static Response make_response(unsigned code, HTTP::HttpRequest const&, bool keep_alive, Vector<String> const& headers, ByteBuffer body, RefPtr<CachedFile> = nullptr);
+    static bool verify_credentials(Vector<HTTP::HttpRequest::Header> const&);
 
     NonnullRefPtr<Core::TCPSocket> m_socket;
+    RefPtr<Core::Notifier> m_write_notifier;
+    RefPtr<Core::Timer> m_idle_timer;
+
+    // What the client has sent us that we haven't handled yet. With pipelining, this may be more than one request.
+    ByteBuffer m_received_data;
+    bool m_peer_closed { false };
+
+    bool m_is_handling_request { false };
+    bool m_keep_alive { false };
+    Optional<Response> m_response;
+    size_t m_response_offset { 0 };
 };
 
 }
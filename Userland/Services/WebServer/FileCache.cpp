@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibCore/MimeData.h>
+#include <WebServer/FileCache.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace WebServer {
+
+CachedFile::CachedFile(struct stat const& st, RefPtr<MappedFile> mapped_file, String mime_type)
+    : m_mapped_file(move(mapped_file))
+    , m_mime_type(move(mime_type))
+    , m_size(st.st_size)
+    , m_device(st.st_dev)
+    , m_inode(st.st_ino)
+    , m_modification_time(st.st_mtime)
+{
+}
+
+bool CachedFile::is_up_to_date(struct stat const& st) const
+{
+    return st.st_dev == m_device && st.st_ino == m_inode && static_cast<size_t>(st.st_size) == m_size && st.st_mtime == m_modification_time;
+}
+
+FileCache& FileCache::the()
+{
+    static FileCache s_the;
+    return s_the;
+}
+
+Result<NonnullRefPtr<CachedFile>, FileCache::Error> FileCache::open(String const& path)
+{
+    // NOTE: We stat the path (rather than an fd we keep open) so that files which get replaced, not just modified, are noticed too.
+    struct stat st;
+    if (stat(path.characters(), &st) < 0)
+        return Error::NotFound;
+    if (!S_ISREG(st.st_mode))
+        return Error::NotARegularFile;
+
+    {
+        Threading::MutexLocker locker(m_lock);
+        if (auto it = m_files.find(path); it != m_files.end() && it->value.file->is_up_to_date(st)) {
+            it->value.last_use = ++m_use_counter;
+            return it->value.file;
+        }
+    }
+
+    dbgln_if(WEBSERVER_DEBUG, "FileCache: Opening {}", path);
+    int fd = ::open(path.characters(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return Error::NotFound;
+    // Make sure that what we map is what we're going to describe.
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return Error::NotARegularFile;
+    }
+
+    RefPtr<MappedFile> mapped_file;
+    if (st.st_size == 0) {
+        // There's nothing to map.
+        ::close(fd);
+    } else {
+        auto mapped_file_or_error = MappedFile::map_from_fd_and_close(fd, path);
+        if (mapped_file_or_error.is_error())
+            return Error::NotFound;
+        mapped_file = mapped_file_or_error.release_value();
+    }
+
+    auto file = adopt_ref(*new CachedFile(st, move(mapped_file), Core::guess_mime_type_based_on_filename(path)));
+
+    Threading::MutexLocker locker(m_lock);
+    m_files.set(path, { file, ++m_use_counter });
+    evict_if_needed();
+    return file;
+}
+
+// Must be called with the lock held.
+void FileCache::evict_if_needed()
+{
+    while (m_files.size() > max_entries) {
+        auto least_recently_used = m_files.begin();
+        for (auto it = m_files.begin(); it != m_files.end(); ++it) {
+            if (it->value.last_use < least_recently_used->value.last_use)
+                least_recently_used = it;
+        }
+        dbgln_if(WEBSERVER_DEBUG, "FileCache: Evicting {}", least_recently_used->key);
+        m_files.remove(least_recently_used);
+    }
+}
+
+}
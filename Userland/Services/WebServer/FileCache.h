@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/HashMap.h>
+#include <AK/MappedFile.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/Result.h>
+#include <AK/String.h>
+#include <LibThreading/Mutex.h>
+#include <sys/stat.h>
+
+namespace WebServer {
+
+// A file that we've opened and mapped before, along with what we knew about it back then.
+// NOTE: Requests may be handled on worker threads, so this is reference counted atomically.
+//       Nothing in it changes after construction, so it can be read from any thread.
+class CachedFile {
+    AK_MAKE_NONCOPYABLE(CachedFile);
+    AK_MAKE_NONMOVABLE(CachedFile);
+
+public:
+    void ref() const { m_ref_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed); }
+    void unref() const
+    {
+        if (m_ref_count.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    ReadonlyBytes bytes() const { return m_mapped_file ? m_mapped_file->bytes() : ReadonlyBytes {}; }
+    size_t size() const { return m_size; }
+    time_t modification_time() const { return m_modification_time; }
+    StringView mime_type() const { return m_mime_type; }
+
+    bool is_up_to_date(struct stat const&) const;
+
+private:
+    friend class FileCache;
+
+    CachedFile(struct stat const&, RefPtr<MappedFile>, String mime_type);
+
+    mutable Atomic<u32> m_ref_count { 1 };
+    RefPtr<MappedFile> m_mapped_file;
+    String m_mime_type;
+    size_t m_size { 0 };
+    dev_t m_device { 0 };
+    ino_t m_inode { 0 };
+    time_t m_modification_time { 0 };
+};
+
+// Keeps recently served files open and mapped, so repeated requests cost us a stat() instead of an open(), a read() and a close().
+// Every lookup stats the file and compares it to what we've cached, so changes on disk show up right away.
+class FileCache {
+public:
+    static FileCache& the();
+
+    enum class Error {
+        NotFound,
+        NotARegularFile,
+    };
+
+    Result<NonnullRefPtr<CachedFile>, Error> open(String const& path);
+
+private:
+    FileCache() = default;
+
+    void evict_if_needed();
+
+    static constexpr size_t max_entries = 256;
+
+    struct Entry {
+        NonnullRefPtr<CachedFile> file;
+        u64 last_use { 0 };
+    };
+
+    Threading::Mutex m_lock;
+    HashMap<String, Entry> m_files;
+    u64 m_use_counter { 0 };
+};
+
+}
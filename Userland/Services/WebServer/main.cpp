@@ -11,6 +11,7 @@
 #include <LibCore/File.h>
 #include <LibCore/TCPServer.h>
 #include <LibHTTP/HttpRequest.h>
+#include <LibThreading/WorkerPool.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
 #include <stdio.h>
@@ -26,12 +27,14 @@ int main(int argc, char** argv)
     int port = default_port;
     String username;
     String password;
+    int thread_count = 0;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(listen_address, "IP address to listen on", "listen-address", 'l', "listen_address");
     args_parser.add_option(port, "Port to listen on", "port", 'p', "port");
     args_parser.add_option(username, "HTTP basic authentication username", "user", 'U', "username");
     args_parser.add_option(password, "HTTP basic authentication password", "pass", 'P', "password");
+    args_parser.add_option(thread_count, "Number of worker threads to handle requests on (0 handles them on the main thread)", "threads", 't', "count");
     args_parser.add_positional_argument(root_path, "Path to serve the contents of", "path", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
@@ -46,6 +49,11 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    if (thread_count < 0) {
+        warnln("Invalid number of threads: {}", thread_count);
+        return 1;
+    }
+
     if (username.is_empty() != password.is_empty()) {
         warnln("Both username and password are required for HTTP basic authentication.");
         return 1;
@@ -58,7 +66,7 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    if (pledge("stdio accept rpath inet unix", nullptr) < 0) {
+    if (pledge("stdio accept rpath inet unix thread", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -70,6 +78,9 @@ int main(int argc, char** argv)
 
     Core::EventLoop loop;
 
+    if (thread_count > 0)
+        WebServer::Client::set_worker_pool(Threading::WorkerPool::create(thread_count, "WebServer"));
+
     auto server = Core::TCPServer::construct();
 
     server->on_ready_to_accept = [&] {
@@ -98,7 +109,7 @@ int main(int argc, char** argv)
 
     unveil(nullptr, nullptr);
 
-    if (pledge("stdio accept rpath", nullptr) < 0) {
+    if (pledge(thread_count > 0 ? "stdio accept rpath thread" : "stdio accept rpath", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -1106,6 +1106,14 @@ void ClientConnection::set_flash_flush(bool enabled)
     Compositor::the().set_flash_flush(enabled);
 }
 
+Messages::WindowServer::GetCompositorStatisticsResponse ClientConnection::get_compositor_statistics()
+{
+    auto statistics = Compositor::the().frame_statistics();
+    return { statistics.frame_count, (u32)statistics.worker_thread_count,
+        statistics.average_paint_time.to_microseconds(), statistics.max_paint_time.to_microseconds(),
+        statistics.average_flush_time.to_microseconds(), statistics.max_flush_time.to_microseconds() };
+}
+
 void ClientConnection::set_window_parent_from_client(i32 client_id, i32 parent_id, i32 child_id)
 {
     auto child_window = window_from_id(child_id);
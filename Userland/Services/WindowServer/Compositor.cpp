@@ -15,12 +15,15 @@
 #include "WindowManager.h"
 #include <AK/Debug.h>
 #include <AK/Memory.h>
+#include <AK/NonnullOwnPtrVector.h>
 #include <AK/ScopeGuard.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/Timer.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/StylePainter.h>
 #include <LibThreading/BackgroundAction.h>
+#include <unistd.h>
 
 namespace WindowServer {
 
@@ -63,6 +66,10 @@ Compositor::Compositor()
         },
         this);
 
+    // The compositing thread paints tiles too while it waits, so one processor is already taken care of.
+    auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    m_worker_pool = Threading::WorkerPool::create(processor_count > 1 ? static_cast<size_t>(processor_count - 1) : 0, "Compositor");
+
     init_bitmaps();
 }
 
@@ -101,6 +108,7 @@ void CompositorScreenData::init_bitmaps(Compositor& compositor, Screen& screen)
     m_flush_rects.clear_with_capacity();
     m_flush_transparent_rects.clear_with_capacity();
     m_flush_special_rects.clear_with_capacity();
+    m_back_buffer_damage.clear_with_capacity();
 
     auto size = screen.size();
     m_front_bitmap = nullptr;
@@ -174,6 +182,9 @@ void Compositor::compose()
         return;
     }
 
+    Core::ElapsedTimer frame_timer(true);
+    frame_timer.start();
+
     if (m_occlusions_dirty) {
         m_occlusions_dirty = false;
         recompute_occlusions();
@@ -324,6 +335,34 @@ void Compositor::compose()
         }
     };
 
+    // Painting happens in two steps. Deciding what goes where involves the window manager and plenty of
+    // reference counted objects, so it stays on this thread and only records the rects to paint. The
+    // dirty parts of each screen are then split into bands that are painted concurrently, each of them
+    // replaying everything that touches it in the recorded order.
+    struct ComposedWindow {
+        Window const* window { nullptr };
+        Gfx::IntPoint transition_offset;
+        Gfx::IntRect window_rect;
+        Vector<Gfx::IntRect, 4> frame_rects;
+        Gfx::IntRect frame_render_rect;
+        Gfx::Bitmap const* backing_store { nullptr };
+        Gfx::IntRect backing_rect;
+        Color fill_color;
+        float opacity { 1.0f };
+        bool is_opaque { true };
+        bool is_unresponsive { false };
+    };
+    struct PendingPaint {
+        Gfx::IntRect rect;
+        bool is_transparent { false };
+        // If there's no window, this paints the wallpaper.
+        ComposedWindow const* window { nullptr };
+        WindowFrame::PerScaleRenderedCache const* frame_cache { nullptr };
+    };
+    NonnullOwnPtrVector<ComposedWindow> composed_windows;
+    Vector<Vector<PendingPaint>> pending_paints;
+    pending_paints.resize(Screen::count());
+
     {
         // Paint any desktop wallpaper rects that are not somehow underneath any window transparency
         // rects and outside of any opaque window areas
@@ -334,8 +373,7 @@ void Compositor::compose()
                 if (!screen_render_rect.is_empty()) {
                     dbgln_if(COMPOSE_DEBUG, "  render wallpaper opaque: {} on screen #{}", screen_render_rect, screen.index());
                     prepare_rect(screen, render_rect);
-                    auto& back_painter = *screen.compositor_screen_data().m_back_painter;
-                    paint_wallpaper(screen, back_painter, render_rect, screen_rect);
+                    pending_paints[screen.index()].append({ render_rect });
                 }
                 return IterationDecision::Continue;
             });
@@ -348,8 +386,7 @@ void Compositor::compose()
                 if (!screen_render_rect.is_empty()) {
                     dbgln_if(COMPOSE_DEBUG, "  render wallpaper transparent: {} on screen #{}", screen_render_rect, screen.index());
                     prepare_transparency_rect(screen, render_rect);
-                    auto& temp_painter = *screen.compositor_screen_data().m_temp_painter;
-                    paint_wallpaper(screen, temp_painter, render_rect, screen_rect);
+                    pending_paints[screen.index()].append({ render_rect, true });
                 }
                 return IterationDecision::Continue;
             });
@@ -357,6 +394,7 @@ void Compositor::compose()
         });
     }
 
+    auto window_color = wm.palette().window();
     auto compose_window = [&](Window& window) -> IterationDecision {
         if (window.screens().is_empty()) {
             // This window doesn't intersect with any screens, so there's nothing to render
@@ -365,35 +403,27 @@ void Compositor::compose()
         auto transition_offset = window_transition_offset(window);
         auto frame_rect = window.frame().render_rect().translated(transition_offset);
         auto window_rect = window.rect().translated(transition_offset);
-        auto frame_rects = frame_rect.shatter(window_rect);
 
         dbgln_if(COMPOSE_DEBUG, "  window {} frame rect: {}", window.title(), frame_rect);
 
-        RefPtr<Gfx::Bitmap> backing_store = window.backing_store();
-        auto compose_window_rect = [&](Screen& screen, Gfx::Painter& painter, const Gfx::IntRect& rect) {
-            if (!window.is_fullscreen()) {
-                rect.for_each_intersected(frame_rects, [&](const Gfx::IntRect& intersected_rect) {
-                    Gfx::PainterStateSaver saver(painter);
-                    painter.add_clip_rect(intersected_rect);
-                    painter.translate(transition_offset);
-                    dbgln_if(COMPOSE_DEBUG, "    render frame: {}", intersected_rect);
-                    window.frame().paint(screen, painter, intersected_rect.translated(-transition_offset));
-                    return IterationDecision::Continue;
-                });
-            }
-
-            auto clear_window_rect = [&](const Gfx::IntRect& clear_rect) {
-                auto fill_color = wm.palette().window();
-                if (!window.is_opaque())
-                    fill_color.set_alpha(255 * window.opacity());
-                painter.fill_rect(clear_rect, fill_color);
-            };
-
-            if (!backing_store) {
-                clear_window_rect(window_rect.intersected(rect));
-                return;
-            }
-
+        composed_windows.append(make<ComposedWindow>());
+        auto& composed_window = composed_windows.last();
+        composed_window.window = &window;
+        composed_window.transition_offset = transition_offset;
+        composed_window.window_rect = window_rect;
+        if (!window.is_fullscreen())
+            composed_window.frame_rects = frame_rect.shatter(window_rect);
+        composed_window.frame_render_rect = window.frame().unconstrained_render_rect();
+        composed_window.opacity = window.opacity();
+        composed_window.is_opaque = window.is_opaque();
+        composed_window.is_unresponsive = window.client() && window.client()->is_unresponsive();
+        composed_window.fill_color = window_color;
+        if (!window.is_opaque())
+            composed_window.fill_color.set_alpha(255 * window.opacity());
+
+        auto* backing_store = window.backing_store();
+        composed_window.backing_store = backing_store;
+        if (backing_store) {
             // Decide where we would paint this window's backing store.
             // This is subtly different from widow.rect(), because window
             // size may be different from its backing store size. This
@@ -402,7 +432,7 @@ void Compositor::compose()
             // we want to try to blit the backing store at the same place
             // it was previously, and fill the rest of the window with its
             // background color.
-            Gfx::IntRect backing_rect;
+            auto& backing_rect = composed_window.backing_rect;
             backing_rect.set_size(backing_store->size());
             switch (WindowManager::the().resize_direction_of_window(window)) {
             case ResizeDirection::None:
@@ -426,34 +456,14 @@ void Compositor::compose()
                 backing_rect.set_top(window_rect.top());
                 break;
             }
+        }
 
-            Gfx::IntRect dirty_rect_in_backing_coordinates = rect.intersected(window_rect)
-                                                                 .intersected(backing_rect)
-                                                                 .translated(-backing_rect.location());
-
-            if (!dirty_rect_in_backing_coordinates.is_empty()) {
-                auto dst = backing_rect.location().translated(dirty_rect_in_backing_coordinates.location());
-
-                if (window.client() && window.client()->is_unresponsive()) {
-                    if (window.is_opaque()) {
-                        painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [](Color src) {
-                            return src.to_grayscale().darkened(0.75f);
-                        });
-                    } else {
-                        u8 alpha = 255 * window.opacity();
-                        painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [&](Color src) {
-                            auto color = src.to_grayscale().darkened(0.75f);
-                            color.set_alpha(alpha);
-                            return color;
-                        });
-                    }
-                } else {
-                    painter.blit(dst, *backing_store, dirty_rect_in_backing_coordinates, window.opacity());
-                }
-            }
-
-            for (auto background_rect : window_rect.shatter(backing_rect))
-                clear_window_rect(background_rect);
+        auto add_pending_paint = [&](Screen& screen, Gfx::IntRect const& rect, bool is_transparent) {
+            // Rendering the frame may have to draw it first, so that can't be left to the tiles.
+            WindowFrame::PerScaleRenderedCache const* frame_cache = nullptr;
+            if (any_of(composed_window.frame_rects, [&](auto& frame_rect) { return frame_rect.intersects(rect); }))
+                frame_cache = window.frame().render_to_cache(screen);
+            pending_paints[screen.index()].append({ rect, is_transparent, &composed_window, frame_cache });
         };
 
         auto& dirty_rects = window.dirty_rects();
@@ -478,10 +488,7 @@ void Compositor::compose()
                     dbgln_if(COMPOSE_DEBUG, "    render opaque: {} on screen #{}", screen_render_rect, screen->index());
 
                     prepare_rect(*screen, screen_render_rect);
-                    auto& back_painter = *screen->compositor_screen_data().m_back_painter;
-                    Gfx::PainterStateSaver saver(back_painter);
-                    back_painter.add_clip_rect(screen_render_rect);
-                    compose_window_rect(*screen, back_painter, screen_render_rect);
+                    add_pending_paint(*screen, screen_render_rect, false);
                 }
                 return IterationDecision::Continue;
             });
@@ -499,9 +506,8 @@ void Compositor::compose()
                         continue;
                     dbgln_if(COMPOSE_DEBUG, "    render wallpaper: {} on screen #{}", screen_render_rect, screen->index());
 
-                    auto& temp_painter = *screen->compositor_screen_data().m_temp_painter;
                     prepare_transparency_rect(*screen, screen_render_rect);
-                    paint_wallpaper(*screen, temp_painter, screen_render_rect, screen_rect);
+                    pending_paints[screen->index()].append({ screen_render_rect, true });
                 }
                 return IterationDecision::Continue;
             });
@@ -517,10 +523,7 @@ void Compositor::compose()
                     dbgln_if(COMPOSE_DEBUG, "    render transparent: {} on screen #{}", screen_render_rect, screen->index());
 
                     prepare_transparency_rect(*screen, screen_render_rect);
-                    auto& temp_painter = *screen->compositor_screen_data().m_temp_painter;
-                    Gfx::PainterStateSaver saver(temp_painter);
-                    temp_painter.add_clip_rect(screen_render_rect);
-                    compose_window_rect(*screen, temp_painter, screen_render_rect);
+                    add_pending_paint(*screen, screen_render_rect, true);
                 }
                 return IterationDecision::Continue;
             });
@@ -562,22 +565,134 @@ void Compositor::compose()
             });
             return is_overlapping;
         }());
+    }
 
+    // NOTE: Everything below may run on the worker threads, so it must not touch anything but pixels.
+    auto paint_window_rect = [&](ComposedWindow const& composed_window, WindowFrame::PerScaleRenderedCache const* frame_cache, Gfx::Painter& painter, const Gfx::IntRect& rect) {
+        auto& window = *composed_window.window;
+        auto transition_offset = composed_window.transition_offset;
+        auto& window_rect = composed_window.window_rect;
+
+        if (frame_cache) {
+            rect.for_each_intersected(composed_window.frame_rects, [&](const Gfx::IntRect& intersected_rect) {
+                Gfx::PainterStateSaver saver(painter);
+                painter.add_clip_rect(intersected_rect);
+                painter.translate(transition_offset);
+                frame_cache->paint(window.frame(), painter, intersected_rect.translated(-transition_offset), composed_window.frame_render_rect);
+                return IterationDecision::Continue;
+            });
+        }
+
+        auto clear_window_rect = [&](const Gfx::IntRect& clear_rect) {
+            painter.fill_rect(clear_rect, composed_window.fill_color);
+        };
+
+        auto* backing_store = composed_window.backing_store;
+        if (!backing_store) {
+            clear_window_rect(window_rect.intersected(rect));
+            return;
+        }
+
+        auto& backing_rect = composed_window.backing_rect;
+        Gfx::IntRect dirty_rect_in_backing_coordinates = rect.intersected(window_rect)
+                                                             .intersected(backing_rect)
+                                                             .translated(-backing_rect.location());
+
+        if (!dirty_rect_in_backing_coordinates.is_empty()) {
+            auto dst = backing_rect.location().translated(dirty_rect_in_backing_coordinates.location());
+
+            if (composed_window.is_unresponsive) {
+                if (composed_window.is_opaque) {
+                    painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [](Color src) {
+                        return src.to_grayscale().darkened(0.75f);
+                    });
+                } else {
+                    u8 alpha = 255 * composed_window.opacity;
+                    painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [&](Color src) {
+                        auto color = src.to_grayscale().darkened(0.75f);
+                        color.set_alpha(alpha);
+                        return color;
+                    });
+                }
+            } else {
+                painter.blit(dst, *backing_store, dirty_rect_in_backing_coordinates, composed_window.opacity);
+            }
+        }
+
+        for (auto background_rect : window_rect.shatter(backing_rect))
+            clear_window_rect(background_rect);
+    };
+
+    struct ComposeTile {
+        Screen* screen { nullptr };
+        Gfx::IntRect rect;
+        OwnPtr<Gfx::Painter> back_painter;
+        OwnPtr<Gfx::Painter> temp_painter;
+    };
+    Vector<ComposeTile> tiles;
+    Screen::for_each([&](auto& screen) {
+        auto& screen_paints = pending_paints[screen.index()];
+        if (screen_paints.is_empty())
+            return IterationDecision::Continue;
+        auto screen_rect = screen.rect();
+        Gfx::IntRect bounding_rect;
+        for (auto& paint : screen_paints)
+            bounding_rect = bounding_rect.united(paint.rect);
+        bounding_rect.intersect(screen_rect);
+
+        // Every tile gets painters of its own, as they are neither cheap to share nor safe to create on the workers.
+        auto& screen_data = screen.compositor_screen_data();
+        for (int y = bounding_rect.top(); y <= bounding_rect.bottom(); y += compose_tile_height) {
+            auto tile_rect = bounding_rect;
+            tile_rect.set_top(y);
+            tile_rect.set_height(min(compose_tile_height, bounding_rect.bottom() - y + 1));
+            auto create_painter = [&](Gfx::Bitmap& bitmap) {
+                auto painter = make<Gfx::Painter>(bitmap);
+                painter->translate(-screen_rect.location());
+                painter->add_clip_rect(tile_rect);
+                return painter;
+            };
+            tiles.append({ &screen, tile_rect, create_painter(*screen_data.m_back_bitmap), create_painter(*screen_data.m_temp_bitmap) });
+        }
+        return IterationDecision::Continue;
+    });
+    m_worker_pool->for_each_in_parallel(tiles.size(), [&](size_t index) {
+        auto& tile = tiles[index];
+        for (auto& paint : pending_paints[tile.screen->index()]) {
+            if (!paint.rect.intersects(tile.rect))
+                continue;
+            auto& painter = paint.is_transparent ? *tile.temp_painter : *tile.back_painter;
+            Gfx::PainterStateSaver saver(painter);
+            painter.add_clip_rect(paint.rect);
+            if (paint.window)
+                paint_window_rect(*paint.window, paint.frame_cache, painter, paint.rect);
+            else
+                paint_wallpaper(*tile.screen, painter, paint.rect, tile.screen->rect());
+        }
+    });
+    tiles.clear();
+
+    if (m_invalidated_window) {
         if (!m_overlay_list.is_empty()) {
             // Render everything to the temporary buffer before we copy it back
             render_overlays();
         }
 
         // Copy anything rendered to the temporary buffer to the back buffer
+        Vector<PendingCopy> transparency_copies;
         Screen::for_each([&](auto& screen) {
             auto screen_rect = screen.rect();
             auto& screen_data = screen.compositor_screen_data();
             for (auto& rect : screen_data.m_flush_transparent_rects.rects())
-                screen_data.m_back_painter->blit(rect.location(), *screen_data.m_temp_bitmap, rect.translated(-screen_rect.location()));
+                transparency_copies.append({ screen_data.m_back_bitmap.ptr(), screen_data.m_temp_bitmap.ptr(), rect.translated(-screen_rect.location()) * screen.scale_factor() });
             return IterationDecision::Continue;
         });
+        copy_in_parallel(transparency_copies);
     }
 
+    // This has to happen before drawing the cursor, as that saves what's behind it from the back buffer.
+    repair_back_buffers();
+
     m_invalidated_any = false;
     m_invalidated_window = false;
     m_invalidated_cursor = false;
@@ -600,13 +715,130 @@ void Compositor::compose()
         screen_data.draw_cursor(cursor_screen, cursor_rect);
     }
 
+    auto paint_time = frame_timer.elapsed_time();
+
+    // Device flushes and buffer flips are independent per screen, so they run concurrently.
+    // The pixel copies in between are pooled across all screens and split into tiles.
+    auto screen_count = Screen::count();
+    if (m_flash_flush) {
+        // This deliberately stalls, so keep it out of the way of the workers.
+        Screen::for_each([&](auto& screen) {
+            flash_flush_rects(screen);
+            return IterationDecision::Continue;
+        });
+    }
+    Vector<Vector<PendingCopy>> flush_copies;
+    flush_copies.resize(screen_count);
+    m_worker_pool->for_each_in_parallel(screen_count, [&](size_t index) {
+        prepare_flush(*Screen::find_by_index(index), flush_copies[index]);
+    });
+    Vector<PendingCopy> all_flush_copies;
+    for (auto& copies : flush_copies)
+        all_flush_copies.extend(move(copies));
+    copy_in_parallel(all_flush_copies);
+    m_worker_pool->for_each_in_parallel(screen_count, [&](size_t index) {
+        finish_flush(*Screen::find_by_index(index));
+    });
+
+    ++m_frame_count;
+    m_recent_frame_times.enqueue({ paint_time, frame_timer.elapsed_time() - paint_time });
+}
+
+static void copy_bitmap_rect(Gfx::Bitmap& target, Gfx::Bitmap const& source, Gfx::IntRect const& physical_rect)
+{
+    for (int y = physical_rect.top(); y <= physical_rect.bottom(); ++y)
+        fast_u32_copy(target.scanline(y) + physical_rect.x(), source.scanline(y) + physical_rect.x(), physical_rect.width());
+}
+
+void Compositor::copy_in_parallel(Vector<PendingCopy> const& copies)
+{
+    // Split every rect into bands, so that even a single full-screen rect keeps all workers busy.
+    Vector<PendingCopy> tiles;
+    for (auto& copy : copies) {
+        for (int y = copy.physical_rect.top(); y <= copy.physical_rect.bottom(); y += compose_tile_height) {
+            auto tile_rect = copy.physical_rect;
+            tile_rect.set_top(y);
+            tile_rect.set_height(min(compose_tile_height, copy.physical_rect.bottom() - y + 1));
+            tiles.append({ copy.target, copy.source, tile_rect });
+        }
+    }
+    m_worker_pool->for_each_in_parallel(tiles.size(), [&](size_t index) {
+        auto& tile = tiles[index];
+        copy_bitmap_rect(*tile.target, *tile.source, tile.physical_rect);
+    });
+}
+
+void Compositor::repair_back_buffers()
+{
+    // With two buffers, the back buffer is one frame behind the front buffer. Rather than
+    // copying every flushed rect back right after flipping, we wait until the next frame has
+    // been painted and only copy the parts of the previous frame's damage that weren't
+    // repainted anyway. For continuously updating content, that's usually nothing at all.
+    Vector<PendingCopy> copies;
     Screen::for_each([&](auto& screen) {
-        flush(screen);
+        auto& screen_data = screen.compositor_screen_data();
+        if (screen_data.m_back_buffer_damage.is_empty())
+            return IterationDecision::Continue;
+        auto stale_rects = screen_data.m_back_buffer_damage.shatter(screen_data.m_flush_rects);
+        stale_rects = stale_rects.shatter(screen_data.m_flush_transparent_rects);
+        stale_rects = stale_rects.shatter(screen_data.m_flush_special_rects);
+        auto screen_rect = screen.rect();
+        for (auto& rect : stale_rects.rects())
+            copies.append({ screen_data.m_back_bitmap.ptr(), screen_data.m_front_bitmap.ptr(), rect.translated(-screen_rect.location()) * screen.scale_factor() });
+        screen_data.m_back_buffer_damage.clear_with_capacity();
         return IterationDecision::Continue;
     });
+    copy_in_parallel(copies);
 }
 
-void Compositor::flush(Screen& screen)
+CompositorFrameStatistics Compositor::frame_statistics() const
+{
+    CompositorFrameStatistics statistics;
+    statistics.frame_count = m_frame_count;
+    statistics.worker_thread_count = m_worker_pool->thread_count();
+    if (m_recent_frame_times.is_empty())
+        return statistics;
+    Time total_paint_time;
+    Time total_flush_time;
+    for (auto& frame_times : m_recent_frame_times) {
+        total_paint_time += frame_times.paint_time;
+        total_flush_time += frame_times.flush_time;
+        statistics.max_paint_time = max(statistics.max_paint_time, frame_times.paint_time);
+        statistics.max_flush_time = max(statistics.max_flush_time, frame_times.flush_time);
+    }
+    statistics.average_paint_time = Time::from_nanoseconds(total_paint_time.to_nanoseconds() / m_recent_frame_times.size());
+    statistics.average_flush_time = Time::from_nanoseconds(total_flush_time.to_nanoseconds() / m_recent_frame_times.size());
+    return statistics;
+}
+
+void Compositor::flash_flush_rects(Screen& screen)
+{
+    auto& screen_data = screen.compositor_screen_data();
+    if (!screen_data.m_have_flush_rects)
+        return;
+
+    auto screen_rect = screen.rect();
+    Gfx::IntRect bounding_flash;
+    for (auto& rect : screen_data.m_flush_rects.rects()) {
+        screen_data.m_front_painter->fill_rect(rect, Color::Yellow);
+        bounding_flash = bounding_flash.united(rect);
+    }
+    for (auto& rect : screen_data.m_flush_transparent_rects.rects()) {
+        screen_data.m_front_painter->fill_rect(rect, Color::Green);
+        bounding_flash = bounding_flash.united(rect);
+    }
+    if (!bounding_flash.is_empty()) {
+        if (screen.can_device_flush_buffers()) {
+            // If the device needs a flush we need to let it know that we
+            // modified the front buffer!
+            bounding_flash.translate_by(-screen_rect.location());
+            screen.flush_display_front_buffer((!screen_data.m_screen_can_set_buffer || !screen_data.m_buffers_are_flipped) ? 0 : 1, bounding_flash);
+        }
+        usleep(10000);
+    }
+}
+
+void Compositor::prepare_flush(Screen& screen, Vector<PendingCopy>& copies)
 {
     auto& screen_data = screen.compositor_screen_data();
 
@@ -618,27 +850,6 @@ void Compositor::flush(Screen& screen)
     screen_data.m_have_flush_rects = false;
 
     auto screen_rect = screen.rect();
-    if (m_flash_flush) {
-        Gfx::IntRect bounding_flash;
-        for (auto& rect : screen_data.m_flush_rects.rects()) {
-            screen_data.m_front_painter->fill_rect(rect, Color::Yellow);
-            bounding_flash = bounding_flash.united(rect);
-        }
-        for (auto& rect : screen_data.m_flush_transparent_rects.rects()) {
-            screen_data.m_front_painter->fill_rect(rect, Color::Green);
-            bounding_flash = bounding_flash.united(rect);
-        }
-        if (!bounding_flash.is_empty()) {
-            if (device_can_flush_buffers) {
-                // If the device needs a flush we need to let it know that we
-                // modified the front buffer!
-                bounding_flash.translate_by(-screen_rect.location());
-                screen.flush_display_front_buffer((!screen_data.m_screen_can_set_buffer || !screen_data.m_buffers_are_flipped) ? 0 : 1, bounding_flash);
-            }
-            usleep(10000);
-        }
-    }
-
     if (device_can_flush_buffers && screen_data.m_screen_can_set_buffer) {
         if (!screen_data.m_has_flipped) {
             // If we have not flipped any buffers before, we should be flushing
@@ -666,45 +877,30 @@ void Compositor::flush(Screen& screen)
 
     auto do_flush = [&](Gfx::IntRect rect) {
         VERIFY(screen_rect.contains(rect));
-        rect.translate_by(-screen_rect.location());
-
-        // Almost everything in Compositor is in logical coordinates, with the painters having
-        // a scale applied. But this routine accesses the backbuffer pixels directly, so it
-        // must work in physical coordinates.
-        auto scaled_rect = rect * screen.scale_factor();
-        Gfx::RGBA32* front_ptr = screen_data.m_front_bitmap->scanline(scaled_rect.y()) + scaled_rect.x();
-        Gfx::RGBA32* back_ptr = screen_data.m_back_bitmap->scanline(scaled_rect.y()) + scaled_rect.x();
-        size_t pitch = screen_data.m_back_bitmap->pitch();
 
         // NOTE: The meaning of a flush depends on whether we can flip buffers or not.
         //
-        //       If flipping is supported, flushing means that we've flipped, and now we
-        //       copy the changed bits from the front buffer to the back buffer, to keep
-        //       them in sync.
+        //       If flipping is supported, flushing means that we've flipped, and the changed
+        //       bits are now stale in the back buffer. We only record them here, they will be
+        //       brought up to date by repair_back_buffers() once we know what the next frame
+        //       is going to repaint anyway.
         //
         //       If flipping is not supported, flushing means that we copy the changed
         //       rects from the backing bitmap to the display framebuffer.
+        //
+        // Almost everything in Compositor is in logical coordinates, with the painters having
+        // a scale applied. But the copy accesses the bitmap pixels directly, so it must work
+        // in physical coordinates.
+        if (screen_data.m_screen_can_set_buffer)
+            screen_data.m_back_buffer_damage.add(rect);
+        rect.translate_by(-screen_rect.location());
+        if (!screen_data.m_screen_can_set_buffer)
+            copies.append({ screen_data.m_front_bitmap.ptr(), screen_data.m_back_bitmap.ptr(), rect * screen.scale_factor() });
 
-        Gfx::RGBA32* to_ptr;
-        const Gfx::RGBA32* from_ptr;
-
-        if (screen_data.m_screen_can_set_buffer) {
-            to_ptr = back_ptr;
-            from_ptr = front_ptr;
-        } else {
-            to_ptr = front_ptr;
-            from_ptr = back_ptr;
-        }
-
-        for (int y = 0; y < scaled_rect.height(); ++y) {
-            fast_u32_copy(to_ptr, from_ptr, scaled_rect.width());
-            from_ptr = (const Gfx::RGBA32*)((const u8*)from_ptr + pitch);
-            to_ptr = (Gfx::RGBA32*)((u8*)to_ptr + pitch);
-        }
         if (device_can_flush_buffers) {
             // Whether or not we need to flush buffers, we need to at least track what we modified
             // so that we can flush these areas next time before we flip buffers. Or, if we don't
-            // support buffer flipping then we will flush them shortly.
+            // support buffer flipping then we will flush them in finish_flush().
             screen.queue_flush_display_rect(rect);
         }
     };
@@ -714,7 +910,12 @@ void Compositor::flush(Screen& screen)
         do_flush(rect);
     for (auto& rect : screen_data.m_flush_special_rects.rects())
         do_flush(rect);
-    if (device_can_flush_buffers && !screen_data.m_screen_can_set_buffer) {
+}
+
+void Compositor::finish_flush(Screen& screen)
+{
+    auto& screen_data = screen.compositor_screen_data();
+    if (screen.can_device_flush_buffers() && !screen_data.m_screen_can_set_buffer) {
         // If we also support flipping buffers we don't really need to flush these areas right now.
         // Instead, we skip this step and just keep track of them until shortly before the next flip.
         // If we however don't support flipping buffers then we need to flush the changed areas right
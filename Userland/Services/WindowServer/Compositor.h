@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <AK/CircularQueue.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Time.h>
 #include <LibCore/Object.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Font.h>
+#include <LibThreading/WorkerPool.h>
 #include <WindowServer/Overlays.h>
 
 namespace WindowServer {
@@ -32,6 +35,16 @@ enum class WallpaperMode {
     Unchecked
 };
 
+struct CompositorFrameStatistics {
+    u64 frame_count { 0 };
+    size_t worker_thread_count { 0 };
+    // These cover the most recent frames only.
+    Time average_paint_time;
+    Time max_paint_time;
+    Time average_flush_time;
+    Time max_flush_time;
+};
+
 struct CompositorScreenData {
     RefPtr<Gfx::Bitmap> m_front_bitmap;
     RefPtr<Gfx::Bitmap> m_back_bitmap;
@@ -54,6 +67,10 @@ struct CompositorScreenData {
     Gfx::DisjointRectSet m_flush_transparent_rects;
     Gfx::DisjointRectSet m_flush_special_rects;
 
+    // When flipping buffers, these are the areas that were updated in the front buffer since
+    // the back buffer was last shown, and thus are stale in the back buffer.
+    Gfx::DisjointRectSet m_back_buffer_damage;
+
     Gfx::Painter& overlay_painter() { return *m_temp_painter; }
 
     void init_bitmaps(Compositor&, Screen&);
@@ -182,6 +199,7 @@ public:
     void unregister_animation(Badge<Animation>, Animation&);
 
     void set_flash_flush(bool b) { m_flash_flush = b; }
+    CompositorFrameStatistics frame_statistics() const;
 
     static NonnullOwnPtr<CompositorScreenData> create_screen_data(Badge<Screen>)
     {
@@ -189,6 +207,19 @@ public:
     }
 
 private:
+    static constexpr int compose_tile_height = 64;
+
+    struct PendingCopy {
+        Gfx::Bitmap* target { nullptr };
+        Gfx::Bitmap const* source { nullptr };
+        Gfx::IntRect physical_rect;
+    };
+
+    struct FrameTimes {
+        Time paint_time;
+        Time flush_time;
+    };
+
     Compositor();
     void init_bitmaps();
     void invalidate_current_screen_number_rects();
@@ -203,7 +234,11 @@ private:
     void recompute_overlay_rects();
     void recompute_occlusions();
     void change_cursor(const Cursor*);
-    void flush(Screen&);
+    void flash_flush_rects(Screen&);
+    void prepare_flush(Screen&, Vector<PendingCopy>&);
+    void finish_flush(Screen&);
+    void copy_in_parallel(Vector<PendingCopy> const&);
+    void repair_back_buffers();
     Gfx::IntPoint window_transition_offset(Window&);
     void update_animations(Screen&, Gfx::DisjointRectSet& flush_rects);
     void create_window_stack_switch_overlay(WindowStack&);
@@ -248,6 +283,10 @@ private:
     Optional<Gfx::Color> m_custom_background_color;
 
     HashTable<Animation*> m_animations;
+
+    RefPtr<Threading::WorkerPool> m_worker_pool;
+    u64 m_frame_count { 0 };
+    CircularQueue<FrameTimes, 60> m_recent_frame_times;
 };
 
 }
@@ -289,12 +289,11 @@ void WindowFrame::paint_normal_frame(Gfx::Painter& painter)
 void WindowFrame::paint(Screen& screen, Gfx::Painter& painter, const Gfx::IntRect& rect)
 {
     if (auto* cached = render_to_cache(screen))
-        cached->paint(*this, painter, rect);
+        cached->paint(*this, painter, rect, unconstrained_render_rect());
 }
 
-void WindowFrame::PerScaleRenderedCache::paint(WindowFrame& frame, Gfx::Painter& painter, const Gfx::IntRect& rect)
+void WindowFrame::PerScaleRenderedCache::paint(WindowFrame const& frame, Gfx::Painter& painter, const Gfx::IntRect& rect, Gfx::IntRect const& frame_rect) const
 {
-    auto frame_rect = frame.unconstrained_render_rect();
     auto window_rect = frame.window().rect();
     if (m_top_bottom) {
         auto top_bottom_height = frame_rect.height() - window_rect.height();
@@ -29,7 +29,9 @@ public:
         friend class WindowFrame;
 
     public:
-        void paint(WindowFrame&, Gfx::Painter&, const Gfx::IntRect&);
+        // Only reads what render() left behind, so the compositor may paint several parts of a frame at once.
+        // frame_rect has to be the frame's unconstrained_render_rect(), which isn't safe to compute off the main thread.
+        void paint(WindowFrame const&, Gfx::Painter&, const Gfx::IntRect&, Gfx::IntRect const& frame_rect) const;
         void render(WindowFrame&, Screen&);
         Optional<HitTestResult> hit_test(WindowFrame&, Gfx::IntPoint const&, Gfx::IntPoint const&);
 
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/URL.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// A simple HTTP load generator: keeps a number of connections busy with GET requests for the same URL,
+// and reports the request rate and latency distribution.
+
+struct Connection {
+    enum class State {
+        Closed,
+        // Connected, and waiting for the next request.
+        Idle,
+        Connecting,
+        Sending,
+        ReadingHead,
+        ReadingBody,
+    };
+
+    int fd { -1 };
+    State state { State::Closed };
+    size_t sent { 0 };
+    Vector<u8> head;
+    size_t body_remaining { 0 };
+    bool server_closes_connection { false };
+    Time request_start;
+};
+
+static sockaddr_in s_address;
+static String s_raw_request;
+static bool s_keep_alive = true;
+
+static Vector<i64> s_latencies_us;
+static size_t s_requests_started = 0;
+static size_t s_errors = 0;
+static u64 s_bytes_received = 0;
+
+static void close_connection(Connection& connection)
+{
+    if (connection.fd >= 0)
+        close(connection.fd);
+    connection.fd = -1;
+    connection.state = Connection::State::Closed;
+}
+
+static bool start_request(Connection& connection)
+{
+    ++s_requests_started;
+    connection.sent = 0;
+    connection.head.clear();
+    connection.body_remaining = 0;
+    connection.request_start = Time::now_monotonic();
+
+    if (connection.fd >= 0) {
+        connection.state = Connection::State::Sending;
+        return true;
+    }
+
+    connection.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (connection.fd < 0) {
+        perror("socket");
+        return false;
+    }
+    if (connect(connection.fd, (sockaddr const*)&s_address, sizeof(s_address)) < 0 && errno != EINPROGRESS) {
+        perror("connect");
+        close_connection(connection);
+        return false;
+    }
+    connection.state = Connection::State::Connecting;
+    return true;
+}
+
+static void fail_request(Connection& connection)
+{
+    ++s_errors;
+    close_connection(connection);
+}
+
+static void finish_request(Connection& connection)
+{
+    s_latencies_us.append((Time::now_monotonic() - connection.request_start).to_microseconds());
+    if (!s_keep_alive || connection.server_closes_connection)
+        close_connection(connection);
+    else
+        connection.state = Connection::State::Idle;
+}
+
+// Returns false if the response head is malformed.
+static bool parse_response_head(Connection& connection)
+{
+    auto head = StringView { connection.head.data(), connection.head.size() };
+    auto lines = head.split_view("\r\n"sv);
+    if (lines.is_empty() || !lines[0].starts_with("HTTP/1."sv))
+        return false;
+    auto status = lines[0].split_view(' ');
+    if (status.size() < 2 || !status[1].to_uint().has_value())
+        return false;
+
+    Optional<unsigned> content_length;
+    connection.server_closes_connection = lines[0].starts_with("HTTP/1.0"sv);
+    for (size_t i = 1; i < lines.size(); ++i) {
+        auto colon = lines[i].find(':');
+        if (!colon.has_value())
+            continue;
+        auto name = lines[i].substring_view(0, colon.value());
+        auto value = lines[i].substring_view(colon.value() + 1).trim_whitespace();
+        if (name.equals_ignoring_case("Content-Length"sv))
+            content_length = value.to_uint();
+        else if (name.equals_ignoring_case("Connection"sv))
+            connection.server_closes_connection = value.equals_ignoring_case("close"sv);
+    }
+    if (!content_length.has_value()) {
+        warnln("Responses without a Content-Length are not supported");
+        return false;
+    }
+    connection.body_remaining = content_length.value();
+    return true;
+}
+
+static void handle_readable(Connection& connection)
+{
+    u8 buffer[64 * KiB];
+    for (;;) {
+        auto nread = read(connection.fd, buffer, sizeof(buffer));
+        if (nread < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return;
+            fail_request(connection);
+            return;
+        }
+        if (nread == 0) {
+            fail_request(connection);
+            return;
+        }
+        s_bytes_received += nread;
+
+        ReadonlyBytes data { buffer, static_cast<size_t>(nread) };
+        if (connection.state == Connection::State::ReadingHead) {
+            auto old_size = connection.head.size();
+            connection.head.append(data.data(), data.size());
+            auto head = StringView { connection.head.data(), connection.head.size() };
+            auto end_of_head = head.find("\r\n\r\n"sv);
+            if (!end_of_head.has_value())
+                continue;
+            connection.head.shrink(end_of_head.value() + 2);
+            if (!parse_response_head(connection)) {
+                fail_request(connection);
+                return;
+            }
+            connection.state = Connection::State::ReadingBody;
+            data = data.slice(end_of_head.value() + 4 - old_size);
+        }
+
+        if (data.size() > connection.body_remaining) {
+            warnln("Got more data than we asked for");
+            fail_request(connection);
+            return;
+        }
+        connection.body_remaining -= data.size();
+        if (connection.body_remaining == 0) {
+            finish_request(connection);
+            return;
+        }
+    }
+}
+
+static void handle_writable(Connection& connection)
+{
+    if (connection.state == Connection::State::Connecting) {
+        int error = 0;
+        socklen_t error_size = sizeof(error);
+        if (getsockopt(connection.fd, SOL_SOCKET, SO_ERROR, &error, &error_size) < 0 || error != 0) {
+            warnln("Failed to connect: {}", strerror(error));
+            fail_request(connection);
+            return;
+        }
+        connection.state = Connection::State::Sending;
+    }
+
+    while (connection.sent < s_raw_request.length()) {
+        auto nwritten = write(connection.fd, s_raw_request.characters() + connection.sent, s_raw_request.length() - connection.sent);
+        if (nwritten < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return;
+            fail_request(connection);
+            return;
+        }
+        connection.sent += nwritten;
+    }
+    connection.state = Connection::State::ReadingHead;
+}
+
+static i64 percentile(Vector<i64> const& sorted_values, double fraction)
+{
+    VERIFY(!sorted_values.is_empty());
+    auto index = static_cast<size_t>(fraction * (sorted_values.size() - 1));
+    return sorted_values[index];
+}
+
+int main(int argc, char** argv)
+{
+    const char* url_string = nullptr;
+    int concurrency = 10;
+    int request_count = 1000;
+    bool no_keep_alive = false;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Send lots of HTTP requests to a server, and report how quickly it answered them.");
+    args_parser.add_option(concurrency, "Number of connections to keep busy at once", "concurrency", 'c', "count");
+    args_parser.add_option(request_count, "Number of requests to send", "requests", 'n', "count");
+    args_parser.add_option(no_keep_alive, "Open a new connection for every request", "no-keep-alive", 'K');
+    args_parser.add_positional_argument(url_string, "URL to request (http only)", "url");
+    args_parser.parse(argc, argv);
+
+    URL url(url_string);
+    if (!url.is_valid() || url.protocol() != "http") {
+        warnln("Invalid URL: '{}'", url_string);
+        return 1;
+    }
+    if (concurrency <= 0 || request_count <= 0) {
+        warnln("The concurrency and number of requests must be positive");
+        return 1;
+    }
+    s_keep_alive = !no_keep_alive;
+
+    auto* hostent = gethostbyname(url.host().characters());
+    if (!hostent) {
+        warnln("Lookup failed for '{}'", url.host());
+        return 1;
+    }
+    memset(&s_address, 0, sizeof(s_address));
+    s_address.sin_family = AF_INET;
+    s_address.sin_port = htons(url.port_or_default());
+    memcpy(&s_address.sin_addr.s_addr, hostent->h_addr_list[0], sizeof(s_address.sin_addr.s_addr));
+
+    auto path = url.path().is_empty() ? String("/") : url.path();
+    if (!url.query().is_empty())
+        path = String::formatted("{}?{}", path, url.query());
+    s_raw_request = String::formatted("GET {} HTTP/1.1\r\nHost: {}\r\nUser-Agent: http-bench\r\nConnection: {}\r\n\r\n", path, url.host(), s_keep_alive ? "keep-alive" : "close");
+
+    Vector<Connection> connections;
+    connections.resize(min(concurrency, request_count));
+    s_latencies_us.ensure_capacity(request_count);
+
+    auto start_time = Time::now_monotonic();
+    Vector<pollfd> poll_fds;
+    Vector<Connection*> polled_connections;
+    for (;;) {
+        poll_fds.clear_with_capacity();
+        polled_connections.clear_with_capacity();
+        for (auto& connection : connections) {
+            if (connection.state == Connection::State::Closed || connection.state == Connection::State::Idle) {
+                if (s_requests_started == static_cast<size_t>(request_count) || !start_request(connection))
+                    continue;
+            }
+            short events = (connection.state == Connection::State::Connecting || connection.state == Connection::State::Sending) ? POLLOUT : POLLIN;
+            poll_fds.append({ connection.fd, events, 0 });
+            polled_connections.append(&connection);
+        }
+        if (poll_fds.is_empty())
+            break;
+
+        if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("poll");
+            return 1;
+        }
+
+        for (size_t i = 0; i < poll_fds.size(); ++i) {
+            auto& connection = *polled_connections[i];
+            if (poll_fds[i].revents & POLLOUT)
+                handle_writable(connection);
+            else if (poll_fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+                handle_readable(connection);
+        }
+    }
+    auto elapsed = Time::now_monotonic() - start_time;
+
+    for (auto& connection : connections)
+        close_connection(connection);
+
+    outln("{} requests ({} failed) over {} connection(s){}", s_requests_started, s_errors, connections.size(), s_keep_alive ? "" : ", without keep-alive");
+    if (s_latencies_us.is_empty())
+        return 1;
+
+    auto elapsed_seconds = elapsed.to_microseconds() / 1'000'000.0;
+    outln("Time taken:   {:.3} s", elapsed_seconds);
+    outln("Requests/sec: {:.1}", s_latencies_us.size() / elapsed_seconds);
+    outln("Transfer:     {:.1} KiB/s", s_bytes_received / 1024.0 / elapsed_seconds);
+
+    quick_sort(s_latencies_us);
+    outln("Latency (ms): min {:.3}, p50 {:.3}, p90 {:.3}, p99 {:.3}, max {:.3}",
+        s_latencies_us.first() / 1000.0,
+        percentile(s_latencies_us, 0.5) / 1000.0,
+        percentile(s_latencies_us, 0.9) / 1000.0,
+        percentile(s_latencies_us, 0.99) / 1000.0,
+        s_latencies_us.last() / 1000.0);
+
+    return s_errors == 0 ? 0 : 1;
+}
@@ -15,6 +15,7 @@
 #include <LibCore/StandardPaths.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/PassManager.h>
@@ -100,6 +101,9 @@ private:
 static bool s_dump_ast = false;
 static bool s_run_bytecode = false;
 static bool s_opt_bytecode = false;
+static bool s_opt_bytecode_aggressively = false;
+static bool s_skip_function_bodies = false;
+static char const* s_bytecode_cache_directory = nullptr;
 static bool s_as_module = false;
 static bool s_print_last_result = false;
 static RefPtr<Line::Editor> s_editor;
@@ -811,6 +815,7 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView source, Strin
 {
     auto program_type = s_as_module ? JS::Program::Type::Module : JS::Program::Type::Script;
     auto parser = JS::Parser(JS::Lexer(source), program_type);
+    parser.set_skip_function_bodies(s_skip_function_bodies);
     auto program = parser.parse_program();
 
     if (s_dump_ast)
@@ -824,13 +829,20 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView source, Strin
         vm->throw_exception<JS::SyntaxError>(interpreter.global_object(), error.to_string());
     } else {
         if (JS::Bytecode::g_dump_bytecode || s_run_bytecode) {
-            auto executable = JS::Bytecode::Generator::generate(*program);
+            auto* cache = JS::Bytecode::ExecutableCache::the();
+            JS::Bytecode::ExecutableCache::Key cache_key { source, program->is_strict_mode(), false, program_type == JS::Program::Type::Module, s_opt_bytecode };
+            auto cached_executable = cache ? cache->load(cache_key, parser.function_nodes()) : Optional<JS::Bytecode::Executable> {};
+            bool is_cached = cached_executable.has_value();
+
+            auto executable = is_cached ? cached_executable.release_value() : JS::Bytecode::Generator::generate(*program);
             executable.name = source_name;
-            if (s_opt_bytecode) {
+            if (s_opt_bytecode && !is_cached) {
                 auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
                 passes.perform(executable);
                 dbgln("Optimisation passes took {}us", passes.elapsed());
             }
+            if (cache && !is_cached)
+                cache->store(cache_key, executable, parser.function_nodes());
 
             if (JS::Bytecode::g_dump_bytecode)
                 executable.dump();
@@ -1111,6 +1123,10 @@ int main(int argc, char** argv)
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
     args_parser.add_option(s_run_bytecode, "Run the bytecode", "run-bytecode", 'b');
     args_parser.add_option(s_opt_bytecode, "Optimize the bytecode", "optimize-bytecode", 'p');
+    args_parser.add_option(s_opt_bytecode_aggressively, "Optimize the bytecode aggressively (implies -p)", "optimize-bytecode-aggressively", 'O');
+    args_parser.add_option(JS::Bytecode::g_dump_passes, "Dump the bytecode before and after every optimization pass", "dump-passes", 'D');
+    args_parser.add_option(s_skip_function_bodies, "Only build the AST of a function once it is called", "lazy-parse", 'L');
+    args_parser.add_option(s_bytecode_cache_directory, "Keep the bytecode of lazily parsed code in the given directory, and reuse it from there (implies -L)", "bytecode-cache", 'c', "directory");
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
@@ -1124,6 +1140,16 @@ int main(int argc, char** argv)
 
     bool syntax_highlight = !disable_syntax_highlight;
 
+    if (s_bytecode_cache_directory) {
+        s_skip_function_bodies = true;
+        JS::Bytecode::ExecutableCache::enable(s_bytecode_cache_directory);
+    }
+
+    if (s_opt_bytecode_aggressively) {
+        s_opt_bytecode = true;
+        JS::Bytecode::Interpreter::set_optimization_level(JS::Bytecode::Interpreter::OptimizationLevel::Aggressive);
+    }
+
     vm = JS::VM::create();
     // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
     // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
@@ -13,12 +13,22 @@ int main(int argc, char** argv)
     auto app = GUI::Application::construct(argc, argv);
 
     int flash_flush = -1;
+    bool show_statistics = false;
     Core::ArgsParser args_parser;
     args_parser.add_option(flash_flush, "Flash flush (repaint) rectangles", "flash-flush", 'f', "0/1");
+    args_parser.add_option(show_statistics, "Show compositor frame time statistics", "statistics", 's');
     args_parser.parse(argc, argv);
 
     if (flash_flush != -1) {
         GUI::WindowServerConnection::the().async_set_flash_flush(flash_flush);
     }
+
+    if (show_statistics) {
+        auto statistics = GUI::WindowServerConnection::the().get_compositor_statistics();
+        outln("frames:          {}", statistics.frame_count());
+        outln("worker threads:  {}", statistics.worker_thread_count());
+        outln("paint time (us): avg {}, max {}", statistics.average_paint_time_us(), statistics.max_paint_time_us());
+        outln("flush time (us): avg {}, max {}", statistics.average_flush_time_us(), statistics.max_flush_time_us());
+    }
     return 0;
 }